@@ -0,0 +1,427 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+// Benchmark harness for the encoders and decoders.
+// Each benchmark is run over a corpus of synthetic images at several sizes and thread counts,
+// and the results are printed to stdout as JSON so they can be tracked for regressions.
+//
+// usage: quicktex_bench [--sizes 256,1024] [--threads 1,8] [--repetitions 3] [--filter substring]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <quicktex/Metrics.h>
+#include <quicktex/MultiEncode.h>
+#include <quicktex/Texture.h>
+#include <quicktex/bptc/bc6h/BC6HDecoder.h>
+#include <quicktex/bptc/bc6h/BC6HEncoder.h>
+#include <quicktex/bptc/bc7/BC7Decoder.h>
+#include <quicktex/bptc/bc7/BC7Encoder.h>
+#include <quicktex/etc/eac/EACDecoder.h>
+#include <quicktex/etc/eac/EACEncoder.h>
+#include <quicktex/etc/eac/RG11Decoder.h>
+#include <quicktex/etc/eac/RG11Encoder.h>
+#include <quicktex/etc/etc2/ETC2Decoder.h>
+#include <quicktex/etc/etc2/ETC2Encoder.h>
+#include <quicktex/etc/etc2/ETC2RGBADecoder.h>
+#include <quicktex/etc/etc2/ETC2RGBAEncoder.h>
+#include <quicktex/s3tc/bc1/BC1Decoder.h>
+#include <quicktex/s3tc/bc1/BC1Encoder.h>
+#include <quicktex/s3tc/bc2/BC2Decoder.h>
+#include <quicktex/s3tc/bc2/BC2Encoder.h>
+#include <quicktex/s3tc/bc3/BC3Decoder.h>
+#include <quicktex/s3tc/bc3/BC3Encoder.h>
+#include <quicktex/s3tc/bc4/BC4Decoder.h>
+#include <quicktex/s3tc/bc4/BC4Encoder.h>
+#include <quicktex/s3tc/bc5/BC5Decoder.h>
+#include <quicktex/s3tc/bc5/BC5Encoder.h>
+
+using namespace quicktex;
+using namespace quicktex::s3tc;
+using namespace quicktex::bptc;
+using namespace quicktex::etc;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::vector<int> sizes = {256, 1024};
+    std::vector<int> threads;
+    int repetitions = 3;
+    std::string filter;
+};
+
+struct Result {
+    std::string name;
+    std::string image;
+    int size;
+    int threads;
+    double seconds;
+    double mpix_per_second;
+    double psnr;  // NaN for decoders, and multi-exposure PSNR for HDR formats
+};
+
+// Synthetic corpus covering smooth gradients, noise, hard edges and alpha, so results don't depend on files on disk
+const std::vector<std::string> image_names = {"gradient", "noise", "checker", "alpha"};
+
+RawTexture MakeImage(const std::string &name, int size) {
+    RawTexture image(size, size);
+    uint32_t state = 0x12345678;
+    auto rand = [&]() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<uint8_t>(state >> 24);
+    };
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            auto u = static_cast<uint8_t>(x * 255 / size);
+            auto v = static_cast<uint8_t>(y * 255 / size);
+            Color c;
+            if (name == "gradient") {
+                c = Color(u, v, static_cast<uint8_t>(255 - u));
+            } else if (name == "noise") {
+                c = Color(rand(), rand(), rand());
+            } else if (name == "checker") {
+                bool on = ((x / 8) + (y / 8)) % 2;
+                c = on ? Color(230, 40, 40) : Color(20, 20, 200);
+            } else {
+                auto a = static_cast<uint8_t>((x / 16 + y / 16) % 3 == 0 ? 0 : v);
+                c = Color(u, static_cast<uint8_t>(u ^ v), v, a);
+            }
+            image.SetPixel(x, y, c);
+        }
+    }
+    return image;
+}
+
+// The same image as half floats, brightened up to 16x from left to right so it covers a range an 8-bit format can't.
+// Signed images are negated in their bottom half, so negative values are measured too
+HalfTexture MakeHalfImage(const std::string &name, int size, bool is_signed) {
+    auto image = MakeImage(name, size);
+    HalfTexture half(size, size);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            auto c = image.GetPixel(x, y);
+            float scale = std::exp2(4.0f * static_cast<float>(x) / static_cast<float>(size)) / 255.0f;
+            if (is_signed && y >= size / 2) scale = -scale;
+            half.SetPixel(x, y, HalfColor(HalfColor::FromFloat(c.r * scale), HalfColor::FromFloat(c.g * scale), HalfColor::FromFloat(c.b * scale)));
+        }
+    }
+    return half;
+}
+
+// Multi-exposure PSNR between two HDR images. Both are tonemapped to 8 bits with a 2.2 gamma at exposures from 1/16x to 16x,
+// which covers the range of MakeHalfImage, and the squared error is averaged over every exposure.
+// Negative values are tonemapped by their magnitude and keep their sign, so errors in signed images are scored on both sides of zero
+double MultiExposurePSNR(const HalfTexture &original, const HalfTexture &decoded) {
+    constexpr int min_exposure = -4;
+    constexpr int max_exposure = 4;
+    constexpr float gamma = 1.0f / 2.2f;
+
+    // (v * 2^e)^gamma == v^gamma * 2^(e * gamma), so the power only has to be taken once per value
+    auto curve = [](float value) { return std::copysign(std::pow(std::abs(value), gamma), value); };
+    auto tonemap = [](float value, float scale) { return std::copysign(std::round(std::min(std::abs(value) * scale, 255.0f)), value); };
+
+    double sum = 0;
+    size_t count = 0;
+    for (int y = 0; y < original.Height(); y++) {
+        for (int x = 0; x < original.Width(); x++) {
+            auto a = original.GetPixel(x, y);
+            auto b = decoded.GetPixel(x, y);
+            for (unsigned c = 0; c < 3; c++) {
+                float va = curve(HalfColor::ToFloat(a[c]));
+                float vb = curve(HalfColor::ToFloat(b[c]));
+                for (int exposure = min_exposure; exposure <= max_exposure; exposure++) {
+                    float scale = 255.0f * std::exp2(static_cast<float>(exposure) * gamma);
+                    double diff = static_cast<double>(tonemap(va, scale)) - static_cast<double>(tonemap(vb, scale));
+                    sum += diff * diff;
+                    count++;
+                }
+            }
+        }
+    }
+
+    double mse = sum / static_cast<double>(count);
+    if (mse == 0) return std::numeric_limits<double>::infinity();
+    return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+// time the fastest of several repetitions of a function
+double Time(int repetitions, const std::function<void()> &func) {
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < repetitions; r++) {
+        auto start = Clock::now();
+        func();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+std::vector<int> ParseList(const std::string &arg) {
+    std::vector<int> values;
+    std::stringstream stream(arg);
+    std::string item;
+    while (std::getline(stream, item, ',')) values.push_back(std::stoi(item));
+    return values;
+}
+
+class Runner {
+   public:
+    explicit Runner(Options options) : _options(std::move(options)) {}
+
+    template <typename E, typename D> void Run(const std::string &name, const E &encoder, const D &decoder, unsigned channels) {
+        bool run_encoder = Selected(name);
+        bool run_decoder = Selected(name + "/decode");
+        if (!run_encoder && !run_decoder) return;
+
+        for (int size : _options.sizes) {
+            for (const auto &image_name : image_names) {
+                auto image = MakeImage(image_name, size);
+                auto encoded = encoder.Encode(image);
+                double psnr = Compare(image, encoded, decoder, channels).PSNR();
+
+                for (int threads : _options.threads) {
+                    SetThreads(threads);
+                    if (run_encoder) {
+                        double seconds = Time(_options.repetitions, [&] { encoded = encoder.Encode(image); });
+                        Add(name, image_name, size, threads, seconds, psnr);
+                    }
+                    if (run_decoder) {
+                        double seconds = Time(_options.repetitions, [&] { (void)decoder.Decode(encoded); });
+                        Add(name + "/decode", image_name, size, threads, seconds, std::numeric_limits<double>::quiet_NaN());
+                    }
+                }
+            }
+        }
+    }
+
+    // Run an HDR encoder and decoder. 8-bit PSNR isn't meaningful for HDR data, so encoders report a multi-exposure PSNR instead
+    template <typename E, typename D> void RunHalf(const std::string &name, const E &encoder, const D &decoder) {
+        bool run_encoder = Selected(name);
+        bool run_decoder = Selected(name + "/decode");
+        if (!run_encoder && !run_decoder) return;
+
+        const double none = std::numeric_limits<double>::quiet_NaN();
+        for (int size : _options.sizes) {
+            for (const auto &image_name : image_names) {
+                auto image = MakeHalfImage(image_name, size, encoder.IsSigned());
+                auto encoded = encoder.Encode(image);
+                double psnr = MultiExposurePSNR(image, decoder.Decode(encoded));
+
+                for (int threads : _options.threads) {
+                    SetThreads(threads);
+                    if (run_encoder) Add(name, image_name, size, threads, Time(_options.repetitions, [&] { encoded = encoder.Encode(image); }), psnr);
+                    if (run_decoder) Add(name + "/decode", image_name, size, threads, Time(_options.repetitions, [&] { (void)decoder.Decode(encoded); }), none);
+                }
+            }
+        }
+    }
+
+    // Time a function of each image that doesn't produce a single encoded texture, such as a multi-format encode. PSNR is left out
+    template <typename F> void RunCustom(const std::string &name, F run) {
+        if (!Selected(name)) return;
+
+        const double none = std::numeric_limits<double>::quiet_NaN();
+        for (int size : _options.sizes) {
+            for (const auto &image_name : image_names) {
+                auto image = MakeImage(image_name, size);
+
+                for (int threads : _options.threads) {
+                    SetThreads(threads);
+                    Add(name, image_name, size, threads, Time(_options.repetitions, [&] { run(image); }), none);
+                }
+            }
+        }
+    }
+
+    void Print() const {
+        std::printf("{\n  \"context\": {\"repetitions\": %d, \"openmp\": %s},\n  \"benchmarks\": [\n", _options.repetitions,
+#ifdef _OPENMP
+                    "true"
+#else
+                    "false"
+#endif
+        );
+        for (size_t i = 0; i < _results.size(); i++) {
+            const auto &r = _results[i];
+            std::printf("    {\"name\": \"%s\", \"image\": \"%s\", \"size\": %d, \"threads\": %d, \"seconds\": %.6g, \"mpix_per_second\": %.6g, \"psnr\": ",
+                        r.name.c_str(), r.image.c_str(), r.size, r.threads, r.seconds, r.mpix_per_second);
+            // JSON has no infinity, so lossless results have a null PSNR and are marked by their own field instead
+            if (std::isnan(r.psnr) || std::isinf(r.psnr)) {
+                std::printf("null");
+            } else {
+                std::printf("%.4f", r.psnr);
+            }
+            std::printf(", \"lossless\": %s}%s\n", std::isinf(r.psnr) ? "true" : "false", i + 1 < _results.size() ? "," : "");
+        }
+        std::printf("  ]\n}\n");
+    }
+
+   private:
+    bool Selected(const std::string &name) const { return name.find(_options.filter) != std::string::npos; }
+
+    static void SetThreads(int threads) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+    }
+
+    void Add(const std::string &name, const std::string &image, int size, int threads, double seconds, double psnr) {
+        double mpix = static_cast<double>(size) * size / 1e6;
+        _results.push_back({name, image, size, threads, seconds, mpix / seconds, psnr});
+        std::fprintf(stderr, "%-40s %-9s %5d %3d threads %10.2f Mpix/s\n", name.c_str(), image.c_str(), size, threads, mpix / seconds);
+    }
+
+    Options _options;
+    std::vector<Result> _results;
+};
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+#ifdef _OPENMP
+    options.threads = {1, omp_get_max_threads()};
+    if (omp_get_max_threads() == 1) options.threads = {1};
+#else
+    options.threads = {1};
+#endif
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for argument " + arg);
+            std::string value = argv[++i];
+
+            if (arg == "--sizes") {
+                options.sizes = ParseList(value);
+            } else if (arg == "--threads") {
+                options.threads = ParseList(value);
+            } else if (arg == "--repetitions") {
+                options.repetitions = std::stoi(value);
+            } else if (arg == "--filter") {
+                options.filter = value;
+            } else {
+                throw std::invalid_argument("Unknown argument " + arg);
+            }
+        }
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "%s\nusage: %s [--sizes 256,1024] [--threads 1,8] [--repetitions 3] [--filter substring]\n", e.what(), argv[0]);
+        return 1;
+    }
+
+    Runner runner(options);
+    const unsigned rgb = 0x7;
+
+    for (unsigned level = 0; level <= 18; level++) {
+        runner.Run("bc1/level" + std::to_string(level), BC1Encoder(level), BC1Decoder(), rgb);
+    }
+
+    const std::vector<std::pair<std::string, BC1Encoder::EndpointMode>> endpoint_modes = {
+        {"LeastSquares", BC1Encoder::EndpointMode::LeastSquares},
+        {"BoundingBox", BC1Encoder::EndpointMode::BoundingBox},
+        {"BoundingBoxInt", BC1Encoder::EndpointMode::BoundingBoxInt},
+        {"PCA", BC1Encoder::EndpointMode::PCA},
+    };
+    for (const auto &[mode_name, mode] : endpoint_modes) {
+        BC1Encoder encoder(5);
+        encoder.SetEndpointMode(mode);
+        runner.Run("bc1/endpoint_mode/" + mode_name, encoder, BC1Decoder(), rgb);
+    }
+
+    const std::vector<std::pair<std::string, BC1Encoder::ErrorMode>> error_modes = {
+        {"None", BC1Encoder::ErrorMode::None},
+        {"Faster", BC1Encoder::ErrorMode::Faster},
+        {"Check2", BC1Encoder::ErrorMode::Check2},
+        {"Full", BC1Encoder::ErrorMode::Full},
+    };
+    for (const auto &[mode_name, mode] : error_modes) {
+        BC1Encoder encoder(5);
+        encoder.SetErrorMode(mode);
+        runner.Run("bc1/error_mode/" + mode_name, encoder, BC1Decoder(), rgb);
+    }
+
+    for (float lambda : {1.0f, 5.0f}) {
+        BC1Encoder bc1(5);
+        bc1.SetRDOLambda(lambda);
+        runner.Run("bc1/rdo" + std::to_string(static_cast<int>(lambda)), bc1, BC1Decoder(), rgb);
+
+        BC4Encoder bc4(0, BC4Encoder::max_level);
+        bc4.SetRDOLambda(lambda);
+        runner.Run("bc4/rdo" + std::to_string(static_cast<int>(lambda)), bc4, BC4Decoder(0), 0x1);
+    }
+
+    runner.Run("bc2", BC2Encoder(5), BC2Decoder(), 0xF);
+    runner.Run("bc2/dither", BC2Encoder(5, true), BC2Decoder(), 0xF);
+    runner.Run("bc3", BC3Encoder(5), BC3Decoder(), 0xF);
+    runner.Run("bc4", BC4Encoder(0), BC4Decoder(0), 0x1);
+    runner.Run("bc5", BC5Encoder(0, 1), BC5Decoder(0, 1), 0x3);
+
+    for (unsigned level = 1; level <= BC4Encoder::max_level; level++) {
+        runner.Run("bc4/level" + std::to_string(level), BC4Encoder(0, level), BC4Decoder(0), 0x1);
+        runner.Run("bc5/level" + std::to_string(level), BC5Encoder(0, 1, level), BC5Decoder(0, 1), 0x3);
+    }
+
+    for (unsigned level = 0; level <= BC7Encoder::max_level; level++) {
+        runner.Run("bc7/level" + std::to_string(level), BC7Encoder(level), BC7Decoder(), 0xF);
+    }
+
+    for (unsigned level = 0; level <= BC6HEncoder::max_level; level++) {
+        runner.RunHalf("bc6h/level" + std::to_string(level), BC6HEncoder(level), BC6HDecoder());
+        runner.RunHalf("bc6h_signed/level" + std::to_string(level), BC6HEncoder(level, true), BC6HDecoder(true));
+    }
+
+    for (unsigned level = 0; level <= ETC2Encoder::max_level; level++) {
+        runner.Run("etc2/level" + std::to_string(level), ETC2Encoder(level), ETC2Decoder(), rgb);
+    }
+    runner.Run("etc2_rgba", ETC2RGBAEncoder(), ETC2RGBADecoder(), 0xF);
+
+    for (unsigned level = 0; level <= EACEncoder::max_level; level++) {
+        runner.Run("r11/level" + std::to_string(level), EACEncoder(0, level), EACDecoder(0), 0x1);
+        runner.Run("rg11/level" + std::to_string(level), RG11Encoder(0, 1, level), RG11Decoder(0, 1), 0x3);
+    }
+
+    // the same encoders as bc1/level5, bc3, bc7/level1 and etc2/level2, so the sum of their times is the cost of encoding each format separately
+    const BC1Encoder multi_bc1(5);
+    const BC3Encoder multi_bc3(5);
+    const BC7Encoder multi_bc7(1);
+    const ETC2Encoder multi_etc2(2);
+    runner.RunCustom("multi/bc1+bc3+bc7+etc2", [&](const RawTexture &image) { (void)EncodeMulti(image, false, multi_bc1, multi_bc3, multi_bc7, multi_etc2); });
+
+    runner.Print();
+    return 0;
+}
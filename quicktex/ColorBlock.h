@@ -30,10 +30,16 @@
 namespace quicktex {
 using Coords = std::tuple<int, int>;
 
-template <int N, int M> class ColorBlock  {
+/**
+ * A block of pixels gathered from a texture for encoding, or written to one after decoding
+ * @tparam P the pixel type. Metrics are only available for 8-bit Color pixels
+ */
+template <int N, int M, typename P = Color> class ColorBlock {
    public:
+    using Pixel = P;
+
     struct Metrics {
-        Color min;
+        Color min;  // includes alpha, unlike avg and sums
         Color max;
         Color avg;
         bool is_greyscale;
@@ -44,37 +50,37 @@ template <int N, int M> class ColorBlock  {
     static constexpr int Width = N;
     static constexpr int Height = M;
 
-    constexpr Color Get(int x, int y) const {
+    constexpr P Get(int x, int y) const {
         if (x >= Width || x < 0) throw std::invalid_argument("x value out of range");
         if (y >= Height || y < 0) throw std::invalid_argument("y value out of range");
 
         return _pixels[x + (N * y)];
     }
 
-    constexpr Color Get(int i) const {
+    constexpr P Get(int i) const {
         if (i >= N * M || i < 0) throw std::invalid_argument("i value out of range");
         return _pixels[i];
     }
 
-    void Set(int x, int y, const Color &value) {
+    void Set(int x, int y, const P &value) {
         if (x >= Width || x < 0) throw std::invalid_argument("x value out of range");
         if (y >= Height || y < 0) throw std::invalid_argument("y value out of range");
         _pixels[x + (N * y)] = value;
     }
 
-    void Set(int i, const Color &value) {
+    void Set(int i, const P &value) {
         if (i >= N * M || i < 0) throw std::invalid_argument("i value out of range");
         _pixels[i] = value;
     }
 
-    void GetRow(int y, Color *dst) const {
+    void GetRow(int y, P *dst) const {
         if (y >= Height || y < 0) throw std::invalid_argument("y value out of range");
-        std::memcpy(dst, &_pixels[N * y], N * sizeof(Color));
+        std::memcpy(dst, &_pixels[N * y], N * sizeof(P));
     }
 
-    void SetRow(int y, const Color *src) {
+    void SetRow(int y, const P *src) {
         if (y >= Height || y < 0) throw std::invalid_argument("y value out of range");
-        std::memcpy(&_pixels[N * y], src, N * sizeof(Color));
+        std::memcpy(&_pixels[N * y], src, N * sizeof(P));
     }
 
     bool IsSingleColor() const {
@@ -87,8 +93,8 @@ template <int N, int M> class ColorBlock  {
 
     Metrics GetMetrics(bool ignore_black = false) const {
         Metrics metrics;
-        metrics.min = Color(UINT8_MAX, UINT8_MAX, UINT8_MAX);
-        metrics.max = Color(0, 0, 0);
+        metrics.min = Color(UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX);
+        metrics.max = Color(0, 0, 0, 0);
         metrics.has_black = false;
         metrics.is_greyscale = true;
         metrics.sums = {0, 0, 0};
@@ -104,11 +110,11 @@ template <int N, int M> class ColorBlock  {
             if (ignore_black && is_black) { continue; }
 
             metrics.is_greyscale &= val.IsGrayscale();
-            for (unsigned c = 0; c < 3; c++) {
+            for (unsigned c = 0; c < 4; c++) {
                 metrics.min[c] = std::min(metrics.min[c], val[c]);
                 metrics.max[c] = std::max(metrics.max[c], val[c]);
-                metrics.sums[c] += val[c];
             }
+            for (unsigned c = 0; c < 3; c++) metrics.sums[c] += val[c];
             total++;
         }
 
@@ -117,7 +123,7 @@ template <int N, int M> class ColorBlock  {
     }
 
    private:
-    std::array<Color, N * M> _pixels;
+    std::array<P, N * M> _pixels;
 };
 
 }  // namespace quicktex
\ No newline at end of file
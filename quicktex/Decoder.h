@@ -14,27 +14,33 @@
 
 namespace quicktex {
 
-template <class T> class Decoder {
+/**
+ * @tparam T the encoded texture type
+ * @tparam R the uncompressed texture type it decodes to, such as HalfTexture for HDR formats
+ */
+template <class T, class R = RawTexture> class Decoder {
    public:
     using Texture = T;
+    using DecodedTexture = R;
 
     virtual ~Decoder() = default;
-    virtual RawTexture Decode(const T &encoded) const = 0;
+    virtual R Decode(const T &encoded, bool flip = false) const = 0;
 };
 
-template <class T> class BlockDecoder : public Decoder<T> {
+template <class T, class R = RawTexture> class BlockDecoder : public Decoder<T, R> {
    public:
     inline static constexpr int BlockWidth = T::BlockType::Width;
     inline static constexpr int BlockHeight = T::BlockType::Height;
 
     using Texture = T;
+    using DecodedTexture = R;
     using EncodedBlock = typename T::BlockType;
-    using DecodedBlock = ColorBlock<BlockWidth, BlockHeight>;
+    using DecodedBlock = ColorBlock<BlockWidth, BlockHeight, typename R::Pixel>;
 
     virtual DecodedBlock DecodeBlock(const EncodedBlock &block) const = 0;
 
-    virtual RawTexture Decode(const T &encoded) const override {
-        auto decoded = RawTexture(encoded.Width(), encoded.Height());
+    virtual R Decode(const T &encoded, bool flip = false) const override {
+        auto decoded = R(encoded.Width(), encoded.Height());
 
         int blocks_x = encoded.BlocksX();
         int blocks_y = encoded.BlocksY();
@@ -46,7 +52,7 @@ template <class T> class BlockDecoder : public Decoder<T> {
             for (int x = 0; x < blocks_x; x++) {
                 auto block = encoded.GetBlock(x, y);
                 auto pixels = DecodeBlock(block);
-                decoded.SetBlock<BlockWidth, BlockHeight>(x, y, pixels);
+                decoded.template SetBlock<BlockWidth, BlockHeight>(x, y, pixels, flip);
             }
         }
 
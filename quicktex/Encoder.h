@@ -7,34 +7,76 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "ColorBlock.h"
+#include "Metrics.h"
 #include "Texture.h"
 
 namespace quicktex {
 
-template <typename T> class Encoder {
+/**
+ * @tparam T the encoded texture type
+ * @tparam R the uncompressed texture type that is encoded, such as HalfTexture for HDR formats
+ */
+template <typename T, typename R = RawTexture> class Encoder {
    public:
     using Texture = T;
+    using DecodedTexture = R;
 
     virtual ~Encoder() = default;
-    virtual T Encode(const RawTexture &decoded) const = 0;
+    virtual T Encode(const R &decoded, bool flip = false) const = 0;
 };
 
-template <typename T> class BlockEncoder : public Encoder<T> {
+template <typename T, typename R = RawTexture> class BlockEncoder : public Encoder<T, R> {
    public:
     inline static constexpr int BlockWidth = T::BlockType::Width;
     inline static constexpr int BlockHeight = T::BlockType::Height;
 
     using Texture = T;
+    using DecodedTexture = R;
     using EncodedBlock = typename T::BlockType;
-    using DecodedBlock = ColorBlock<BlockWidth, BlockHeight>;
+    using DecodedBlock = ColorBlock<BlockWidth, BlockHeight, typename R::Pixel>;
+    using BlockMetrics = typename DecodedBlock::Metrics;
 
     virtual EncodedBlock EncodeBlock(const DecodedBlock &block) const = 0;
 
-    virtual T Encode(const RawTexture &decoded) const override {
+    /**
+     * Encode a block using metrics already computed by block.GetMetrics(), such as when the same block is encoded to several formats.
+     * Encoders that would compute the same metrics themselves override this to skip doing so, and the rest ignore them.
+     */
+    virtual EncodedBlock EncodeBlockWithMetrics(const DecodedBlock &block, const BlockMetrics &) const { return EncodeBlock(block); }
+
+    /**
+     * Make a second pass over a texture once all of its blocks have been encoded, for encoders whose choice for a block depends on its neighbors,
+     * such as rate-distortion optimization. Does nothing by default.
+     * @param decoded The texture that was encoded
+     * @param encoded The encoded texture, which is modified in place
+     * @param flip True if the texture was vertically flipped while encoding
+     * @return true if any blocks were changed
+     */
+    virtual bool OptimizeTexture(const R &, T &, bool) const { return false; }
+
+    virtual T Encode(const R &decoded, bool flip = false) const override {
         auto encoded = T(decoded.Width(), decoded.Height());
+        EncodeInto(decoded, encoded, flip);
+        return encoded;
+    }
+
+    /**
+     * Encode a texture into an existing texture, such as a view of a memory-mapped file.
+     * @param decoded The texture to encode
+     * @param encoded The destination texture. Must have the same dimensions as the input.
+     * @param flip If true, vertically flip the texture while encoding, at no extra cost
+     */
+    void EncodeInto(const R &decoded, T &encoded, bool flip = false) const {
+        if (encoded.Size() != decoded.Size()) throw std::invalid_argument("Destination texture must have the same dimensions as the input");
 
         int blocks_x = encoded.BlocksX();
         int blocks_y = encoded.BlocksY();
@@ -43,18 +85,134 @@ template <typename T> class BlockEncoder : public Encoder<T> {
         // due to thread creation/teardown taking longer than the encoding process itself.
         // As a result, this is sometimes left as a serial operation despite being embarassingly parallelizable
         // threshold for number of blocks before multithreading is set by overriding MTThreshold()
-#pragma omp parallel for if (blocks_x * blocks_y >= MTThreshold())
+#pragma omp parallel for if (static_cast<size_t>(blocks_x * blocks_y) >= MTThreshold())
         for (int y = 0; y < blocks_y; y++) {
             for (int x = 0; x < blocks_x; x++) {
-                auto pixels = decoded.GetBlock<BlockWidth, BlockHeight>(x, y);
+                auto pixels = decoded.template GetBlock<BlockWidth, BlockHeight>(x, y, flip);
                 auto block = EncodeBlock(pixels);
                 encoded.SetBlock(x, y, block);
             }
         }
 
+        OptimizeTexture(decoded, encoded, flip);
+    }
+
+    /**
+     * Encode a texture and measure its quality in the same pass.
+     * Each block is decoded again right after it is encoded, while it is still in cache, so no second pass over the texture is needed.
+     * @param decoded The texture to encode
+     * @param decoder A decoder matching this encoder's settings, used to reconstruct each block
+     * @param channels Bitmask of the channels the format stores, which are the only ones included in the overall metrics
+     * @param flip If true, vertically flip the texture while encoding
+     * @return The encoded texture, and a report with the error of each block and of the whole texture
+     */
+    template <typename D>
+    std::pair<T, ErrorReport> EncodeWithReport(const R &decoded, const D &decoder, unsigned channels = ErrorMetrics::AllChannels,
+                                               bool flip = false) const {
+        auto encoded = T(decoded.Width(), decoded.Height());
+
+        int blocks_x = encoded.BlocksX();
+        int blocks_y = encoded.BlocksY();
+
+        ErrorReport report(blocks_x, blocks_y, channels);
+        ErrorMetrics metrics(channels);
+
+#pragma omp parallel for reduction(+ : metrics) if (static_cast<size_t>(blocks_x * blocks_y) >= MTThreshold())
+        for (int y = 0; y < blocks_y; y++) {
+            int height = std::min(BlockHeight, decoded.Height() - y * BlockHeight);
+            for (int x = 0; x < blocks_x; x++) {
+                int width = std::min(BlockWidth, decoded.Width() - x * BlockWidth);
+                auto pixels = decoded.template GetBlock<BlockWidth, BlockHeight>(x, y, flip);
+                auto block = EncodeBlock(pixels);
+                encoded.SetBlock(x, y, block);
+
+                auto reconstructed = decoder.DecodeBlock(block);
+                auto error = metrics.AddBlock(pixels, reconstructed, width, height);
+                metrics.AddBlockSSIM(pixels, reconstructed, width, height);
+                report.SetBlockError(x, y, static_cast<float>(error));
+            }
+        }
+
+        if (OptimizeTexture(decoded, encoded, flip)) {
+            // some blocks changed after they were measured, so measure the whole texture again
+            report = ErrorReport(blocks_x, blocks_y, channels);
+            metrics = ErrorMetrics(channels);
+
+#pragma omp parallel for reduction(+ : metrics) if (static_cast<size_t>(blocks_x * blocks_y) >= MTThreshold())
+            for (int y = 0; y < blocks_y; y++) {
+                int height = std::min(BlockHeight, decoded.Height() - y * BlockHeight);
+                for (int x = 0; x < blocks_x; x++) {
+                    int width = std::min(BlockWidth, decoded.Width() - x * BlockWidth);
+                    auto pixels = decoded.template GetBlock<BlockWidth, BlockHeight>(x, y, flip);
+                    auto reconstructed = decoder.DecodeBlock(encoded.GetBlock(x, y));
+                    auto error = metrics.AddBlock(pixels, reconstructed, width, height);
+                    metrics.AddBlockSSIM(pixels, reconstructed, width, height);
+                    report.SetBlockError(x, y, static_cast<float>(error));
+                }
+            }
+        }
+
+        report.metrics = metrics;
+        return {std::move(encoded), std::move(report)};
+    }
+
+    /**
+     * Encode several textures at once, such as every mip level, array slice and cube face of a resource.
+     * All blocks of all textures are encoded in a single parallel loop, so small textures like low mip levels still share the work.
+     * @param textures The textures to encode
+     * @param flip If true, vertically flip each texture while encoding
+     * @return The encoded textures, in the same order as the input
+     */
+    std::vector<T> EncodeBatch(const std::vector<R> &textures, bool flip = false) const {
+        std::vector<T> encoded;
+        std::vector<int> offsets;  // index of the first block of each texture
+        encoded.reserve(textures.size());
+        offsets.reserve(textures.size());
+
+        int total_blocks = 0;
+        for (const auto &texture : textures) {
+            offsets.push_back(total_blocks);
+            encoded.emplace_back(texture.Width(), texture.Height());
+            total_blocks += encoded.back().BlocksX() * encoded.back().BlocksY();
+        }
+
+#pragma omp parallel for if (static_cast<size_t>(total_blocks) >= MTThreshold())
+        for (int i = 0; i < total_blocks; i++) {
+            auto t = static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), i) - offsets.begin() - 1);
+            auto &dest = encoded[t];
+            int b = i - offsets[t];
+            int x = b % dest.BlocksX();
+            int y = b / dest.BlocksX();
+
+            auto pixels = textures[t].template GetBlock<BlockWidth, BlockHeight>(x, y, flip);
+            dest.SetBlock(x, y, EncodeBlock(pixels));
+        }
+
+        for (size_t t = 0; t < textures.size(); t++) OptimizeTexture(textures[t], encoded[t], flip);
         return encoded;
     }
 
+    /**
+     * Encode a texture one horizontal strip at a time, so that only a single strip of the input and output needs to be in memory at once.
+     * Each strip is encoded independently and handed to the sink before the next one is requested.
+     * @param source Callback returning the next strip of the input, or nullopt once the input is exhausted.
+     * Every strip must be the same width, and all strips except the last must have a height that is a multiple of the block height.
+     * @param sink Callback receiving each encoded strip in order, top to bottom.
+     */
+    void EncodeStream(const std::function<std::optional<R>()> &source, const std::function<void(T)> &sink) const {
+        int width = 0;
+        bool finished = false;
+
+        while (auto strip = source()) {
+            if (finished) throw std::invalid_argument("Only the last strip may have a height that is not a multiple of the block height");
+            if (width == 0) width = strip->Width();
+            if (strip->Width() != width) throw std::invalid_argument("All strips must have the same width");
+
+            finished = (strip->Height() % BlockHeight) != 0;
+            sink(Encode(*strip));
+        }
+    }
+
     virtual size_t MTThreshold() const { return SIZE_MAX; };
 };
 }  // namespace quicktex
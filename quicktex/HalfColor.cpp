@@ -0,0 +1,80 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "HalfColor.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace quicktex {
+
+float HalfColor::ToFloat(uint16_t half) {
+    const uint32_t sign = (half & 0x8000U) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1FU;
+    const uint32_t mantissa = half & 0x3FFU;
+
+    if (exponent == 0) {
+        // zero or subnormal, which is a normal float
+        const float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    }
+
+    uint32_t bits;
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000U | (mantissa << 13);  // infinity or NaN
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t HalfColor::FromFloat(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000U);
+    const uint32_t magnitude = bits & 0x7FFFFFFFU;
+
+    if (magnitude > 0x7F800000U) return sign | 0x7E00U;   // NaN
+    if (magnitude >= 0x477FF000U) return sign | 0x7C00U;  // infinity, or too large to round to the largest finite half
+
+    // round the bits shifted out to nearest, with ties to even
+    auto round = [](uint32_t kept, uint32_t shifted, unsigned shift) {
+        const uint32_t halfway = 1U << (shift - 1);
+        if (shifted > halfway || (shifted == halfway && (kept & 1U))) kept++;
+        return kept;
+    };
+
+    if (magnitude < 0x38800000U) {
+        // subnormal half, with the implicit bit of the float's mantissa made explicit
+        if (magnitude < 0x33000000U) return sign;  // rounds to zero
+        const uint32_t mantissa = (magnitude & 0x7FFFFFU) | 0x800000U;
+        const unsigned shift = 126 - (magnitude >> 23);
+        return static_cast<uint16_t>(sign | round(mantissa >> shift, mantissa & ((1U << shift) - 1), shift));
+    }
+
+    // a carry out of the mantissa correctly rounds up to the next exponent
+    const uint32_t rebased = magnitude - (112U << 23);
+    return static_cast<uint16_t>(sign | round(rebased >> 13, rebased & 0x1FFFU, 13));
+}
+
+}  // namespace quicktex
@@ -0,0 +1,62 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace quicktex {
+
+/// An RGBA pixel of IEEE 754 half-precision floats, stored as their raw bits so textures can be shared with other libraries and the GPU
+#pragma pack(push, 1)
+class HalfColor {
+   public:
+    static constexpr uint16_t One = 0x3C00;
+    static constexpr uint16_t MaxFinite = 0x7BFF;
+
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+    uint16_t a;
+
+    constexpr HalfColor() : HalfColor(0, 0, 0, One) {}
+
+    constexpr HalfColor(uint16_t vr, uint16_t vg, uint16_t vb, uint16_t va = One) : r(vr), g(vg), b(vb), a(va) {}
+
+    /// Convert the bits of a half-precision float to a float. This is exact
+    static float ToFloat(uint16_t half);
+
+    /// Convert a float to the bits of the nearest half-precision float, rounding ties to even. Values too large to represent become infinite
+    static uint16_t FromFloat(float value);
+
+    uint16_t operator[](size_t index) const {
+        assert(index < 4);
+        return reinterpret_cast<const uint16_t *>(this)[index];
+    }
+    uint16_t &operator[](size_t index) {
+        assert(index < 4);
+        return reinterpret_cast<uint16_t *>(this)[index];
+    }
+
+    bool operator==(const HalfColor &Rhs) const { return r == Rhs.r && g == Rhs.g && b == Rhs.b && a == Rhs.a; }
+    bool operator!=(const HalfColor &Rhs) const { return !(Rhs == *this); }
+};
+#pragma pack(pop)
+}  // namespace quicktex
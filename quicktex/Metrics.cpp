@@ -0,0 +1,35 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Metrics.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "Texture.h"
+
+namespace quicktex {
+
+ErrorMetrics Compare(const RawTexture &a, const RawTexture &b, unsigned channels) {
+    if (a.Size() != b.Size()) throw std::invalid_argument("Textures must have the same dimensions");
+
+    return CompareBlocks(
+        a.Width(), a.Height(), [&](int x, int y) { return std::make_pair(a.GetBlock<4, 4>(x, y), b.GetBlock<4, 4>(x, y)); }, channels);
+}
+
+}  // namespace quicktex
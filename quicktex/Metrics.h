@@ -0,0 +1,409 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ColorBlock.h"
+#include "Texture.h"
+
+namespace quicktex {
+
+/**
+ * Accumulates the error between an original texture and its reconstruction, per channel.
+ * Only the channels in the mask contribute to the overall MSE, PSNR, max error and SSIM,
+ * so formats that discard channels (like BC4 or BC5) aren't penalized for them.
+ */
+class ErrorMetrics {
+   public:
+    static constexpr unsigned AllChannels = 0xF;
+
+    /// Running sums over a window of one channel, used to compute SSIM
+    struct WindowSums {
+        uint64_t n = 0;
+        uint64_t a = 0, b = 0;
+        uint64_t aa = 0, bb = 0, ab = 0;
+
+        void Add(uint8_t va, uint8_t vb) {
+            n++;
+            a += va;
+            b += vb;
+            aa += static_cast<uint64_t>(va * va);
+            bb += static_cast<uint64_t>(vb * vb);
+            ab += static_cast<uint64_t>(va * vb);
+        }
+
+        WindowSums &operator+=(const WindowSums &rhs) {
+            n += rhs.n;
+            a += rhs.a;
+            b += rhs.b;
+            aa += rhs.aa;
+            bb += rhs.bb;
+            ab += rhs.ab;
+            return *this;
+        }
+
+        /// Sums for each channel over the part of a block that lies inside the texture
+        template <int N, int M>
+        static std::array<WindowSums, 4> FromBlock(const ColorBlock<N, M> &original, const ColorBlock<N, M> &reconstructed, int width = N, int height = M) {
+            auto data_a = Flatten(original, width, height);
+            auto data_b = Flatten(reconstructed, width, height);
+
+            // accumulate in 32 bits, which can't overflow for a single block.
+            // Pixels outside the texture are zero in both blocks, so they don't change any of the sums
+            std::array<uint32_t, 4> a = {}, b = {}, aa = {}, bb = {}, ab = {};
+            for (size_t i = 0; i < data_a.size(); i += 4) {
+                for (size_t c = 0; c < 4; c++) {
+                    uint32_t va = data_a[i + c];
+                    uint32_t vb = data_b[i + c];
+                    a[c] += va;
+                    b[c] += vb;
+                    aa[c] += va * va;
+                    bb[c] += vb * vb;
+                    ab[c] += va * vb;
+                }
+            }
+
+            std::array<WindowSums, 4> sums;
+            for (unsigned c = 0; c < 4; c++) sums[c] = {static_cast<uint64_t>(width * height), a[c], b[c], aa[c], bb[c], ab[c]};
+            return sums;
+        }
+
+        double SSIM() const {
+            constexpr double c1 = (0.01 * 255) * (0.01 * 255);
+            constexpr double c2 = (0.03 * 255) * (0.03 * 255);
+            if (n == 0) return 1.0;
+
+            auto count = static_cast<double>(n);
+            double mean_a = static_cast<double>(a) / count;
+            double mean_b = static_cast<double>(b) / count;
+            double var_a = static_cast<double>(aa) / count - mean_a * mean_a;
+            double var_b = static_cast<double>(bb) / count - mean_b * mean_b;
+            double cov = static_cast<double>(ab) / count - mean_a * mean_b;
+
+            return ((2 * mean_a * mean_b + c1) * (2 * cov + c2)) / ((mean_a * mean_a + mean_b * mean_b + c1) * (var_a + var_b + c2));
+        }
+    };
+
+    explicit ErrorMetrics(unsigned channels = AllChannels) : _channels(channels) {
+        if (channels == 0 || channels > AllChannels) throw std::invalid_argument("Channel mask must contain between 1 and 4 channels");
+    }
+
+    /**
+     * Add the error between an original block and its reconstruction
+     * @param width number of columns of the block that lie inside the texture
+     * @param height number of rows of the block that lie inside the texture
+     * @return the mean squared error of the block over the measured channels
+     */
+    template <int N, int M> double AddBlock(const ColorBlock<N, M> &original, const ColorBlock<N, M> &reconstructed, int width = N, int height = M) {
+        auto data_a = Flatten(original, width, height);
+        auto data_b = Flatten(reconstructed, width, height);
+
+        // fixed-size loops over the whole block so the compiler can vectorize them.
+        // Pixels outside the texture are zero in both blocks, so they add no error
+        std::array<uint32_t, 4> sse = {};
+        std::array<uint8_t, 4> max_error = {};
+        for (size_t i = 0; i < data_a.size(); i += 4) {
+            for (size_t c = 0; c < 4; c++) {
+                int diff = std::abs(static_cast<int>(data_a[i + c]) - static_cast<int>(data_b[i + c]));
+                sse[c] += static_cast<uint32_t>(diff * diff);
+                max_error[c] = std::max(max_error[c], static_cast<uint8_t>(diff));
+            }
+        }
+
+        uint64_t block_sse = 0;
+        for (unsigned c = 0; c < 4; c++) {
+            _sse[c] += sse[c];
+            _max_error[c] = std::max(_max_error[c], max_error[c]);
+            if (HasChannel(c)) block_sse += sse[c];
+        }
+
+        auto pixels = static_cast<uint64_t>(width * height);
+        _pixels += pixels;
+        return static_cast<double>(block_sse) / static_cast<double>(pixels * ChannelCount());
+    }
+
+    /**
+     * Add the SSIM of a block to the average, treating the whole block as a single window.
+     * This is a cheap stand-in for a full windowed SSIM, and is most useful for comparing encoder settings against each other.
+     */
+    template <int N, int M> void AddBlockSSIM(const ColorBlock<N, M> &original, const ColorBlock<N, M> &reconstructed, int width = N, int height = M) {
+        AddSSIM(SSIM(WindowSums::FromBlock(original, reconstructed, width, height)));
+    }
+
+    /// Add the SSIM of a single window to the average
+    void AddSSIM(double ssim, uint64_t windows = 1) {
+        _ssim_sum += ssim * static_cast<double>(windows);
+        _ssim_windows += windows;
+    }
+
+    ErrorMetrics &operator+=(const ErrorMetrics &rhs) {
+        for (unsigned c = 0; c < 4; c++) {
+            _sse[c] += rhs._sse[c];
+            _max_error[c] = std::max(_max_error[c], rhs._max_error[c]);
+        }
+        _pixels += rhs._pixels;
+        _ssim_sum += rhs._ssim_sum;
+        _ssim_windows += rhs._ssim_windows;
+        return *this;
+    }
+
+    unsigned Channels() const { return _channels; }
+    bool HasChannel(unsigned c) const { return (_channels >> c) & 1U; }
+    unsigned ChannelCount() const {
+        unsigned count = 0;
+        for (unsigned c = 0; c < 4; c++) count += HasChannel(c);
+        return count;
+    }
+
+    uint64_t Pixels() const { return _pixels; }
+
+    /// Mean squared error of a single channel
+    double MSE(unsigned c) const {
+        if (c >= 4) throw std::invalid_argument("Channel out of range");
+        return _pixels ? static_cast<double>(_sse[c]) / static_cast<double>(_pixels) : 0;
+    }
+
+    /// Mean squared error over all measured channels
+    double MSE() const {
+        double mse = 0;
+        for (unsigned c = 0; c < 4; c++) {
+            if (HasChannel(c)) mse += MSE(c);
+        }
+        return mse / ChannelCount();
+    }
+
+    /// Peak signal-to-noise ratio of a single channel in dB, or infinity if the channel is identical
+    double PSNR(unsigned c) const { return ToPSNR(MSE(c)); }
+
+    /// Peak signal-to-noise ratio over all measured channels in dB, or infinity if they are identical
+    double PSNR() const { return ToPSNR(MSE()); }
+
+    /// Largest absolute difference in a single channel
+    uint8_t MaxError(unsigned c) const {
+        if (c >= 4) throw std::invalid_argument("Channel out of range");
+        return _max_error[c];
+    }
+
+    /// Largest absolute difference over all measured channels
+    uint8_t MaxError() const {
+        uint8_t max = 0;
+        for (unsigned c = 0; c < 4; c++) {
+            if (HasChannel(c)) max = std::max(max, _max_error[c]);
+        }
+        return max;
+    }
+
+    /// Mean structural similarity over all windows added, between -1 and 1 where 1 is identical
+    double SSIM() const { return _ssim_windows ? _ssim_sum / static_cast<double>(_ssim_windows) : 1.0; }
+
+    /// SSIM of a single window, averaged over the measured channels
+    double SSIM(const std::array<WindowSums, 4> &window) const {
+        double ssim = 0;
+        for (unsigned c = 0; c < 4; c++) {
+            if (HasChannel(c)) ssim += window[c].SSIM();
+        }
+        return ssim / ChannelCount();
+    }
+
+    static double ToPSNR(double mse) {
+        if (mse == 0) return std::numeric_limits<double>::infinity();
+        return 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+   private:
+    /// Copy a block's channels into a flat array, with pixels outside of width and height set to zero
+    template <int N, int M> static std::array<uint8_t, N * M * 4> Flatten(const ColorBlock<N, M> &block, int width, int height) {
+        std::array<uint8_t, N * M * 4> data = {};
+        for (int y = 0; y < height; y++) {
+            auto *row = &data[static_cast<size_t>(y * N * 4)];
+            block.GetRow(y, reinterpret_cast<Color *>(row));
+            std::fill(row + width * 4, row + N * 4, uint8_t(0));
+        }
+        return data;
+    }
+
+    unsigned _channels;
+    std::array<uint64_t, 4> _sse = {};
+    std::array<uint8_t, 4> _max_error = {};
+    uint64_t _pixels = 0;
+    double _ssim_sum = 0;
+    uint64_t _ssim_windows = 0;
+};
+
+#pragma omp declare reduction(+ : ErrorMetrics : omp_out += omp_in) initializer(omp_priv = ErrorMetrics(omp_orig.Channels()))
+
+/**
+ * Compare two textures block by block, computing the error of each channel and SSIM over overlapping 8x8 windows with a stride of 4 pixels.
+ * Rows of blocks are split into chunks which are compared in parallel, and only two rows of window sums are kept per chunk.
+ * @param width width of the textures in pixels
+ * @param height height of the textures in pixels
+ * @param get_blocks function taking block coordinates and returning a pair of 4x4 blocks to compare
+ * @param channels bitmask of the channels to include in the overall metrics
+ */
+template <typename F> ErrorMetrics CompareBlocks(int width, int height, F get_blocks, unsigned channels = ErrorMetrics::AllChannels) {
+    using Sums = std::array<ErrorMetrics::WindowSums, 4>;
+    constexpr int chunk_rows = 16;
+
+    const int blocks_x = (width + 3) / 4;
+    const int blocks_y = (height + 3) / 4;
+    const int chunks = (blocks_y + chunk_rows - 1) / chunk_rows;
+
+    // windows are 2x2 blocks, or the whole texture in dimensions smaller than 8 pixels
+    const int window_w = std::min(2, blocks_x);
+    const int window_h = std::min(2, blocks_y);
+
+    ErrorMetrics metrics(channels);
+
+#pragma omp parallel for reduction(+ : metrics) schedule(static)
+    for (int chunk = 0; chunk < chunks; chunk++) {
+        const int first = chunk * chunk_rows;
+        const int last = std::min(blocks_y, first + chunk_rows);
+
+        std::vector<Sums> prev_row(static_cast<size_t>(blocks_x));
+        std::vector<Sums> row(static_cast<size_t>(blocks_x));
+
+        // windows starting in the last row of the chunk also need the first row of the next chunk
+        const int end = std::min(blocks_y, last + window_h - 1);
+        for (int y = first; y < end; y++) {
+            const int block_height = std::min(4, height - y * 4);
+            for (int x = 0; x < blocks_x; x++) {
+                const int block_width = std::min(4, width - x * 4);
+                const auto [a, b] = get_blocks(x, y);
+                if (y < last) metrics.AddBlock(a, b, block_width, block_height);
+                row[static_cast<size_t>(x)] = ErrorMetrics::WindowSums::FromBlock(a, b, block_width, block_height);
+            }
+
+            const int window_y = y - (window_h - 1);
+            if (window_y >= first) {
+                for (int x = 0; x + window_w <= blocks_x; x++) {
+                    Sums window = {};
+                    for (int wx = x; wx < x + window_w; wx++) {
+                        for (unsigned c = 0; c < 4; c++) {
+                            window[c] += row[static_cast<size_t>(wx)][c];
+                            if (window_h > 1) window[c] += prev_row[static_cast<size_t>(wx)][c];
+                        }
+                    }
+                    metrics.AddSSIM(metrics.SSIM(window));
+                }
+            }
+
+            std::swap(prev_row, row);
+        }
+    }
+
+    return metrics;
+}
+
+/**
+ * Compare two textures of the same size
+ * @param channels bitmask of the channels to include in the overall metrics
+ */
+ErrorMetrics Compare(const RawTexture &a, const RawTexture &b, unsigned channels = ErrorMetrics::AllChannels);
+
+/**
+ * Compare a texture with an encoded texture, decoding one block at a time instead of decoding the whole texture first
+ * @param original The texture before encoding
+ * @param encoded The encoded texture
+ * @param decoder A decoder for the encoded texture
+ * @param channels Bitmask of the channels to include in the overall metrics
+ * @param flip If true, the texture was flipped while encoding
+ */
+template <typename B, typename D>
+ErrorMetrics Compare(const RawTexture &original, const BlockTexture<B> &encoded, const D &decoder, unsigned channels = ErrorMetrics::AllChannels,
+                     bool flip = false) {
+    static_assert(B::Width == 4 && B::Height == 4, "Only 4x4 blocks are supported");
+    if (encoded.Size() != original.Size()) throw std::invalid_argument("Textures must have the same dimensions");
+
+    return CompareBlocks(
+        original.Width(), original.Height(),
+        [&](int x, int y) { return std::make_pair(original.GetBlock<4, 4>(x, y, flip), decoder.DecodeBlock(encoded.GetBlock(x, y))); }, channels);
+}
+
+/**
+ * Quality report for an encoded texture: error metrics for the whole texture, and the MSE of each block
+ */
+class ErrorReport {
+   public:
+    ErrorReport(int blocks_x, int blocks_y, unsigned channels = ErrorMetrics::AllChannels)
+        : metrics(channels), _blocks_x(blocks_x), _blocks_y(blocks_y), _block_errors(static_cast<size_t>(blocks_x * blocks_y)) {}
+
+    ErrorMetrics metrics;
+
+    /**
+     * Measure the quality of an already-encoded texture by decoding it one block at a time
+     * @param original The texture before encoding
+     * @param encoded The encoded texture
+     * @param decoder A decoder for the encoded texture
+     * @param channels Bitmask of the channels to include in the overall metrics
+     * @param flip If true, the texture was flipped while encoding
+     */
+    template <typename B, typename D>
+    static ErrorReport Measure(const RawTexture &original, const BlockTexture<B> &encoded, const D &decoder, unsigned channels = ErrorMetrics::AllChannels,
+                               bool flip = false) {
+        if (encoded.Size() != original.Size()) throw std::invalid_argument("Textures must have the same dimensions");
+
+        constexpr int N = static_cast<int>(B::Width);
+        constexpr int M = static_cast<int>(B::Height);
+
+        ErrorReport report(encoded.BlocksX(), encoded.BlocksY(), channels);
+        for (int y = 0; y < report.BlocksY(); y++) {
+            int height = std::min(M, original.Height() - y * M);
+            for (int x = 0; x < report.BlocksX(); x++) {
+                int width = std::min(N, original.Width() - x * N);
+                auto pixels = original.GetBlock<N, M>(x, y, flip);
+                auto reconstructed = decoder.DecodeBlock(encoded.GetBlock(x, y));
+                auto error = report.metrics.AddBlock(pixels, reconstructed, width, height);
+                report.metrics.AddBlockSSIM(pixels, reconstructed, width, height);
+                report.SetBlockError(x, y, static_cast<float>(error));
+            }
+        }
+        return report;
+    }
+
+    int BlocksX() const { return _blocks_x; }
+    int BlocksY() const { return _blocks_y; }
+
+    /// Mean squared error of a single block over the measured channels
+    float GetBlockError(int x, int y) const { return _block_errors.at(Index(x, y)); }
+    void SetBlockError(int x, int y, float error) { _block_errors.at(Index(x, y)) = error; }
+
+    /// Largest block MSE in the texture, useful for flagging bad compressions that a good average would hide
+    float MaxBlockError() const { return _block_errors.empty() ? 0 : *std::max_element(_block_errors.begin(), _block_errors.end()); }
+
+   private:
+    size_t Index(int x, int y) const {
+        if (x < 0 || x >= _blocks_x) throw std::out_of_range("x value out of range.");
+        if (y < 0 || y >= _blocks_y) throw std::out_of_range("y value out of range.");
+        return static_cast<size_t>(x + y * _blocks_x);
+    }
+
+    int _blocks_x;
+    int _blocks_y;
+    std::vector<float> _block_errors;
+};
+
+}  // namespace quicktex
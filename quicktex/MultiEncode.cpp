@@ -0,0 +1,53 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "MultiEncode.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Texture.h"
+
+namespace quicktex {
+
+void EncodeMultiInto(const RawTexture &decoded, const std::vector<std::shared_ptr<EncodeTarget>> &targets, bool flip) {
+    size_t threshold = SIZE_MAX;
+    for (const auto &target : targets) {
+        if (!target) throw std::invalid_argument("Encode targets cannot be null");
+        if (target->Output().Size() != decoded.Size()) throw std::invalid_argument("Destination textures must have the same dimensions as the input");
+        threshold = std::min(threshold, target->MTThreshold());
+    }
+
+    int blocks_x = (decoded.Width() + 3) / 4;
+    int blocks_y = (decoded.Height() + 3) / 4;
+
+    // every target encodes each block, so the loop is worth parallelizing as soon as any one of them would be on its own
+#pragma omp parallel for if (static_cast<size_t>(blocks_x * blocks_y) >= threshold)
+    for (int y = 0; y < blocks_y; y++) {
+        for (int x = 0; x < blocks_x; x++) {
+            auto pixels = decoded.GetBlock<4, 4>(x, y, flip);
+            auto metrics = pixels.GetMetrics();
+            for (const auto &target : targets) target->EncodeBlock(x, y, pixels, metrics);
+        }
+    }
+
+    for (const auto &target : targets) target->OptimizeTexture(decoded, flip);
+}
+
+}  // namespace quicktex
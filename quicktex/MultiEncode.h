@@ -0,0 +1,109 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "ColorBlock.h"
+#include "Encoder.h"
+#include "Texture.h"
+
+namespace quicktex {
+
+/**
+ * One output of a multi-format encode: an encoder of 4x4 blocks, and the texture it writes them to
+ */
+class EncodeTarget {
+   public:
+    using DecodedBlock = ColorBlock<4, 4>;
+    using BlockMetrics = DecodedBlock::Metrics;
+
+    virtual ~EncodeTarget() = default;
+
+    virtual Texture &Output() = 0;
+
+    /// Encode a single block to the output, using metrics already computed by pixels.GetMetrics()
+    virtual void EncodeBlock(int x, int y, const DecodedBlock &pixels, const BlockMetrics &metrics) = 0;
+
+    /// Make the encoder's second pass over the output, once every block has been encoded
+    virtual void OptimizeTexture(const RawTexture &decoded, bool flip) = 0;
+
+    virtual size_t MTThreshold() const = 0;
+};
+
+/**
+ * A multi-format encode target for a BlockEncoder, which owns its output texture.
+ * The encoder is held by reference, so it must outlive the target.
+ * @tparam E the encoder type, which must encode 4x4 blocks of a RawTexture
+ */
+template <typename E> class BlockEncodeTarget final : public EncodeTarget {
+   public:
+    using EncodedTexture = typename E::Texture;
+    using Base = BlockEncoder<EncodedTexture, typename E::DecodedTexture>;
+
+    static_assert(std::is_base_of_v<Base, E>, "Multi-format encoding requires a BlockEncoder");
+    static_assert(std::is_same_v<typename E::DecodedTexture, RawTexture>, "Multi-format encoding only supports 8-bit RGBA input");
+    static_assert(E::BlockWidth == 4 && E::BlockHeight == 4, "Multi-format encoding only supports 4x4 blocks");
+
+    BlockEncodeTarget(const E &encoder, int width, int height) : _encoder(encoder), _output(width, height) {}
+
+    EncodedTexture &Output() override { return _output; }
+
+    void EncodeBlock(int x, int y, const DecodedBlock &pixels, const BlockMetrics &metrics) override {
+        _output.SetBlock(x, y, _encoder.EncodeBlockWithMetrics(pixels, metrics));
+    }
+
+    void OptimizeTexture(const RawTexture &decoded, bool flip) override { _encoder.OptimizeTexture(decoded, _output, flip); }
+
+    size_t MTThreshold() const override { return _encoder.MTThreshold(); }
+
+   private:
+    const E &_encoder;
+    EncodedTexture _output;
+};
+
+/**
+ * Encode a texture to several formats in a single pass, such as when exporting the same texture for several platforms.
+ * Each block is gathered from the input and measured once, and then passed to every target's encoder while it is still in cache.
+ * The output is identical to encoding the texture with each encoder separately.
+ * @param decoded The texture to encode
+ * @param targets The encoders and their outputs. Every output must have the same dimensions as the input
+ * @param flip If true, vertically flip the texture while encoding
+ */
+void EncodeMultiInto(const RawTexture &decoded, const std::vector<std::shared_ptr<EncodeTarget>> &targets, bool flip = false);
+
+/**
+ * Encode a texture to several formats in a single pass
+ * @param decoded The texture to encode
+ * @param flip If true, vertically flip the texture while encoding
+ * @param encoders The encoders to use, each of which must encode 4x4 blocks of a RawTexture
+ * @return A tuple of the encoded textures, in the same order as the encoders
+ */
+template <typename... E> std::tuple<typename E::Texture...> EncodeMulti(const RawTexture &decoded, bool flip, const E &...encoders) {
+    auto targets = std::make_tuple(std::make_shared<BlockEncodeTarget<E>>(encoders, decoded.Width(), decoded.Height())...);
+
+    std::apply([&](const auto &...t) { EncodeMultiInto(decoded, std::vector<std::shared_ptr<EncodeTarget>>{t...}, flip); }, targets);
+    return std::apply([](const auto &...t) { return std::make_tuple(std::move(t->Output())...); }, targets);
+}
+
+}  // namespace quicktex
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <climits>
 #include <cstdint>
@@ -27,10 +28,12 @@
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "Color.h"
 #include "ColorBlock.h"
+#include "HalfColor.h"
 
 namespace quicktex {
 
@@ -61,37 +64,49 @@ class Texture {
     int _height;
 };
 
-class RawTexture : public Texture {
+/**
+ * An uncompressed texture, which is the input to encoders and the output of decoders
+ * @tparam P the pixel type, such as 8-bit Color for LDR formats or HalfColor for HDR formats
+ */
+template <typename P> class PixelTexture : public Texture {
     using Base = Texture;
 
    public:
+    using Pixel = P;
+
     /**
-     * Create a new RawTexture
+     * Create a new texture
      * @param width width of the texture in pixels
      * @param height height of the texture in pixels
      */
-    RawTexture(int width, int height) : Base(width, height), _pixels(_width * _height) {}
+    PixelTexture(int width, int height) : Base(width, height), _pixels(static_cast<size_t>(_width * _height)) {}
 
-    Color GetPixel(int x, int y) const {
+    P GetPixel(int x, int y) const {
         if (x < 0 || x >= _width) throw std::invalid_argument("x value out of range.");
         if (y < 0 || y >= _height) throw std::invalid_argument("y value out of range.");
         return _pixels.at(x + (y * _width));
     }
 
-    void SetPixel(int x, int y, Color val) {
+    void SetPixel(int x, int y, P val) {
         if (x < 0 || x >= _width) throw std::invalid_argument("x value out of range.");
         if (y < 0 || y >= _height) throw std::invalid_argument("y value out of range.");
         _pixels.at(x + (y * _width)) = val;
     }
 
-    size_t NBytes() const noexcept override { return static_cast<unsigned long>(Width() * Height()) * sizeof(Color); }
+    size_t NBytes() const noexcept override { return static_cast<unsigned long>(Width() * Height()) * sizeof(P); }
 
-    template <int N, int M> ColorBlock<N, M> GetBlock(int block_x, int block_y) const {
+    /**
+     * Get a block of pixels from the texture. Pixels outside the texture wrap around to the other side.
+     * @param block_x x coordinate of the block, in blocks
+     * @param block_y y coordinate of the block, in blocks
+     * @param flip if true, treat the texture as if it were vertically flipped, reading rows bottom-up
+     */
+    template <int N, int M> ColorBlock<N, M, P> GetBlock(int block_x, int block_y, bool flip = false) const {
         if (block_x < 0) throw std::out_of_range("x value out of range.");
         if (block_y < 0) throw std::out_of_range("y value out of range.");
 
         // coordinates in the image of the top-left pixel of the selected block
-        ColorBlock<N, M> block;
+        ColorBlock<N, M, P> block;
         int pixel_x = block_x * N;
         int pixel_y = block_y * M;
 
@@ -99,19 +114,26 @@ class RawTexture : public Texture {
             // fast memcpy if the block is entirely inside the bounds of the texture
             for (int y = 0; y < M; y++) {
                 // copy each row into the ColorBlock
-                block.SetRow(y, &_pixels[pixel_x + (_width * (pixel_y + y))]);
+                block.SetRow(y, &_pixels[pixel_x + (_width * Row(pixel_y + y, flip))]);
             }
         } else {
             // slower pixel-wise copy if the block goes over the edges
             for (int x = 0; x < N; x++) {
-                for (int y = 0; y < M; y++) { block.Set(x, y, GetPixel((pixel_x + x) % _width, (pixel_y + y) % _height)); }
+                for (int y = 0; y < M; y++) { block.Set(x, y, GetPixel((pixel_x + x) % _width, Row((pixel_y + y) % _height, flip))); }
             }
         }
 
         return block;
     }
 
-    template <int N, int M> void SetBlock(int block_x, int block_y, const ColorBlock<N, M> &block) {
+    /**
+     * Write a block of pixels to the texture. Pixels outside the texture wrap around to the other side.
+     * @param block_x x coordinate of the block, in blocks
+     * @param block_y y coordinate of the block, in blocks
+     * @param block the pixels to write
+     * @param flip if true, treat the texture as if it were vertically flipped, writing rows bottom-up
+     */
+    template <int N, int M> void SetBlock(int block_x, int block_y, const ColorBlock<N, M, P> &block, bool flip = false) {
         if (block_x < 0) throw std::out_of_range("x value out of range.");
         if (block_y < 0) throw std::out_of_range("y value out of range.");
 
@@ -123,12 +145,12 @@ class RawTexture : public Texture {
             // fast row-wise memcpy if the block is entirely inside the bounds of the texture
             for (int y = 0; y < M; y++) {
                 // copy each row out of the ColorBlock
-                block.GetRow(y, &_pixels[pixel_x + (_width * (pixel_y + y))]);
+                block.GetRow(y, &_pixels[pixel_x + (_width * Row(pixel_y + y, flip))]);
             }
         } else {
             // slower pixel-wise copy if the block goes over the edges
             for (int x = 0; x < N; x++) {
-                for (int y = 0; y < M; y++) { SetPixel((pixel_x + x) % _width, (pixel_y + y) % _height, block.Get(x, y)); }
+                for (int y = 0; y < M; y++) { SetPixel((pixel_x + x) % _width, Row((pixel_y + y) % _height, flip), block.Get(x, y)); }
             }
         }
     }
@@ -137,12 +159,30 @@ class RawTexture : public Texture {
     virtual uint8_t *Data() noexcept override { return reinterpret_cast<uint8_t *>(_pixels.data()); }
 
    protected:
-    std::vector<Color> _pixels;
+    std::vector<P> _pixels;
+
+   private:
+    /// index of the row in memory for a given row of the texture
+    int Row(int y, bool flip) const noexcept { return flip ? _height - 1 - y : y; }
 };
 
+/// A texture of 8-bit RGBA pixels
+using RawTexture = PixelTexture<Color>;
+
+/// A texture of RGBA half-precision float pixels, for HDR formats
+using HalfTexture = PixelTexture<HalfColor>;
+
+// Blocks that can't always be flipped or mirrored losslessly provide CanFlip() or CanMirror(), which BlockTexture checks before changing anything
+template <typename B, typename = void> struct HasCanFlip : std::false_type {};
+template <typename B> struct HasCanFlip<B, std::void_t<decltype(std::declval<const B &>().CanFlip())>> : std::true_type {};
+
+template <typename B, typename = void> struct HasCanMirror : std::false_type {};
+template <typename B> struct HasCanMirror<B, std::void_t<decltype(std::declval<const B &>().CanMirror())>> : std::true_type {};
+
 template <typename B> class BlockTexture final : public Texture {
    private:
-    std::vector<B> _blocks;
+    std::vector<B> _owned;  // empty if the texture is a view of external memory
+    B *_blocks;
     int _width_b;
     int _height_b;
 
@@ -158,9 +198,43 @@ template <typename B> class BlockTexture final : public Texture {
     BlockTexture(int width, int height) : Base(width, height) {
         _width_b = (_width + B::Width - 1) / B::Width;
         _height_b = (_height + B::Height - 1) / B::Height;
-        _blocks = std::vector<B>(_width_b * _height_b);
+        _owned = std::vector<B>(_width_b * _height_b);
+        _blocks = _owned.data();
+    }
+
+    /**
+     * Create a new BlockTexture that views existing memory instead of owning its blocks. No data is copied.
+     * The memory must remain valid for the lifetime of the texture and any copies of it.
+     * @param data pointer to the first block. must be aligned to alignof(B) and large enough to hold every block of the texture
+     * @param width width of the texture in pixels.
+     * @param height height of the texture in pixels.
+     */
+    static BlockTexture View(uint8_t *data, int width, int height) {
+        if (data == nullptr) throw std::invalid_argument("Texture data must not be null");
+        if (reinterpret_cast<uintptr_t>(data) % alignof(B) != 0) throw std::invalid_argument("Texture data is not correctly aligned");
+
+        return BlockTexture(width, height, reinterpret_cast<B *>(data));
+    }
+
+    BlockTexture(const BlockTexture &other) : Base(other), _owned(other._owned), _width_b(other._width_b), _height_b(other._height_b) {
+        _blocks = other.IsView() ? other._blocks : _owned.data();
+    }
+
+    BlockTexture(BlockTexture &&other) noexcept
+        : Base(other), _owned(std::move(other._owned)), _blocks(other._blocks), _width_b(other._width_b), _height_b(other._height_b) {}
+
+    BlockTexture &operator=(BlockTexture other) noexcept {
+        Base::operator=(other);
+        _owned = std::move(other._owned);
+        _blocks = other._blocks;
+        _width_b = other._width_b;
+        _height_b = other._height_b;
+        return *this;
     }
 
+    /// True if the texture views external memory instead of owning its blocks
+    bool IsView() const noexcept { return _owned.empty(); }
+
     constexpr int BlocksX() const { return _width_b; }
     constexpr int BlocksY() const { return _height_b; }
     constexpr std::tuple<int, int> BlocksXY() const { return std::tuple<int, int>(_width_b, _height_b); }
@@ -168,19 +242,71 @@ template <typename B> class BlockTexture final : public Texture {
     B GetBlock(int x, int y) const {
         if (x < 0 || x >= _width_b) throw std::out_of_range("x value out of range.");
         if (y < 0 || y >= _height_b) throw std::out_of_range("y value out of range.");
-        return _blocks.at(x + (y * _width_b));
+        return _blocks[x + (y * _width_b)];
     }
 
     void SetBlock(int x, int y, const B &val) {
         if (x < 0 || x >= _width_b) throw std::out_of_range("x value out of range.");
         if (y < 0 || y >= _height_b) throw std::out_of_range("y value out of range.");
-        _blocks.at(x + (y * _width_b)) = val;
+        _blocks[x + (y * _width_b)] = val;
     }
 
-    size_t NBytes() const noexcept override { return _blocks.size() * sizeof(B); }
+    /**
+     * Flip the texture vertically in place, by reversing the order of the rows of blocks and flipping each block.
+     * This is lossless, and does not decode the texture.
+     * The height of the texture must be a multiple of the block height, so that no padding ends up at the top of the texture.
+     * If any block can't be flipped losslessly, an exception is thrown and the texture is left unchanged.
+     */
+    void Flip() {
+        if (_height % B::Height != 0) throw std::invalid_argument("Texture height must be a multiple of the block height to flip.");
+        if constexpr (HasCanFlip<B>::value) {
+            if (!std::all_of(_blocks, _blocks + _width_b * _height_b, [](const B &block) { return block.CanFlip(); }))
+                throw std::invalid_argument("Texture contains a block that can't be flipped losslessly.");
+        }
 
-    const uint8_t *Data() const noexcept override { return reinterpret_cast<const uint8_t *>(_blocks.data()); }
-    uint8_t *Data() noexcept override { return reinterpret_cast<uint8_t *>(_blocks.data()); }
+        for (int y = 0; y < (_height_b + 1) / 2; y++) {
+            B *top = &_blocks[y * _width_b];
+            B *bottom = &_blocks[(_height_b - 1 - y) * _width_b];
+            for (int x = 0; x < _width_b; x++) {
+                top[x].Flip();
+                if (top != bottom) {
+                    bottom[x].Flip();
+                    std::swap(top[x], bottom[x]);
+                }
+            }
+        }
+    }
+
+    /**
+     * Mirror the texture horizontally in place, by reversing the order of the blocks in each row and mirroring each block.
+     * This is lossless, and does not decode the texture.
+     * The width of the texture must be a multiple of the block width, so that no padding ends up at the left of the texture.
+     * If any block can't be mirrored losslessly, an exception is thrown and the texture is left unchanged.
+     */
+    void Mirror() {
+        if (_width % B::Width != 0) throw std::invalid_argument("Texture width must be a multiple of the block width to mirror.");
+        if constexpr (HasCanMirror<B>::value) {
+            if (!std::all_of(_blocks, _blocks + _width_b * _height_b, [](const B &block) { return block.CanMirror(); }))
+                throw std::invalid_argument("Texture contains a block that can't be mirrored losslessly.");
+        }
+
+        for (int y = 0; y < _height_b; y++) {
+            B *row = &_blocks[y * _width_b];
+            for (int x = 0; x < _width_b; x++) row[x].Mirror();
+            std::reverse(row, row + _width_b);
+        }
+    }
+
+    size_t NBytes() const noexcept override { return static_cast<size_t>(_width_b * _height_b) * sizeof(B); }
+
+    const uint8_t *Data() const noexcept override { return reinterpret_cast<const uint8_t *>(_blocks); }
+    uint8_t *Data() noexcept override { return reinterpret_cast<uint8_t *>(_blocks); }
+
+   private:
+    BlockTexture(int width, int height, B *blocks) : Base(width, height), _blocks(blocks) {
+        _width_b = (_width + B::Width - 1) / B::Width;
+        _height_b = (_height + B::Height - 1) / B::Height;
+    }
 };
 
 }  // namespace quicktex
\ No newline at end of file
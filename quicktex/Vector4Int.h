@@ -99,6 +99,7 @@ class Vector4Int {
         return max;
     }
     unsigned int SqrMag() { return (unsigned)Dot(*this, *this); }
+    unsigned int SqrMag(const Vector4Int &weights) const { return (unsigned)Dot(*this * *this, weights); }
 
    private:
     template <typename Op> friend Vector4Int DoOp(const Vector4Int &lhs, const Vector4Int &rhs, Op f) {
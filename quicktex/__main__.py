@@ -1,5 +1,6 @@
 import click
 
+from quicktex.cli.bench import bench
 from quicktex.cli.decode import decode
 from quicktex.cli.encode import encode
 
@@ -12,6 +13,7 @@ def main():
 
 main.add_command(encode)
 main.add_command(decode)
+main.add_command(bench)
 
 if __name__ == '__main__':
     main()
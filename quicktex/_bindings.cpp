@@ -20,9 +20,17 @@
 
 #include <pybind11/pybind11.h>
 
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "Color.h"
 #include "Decoder.h"
 #include "Encoder.h"
+#include "Metrics.h"
+#include "MultiEncode.h"
 #include "Texture.h"
 #include "_bindings.h"
 
@@ -34,6 +42,8 @@ namespace py = pybind11;
 namespace quicktex::bindings {
 
 void InitS3TC(py::module_ &m);
+void InitBPTC(py::module_ &m);
+void InitETC(py::module_ &m);
 
 PYBIND11_MODULE(_quicktex, m) {
     m.doc() = "More Stuff";
@@ -67,7 +77,133 @@ PYBIND11_MODULE(_quicktex, m) {
 
     DefSubscript2D(raw_texture, &RawTexture::GetPixel, &RawTexture::SetPixel, &RawTexture::Size);
 
+    // HalfTexture
+
+    py::class_<HalfTexture, Texture> half_texture(m, "HalfTexture", R"doc(
+        A texture of RGBA half-precision float pixels, used for HDR formats such as BC6H.
+        Pixels are read and written as tuples of floats, and the buffer holds the raw 16-bit values in RGBA order.
+    )doc");
+
+    half_texture.def(py::init<int, int>(), "width"_a, "height"_a);
+    half_texture.def_static("frombytes", &BufferToTexture<HalfTexture>, "data"_a, "width"_a, "height"_a);
+
+    DefSubscript2D(half_texture, &HalfTexture::GetPixel, &HalfTexture::SetPixel, &HalfTexture::Size);
+
+    // ErrorMetrics
+
+    py::class_<ErrorMetrics> error_metrics(m, "ErrorMetrics", R"doc(
+        Error between a texture and its reconstruction after encoding.
+        Only the channels stored by the format are included in the overall values, but per-channel values are available for every channel.
+    )doc");
+
+    error_metrics.def_property_readonly("pixels", &ErrorMetrics::Pixels, "Number of pixels measured.");
+    error_metrics.def_property_readonly("channels", &ErrorMetrics::Channels, "Bitmask of the channels included in the overall metrics.");
+    error_metrics.def_property_readonly("mse", py::overload_cast<>(&ErrorMetrics::MSE, py::const_), "Mean squared error over the measured channels.");
+    error_metrics.def_property_readonly("psnr", py::overload_cast<>(&ErrorMetrics::PSNR, py::const_),
+                                        "Peak signal-to-noise ratio over the measured channels in dB. Infinite if the textures are identical.");
+    error_metrics.def_property_readonly("max_error", py::overload_cast<>(&ErrorMetrics::MaxError, py::const_),
+                                        "Largest absolute difference of any measured channel.");
+    error_metrics.def_property_readonly("ssim", &ErrorMetrics::SSIM, "Mean structural similarity, between -1 and 1 where 1 is identical.");
+    error_metrics.def_property_readonly(
+        "channel_mse", [](const ErrorMetrics &e) { return std::make_tuple(e.MSE(0), e.MSE(1), e.MSE(2), e.MSE(3)); },
+        "Mean squared error of each channel, as an RGBA tuple.");
+    error_metrics.def_property_readonly(
+        "channel_psnr", [](const ErrorMetrics &e) { return std::make_tuple(e.PSNR(0), e.PSNR(1), e.PSNR(2), e.PSNR(3)); },
+        "Peak signal-to-noise ratio of each channel, as an RGBA tuple.");
+    error_metrics.def_property_readonly(
+        "channel_max_error", [](const ErrorMetrics &e) { return std::make_tuple(e.MaxError(0), e.MaxError(1), e.MaxError(2), e.MaxError(3)); },
+        "Largest absolute difference in each channel, as an RGBA tuple.");
+
+    // ErrorReport
+
+    py::class_<ErrorReport> error_report(m, "ErrorReport", "Quality report for an encoded texture, returned by ``encode`` when ``report=True``.");
+
+    error_report.def_readonly("metrics", &ErrorReport::metrics, "The :py:class:`ErrorMetrics` of the whole texture.");
+    error_report.def_property_readonly("blocks_x", &ErrorReport::BlocksX, "Width of the texture in blocks.");
+    error_report.def_property_readonly("blocks_y", &ErrorReport::BlocksY, "Height of the texture in blocks.");
+    error_report.def_property_readonly("max_block_error", &ErrorReport::MaxBlockError, "Largest mean squared error of any block.");
+    error_report.def("block_error", &ErrorReport::GetBlockError, "x"_a, "y"_a, "Mean squared error of a single block over the measured channels.");
+    error_report.def_property_readonly(
+        "block_errors",
+        [](const ErrorReport &r) {
+            std::vector<std::vector<float>> rows(static_cast<size_t>(r.BlocksY()));
+            for (int y = 0; y < r.BlocksY(); y++) {
+                for (int x = 0; x < r.BlocksX(); x++) rows[static_cast<size_t>(y)].push_back(r.GetBlockError(x, y));
+            }
+            return rows;
+        },
+        "Mean squared error of every block, as a list of rows.");
+
+    using CompareFunc = ErrorMetrics (*)(const RawTexture &, const RawTexture &, unsigned);
+    m.def("compare", static_cast<CompareFunc>(&Compare), "a"_a, "b"_a, "channels"_a = ErrorMetrics::AllChannels, py::call_guard<py::gil_scoped_release>(),
+          R"doc(
+        Compare two textures of the same size, in parallel.
+        SSIM is computed over overlapping 8x8 windows with a stride of 4 pixels, and averaged over the measured channels.
+
+        :param RawTexture a: The first texture.
+        :param RawTexture b: The second texture.
+        :param int channels: Bitmask of the channels to include in the overall metrics, where bit 0 is red. Default: all channels.
+        :returns: An :py:class:`ErrorMetrics` with the error of each channel and the SSIM.
+    )doc");
+
+    m.def(
+        "set_thread_count",
+        [](int threads) {
+            if (threads < 1) throw std::invalid_argument("Thread count must be at least 1");
+#ifdef _OPENMP
+            omp_set_num_threads(threads);
+#endif
+        },
+        "threads"_a, R"doc(
+        Set the maximum number of threads used by encoders and decoders that are called from the current Python thread.
+        Each Python thread has its own limit, so threads that convert different textures at once can split the CPU between them.
+        Threads that never call this use every core, or the value of the ``OMP_NUM_THREADS`` environment variable.
+
+        :param int threads: The maximum number of threads, at least 1.
+    )doc");
+
+    // Multi-format encoding
+
+    py::class_<EncodeTarget, std::shared_ptr<EncodeTarget>> encode_target(m, "_EncodeTarget");
+    encode_target.def_property_readonly("output", &EncodeTarget::Output, py::return_value_policy::reference_internal);
+
+    m.def(
+        "encode_multi",
+        [](const RawTexture &texture, const std::vector<py::object> &encoders, bool flip) {
+            std::vector<py::object> py_targets;
+            std::vector<std::shared_ptr<EncodeTarget>> targets;
+            for (const auto &encoder : encoders) {
+                if (!py::hasattr(encoder, "_encode_target")) {
+                    throw py::type_error(py::type::of(encoder).attr("__name__").cast<std::string>() + " can't be used for multi-format encoding");
+                }
+                py_targets.push_back(encoder.attr("_encode_target")(texture.Width(), texture.Height()));
+                targets.push_back(py_targets.back().cast<std::shared_ptr<EncodeTarget>>());
+            }
+
+            {
+                py::gil_scoped_release release;
+                EncodeMultiInto(texture, targets, flip);
+            }
+
+            py::list outputs;
+            for (const auto &target : py_targets) outputs.append(target.attr("output"));
+            return outputs;
+        },
+        "texture"_a, "encoders"_a, "flip"_a = false, R"doc(
+        Encode a raw texture to several formats in a single pass, such as when exporting the same texture for several platforms.
+        Each block is read from the input and measured once, then encoded by every encoder while it is still in cache.
+        The output is identical to calling each encoder's ``encode`` method separately.
+
+        :param RawTexture texture: Input texture to encode.
+        :param encoders: A sequence of encoders for formats with 4x4 blocks and 8-bit input, such as BC1, BC3, BC7 or ETC2.
+            May contain the same encoder more than once.
+        :param bool flip: If true, vertically flip the texture while encoding. Default: False
+        :returns: A list of new textures, one for each encoder in the same order.
+    )doc");
+
     InitS3TC(m);
+    InitBPTC(m);
+    InitETC(m);
 }
 
 }  // namespace quicktex::bindings
\ No newline at end of file
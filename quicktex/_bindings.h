@@ -20,15 +20,21 @@
 
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 #include "Color.h"
 #include "ColorBlock.h"
+#include "HalfColor.h"
+#include "Metrics.h"
+#include "MultiEncode.h"
 #include "Texture.h"
 #include "util.h"
 
@@ -80,6 +86,53 @@ template <> struct type_caster<Color> {
         return val;
     }
 };
+/// Type caster for half-float color class to allow it to be converted to and from a python tuple of floats
+template <> struct type_caster<HalfColor> {
+   public:
+    PYBIND11_TYPE_CASTER(HalfColor, _("HalfColor"));
+
+    bool load(handle src, bool) {
+        PyObject* source = src.ptr();
+
+        PyObject* tmp = PySequence_Tuple(source);
+
+        // if the object is not a tuple, return false
+        if (!tmp) { return false; }  // incorrect type
+
+        // check the size
+        Py_ssize_t size = PyTuple_Size(tmp);
+        if (size < 3 || size > 4) {
+            Py_DECREF(tmp);
+            return false;
+        }  // incorrect size
+
+        value.a = HalfColor::One;
+        // now we get the contents
+        for (int i = 0; i < size; i++) {
+            double chan = PyFloat_AsDouble(PyTuple_GetItem(tmp, i));
+            if (chan == -1.0 && PyErr_Occurred()) {
+                PyErr_Clear();
+                Py_DECREF(tmp);
+                return false;  // incorrect channel type
+            }
+            value[static_cast<unsigned>(i)] = HalfColor::FromFloat(static_cast<float>(chan));
+        }
+        Py_DECREF(tmp);
+
+        return true;
+    }
+
+    static handle cast(HalfColor src, return_value_policy, handle) {
+        PyObject* val = PyTuple_New(4);
+
+        for (int i = 0; i < 4; i++) {
+            PyObject* chan = PyFloat_FromDouble(HalfColor::ToFloat(src[static_cast<unsigned>(i)]));
+            PyTuple_SetItem(val, i, chan);
+        }
+
+        return val;
+    }
+};
 }  // namespace pybind11::detail
 
 namespace py = pybind11;
@@ -108,6 +161,19 @@ template <typename T> T BufferToTexture(py::buffer buf, int width, int height) {
     return output;
 }
 
+template <typename B> BlockTexture<B> BufferToBlockTextureView(py::buffer buf, int width, int height) {
+    auto info = buf.request(true);
+
+    if (info.format != py::format_descriptor<uint8_t>::format()) throw std::runtime_error("Incompatible format in python buffer: expected a byte array.");
+    if (info.ndim != 1) throw std::runtime_error("Incompatible format in python buffer: Incorrect number of dimensions.");
+    if (info.strides[0] != 1) throw std::runtime_error("Incompatible format in python buffer: 1-D buffer is not contiguous.");
+
+    auto view = BlockTexture<B>::View(reinterpret_cast<uint8_t*>(info.ptr), width, height);
+    if (info.size < (Py_ssize_t)view.NBytes()) throw std::runtime_error("Incompatible format in python buffer: Input data is smaller than texture size.");
+
+    return view;
+}
+
 template <typename T> T BufferToPOD(py::buffer buf) {
     static_assert(std::is_trivially_copyable_v<T>);
 
@@ -189,6 +255,9 @@ template <typename B> py::class_<B> BindBlock(py::module_& m, const char* name)
 
     block.def(py::self == py::self);
 
+    block.def("flip", &B::Flip, "Flip the block vertically in place, by reordering its selectors.");
+    block.def("mirror", &B::Mirror, "Mirror the block horizontally in place, by reordering its selectors.");
+
     block.def_buffer([](B& b) { return py::buffer_info(reinterpret_cast<uint8_t*>(&b), sizeof(B)); });
     block.def(
         "tobytes", [](const B& b) { return py::bytes(reinterpret_cast<const char*>(&b), sizeof(B)); },
@@ -217,6 +286,15 @@ template <typename B> py::class_<BlockTexture<B>> BindBlockTexture(py::module_&
         :param int height: The height of the texture in pixels. must be > 0
     )doc";
 
+    const auto* const from_buffer_str = R"doc(
+        Create a new {0} with the given dimensions that views the memory of a writable bytes-like object, such as a memory-mapped file.
+        No data is copied, and the texture keeps the object alive for as long as it exists.
+
+        :param data: A writable, contiguous bytes-like object at least the size of the resulting texture, aligned to the block size.
+        :param int width: The width of the texture in pixels. Must be > 0.
+        :param int height: The height of the texture in pixels. must be > 0
+    )doc";
+
     using BTex = BlockTexture<B>;
 
     py::class_<BTex, Texture> block_texture(m, name);
@@ -224,12 +302,178 @@ template <typename B> py::class_<BlockTexture<B>> BindBlockTexture(py::module_&
     block_texture.def(py::init<int, int>(), "width"_a, "height"_a, Format(constructor_str, name).c_str());
     block_texture.def_static("from_bytes", &BufferToTexture<BTex>, "data"_a, "width"_a, "height"_a, Format(from_bytes_str, name).c_str());
 
+    block_texture.def_static("from_buffer", &BufferToBlockTextureView<B>, "data"_a, "width"_a, "height"_a, py::keep_alive<0, 1>(),
+                             Format(from_buffer_str, name).c_str());
+
+    block_texture.def_property_readonly("is_view", &BTex::IsView, "True if the texture is a view of another object's memory. Readonly.");
     block_texture.def_property_readonly("width_blocks", &BTex::BlocksX, "The width of the texture in blocks.");
     block_texture.def_property_readonly("height_blocks", &BTex::BlocksY, "The height of the texture in blocks.");
     block_texture.def_property_readonly("size_blocks", &BTex::BlocksXY, "The dimensions of the texture in blocks.");
 
+    block_texture.def("flip", &BTex::Flip, R"doc(
+        Flip the texture vertically in place, without decoding it. This is lossless.
+
+        :raises ValueError: if the height of the texture is not a multiple of the block height,
+            or if any block can't be flipped losslessly, in which case the texture is left unchanged.
+    )doc");
+    block_texture.def("mirror", &BTex::Mirror, R"doc(
+        Mirror the texture horizontally in place, without decoding it. This is lossless.
+
+        :raises ValueError: if the width of the texture is not a multiple of the block width,
+            or if any block can't be mirrored losslessly, in which case the texture is left unchanged.
+    )doc");
+
     DefSubscript2D(block_texture, &BTex::GetBlock, &BTex::SetBlock, &BTex::BlocksXY);
 
     return std::move(block_texture);
 }
+
+/**
+ * Encode a texture with the GIL released, returning a (texture, report) tuple
+ * @param decoder A decoder matching the encoder's settings
+ * @param channels Bitmask of the channels the format stores
+ */
+template <typename E, typename D> py::object EncodeWithReport(const E& encoder, const RawTexture& texture, bool flip, const D& decoder, unsigned channels) {
+    std::pair<typename E::Texture, ErrorReport> result = [&] {
+        py::gil_scoped_release release;
+        return encoder.EncodeWithReport(texture, decoder, channels, flip);
+    }();
+    return py::cast(std::move(result));
+}
+
+/// Encode a texture with the GIL released, returning only the texture
+template <typename E> py::object EncodeTexture(const E& encoder, const typename E::DecodedTexture& texture, bool flip) {
+    typename E::Texture result(texture.Width(), texture.Height());
+    {
+        py::gil_scoped_release release;
+        encoder.EncodeInto(texture, result, flip);
+    }
+    return py::cast(std::move(result));
+}
+
+/**
+ * Bind an encoder's encode method, with an optional quality report
+ * @param decoder_for Function returning a decoder matching an encoder's settings, and the bitmask of channels the format stores
+ */
+template <typename E, typename... Options, typename F> void DefEncode(py::class_<E, Options...>& encoder, const char* texture_name, F decoder_for) {
+    const char* encode_doc = R"doc(
+        Encode a raw texture into a new {0} using the encoder's current settings.
+
+        :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while encoding, at no extra cost. Default: False
+        :param bool report: If true, also measure the error of each block while encoding and return an :py:class:`~quicktex.ErrorReport`.
+            This is much faster than decoding and comparing the texture afterwards. Default: False
+        :returns: A new {0} with the same dimension as the input, or a tuple of (texture, report) if ``report`` is True.
+    )doc";
+
+    encoder.def(
+        "encode",
+        [decoder_for](const E& self, const RawTexture& texture, bool flip, bool report) -> py::object {
+            if (report) {
+                auto [decoder, channels] = decoder_for(self);
+                return EncodeWithReport(self, texture, flip, decoder, channels);
+            }
+
+            return EncodeTexture(self, texture, flip);
+        },
+        "texture"_a, "flip"_a = false, "report"_a = false, Format(encode_doc, texture_name).c_str());
+}
+
+/**
+ * Bind a decoder's compare method, which scores an encoded texture against the original without decoding it all at once
+ * @param default_channels Function returning the bitmask of channels a decoder writes to
+ */
+template <typename D, typename... Options, typename F> void DefCompare(py::class_<D, Options...>& decoder, F default_channels) {
+    using Tex = typename D::Texture;
+
+    decoder.def(
+        "compare",
+        [default_channels](const D& self, const RawTexture& original, const Tex& encoded, std::optional<unsigned> channels, bool flip) {
+            unsigned mask = channels.value_or(default_channels(self));
+            py::gil_scoped_release release;
+            return Compare(original, encoded, self, mask, flip);
+        },
+        "original"_a, "encoded"_a, "channels"_a = py::none(), "flip"_a = false, R"doc(
+        Compare an encoded texture with the original, decoding it one block at a time so the full decoded texture is never stored.
+
+        :param RawTexture original: The texture before encoding.
+        :param encoded: The encoded texture.
+        :param int channels: Bitmask of the channels to include in the overall metrics, where bit 0 is red. Default: the channels written by this decoder.
+        :param bool flip: If true, the texture was flipped while encoding. Default: False
+        :returns: An :py:class:`~quicktex.ErrorMetrics` with the error of each channel and the SSIM.
+    )doc");
+}
+
+template <typename E, typename... Options> void DefEncodeInto(py::class_<E, Options...>& encoder) {
+    encoder.def("encode_into", &E::EncodeInto, "texture"_a, "output"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Encode a raw texture into an existing texture using the encoder's current settings, such as a view created with ``from_buffer``.
+
+        :param RawTexture texture: Input texture to encode.
+        :param output: Destination texture. Must have the same dimensions as the input.
+        :param bool flip: If true, vertically flip the texture while encoding. Default: False
+    )doc");
+}
+
+template <typename E, typename... Options> void DefEncodeBatch(py::class_<E, Options...>& encoder) {
+    encoder.def("encode_batch", &E::EncodeBatch, "textures"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Encode several raw textures at once using the encoder's current settings, such as every mip level, array slice and cube face of a resource.
+        All blocks of all textures are encoded in a single parallel job.
+
+        :param textures: A sequence of :py:class:`~quicktex.RawTexture` to encode.
+        :param bool flip: If true, vertically flip each texture while encoding. Default: False
+        :returns: A list of new textures with the encoded data, in the same order as the input.
+    )doc");
+}
+
+/// Bind the method quicktex.encode_multi uses to create a target for an encoder, which keeps the encoder alive for as long as the target exists
+template <typename E, typename... Options> void DefEncodeMulti(py::class_<E, Options...>& encoder) {
+    encoder.def(
+        "_encode_target",
+        [](const E& self, int width, int height) -> std::shared_ptr<EncodeTarget> { return std::make_shared<BlockEncodeTarget<E>>(self, width, height); },
+        "width"_a, "height"_a, py::keep_alive<0, 1>());
+}
+
+template <typename E, typename... Options> void DefEncodeStream(py::class_<E, Options...>& encoder) {
+    using Tex = typename E::Texture;
+    using Decoded = typename E::DecodedTexture;
+
+    encoder.def(
+        "encode_stream",
+        [](const E& self, py::iterable strips, int width, py::function sink) {
+            if (width <= 0) throw std::invalid_argument("Texture width must be greater than 0");
+            auto row_bytes = static_cast<Py_ssize_t>(width) * static_cast<Py_ssize_t>(sizeof(typename Decoded::Pixel));
+            auto it = py::iter(strips);
+
+            // the strips are read and the sink is called with the GIL held, while the strips are encoded without it
+            auto source = [&]() -> std::optional<Decoded> {
+                py::gil_scoped_acquire acquire;
+                auto item = py::reinterpret_steal<py::object>(PyIter_Next(it.ptr()));
+                if (!item) {
+                    if (PyErr_Occurred()) throw py::error_already_set();
+                    return std::nullopt;
+                }
+
+                auto buf = item.cast<py::buffer>();
+                auto size = buf.request(false).size;
+                if (size % row_bytes != 0) throw std::invalid_argument("Strip size in bytes is not a multiple of the row size.");
+
+                return BufferToTexture<Decoded>(buf, width, static_cast<int>(size / row_bytes));
+            };
+
+            py::gil_scoped_release release;
+            self.EncodeStream(source, [&](Tex encoded) {
+                py::gil_scoped_acquire acquire;
+                sink(py::cast(std::move(encoded)));
+            });
+        },
+        "strips"_a, "width"_a, "sink"_a, R"doc(
+        Encode a texture one horizontal strip at a time, so that the full input and output never need to be in memory at once.
+        Each strip is encoded and passed to ``sink`` before the next strip is read.
+
+        :param strips: An iterable of bytes-like objects (such as :py:class:`~quicktex.RawTexture`) containing RGBA rows of the input.
+            All strips except the last must contain a multiple of 4 rows.
+        :param int width: The width of the input in pixels.
+        :param sink: A callable that is passed each encoded strip as a new texture, in order from top to bottom.
+    )doc");
+}
 }  // namespace quicktex::bindings
\ No newline at end of file
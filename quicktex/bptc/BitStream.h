@@ -0,0 +1,93 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace quicktex::bptc {
+
+using BlockBytes = std::array<uint8_t, 16>;
+
+/// Reads fields from a 128-bit BPTC block, starting from the least significant bit of the first byte
+class BitReader {
+   public:
+    explicit BitReader(const BlockBytes &bytes) {
+        for (unsigned i = 0; i < 8; i++) {
+            _lo |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+            _hi |= static_cast<uint64_t>(bytes[i + 8]) << (8 * i);
+        }
+    }
+
+    /// Read the next field of up to 32 bits
+    unsigned Read(unsigned bits) {
+        if (bits == 0) return 0;
+        uint64_t value;
+        if (_pos >= 64) {
+            value = _hi >> (_pos - 64);
+        } else {
+            value = _lo >> _pos;
+            if (_pos > 0 && _pos + bits > 64) value |= _hi << (64 - _pos);
+        }
+        _pos += bits;
+        return static_cast<unsigned>(value & ((uint64_t(1) << bits) - 1));
+    }
+
+    unsigned Position() const { return _pos; }
+
+   private:
+    uint64_t _lo = 0;
+    uint64_t _hi = 0;
+    unsigned _pos = 0;
+};
+
+/// Writes fields to a 128-bit BPTC block, starting from the least significant bit of the first byte
+class BitWriter {
+   public:
+    /// Write the next field of up to 32 bits
+    void Write(unsigned value, unsigned bits) {
+        if (bits == 0) return;
+        const uint64_t masked = value & ((uint64_t(1) << bits) - 1);
+        if (_pos >= 64) {
+            _hi |= masked << (_pos - 64);
+        } else {
+            _lo |= masked << _pos;
+            if (_pos > 0 && _pos + bits > 64) _hi |= masked >> (64 - _pos);
+        }
+        _pos += bits;
+    }
+
+    unsigned Position() const { return _pos; }
+
+    BlockBytes Bytes() const {
+        BlockBytes bytes;
+        for (unsigned i = 0; i < 8; i++) {
+            bytes[i] = static_cast<uint8_t>(_lo >> (8 * i));
+            bytes[i + 8] = static_cast<uint8_t>(_hi >> (8 * i));
+        }
+        return bytes;
+    }
+
+   private:
+    uint64_t _lo = 0;
+    uint64_t _hi = 0;
+    unsigned _pos = 0;
+};
+
+}  // namespace quicktex::bptc
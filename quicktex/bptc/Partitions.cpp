@@ -0,0 +1,228 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Partitions.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+#include "../util.h"
+#include "Tables.h"
+
+namespace quicktex::bptc {
+
+namespace {
+RemapTable MakeRemapTable(const PixelMap &map) {
+    RemapTable table;
+    for (unsigned subsets = 2; subsets <= 3; subsets++) {
+        for (unsigned p = 0; p < 64; p++) {
+            PixelMap moved;
+            for (unsigned i = 0; i < 16; i++) moved[i] = Subset(subsets, p, map[i]);
+
+            // use the lowest matching partition, so that modes with fewer partition bits can still find it if it exists
+            for (unsigned q = 0; q < 64; q++) {
+                std::array<int, 3> original = {-1, -1, -1};
+                bool match = true;
+                for (unsigned i = 0; i < 16 && match; i++) {
+                    auto &o = original[Subset(subsets, q, i)];
+                    if (o < 0) o = moved[i];
+                    match = (o == moved[i]);
+                }
+                // labels must map one-to-one. Every subset of every partition is non-empty, so checking for duplicates is enough
+                for (unsigned a = 0; a < subsets && match; a++) {
+                    for (unsigned b = a + 1; b < subsets; b++) match &= (original[a] != original[b]);
+                }
+                if (!match) continue;
+
+                auto &remap = table[subsets - 2][p];
+                remap.partition = static_cast<int>(q);
+                for (unsigned s = 0; s < subsets; s++) remap.subsets[s] = static_cast<uint8_t>(original[s]);
+                break;
+            }
+        }
+    }
+    return table;
+}
+
+}  // namespace
+
+const RemapTable &FlipTable() {
+    static const RemapTable table = MakeRemapTable(flip_map);
+    return table;
+}
+
+const RemapTable &MirrorTable() {
+    static const RemapTable table = MakeRemapTable(mirror_map);
+    return table;
+}
+
+const Remap *FindRemap(const RemapTable &table, unsigned subsets, unsigned partition, unsigned available) {
+    if (subsets < 2) return nullptr;
+    const auto &remap = table[subsets - 2][partition];
+    if (remap.partition < 0 || static_cast<unsigned>(remap.partition) >= available) return nullptr;
+    return &remap;
+}
+
+namespace {
+// Partition membership of every pixel as a mask of all ones or all zeros, with partitions innermost so loops over all of them vectorize
+using Lanes = std::array<int, 64>;
+using MembershipTable = std::array<std::array<Lanes, 16>, 3>;  // indexed by [subset][pixel][partition]
+
+MembershipTable MakeMembershipTable(unsigned subsets) {
+    MembershipTable table = {};
+    for (unsigned s = 0; s < subsets; s++) {
+        for (unsigned i = 0; i < 16; i++) {
+            for (unsigned p = 0; p < 64; p++) table[s][i][p] = (Subset(subsets, p, i) == s) ? -1 : 0;
+        }
+    }
+    return table;
+}
+
+const MembershipTable &GetMembershipTable(unsigned subsets) {
+    static const MembershipTable table2 = MakeMembershipTable(2);
+    static const MembershipTable table3 = MakeMembershipTable(3);
+    return subsets == 2 ? table2 : table3;
+}
+
+// Channel pairs of the upper triangle of a 4x4 scatter matrix. Pairs with alpha are last, so they can be skipped for opaque blocks
+constexpr std::array<std::array<unsigned, 2>, 10> scatter_pairs = {{{0, 0}, {0, 1}, {0, 2}, {1, 1}, {1, 2}, {2, 2}, {0, 3}, {1, 3}, {2, 3}, {3, 3}}};
+
+// Moments of one subset of every partition
+struct Moments {
+    Lanes count = {};
+    std::array<Lanes, 4> sums = {};
+    std::array<Lanes, 10> products = {};
+};
+
+// Add the squared distance of each partition's subset from its principal axis to its estimate.
+// The distance is the subset's total variance minus the variance along the axis, which is found by power iteration.
+// There are no branches, so the loop vectorizes across partitions
+void AddResiduals(const Moments &moments, std::array<float, 64> &estimates) {
+    for (unsigned p = 0; p < 64; p++) {
+        const float count = static_cast<float>(moments.count[p]);
+        auto scatter = [&](unsigned j) {
+            const float sum_a = static_cast<float>(moments.sums[scatter_pairs[j][0]][p]);
+            const float sum_b = static_cast<float>(moments.sums[scatter_pairs[j][1]][p]);
+            return static_cast<float>(moments.products[j][p]) - sum_a * sum_b / count;
+        };
+
+        // normalize by the trace so iterating doesn't overflow.
+        // Floating point min and max are branches unless traps are disabled, so small offsets keep divisors non-zero instead
+        const float trace = scatter(0) + scatter(3) + scatter(5) + scatter(9);
+        const float scale = 1.0f / (trace + 1e-6f);
+        const float s00 = scatter(0) * scale, s01 = scatter(1) * scale, s02 = scatter(2) * scale, s11 = scatter(3) * scale;
+        const float s12 = scatter(4) * scale, s22 = scatter(5) * scale, s03 = scatter(6) * scale, s13 = scatter(7) * scale;
+        const float s23 = scatter(8) * scale, s33 = scatter(9) * scale;
+
+        // start from the column with the most variance, so the start isn't orthogonal to the axis
+        const bool use1 = s11 > s00;
+        const float best1 = use1 ? s11 : s00;
+        const bool use2 = s22 > best1;
+        const float best2 = use2 ? s22 : best1;
+        const bool use3 = s33 > best2;
+        float v0 = use3 ? s03 : (use2 ? s02 : (use1 ? s01 : s00));
+        float v1 = use3 ? s13 : (use2 ? s12 : (use1 ? s11 : s01));
+        float v2 = use3 ? s23 : (use2 ? s22 : (use1 ? s12 : s02));
+        float v3 = use3 ? s33 : (use2 ? s23 : (use1 ? s13 : s03));
+
+        // multiply the axis by the matrix. Written out instead of looped so the partition loop has no inner loops to vectorize around
+        float n0, n1, n2, n3;
+        auto multiply = [&]() {
+            n0 = s00 * v0 + s01 * v1 + s02 * v2 + s03 * v3;
+            n1 = s01 * v0 + s11 * v1 + s12 * v2 + s13 * v3;
+            n2 = s02 * v0 + s12 * v1 + s22 * v2 + s23 * v3;
+            n3 = s03 * v0 + s13 * v1 + s23 * v2 + s33 * v3;
+        };
+        auto step = [&]() {
+            multiply();
+            v0 = n0, v1 = n1, v2 = n2, v3 = n3;
+        };
+        step();
+        step();
+        step();
+
+        // the Rayleigh quotient of the axis is the fraction of the variance along it
+        multiply();
+        const float length = v0 * v0 + v1 * v1 + v2 * v2 + v3 * v3 + 1e-30f;
+        const float fraction = (v0 * n0 + v1 * n1 + v2 * n2 + v3 * n3) / length;
+
+        estimates[p] += trace * std::fabs(1.0f - fraction);  // the fraction is at most 1 except for rounding
+    }
+}
+
+// EstimatePartitions is called from other files, so the kernel is kept separate to be compiled for each instruction set
+QUICKTEX_TARGET_CLONES void Estimate(const Planes &pixels, unsigned subsets, unsigned channels, std::array<float, 64> &estimates) {
+    const auto &membership = GetMembershipTable(subsets);
+    const unsigned pairs = channels == 4 ? 10 : 6;
+
+    std::array<Plane, 10> products = {};
+    for (unsigned j = 0; j < pairs; j++) {
+        for (unsigned i = 0; i < 16; i++) products[j][i] = pixels[scatter_pairs[j][0]][i] * pixels[scatter_pairs[j][1]][i];
+    }
+
+    // moments of subset 0 are whatever the other subsets leave of the block's
+    Moments first;
+    first.count.fill(16);
+    for (unsigned c = 0; c < channels; c++) first.sums[c].fill(std::accumulate(pixels[c].begin(), pixels[c].end(), 0));
+    for (unsigned j = 0; j < pairs; j++) first.products[j].fill(std::accumulate(products[j].begin(), products[j].end(), 0));
+
+    estimates.fill(0);
+    for (unsigned s = 1; s < subsets; s++) {
+        Moments moments;
+        for (unsigned i = 0; i < 16; i++) {
+            const Lanes &member = membership[s][i];
+            for (unsigned p = 0; p < 64; p++) moments.count[p] -= member[p];
+            for (unsigned c = 0; c < channels; c++) {
+                for (unsigned p = 0; p < 64; p++) moments.sums[c][p] += member[p] & pixels[c][i];
+            }
+            for (unsigned j = 0; j < pairs; j++) {
+                for (unsigned p = 0; p < 64; p++) moments.products[j][p] += member[p] & products[j][i];
+            }
+        }
+
+        for (unsigned p = 0; p < 64; p++) first.count[p] -= moments.count[p];
+        for (unsigned c = 0; c < channels; c++) {
+            for (unsigned p = 0; p < 64; p++) first.sums[c][p] -= moments.sums[c][p];
+        }
+        for (unsigned j = 0; j < pairs; j++) {
+            for (unsigned p = 0; p < 64; p++) first.products[j][p] -= moments.products[j][p];
+        }
+
+        AddResiduals(moments, estimates);
+    }
+    AddResiduals(first, estimates);
+}
+}  // namespace
+
+void EstimatePartitions(const Planes &pixels, unsigned subsets, unsigned channels, std::array<float, 64> &estimates) {
+    Estimate(pixels, subsets, channels, estimates);
+}
+
+unsigned BestPartitions(const std::array<float, 64> &estimates, unsigned available, unsigned count, std::array<uint8_t, 64> &best) {
+    std::iota(best.begin(), best.begin() + available, 0);
+    count = std::min(count, available);
+    std::partial_sort(best.begin(), best.begin() + count, best.begin() + available, [&](uint8_t a, uint8_t b) {
+        return estimates[a] < estimates[b] || (estimates[a] == estimates[b] && a < b);
+    });
+    return count;
+}
+
+}  // namespace quicktex::bptc
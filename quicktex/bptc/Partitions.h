@@ -0,0 +1,69 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace quicktex::bptc {
+
+// Partition handling shared by the BPTC formats, BC6H and BC7
+
+using PixelMap = std::array<uint8_t, 16>;
+
+/// Source pixel of each destination pixel when flipping a block vertically. The map is its own inverse
+inline constexpr PixelMap flip_map = {12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3};
+
+/// Source pixel of each destination pixel when mirroring a block horizontally. The map is its own inverse
+inline constexpr PixelMap mirror_map = {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+
+/// A partition with the same shape as another one after flipping or mirroring, up to the order of its subsets
+struct Remap {
+    int partition = -1;                         // the equivalent partition, or -1 if there is none
+    std::array<uint8_t, 3> subsets = {0, 1, 2};  // the original subset of each subset in the new partition
+};
+
+using RemapTable = std::array<std::array<Remap, 64>, 2>;  // indexed by [subsets - 2][partition]
+
+/// Equivalent partitions after flipping vertically. Each partition maps to the lowest matching one
+const RemapTable &FlipTable();
+
+/// Equivalent partitions after mirroring horizontally. Each partition maps to the lowest matching one
+const RemapTable &MirrorTable();
+
+/// The equivalent of a partition in a remap table, or nullptr if it has none among the first `available` partitions
+const Remap *FindRemap(const RemapTable &table, unsigned subsets, unsigned partition, unsigned available);
+
+using Plane = std::array<int, 16>;
+using Planes = std::array<Plane, 4>;  // a block's pixels with one plane per channel, so loops over them vectorize
+
+/**
+ * Estimate the error of every partition from the scatter of each of its subsets around a line, without quantizing anything.
+ * Products of values are summed as ints, so values must be below 2^13
+ * @param pixels The block's pixels in planar order
+ * @param subsets The number of subsets, 2 or 3
+ * @param channels The number of channels to include, 3 or 4
+ * @param estimates The estimated error of each partition
+ */
+void EstimatePartitions(const Planes &pixels, unsigned subsets, unsigned channels, std::array<float, 64> &estimates);
+
+/// The partitions with the lowest estimates among the first `available` ones, from best to worst. Returns how many were written to best
+unsigned BestPartitions(const std::array<float, 64> &estimates, unsigned available, unsigned count, std::array<uint8_t, 64> &best);
+
+}  // namespace quicktex::bptc
@@ -0,0 +1,5 @@
+"""
+The bptc module provides encoders and decoders for the BPTC formats, BC6H and BC7, which store 4x4 blocks in 16 bytes
+using one of several modes chosen per block.
+"""
+from _quicktex._bptc import *
@@ -0,0 +1,277 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "BC6HBlock.h"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "../BitStream.h"
+#include "../Partitions.h"
+#include "../Tables.h"
+
+namespace quicktex::bptc {
+
+namespace {
+// Fields of a mode's header, after its mode bits. Endpoint fields are named like the D3D documentation, with W and X
+// the first subset's endpoints, and Y and Z the second subset's
+enum Field : uint8_t { D, RW, GW, BW, RX, GX, BX, RY, GY, BY, RZ, GZ, BZ };
+
+// A run of consecutive bits of a field, stored in the block from its least significant bit up, or from its most significant bit down if reversed
+struct Run {
+    Field field;
+    uint8_t low;
+    uint8_t count;
+    bool reversed = false;
+};
+
+constexpr unsigned MaxRuns = 24;
+using Layout = std::array<Run, MaxRuns>;  // unused runs at the end have a count of 0
+
+// clang-format off
+constexpr std::array<Layout, BC6HBlock::ModeCount> layouts = {{
+    {{{GY, 4, 1}, {BY, 4, 1}, {BZ, 4, 1}, {RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 5}, {GZ, 4, 1}, {GY, 0, 4}, {GX, 0, 5}, {BZ, 0, 1},
+      {GZ, 0, 4}, {BX, 0, 5}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 5}, {BZ, 2, 1}, {RZ, 0, 5}, {BZ, 3, 1}, {D, 0, 5}}},
+    {{{GY, 5, 1}, {GZ, 4, 1}, {GZ, 5, 1}, {RW, 0, 7}, {BZ, 0, 1}, {BZ, 1, 1}, {BY, 4, 1}, {GW, 0, 7}, {BY, 5, 1}, {BZ, 2, 1}, {GY, 4, 1},
+      {BW, 0, 7}, {BZ, 3, 1}, {BZ, 5, 1}, {BZ, 4, 1}, {RX, 0, 6}, {GY, 0, 4}, {GX, 0, 6}, {GZ, 0, 4}, {BX, 0, 6}, {BY, 0, 4}, {RY, 0, 6},
+      {RZ, 0, 6}, {D, 0, 5}}},
+    {{{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 5}, {RW, 10, 1}, {GY, 0, 4}, {GX, 0, 4}, {GW, 10, 1}, {BZ, 0, 1}, {GZ, 0, 4},
+      {BX, 0, 4}, {BW, 10, 1}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 5}, {BZ, 2, 1}, {RZ, 0, 5}, {BZ, 3, 1}, {D, 0, 5}}},
+    {{{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 4}, {RW, 10, 1}, {GZ, 4, 1}, {GY, 0, 4}, {GX, 0, 5}, {GW, 10, 1}, {GZ, 0, 4},
+      {BX, 0, 4}, {BW, 10, 1}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 4}, {BZ, 0, 1}, {BZ, 2, 1}, {RZ, 0, 4}, {GY, 4, 1}, {BZ, 3, 1}, {D, 0, 5}}},
+    {{{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 4}, {RW, 10, 1}, {BY, 4, 1}, {GY, 0, 4}, {GX, 0, 4}, {GW, 10, 1}, {BZ, 0, 1},
+      {GZ, 0, 4}, {BX, 0, 5}, {BW, 10, 1}, {BY, 0, 4}, {RY, 0, 4}, {BZ, 1, 1}, {BZ, 2, 1}, {RZ, 0, 4}, {BZ, 4, 1}, {BZ, 3, 1}, {D, 0, 5}}},
+    {{{RW, 0, 9}, {BY, 4, 1}, {GW, 0, 9}, {GY, 4, 1}, {BW, 0, 9}, {BZ, 4, 1}, {RX, 0, 5}, {GZ, 4, 1}, {GY, 0, 4}, {GX, 0, 5}, {BZ, 0, 1},
+      {GZ, 0, 4}, {BX, 0, 5}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 5}, {BZ, 2, 1}, {RZ, 0, 5}, {BZ, 3, 1}, {D, 0, 5}}},
+    {{{RW, 0, 8}, {GZ, 4, 1}, {BY, 4, 1}, {GW, 0, 8}, {BZ, 2, 1}, {GY, 4, 1}, {BW, 0, 8}, {BZ, 3, 1}, {BZ, 4, 1}, {RX, 0, 6}, {GY, 0, 4},
+      {GX, 0, 5}, {BZ, 0, 1}, {GZ, 0, 4}, {BX, 0, 5}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 6}, {RZ, 0, 6}, {D, 0, 5}}},
+    {{{RW, 0, 8}, {BZ, 0, 1}, {BY, 4, 1}, {GW, 0, 8}, {GY, 5, 1}, {GY, 4, 1}, {BW, 0, 8}, {GZ, 5, 1}, {BZ, 4, 1}, {RX, 0, 5}, {GZ, 4, 1},
+      {GY, 0, 4}, {GX, 0, 6}, {GZ, 0, 4}, {BX, 0, 5}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 5}, {BZ, 2, 1}, {RZ, 0, 5}, {BZ, 3, 1}, {D, 0, 5}}},
+    {{{RW, 0, 8}, {BZ, 1, 1}, {BY, 4, 1}, {GW, 0, 8}, {BY, 5, 1}, {GY, 4, 1}, {BW, 0, 8}, {BZ, 5, 1}, {BZ, 4, 1}, {RX, 0, 5}, {GZ, 4, 1},
+      {GY, 0, 4}, {GX, 0, 5}, {BZ, 0, 1}, {GZ, 0, 4}, {BX, 0, 6}, {BY, 0, 4}, {RY, 0, 5}, {BZ, 2, 1}, {RZ, 0, 5}, {BZ, 3, 1}, {D, 0, 5}}},
+    {{{RW, 0, 6}, {GZ, 4, 1}, {BZ, 0, 1}, {BZ, 1, 1}, {BY, 4, 1}, {GW, 0, 6}, {GY, 5, 1}, {BY, 5, 1}, {BZ, 2, 1}, {GY, 4, 1}, {BW, 0, 6},
+      {GZ, 5, 1}, {BZ, 3, 1}, {BZ, 5, 1}, {BZ, 4, 1}, {RX, 0, 6}, {GY, 0, 4}, {GX, 0, 6}, {GZ, 0, 4}, {BX, 0, 6}, {BY, 0, 4}, {RY, 0, 6},
+      {RZ, 0, 6}, {D, 0, 5}}},
+    {{{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 10}, {GX, 0, 10}, {BX, 0, 10}}},
+    {{{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 9}, {RW, 10, 1}, {GX, 0, 9}, {GW, 10, 1}, {BX, 0, 9}, {BW, 10, 1}}},
+    {{{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 8}, {RW, 10, 2, true}, {GX, 0, 8}, {GW, 10, 2, true}, {BX, 0, 8}, {BW, 10, 2, true}}},
+    {{{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 4}, {RW, 10, 6, true}, {GX, 0, 4}, {GW, 10, 6, true}, {BX, 0, 4}, {BW, 10, 6, true}}},
+}};
+// clang-format on
+
+// The header fields of a block as stored, which are the partition and 12 endpoint channels
+using Fields = std::array<unsigned, 13>;
+
+int &Channel(BC6HBlock::Unpacked &unpacked, unsigned field) {
+    const unsigned endpoint = (field - 1) / 3;  // W, X, Y, Z
+    return unpacked.endpoints[endpoint / 2][endpoint % 2][(field - 1) % 3];
+}
+
+constexpr int Mask(unsigned bits) { return static_cast<int>((1U << bits) - 1); }
+
+constexpr int SignExtend(int value, unsigned bits) {
+    const int sign = 1 << (bits - 1);
+    return ((value & Mask(bits)) ^ sign) - sign;
+}
+
+// The precision of a field as stored. Field 0 is the partition
+unsigned FieldBits(const BC6HBlock::ModeInfo &info, unsigned field) {
+    if (field == D) return info.subsets == 2 ? 5 : 0;
+    if (field <= BW) return info.endpoint_bits;
+    return info.delta_bits[(field - 1) % 3];
+}
+
+// Swap the endpoints of every subset whose anchor index has its top bit set, and invert its indices.
+// Weights are symmetric, so this decodes to exactly the same colors
+void NormalizeAnchors(BC6HBlock::Unpacked &unpacked) {
+    const auto &info = BC6HBlock::Modes[static_cast<unsigned>(unpacked.mode)];
+    const unsigned max = (1U << info.index_bits) - 1;
+    const unsigned high = 1U << (info.index_bits - 1);
+
+    for (unsigned s = 0; s < info.subsets; s++) {
+        if ((unpacked.indices[Anchor(info.subsets, unpacked.partition, s)] & high) == 0) continue;
+
+        for (unsigned i = 0; i < 16; i++) {
+            if (Subset(info.subsets, unpacked.partition, i) == s) unpacked.indices[i] = static_cast<uint8_t>(max - unpacked.indices[i]);
+        }
+        std::swap(unpacked.endpoints[s][0], unpacked.endpoints[s][1]);
+    }
+}
+
+// The header fields of normalized fields, or false if they don't fit. Deltas are compared modulo the endpoint precision,
+// so this works for both signed and unsigned endpoints
+bool Store(BC6HBlock::Unpacked &unpacked, Fields &fields) {
+    const auto &info = BC6HBlock::Modes[static_cast<unsigned>(unpacked.mode)];
+    const int low = -(1 << (info.endpoint_bits - 1));
+    const int high = Mask(info.endpoint_bits);
+
+    fields = {};
+    fields[D] = unpacked.partition;
+    for (unsigned field = RW; field < RW + 6 * info.subsets; field++) {
+        const int value = Channel(unpacked, field);
+        if (value < low || value > high) return false;
+
+        if (field <= BW || !info.transformed) {
+            fields[field] = static_cast<unsigned>(value & Mask(info.endpoint_bits));
+            continue;
+        }
+
+        const unsigned bits = FieldBits(info, field);
+        const int delta = SignExtend(value - Channel(unpacked, (field - 1) % 3 + RW), info.endpoint_bits);
+        if (delta < -(1 << (bits - 1)) || delta >= (1 << (bits - 1))) return false;
+        fields[field] = static_cast<unsigned>(delta & Mask(bits));
+    }
+    return true;
+}
+
+// Pack fields that fit into a bitstream
+BlockBytes Write(const BC6HBlock::Unpacked &unpacked, const Fields &fields) {
+    const auto &info = BC6HBlock::Modes[static_cast<unsigned>(unpacked.mode)];
+    BitWriter writer;
+    writer.Write(info.code, info.code < 2 ? 2 : 5);
+
+    for (const Run &run : layouts[static_cast<unsigned>(unpacked.mode)]) {
+        for (unsigned b = 0; b < run.count; b++) {
+            const unsigned bit = run.reversed ? run.low + run.count - 1 - b : run.low + b;
+            writer.Write(fields[run.field] >> bit, 1);
+        }
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        const bool anchor = (Anchor(info.subsets, unpacked.partition, Subset(info.subsets, unpacked.partition, i)) == i);
+        writer.Write(unpacked.indices[i], info.index_bits - anchor);
+    }
+
+    return writer.Bytes();
+}
+
+// Flip or mirror a block into bytes, or return false if it can't be
+bool Transform(const BC6HBlock &block, const PixelMap &map, const RemapTable &table, BlockBytes &bytes) {
+    const auto unpacked = block.Unpack();
+    if (unpacked.mode < 0) return true;  // reserved modes decode to black regardless, so they are left unchanged
+
+    auto moved = unpacked;
+    for (unsigned i = 0; i < 16; i++) moved.indices[i] = unpacked.indices[map[i]];
+
+    if (BC6HBlock::Modes[static_cast<unsigned>(unpacked.mode)].subsets > 1) {
+        const auto *remap = FindRemap(table, 2, unpacked.partition, BC6HBlock::PartitionCount);
+        if (!remap) return false;
+
+        moved.partition = static_cast<unsigned>(remap->partition);
+        for (unsigned s = 0; s < BC6HBlock::MaxSubsets; s++) moved.endpoints[s] = unpacked.endpoints[remap->subsets[s]];
+    }
+
+    // the first endpoint may change, so deltas need to be checked again
+    NormalizeAnchors(moved);
+    Fields fields;
+    if (!Store(moved, fields)) return false;
+
+    bytes = Write(moved, fields);
+    return true;
+}
+}  // namespace
+
+int BC6HBlock::GetMode() const {
+    const unsigned code = _bytes[0] & 0x03U;
+    if (code < 2) return static_cast<int>(code);
+
+    const unsigned code5 = _bytes[0] & 0x1FU;
+    for (unsigned mode = 2; mode < ModeCount; mode++) {
+        if (Modes[mode].code == code5) return static_cast<int>(mode);
+    }
+    return -1;
+}
+
+BC6HBlock::Unpacked BC6HBlock::Unpack(bool is_signed) const {
+    Unpacked unpacked;
+    unpacked.mode = GetMode();
+    if (unpacked.mode < 0) return unpacked;
+
+    const auto &info = Modes[static_cast<unsigned>(unpacked.mode)];
+    BitReader reader(_bytes);
+    reader.Read(info.code < 2 ? 2 : 5);
+
+    Fields fields = {};
+    for (const Run &run : layouts[static_cast<unsigned>(unpacked.mode)]) {
+        for (unsigned b = 0; b < run.count; b++) {
+            const unsigned bit = run.reversed ? run.low + run.count - 1 - b : run.low + b;
+            fields[run.field] |= reader.Read(1) << bit;
+        }
+    }
+
+    unpacked.partition = fields[D];
+    for (unsigned field = RW; field < RW + 6 * info.subsets; field++) {
+        int value = static_cast<int>(fields[field]);
+        if (field > BW && info.transformed) {
+            const int base = static_cast<int>(fields[(field - 1) % 3 + RW]);
+            value = (base + SignExtend(value, FieldBits(info, field))) & Mask(info.endpoint_bits);
+        }
+        Channel(unpacked, field) = is_signed ? SignExtend(value, info.endpoint_bits) : value;
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        const bool anchor = (Anchor(info.subsets, unpacked.partition, Subset(info.subsets, unpacked.partition, i)) == i);
+        unpacked.indices[i] = static_cast<uint8_t>(reader.Read(info.index_bits - anchor));
+    }
+
+    return unpacked;
+}
+
+void BC6HBlock::Pack(Unpacked unpacked) {
+    if (unpacked.mode < 0 || unpacked.mode >= static_cast<int>(ModeCount)) throw std::invalid_argument("Invalid BC6H mode");
+    const auto &info = Modes[static_cast<unsigned>(unpacked.mode)];
+    if (unpacked.partition >= (info.subsets == 2 ? PartitionCount : 1)) throw std::invalid_argument("Partition out of range for BC6H mode");
+
+    NormalizeAnchors(unpacked);
+    Fields fields;
+    if (!Store(unpacked, fields)) throw std::invalid_argument("BC6H endpoints are out of range or too far apart for their mode");
+
+    _bytes = Write(unpacked, fields);
+}
+
+bool BC6HBlock::Fits(const Unpacked &unpacked) {
+    if (unpacked.mode < 0 || unpacked.mode >= static_cast<int>(ModeCount)) return false;
+    if (unpacked.partition >= (Modes[static_cast<unsigned>(unpacked.mode)].subsets == 2 ? PartitionCount : 1)) return false;
+
+    auto normalized = unpacked;
+    NormalizeAnchors(normalized);
+    Fields fields;
+    return Store(normalized, fields);
+}
+
+bool BC6HBlock::CanFlip() const {
+    BlockBytes bytes;
+    return Transform(*this, flip_map, FlipTable(), bytes);
+}
+
+bool BC6HBlock::CanMirror() const {
+    BlockBytes bytes;
+    return Transform(*this, mirror_map, MirrorTable(), bytes);
+}
+
+void BC6HBlock::Flip() {
+    if (!Transform(*this, flip_map, FlipTable(), _bytes)) throw std::invalid_argument("BC6H block has no vertically flipped equivalent");
+}
+
+void BC6HBlock::Mirror() {
+    if (!Transform(*this, mirror_map, MirrorTable(), _bytes)) throw std::invalid_argument("BC6H block has no horizontally mirrored equivalent");
+}
+
+}  // namespace quicktex::bptc
@@ -0,0 +1,163 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../BitStream.h"
+
+namespace quicktex::bptc {
+
+// Only 4-byte aligned, because BC6H data in a DDS file follows the 148-byte header and DX10 extension,
+// and textures can view memory-mapped files directly
+class alignas(4) BC6HBlock {
+   public:
+    static constexpr size_t Width = 4;
+    static constexpr size_t Height = 4;
+
+    static constexpr unsigned ModeCount = 14;
+    static constexpr unsigned MaxSubsets = 2;
+
+    /// Layout of one of the 14 BC6H modes. Modes are numbered from 0, so mode 0 here is mode 1 in the D3D documentation
+    struct ModeInfo {
+        unsigned code;                       // the mode's bits at the start of the block, 2 bits long if below 2 or 5 bits otherwise
+        unsigned subsets;                    // number of subsets, each with its own pair of endpoints
+        bool transformed;                    // true if every endpoint after the first is stored as a signed delta from the first
+        unsigned endpoint_bits;              // bits per channel of the first endpoint, and of every endpoint after undoing deltas
+        std::array<unsigned, 3> delta_bits;  // bits per red, green and blue channel of every endpoint after the first
+        unsigned index_bits;                 // bits per index
+    };
+
+    static constexpr std::array<ModeInfo, ModeCount> Modes = {{
+        {0x00, 2, true, 10, {5, 5, 5}, 3},
+        {0x01, 2, true, 7, {6, 6, 6}, 3},
+        {0x02, 2, true, 11, {5, 4, 4}, 3},
+        {0x06, 2, true, 11, {4, 5, 4}, 3},
+        {0x0A, 2, true, 11, {4, 4, 5}, 3},
+        {0x0E, 2, true, 9, {5, 5, 5}, 3},
+        {0x12, 2, true, 8, {6, 5, 5}, 3},
+        {0x16, 2, true, 8, {5, 6, 5}, 3},
+        {0x1A, 2, true, 8, {5, 5, 6}, 3},
+        {0x1E, 2, false, 6, {6, 6, 6}, 3},
+        {0x03, 1, false, 10, {10, 10, 10}, 4},
+        {0x07, 1, true, 11, {9, 9, 9}, 4},
+        {0x0B, 1, true, 12, {8, 8, 8}, 4},
+        {0x0F, 1, true, 16, {4, 4, 4}, 4},
+    }};
+
+    /// Number of partitions available to modes with two subsets, which are the first 32 BC7 2-subset partitions
+    static constexpr unsigned PartitionCount = 32;
+
+    using Endpoint = std::array<int, 3>;
+    using EndpointArray = std::array<std::array<Endpoint, 2>, MaxSubsets>;
+    using IndexArray = std::array<uint8_t, Width * Height>;
+
+    /// The fields of a block, unpacked from its bitstream
+    struct Unpacked {
+        int mode = -1;                 // the block's mode, or -1 for a reserved mode, which decodes to black
+        unsigned partition = 0;        // the partition mapping pixels to subsets, if the mode has two subsets
+        EndpointArray endpoints = {};  // each subset's endpoints at the mode's endpoint precision, with deltas undone. Negative if signed
+        IndexArray indices = {};       // index of each pixel in row-major order
+    };
+
+    /// Create a new BC6HBlock. All of its bits are zero, which is mode 0 with black endpoints
+    constexpr BC6HBlock() : _bytes() {
+        static_assert(sizeof(BC6HBlock) == 16);
+        static_assert(sizeof(std::array<BC6HBlock, 10>) == 16 * 10);
+        static_assert(alignof(BC6HBlock) >= 4);
+    }
+
+    /// Create a new BC6HBlock by packing its fields
+    explicit BC6HBlock(const Unpacked& unpacked) { Pack(unpacked); }
+
+    /**
+     * Expand a quantized endpoint channel to 16 bits, before interpolation
+     * @param value The channel's value, which is negative for a negative signed channel
+     * @param bits The mode's endpoint precision
+     * @param is_signed True for BC6H_SF16, false for BC6H_UF16
+     */
+    static constexpr int Unquantize(int value, unsigned bits, bool is_signed) {
+        if (!is_signed) {
+            if (bits >= 15 || value == 0) return value;
+            if (value == (1 << bits) - 1) return 0xFFFF;
+            return ((value << 16) + 0x8000) >> bits;
+        }
+
+        if (bits >= 16 || value == 0) return value;
+        const bool negative = value < 0;
+        const int magnitude = negative ? -value : value;
+        const int expanded = magnitude >= (1 << (bits - 1)) - 1 ? 0x7FFF : ((magnitude << 15) + 0x4000) >> (bits - 1);
+        return negative ? -expanded : expanded;
+    }
+
+    /// Scale an interpolated value to the bits of a half-precision float, which never produces infinity or NaN
+    static constexpr uint16_t Finish(int value, bool is_signed) {
+        if (!is_signed) return static_cast<uint16_t>((value * 31) >> 6);
+        if (value < 0) return static_cast<uint16_t>(0x8000 | ((-value * 31) >> 5));
+        return static_cast<uint16_t>((value * 31) >> 5);
+    }
+
+    /**
+     * Unpack the block's fields from its bitstream
+     * @param is_signed True to sign-extend the endpoints of a BC6H_SF16 block
+     */
+    Unpacked Unpack(bool is_signed = false) const;
+
+    /**
+     * Pack fields into the block's bitstream.
+     * The index of each subset's anchor pixel is stored with one less bit, so subsets whose anchor index has its top bit set
+     * are first normalized by swapping their endpoints and inverting their indices, which decodes to the same colors.
+     * Packing works for either signedness, because endpoints are only compared modulo their precision
+     * @throws std::invalid_argument if an endpoint is out of range, or a delta doesn't fit in the mode after normalizing. See Fits()
+     */
+    void Pack(Unpacked unpacked);
+
+    /// True if the fields can be packed, so every endpoint is in range and every delta fits after normalizing anchors
+    static bool Fits(const Unpacked& unpacked);
+
+    /// The block's mode, or -1 for a reserved mode
+    int GetMode() const;
+
+    /// True if the block can be flipped losslessly. Some partitions have no vertically flipped equivalent, and some deltas no longer fit after flipping
+    bool CanFlip() const;
+
+    /// True if the block can be mirrored losslessly. Some partitions have no horizontally mirrored equivalent, and some deltas no longer fit after mirroring
+    bool CanMirror() const;
+
+    /**
+     * Flip the block vertically by reordering its indices and remapping its partition
+     * @throws std::invalid_argument if the block can't be flipped. See CanFlip()
+     */
+    void Flip();
+
+    /**
+     * Mirror the block horizontally by reordering its indices and remapping its partition
+     * @throws std::invalid_argument if the block can't be mirrored. See CanMirror()
+     */
+    void Mirror();
+
+    bool operator==(const BC6HBlock& Rhs) const { return _bytes == Rhs._bytes; }
+    bool operator!=(const BC6HBlock& Rhs) const { return !(Rhs == *this); }
+
+   private:
+    BlockBytes _bytes;
+};
+}  // namespace quicktex::bptc
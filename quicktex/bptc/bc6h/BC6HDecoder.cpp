@@ -0,0 +1,87 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "BC6HDecoder.h"
+
+#include <array>
+#include <cstdint>
+
+#include "../../ColorBlock.h"
+#include "../../HalfColor.h"
+#include "../../util.h"
+#include "../Tables.h"
+#include "BC6HBlock.h"
+
+namespace quicktex::bptc {
+
+namespace {
+using Lanes = std::array<int, 16>;
+
+// Interpolate every channel of every pixel and convert them to halves.
+// Loops have a fixed trip count and no branches, so they vectorize
+QUICKTEX_TARGET_CLONES void InterpolatePlanes(const std::array<Lanes, 3> &low, const std::array<Lanes, 3> &high, const Lanes &weights, bool is_signed,
+                                              std::array<std::array<uint16_t, 16>, 3> &output) {
+    for (unsigned c = 0; c < 3; c++) {
+        for (unsigned i = 0; i < 16; i++) {
+            const int value = ((64 - weights[i]) * low[c][i] + weights[i] * high[c][i] + 32) >> 6;
+            const bool negative = is_signed && value < 0;
+            const int magnitude = negative ? -value : value;
+            const int scaled = is_signed ? (magnitude * 31) >> 5 : (magnitude * 31) >> 6;
+            output[c][i] = static_cast<uint16_t>(scaled | (negative ? 0x8000 : 0));
+        }
+    }
+}
+}  // namespace
+
+ColorBlock<4, 4, HalfColor> BC6HDecoder::DecodeBlock(const BC6HBlock &block) const {
+    auto output = ColorBlock<4, 4, HalfColor>();
+    const auto unpacked = block.Unpack(_is_signed);
+
+    std::array<HalfColor, 16> colors;  // reserved modes decode to black
+    if (unpacked.mode >= 0) {
+        const auto &info = BC6HBlock::Modes[static_cast<unsigned>(unpacked.mode)];
+
+        std::array<std::array<BC6HBlock::Endpoint, 2>, BC6HBlock::MaxSubsets> expanded = {};
+        for (unsigned s = 0; s < info.subsets; s++) {
+            for (unsigned e = 0; e < 2; e++) {
+                for (unsigned c = 0; c < 3; c++) expanded[s][e][c] = BC6HBlock::Unquantize(unpacked.endpoints[s][e][c], info.endpoint_bits, _is_signed);
+            }
+        }
+
+        // gather each pixel's endpoints and weight into planes
+        std::array<Lanes, 3> low, high;
+        Lanes weights;
+        const uint8_t *table = Weights(info.index_bits);
+        for (unsigned i = 0; i < 16; i++) {
+            const auto &pair = expanded[Subset(info.subsets, unpacked.partition, i)];
+            for (unsigned c = 0; c < 3; c++) {
+                low[c][i] = pair[0][c];
+                high[c][i] = pair[1][c];
+            }
+            weights[i] = table[unpacked.indices[i]];
+        }
+
+        std::array<std::array<uint16_t, 16>, 3> channels;
+        InterpolatePlanes(low, high, weights, _is_signed, channels);
+        for (unsigned i = 0; i < 16; i++) colors[i] = HalfColor(channels[0][i], channels[1][i], channels[2][i]);
+    }
+
+    for (int y = 0; y < 4; y++) output.SetRow(y, &colors[static_cast<size_t>(y * 4)]);
+    return output;
+}
+}  // namespace quicktex::bptc
@@ -0,0 +1,41 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include "../../ColorBlock.h"
+#include "../../Decoder.h"
+#include "../../HalfColor.h"
+#include "../../Texture.h"
+#include "BC6HBlock.h"
+
+namespace quicktex::bptc {
+
+class BC6HDecoder final : public BlockDecoder<BlockTexture<BC6HBlock>, HalfTexture> {
+   public:
+    /// @param is_signed True to decode BC6H_SF16 blocks, which can store negative values, or false for BC6H_UF16
+    explicit BC6HDecoder(bool is_signed = false) : _is_signed(is_signed) {}
+
+    bool IsSigned() const { return _is_signed; }
+
+    ColorBlock<4, 4, HalfColor> DecodeBlock(const BC6HBlock &block) const override;
+
+   private:
+    bool _is_signed;
+};
+}  // namespace quicktex::bptc
@@ -0,0 +1,495 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "BC6HEncoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "../../ColorBlock.h"
+#include "../../HalfColor.h"
+#include "../../util.h"
+#include "../Partitions.h"
+#include "../Tables.h"
+#include "BC6HBlock.h"
+
+namespace quicktex::bptc {
+
+// Values are compared as the integer bits of their half-precision floats, negated for negative values. This is close to a
+// logarithmic scale, so errors in dark and bright areas are weighted about equally, which suits HDR content better than linear error
+
+namespace {
+using FloatPlane = std::array<float, 16>;
+using FloatPlanes = std::array<FloatPlane, 3>;
+using Line = std::array<std::array<float, 3>, 2>;  // a subset's endpoints before quantization
+using Unpacked = BC6HBlock::Unpacked;
+using IndexArray = BC6HBlock::IndexArray;
+using ModeInfo = BC6HBlock::ModeInfo;
+
+// The pixels of one subset in planar order, so that loops over them vectorize. Unused pixels are 0
+struct SubsetValues {
+    FloatPlanes values = {};
+    unsigned count = 0;
+    std::array<uint8_t, 16> pixels = {};  // position in the block of each value
+};
+
+using Subsets = std::array<SubsetValues, BC6HBlock::MaxSubsets>;
+
+struct Candidate {
+    Unpacked unpacked;
+    float error = std::numeric_limits<float>::infinity();
+};
+
+struct Settings {
+    bool is_signed;
+    unsigned refine_passes;
+    bool mode_search;
+};
+
+using Lines = std::array<Line, BC6HBlock::MaxSubsets>;
+
+// Modes of each subset count from the most precise endpoints to the least. The last one of each stores endpoints without deltas, so it always fits
+constexpr std::array<unsigned, 4> one_subset_modes = {13, 12, 11, 10};
+constexpr std::array<unsigned, 10> two_subset_modes = {2, 3, 4, 0, 5, 6, 7, 8, 1, 9};
+
+// region conversion
+
+// The value of a half that can be stored. Unsigned blocks can't store negative values, and neither can store infinity or NaN
+int ToValue(uint16_t half, bool is_signed) {
+    const int magnitude = half & 0x7FFF;
+    if (magnitude > 0x7C00) return 0;  // NaN
+    const int clamped = std::min(magnitude, static_cast<int>(HalfColor::MaxFinite));
+    if (half & 0x8000) return is_signed ? -clamped : 0;
+    return clamped;
+}
+
+// The value decoded from an interpolated endpoint channel
+int Finish(int interpolated, bool is_signed) {
+    const uint16_t half = BC6HBlock::Finish(interpolated, is_signed);
+    return (half & 0x8000) ? -(half & 0x7FFF) : half;
+}
+
+// The quantized endpoint channel that decodes closest to a value
+int QuantizeChannel(float value, unsigned bits, bool is_signed) {
+    int low, high, guess;
+    if (is_signed) {
+        // a 16-bit channel of -32768 would decode to negative infinity
+        high = (1 << (bits - 1)) - 1;
+        low = bits >= 16 ? -high : -high - 1;
+        const float magnitude = std::fabs(value) * 32.0f / 31.0f;
+        const float scaled = bits >= 16 ? magnitude : magnitude * static_cast<float>(1 << (bits - 1)) / 32768.0f - 0.5f;
+        guess = static_cast<int>(std::lround(scaled));
+        if (value < 0) guess = -guess;
+    } else {
+        low = 0;
+        high = (1 << bits) - 1;
+        const float expanded = std::max(value, 0.0f) * 64.0f / 31.0f;
+        guess = static_cast<int>(std::lround(bits >= 15 ? expanded : expanded * static_cast<float>(1 << bits) / 65536.0f - 0.5f));
+    }
+
+    // decoding is monotonic but not linear, so check the neighbors of the estimate
+    int best = clampi(guess, low, high);
+    float best_error = std::fabs(static_cast<float>(Finish(BC6HBlock::Unquantize(best, bits, is_signed), is_signed)) - value);
+    for (int q : {guess - 1, guess + 1}) {
+        if (q < low || q > high) continue;
+        const float error = std::fabs(static_cast<float>(Finish(BC6HBlock::Unquantize(q, bits, is_signed), is_signed)) - value);
+        if (error < best_error) {
+            best = q;
+            best_error = error;
+        }
+    }
+    return best;
+}
+// endregion
+
+// region kernels
+
+// Choose the closest palette entry for every value in a subset, returning the total squared error.
+// Loops run over all 16 lanes, including unused ones, so they have a fixed trip count and vectorize
+float SelectIndices(const SubsetValues &subset, const FloatPlanes &palette, unsigned entries, IndexArray &indices) {
+    // indices are tracked as floats, since lanes of different types or widths keep the loop from vectorizing
+    FloatPlane best, chosen = {};
+    best.fill(std::numeric_limits<float>::max());
+
+    for (unsigned k = 0; k < entries; k++) {
+        const float p0 = palette[0][k], p1 = palette[1][k], p2 = palette[2][k];
+        const float index = static_cast<float>(k);
+        for (unsigned i = 0; i < 16; i++) {
+            const float d0 = subset.values[0][i] - p0;
+            const float d1 = subset.values[1][i] - p1;
+            const float d2 = subset.values[2][i] - p2;
+            const float error = d0 * d0 + d1 * d1 + d2 * d2;
+            chosen[i] = error < best[i] ? index : chosen[i];
+            best[i] = std::min(best[i], error);
+        }
+    }
+
+    float total = 0;
+    for (unsigned i = 0; i < 16; i++) indices[i] = static_cast<uint8_t>(chosen[i]);
+    for (unsigned i = 0; i < subset.count; i++) total += best[i];
+    return total;
+}
+// endregion
+
+// region subset fitting
+
+// Gather the pixels of one subset of a partition from the block
+SubsetValues GatherSubset(const FloatPlanes &block, unsigned subsets, unsigned partition, unsigned subset_index) {
+    SubsetValues subset;
+    for (unsigned i = 0; i < 16; i++) {
+        if (Subset(subsets, partition, i) != subset_index) continue;
+        for (unsigned c = 0; c < 3; c++) subset.values[c][subset.count] = block[c][i];
+        subset.pixels[subset.count++] = static_cast<uint8_t>(i);
+    }
+    return subset;
+}
+
+// Fit a line to a subset along its principal axis, with endpoints at the extremes of its projection
+Line FitLine(const SubsetValues &subset) {
+    const float count = static_cast<float>(subset.count);
+
+    std::array<float, 3> mean = {};
+    for (unsigned c = 0; c < 3; c++) {
+        for (unsigned i = 0; i < subset.count; i++) mean[c] += subset.values[c][i];
+        mean[c] /= count;
+    }
+
+    std::array<std::array<float, 3>, 3> covariance = {};
+    for (unsigned i = 0; i < subset.count; i++) {
+        for (unsigned a = 0; a < 3; a++) {
+            for (unsigned b = a; b < 3; b++) covariance[a][b] += (subset.values[a][i] - mean[a]) * (subset.values[b][i] - mean[b]);
+        }
+    }
+    for (unsigned a = 0; a < 3; a++) {
+        for (unsigned b = 0; b < a; b++) covariance[a][b] = covariance[b][a];
+    }
+
+    // principal axis by power iteration, starting from the channel with the most variance
+    std::array<float, 3> axis = {};
+    unsigned start = 0;
+    for (unsigned c = 1; c < 3; c++) {
+        if (covariance[c][c] > covariance[start][start]) start = c;
+    }
+    axis[start] = 1.0f;
+    for (unsigned iter = 0; iter < 6; iter++) {
+        std::array<float, 3> next = {};
+        for (unsigned a = 0; a < 3; a++) {
+            for (unsigned b = 0; b < 3; b++) next[a] += covariance[a][b] * axis[b];
+        }
+        float length = 0;
+        for (unsigned c = 0; c < 3; c++) length = std::max(length, std::fabs(next[c]));
+        if (length <= 0) break;
+        for (unsigned c = 0; c < 3; c++) axis[c] = next[c] / length;
+    }
+
+    float low = 0, high = 0;
+    float norm = 0;
+    for (unsigned c = 0; c < 3; c++) norm += axis[c] * axis[c];
+    if (norm > 0) {
+        for (unsigned i = 0; i < subset.count; i++) {
+            float t = 0;
+            for (unsigned c = 0; c < 3; c++) t += (subset.values[c][i] - mean[c]) * axis[c];
+            t /= norm;
+            if (i == 0 || t < low) low = t;
+            if (i == 0 || t > high) high = t;
+        }
+    }
+
+    Line line;
+    for (unsigned c = 0; c < 3; c++) {
+        line[0][c] = mean[c] + low * axis[c];
+        line[1][c] = mean[c] + high * axis[c];
+    }
+    return line;
+}
+
+// Solve for the line that best fits a subset with the block's current indices. Returns false if every value has the same index
+bool LeastSquares(const SubsetValues &subset, const IndexArray &indices, unsigned index_bits, Line &line) {
+    const uint8_t *weights = Weights(index_bits);
+    float aa = 0, ab = 0, bb = 0;
+    std::array<float, 3> ax = {}, bx = {};
+
+    for (unsigned i = 0; i < subset.count; i++) {
+        const float t = static_cast<float>(weights[indices[subset.pixels[i]]]) / 64.0f;
+        const float s = 1.0f - t;
+        aa += s * s;
+        ab += s * t;
+        bb += t * t;
+        for (unsigned c = 0; c < 3; c++) {
+            ax[c] += s * subset.values[c][i];
+            bx[c] += t * subset.values[c][i];
+        }
+    }
+
+    const float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) return false;
+
+    for (unsigned c = 0; c < 3; c++) {
+        line[0][c] = (bb * ax[c] - ab * bx[c]) / det;
+        line[1][c] = (aa * bx[c] - ab * ax[c]) / det;
+    }
+    return true;
+}
+
+// Interpolate the palette of one subset's quantized endpoints, then choose its indices, returning its error
+float EvaluateSubset(const SubsetValues &subset, const ModeInfo &info, const std::array<BC6HBlock::Endpoint, 2> &endpoints, bool is_signed,
+                     IndexArray &indices) {
+    std::array<std::array<int, 3>, 2> expanded;
+    for (unsigned e = 0; e < 2; e++) {
+        for (unsigned c = 0; c < 3; c++) expanded[e][c] = BC6HBlock::Unquantize(endpoints[e][c], info.endpoint_bits, is_signed);
+    }
+
+    const unsigned entries = 1U << info.index_bits;
+    const uint8_t *weights = Weights(info.index_bits);
+    FloatPlanes palette = {};
+    for (unsigned c = 0; c < 3; c++) {
+        for (unsigned k = 0; k < entries; k++) palette[c][k] = static_cast<float>(Finish(Interpolate(expanded[0][c], expanded[1][c], weights[k]), is_signed));
+    }
+
+    IndexArray subset_indices;
+    const float error = SelectIndices(subset, palette, entries, subset_indices);
+    for (unsigned i = 0; i < subset.count; i++) indices[subset.pixels[i]] = subset_indices[i];
+    return error;
+}
+
+// Choose the indices of every subset for a candidate's endpoints, and update its error
+void Evaluate(const Subsets &subsets, bool is_signed, Candidate &candidate) {
+    auto &unpacked = candidate.unpacked;
+    const auto &info = BC6HBlock::Modes[static_cast<unsigned>(unpacked.mode)];
+
+    candidate.error = 0;
+    for (unsigned s = 0; s < info.subsets; s++) candidate.error += EvaluateSubset(subsets[s], info, unpacked.endpoints[s], is_signed, unpacked.indices);
+}
+
+// Move every endpoint after the first close enough to it for its deltas to fit. Packing may swap the first subset's endpoints
+// so that its anchor index has its top bit clear, so the endpoint that ends up first is used
+void ClampDeltas(Unpacked &unpacked) {
+    const auto &info = BC6HBlock::Modes[static_cast<unsigned>(unpacked.mode)];
+    const unsigned first = unpacked.indices[0] >> (info.index_bits - 1);
+    const auto base = unpacked.endpoints[0][first];
+
+    for (unsigned s = 0; s < info.subsets; s++) {
+        for (unsigned e = 0; e < 2; e++) {
+            if (s == 0 && e == first) continue;
+            for (unsigned c = 0; c < 3; c++) {
+                const int range = 1 << (info.delta_bits[c] - 1);
+                unpacked.endpoints[s][e][c] = clampi(unpacked.endpoints[s][e][c], base[c] - range, base[c] + range - 1);
+            }
+        }
+    }
+}
+
+// Quantize lines to a mode's precision and choose indices for them. Returns false if the endpoints can't be made to fit the mode
+bool Quantize(const Subsets &subsets, const Lines &lines, unsigned mode, unsigned partition, bool is_signed,
+              Candidate &candidate) {
+    const auto &info = BC6HBlock::Modes[mode];
+    auto &unpacked = candidate.unpacked;
+    unpacked.mode = static_cast<int>(mode);
+    unpacked.partition = partition;
+
+    for (unsigned s = 0; s < info.subsets; s++) {
+        for (unsigned e = 0; e < 2; e++) {
+            for (unsigned c = 0; c < 3; c++) unpacked.endpoints[s][e][c] = QuantizeChannel(lines[s][e][c], info.endpoint_bits, is_signed);
+        }
+    }
+    Evaluate(subsets, is_signed, candidate);
+
+    // clamping can change which endpoint is first, so it might need to be done twice
+    for (unsigned attempt = 0; attempt < 2; attempt++) {
+        if (BC6HBlock::Fits(unpacked)) return true;
+        ClampDeltas(unpacked);
+        Evaluate(subsets, is_signed, candidate);
+    }
+    return BC6HBlock::Fits(unpacked);
+}
+
+// Try moving each channel of each endpoint by one step, keeping every change that lowers the error
+QUICKTEX_TARGET_CLONES void SearchEndpoints(const Subsets &subsets, bool is_signed, Candidate &best) {
+    const auto &info = BC6HBlock::Modes[static_cast<unsigned>(best.unpacked.mode)];
+    const int low = is_signed ? -(1 << (info.endpoint_bits - 1)) + (info.endpoint_bits >= 16) : 0;
+    const int high = is_signed ? (1 << (info.endpoint_bits - 1)) - 1 : (1 << info.endpoint_bits) - 1;
+
+    for (unsigned s = 0; s < info.subsets; s++) {
+        for (unsigned e = 0; e < 2; e++) {
+            for (unsigned c = 0; c < 3 && best.error > 0; c++) {
+                for (int step : {-1, 1}) {
+                    Candidate trial = best;
+                    int &value = trial.unpacked.endpoints[s][e][c];
+                    if (value + step < low || value + step > high) continue;
+                    value += step;
+
+                    Evaluate(subsets, is_signed, trial);
+                    if (trial.error < best.error && BC6HBlock::Fits(trial.unpacked)) best = trial;
+                }
+            }
+        }
+    }
+}
+// endregion
+
+// region modes
+
+// Encode a block with one mode, starting from lines fitted to each subset
+QUICKTEX_TARGET_CLONES Candidate FitMode(const Subsets &subsets, const Lines &lines, unsigned mode, unsigned partition, const Settings &settings) {
+    const auto &info = BC6HBlock::Modes[mode];
+
+    Candidate best;
+    if (!Quantize(subsets, lines, mode, partition, settings.is_signed, best)) return {};
+
+    for (unsigned pass = 0; pass < settings.refine_passes && best.error > 0; pass++) {
+        auto refined = lines;
+        for (unsigned s = 0; s < info.subsets; s++) LeastSquares(subsets[s], best.unpacked.indices, info.index_bits, refined[s]);
+
+        Candidate candidate;
+        if (!Quantize(subsets, refined, mode, partition, settings.is_signed, candidate) || candidate.error >= best.error) break;
+        best = candidate;
+    }
+
+    return best;
+}
+
+// True if lines quantized to a mode's precision have deltas that fit without clamping
+bool DeltasFit(const Lines &lines, unsigned mode, bool is_signed) {
+    const auto &info = BC6HBlock::Modes[mode];
+    if (!info.transformed) return true;
+
+    BC6HBlock::Endpoint base;
+    for (unsigned c = 0; c < 3; c++) base[c] = QuantizeChannel(lines[0][0][c], info.endpoint_bits, is_signed);
+
+    for (unsigned s = 0; s < info.subsets; s++) {
+        for (unsigned e = (s == 0); e < 2; e++) {
+            for (unsigned c = 0; c < 3; c++) {
+                const int range = 1 << (info.delta_bits[c] - 1);
+                const int delta = QuantizeChannel(lines[s][e][c], info.endpoint_bits, is_signed) - base[c];
+                if (delta < -range || delta >= range) return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Encode a block with modes from the most precise to the least, up to the first one whose deltas fit without clamping.
+// Modes after it can only quantize worse, so they are skipped. Modes before it are only tried with their deltas clamped if searching modes
+template <size_t N>
+void FitModes(const Subsets &subsets, const Lines &lines, const std::array<unsigned, N> &modes, unsigned partition, const Settings &settings, Candidate &best) {
+    for (unsigned mode : modes) {
+        const bool fits = DeltasFit(lines, mode, settings.is_signed);
+        if (fits || settings.mode_search) {
+            auto candidate = FitMode(subsets, lines, mode, partition, settings);
+            if (candidate.error < best.error) best = std::move(candidate);
+        }
+        if (fits || best.error == 0) return;
+    }
+}
+// endregion
+}  // namespace
+
+void BC6HEncoder::SetLevel(unsigned level) {
+    if (level > max_level) throw std::invalid_argument("Level out of range, must be between 0 and 4 inclusive");
+
+    _endpoint_search = false;
+    _mode_search = false;
+
+    switch (level) {
+        case 0:
+            // single subset only, for baking large numbers of smooth lightmaps quickly
+            _partitions = 0;
+            _refine_passes = 0;
+            break;
+        case 1:
+            // adds the two-subset modes with the best estimated partition, for hard edges
+            _partitions = 1;
+            _refine_passes = 1;
+            break;
+        default:
+        case 2:
+            _partitions = 4;
+            _refine_passes = 1;
+            break;
+        case 3:
+            _partitions = 8;
+            _refine_passes = 2;
+            _mode_search = true;
+            break;
+        case 4:
+            _partitions = 32;
+            _refine_passes = 3;
+            _endpoint_search = true;
+            _mode_search = true;
+            break;
+    }
+}
+
+void BC6HEncoder::SetPartitions(unsigned partitions) {
+    if (partitions > max_partitions) throw std::invalid_argument("Partitions out of range, must be between 0 and 32 inclusive");
+    _partitions = partitions;
+}
+
+void BC6HEncoder::SetRefinePasses(unsigned refine_passes) {
+    if (refine_passes > max_refine_passes) throw std::invalid_argument("Refine passes out of range, must be between 0 and 8 inclusive");
+    _refine_passes = refine_passes;
+}
+
+BC6HBlock BC6HEncoder::EncodeBlock(const ColorBlock<4, 4, HalfColor> &pixels) const {
+    std::array<HalfColor, 16> colors;
+    for (int y = 0; y < 4; y++) pixels.GetRow(y, &colors[static_cast<size_t>(y * 4)]);
+
+    FloatPlanes block;
+    Planes estimate_block = {};
+    for (unsigned i = 0; i < 16; i++) {
+        for (unsigned c = 0; c < 3; c++) {
+            const int value = ToValue(colors[i][c], _is_signed);
+            block[c][i] = static_cast<float>(value);
+            estimate_block[c][i] = value / 4;  // partition estimates sum products as ints, which would overflow at full range
+        }
+    }
+
+    Candidate best;
+    const Settings settings = {_is_signed, _refine_passes, _mode_search};
+
+    const Subsets whole = {GatherSubset(block, 1, 0, 0)};
+    FitModes(whole, {FitLine(whole[0])}, one_subset_modes, 0, settings, best);
+
+    if (_partitions > 0 && best.error > 0) {
+        std::array<float, 64> estimates;
+        std::array<uint8_t, 64> partitions;
+        EstimatePartitions(estimate_block, 2, 3, estimates);
+        const unsigned count = BestPartitions(estimates, BC6HBlock::PartitionCount, _partitions, partitions);
+
+        for (unsigned r = 0; r < count && best.error > 0; r++) {
+            const Subsets subsets = {GatherSubset(block, 2, partitions[r], 0), GatherSubset(block, 2, partitions[r], 1)};
+            FitModes(subsets, {FitLine(subsets[0]), FitLine(subsets[1])}, two_subset_modes, partitions[r], settings, best);
+        }
+    }
+
+    // only the best candidate is searched, since searching is much slower than fitting
+    if (_endpoint_search && best.error > 0) {
+        const unsigned subset_count = BC6HBlock::Modes[static_cast<unsigned>(best.unpacked.mode)].subsets;
+        Subsets subsets;
+        for (unsigned s = 0; s < subset_count; s++) subsets[s] = GatherSubset(block, subset_count, best.unpacked.partition, s);
+        SearchEndpoints(subsets, _is_signed, best);
+    }
+
+    return BC6HBlock(best.unpacked);
+}
+}  // namespace quicktex::bptc
@@ -0,0 +1,78 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../../ColorBlock.h"
+#include "../../Encoder.h"
+#include "../../HalfColor.h"
+#include "../../Texture.h"
+#include "BC6HBlock.h"
+
+namespace quicktex::bptc {
+
+class BC6HEncoder final : public BlockEncoder<BlockTexture<BC6HBlock>, HalfTexture> {
+   public:
+    /// Highest quality level. Level 0 only uses modes with one subset, and each level after it tries more partitions
+    static constexpr unsigned max_level = 4;
+
+    static constexpr unsigned max_partitions = BC6HBlock::PartitionCount;
+    static constexpr unsigned max_refine_passes = 8;
+
+    /**
+     * @param level The preset quality level. See SetLevel()
+     * @param is_signed True to encode BC6H_SF16, which can store negative values, or false for BC6H_UF16, which clamps them to 0
+     */
+    explicit BC6HEncoder(unsigned level = 2, bool is_signed = false) : _is_signed(is_signed) { SetLevel(level); }
+
+    /// Set all settings from a preset level between 0 and max_level inclusive
+    void SetLevel(unsigned level);
+
+    bool IsSigned() const { return _is_signed; }
+
+    /// Number of partitions fully fitted by the modes with two subsets, chosen from the best estimates of all of them. 0 uses one subset only
+    unsigned GetPartitions() const { return _partitions; }
+    void SetPartitions(unsigned partitions);
+
+    /// Number of least-squares passes used to refine each mode's endpoints after its indices are chosen
+    unsigned GetRefinePasses() const { return _refine_passes; }
+    void SetRefinePasses(unsigned refine_passes);
+
+    /// If true, try moving each channel of each quantized endpoint up or down by one step after refining
+    bool GetEndpointSearch() const { return _endpoint_search; }
+    void SetEndpointSearch(bool endpoint_search) { _endpoint_search = endpoint_search; }
+
+    /// If true, also try modes with more precise endpoints than the most precise one whose deltas fit, by clamping their deltas
+    bool GetModeSearch() const { return _mode_search; }
+    void SetModeSearch(bool mode_search) { _mode_search = mode_search; }
+
+    BC6HBlock EncodeBlock(const ColorBlock<4, 4, HalfColor> &pixels) const override;
+
+    virtual size_t MTThreshold() const override { return 16; }
+
+   private:
+    bool _is_signed;
+    unsigned _partitions;
+    unsigned _refine_passes;
+    bool _endpoint_search;
+    bool _mode_search;
+};
+}  // namespace quicktex::bptc
@@ -0,0 +1 @@
+from _quicktex._bptc._bc6h import *
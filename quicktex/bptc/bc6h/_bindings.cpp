@@ -0,0 +1,159 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "../../_bindings.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "../../Decoder.h"
+#include "../../Encoder.h"
+#include "BC6HBlock.h"
+#include "BC6HDecoder.h"
+#include "BC6HEncoder.h"
+
+namespace py = pybind11;
+namespace quicktex::bindings {
+
+using namespace quicktex::bptc;
+using namespace pybind11::literals;
+
+void InitBC6H(py::module_ &bptc) {
+    auto bc6h = bptc.def_submodule("_bc6h", "internal bc6h module");
+
+    // region BC6HBlock
+    auto bc6h_block = BindBlock<BC6HBlock>(bc6h, "BC6HBlock");
+    bc6h_block.doc() = R"doc(
+        A single BC6H block. All of its bits are zero by default, which is mode 0 with black endpoints.
+
+        The fields of a block are packed into a 128-bit stream whose layout depends on its mode, so they are exposed as readonly properties.
+        Whether the block is signed or unsigned is not stored in it, and is instead chosen by the decoder.
+    )doc";
+
+    bc6h_block.def(py::init<>());
+
+    bc6h_block.def_property_readonly("mode", &BC6HBlock::GetMode, R"doc(
+        The block's mode between 0 and 13 inclusive, or -1 for a reserved mode. Readonly.
+        Modes 0 to 9 have two subsets and modes 10 to 13 have one, in the order they are listed in the specification.
+    )doc");
+    bc6h_block.def_property_readonly(
+        "partition", [](const BC6HBlock &self) { return self.Unpack().partition; },
+        "The partition mapping pixels to subsets, or 0 if the block's mode only has one subset. Readonly.");
+
+    bc6h_block.def_property_readonly("can_flip", &BC6HBlock::CanFlip, R"doc(
+        True if the block can be flipped losslessly. Some partitions have no vertically flipped equivalent,
+        and some endpoints can't be stored as deltas once their order changes, so flipping them raises a ValueError. Readonly.
+    )doc");
+    bc6h_block.def_property_readonly("can_mirror", &BC6HBlock::CanMirror, R"doc(
+        True if the block can be mirrored losslessly. Some partitions have no horizontally mirrored equivalent,
+        and some endpoints can't be stored as deltas once their order changes, so mirroring them raises a ValueError. Readonly.
+    )doc");
+    // endregion
+
+    // region BC6HTexture
+    auto bc6h_texture = BindBlockTexture<BC6HBlock>(bc6h, "BC6HTexture");
+    bc6h_texture.doc() = "A texture comprised of BC6H blocks.";
+    // endregion
+
+    // region BC6HEncoder
+    py::class_<BC6HEncoder> bc6h_encoder(bc6h, "BC6HEncoder", R"doc(
+        Encodes HDR RGB textures to BC6H. Alpha is ignored.
+    )doc");
+
+    bc6h_encoder.def(py::init<unsigned, bool>(), "level"_a = 2, "is_signed"_a = false, R"doc(
+        Create a new BC6H encoder with the specified preset level.
+
+        :param int level: The preset level of the resulting encoder, between 0 and :py:const:`BC6HEncoder.max_level` inclusive.
+            See :py:meth:`set_level` for more information. Default: 2.
+        :param bool is_signed: If true, encode BC6H_SF16, which can store negative values.
+            Otherwise encode BC6H_UF16, which clamps negative values to 0. Default: False
+    )doc");
+
+    bc6h_encoder.def(
+        "encode", [](const BC6HEncoder &self, const HalfTexture &texture, bool flip) { return EncodeTexture(self, texture, flip); }, "texture"_a,
+        "flip"_a = false, R"doc(
+        Encode a half-float texture into a new BC6HTexture using the encoder's current settings.
+
+        :param HalfTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while encoding, at no extra cost. Default: False
+        :returns: A new BC6HTexture with the same dimension as the input.
+    )doc");
+
+    DefEncodeInto(bc6h_encoder);
+    DefEncodeBatch(bc6h_encoder);
+    DefEncodeStream(bc6h_encoder);
+
+    bc6h_encoder.def("set_level", &BC6HEncoder::SetLevel, "level"_a, R"doc(
+        Select a preset quality level, between 0 and :py:const:`BC6HEncoder.max_level` inclusive.
+        Higher quality levels are slower, but produce blocks that are a closer match to input.
+        This sets :py:attr:`partitions`, :py:attr:`refine_passes`, :py:attr:`endpoint_search` and :py:attr:`mode_search`.
+
+        Level 0 only uses modes with one subset, and is fast enough to bake large numbers of lightmaps.
+        Each level after it tries more partitions and refines endpoints further.
+
+        :param int level: The preset level of the resulting encoder, between 0 and :py:const:`BC6HEncoder.max_level` inclusive. Default: 2.
+    )doc");
+
+    bc6h_encoder.def_readonly_static("max_level", &BC6HEncoder::max_level);
+    bc6h_encoder.def_readonly_static("max_partitions", &BC6HEncoder::max_partitions);
+    bc6h_encoder.def_readonly_static("max_refine_passes", &BC6HEncoder::max_refine_passes);
+
+    bc6h_encoder.def_property_readonly("is_signed", &BC6HEncoder::IsSigned, "True if the encoder produces BC6H_SF16 blocks. Readonly.");
+
+    bc6h_encoder.def_property("partitions", &BC6HEncoder::GetPartitions, &BC6HEncoder::SetPartitions, R"doc(
+        Number of partitions fully fitted by the modes with two subsets, between 0 and :py:const:`BC6HEncoder.max_partitions` inclusive.
+        Every partition is estimated at once, and only the ones with the lowest estimates are fitted. 0 only uses modes with one subset.
+    )doc");
+
+    bc6h_encoder.def_property("refine_passes", &BC6HEncoder::GetRefinePasses, &BC6HEncoder::SetRefinePasses, R"doc(
+        Number of least-squares passes used to refine each mode's endpoints after its indices are chosen,
+        between 0 and :py:const:`BC6HEncoder.max_refine_passes` inclusive.
+    )doc");
+
+    bc6h_encoder.def_property("endpoint_search", &BC6HEncoder::GetEndpointSearch, &BC6HEncoder::SetEndpointSearch, R"doc(
+        If true, try moving each channel of each quantized endpoint up or down by one step after refining.
+    )doc");
+
+    bc6h_encoder.def_property("mode_search", &BC6HEncoder::GetModeSearch, &BC6HEncoder::SetModeSearch, R"doc(
+        If true, also try modes with more precise endpoints than the most precise one whose deltas fit, by clamping their deltas.
+    )doc");
+    // endregion
+
+    // region BC6HDecoder
+    py::class_<BC6HDecoder> bc6h_decoder(bc6h, "BC6HDecoder", R"doc(
+        Decodes BC6H textures to half-float RGB, with an alpha of 1
+    )doc");
+
+    bc6h_decoder.def(py::init<bool>(), "is_signed"_a = false, R"doc(
+        Create a new BC6H decoder.
+
+        :param bool is_signed: If true, decode BC6H_SF16 blocks. Otherwise decode BC6H_UF16 blocks. Default: False
+    )doc");
+
+    bc6h_decoder.def_property_readonly("is_signed", &BC6HDecoder::IsSigned, "True if the decoder reads BC6H_SF16 blocks. Readonly.");
+
+    bc6h_decoder.def("decode", &BC6HDecoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Decode a BC6H texture into a new HalfTexture.
+
+        :param BC6HTexture texture: Input texture to decode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
+        :returns: A new HalfTexture with the same dimensions as the input
+    )doc");
+    // endregion
+}
+}  // namespace quicktex::bindings
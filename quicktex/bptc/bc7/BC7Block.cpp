@@ -0,0 +1,201 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "BC7Block.h"
+
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+#include "../BitStream.h"
+#include "../Partitions.h"
+#include "../Tables.h"
+
+namespace quicktex::bptc {
+
+namespace {
+// The equivalent of a block's partition in a remap table, or nullptr if it has none or it can't be stored by the block's mode
+const Remap *FindModeRemap(const RemapTable &table, int mode, unsigned partition) {
+    const auto &info = BC7Block::Modes[static_cast<unsigned>(mode)];
+    return FindRemap(table, info.subsets, partition, 1U << info.partition_bits);
+}
+
+bool CanTransform(const BC7Block &block, const RemapTable &table) {
+    const int mode = block.GetMode();
+    if (mode < 0 || BC7Block::Modes[static_cast<unsigned>(mode)].subsets == 1) return true;
+    return FindModeRemap(table, mode, block.Unpack().partition) != nullptr;
+}
+
+void Transform(BC7Block &block, const PixelMap &map, const RemapTable &table, const char *error) {
+    const auto unpacked = block.Unpack();
+    if (unpacked.mode < 0) return;  // reserved modes decode to transparent black regardless
+
+    auto moved = unpacked;
+    for (unsigned i = 0; i < 16; i++) {
+        moved.indices[i] = unpacked.indices[map[i]];
+        moved.indices2[i] = unpacked.indices2[map[i]];
+    }
+
+    if (BC7Block::Modes[static_cast<unsigned>(unpacked.mode)].subsets > 1) {
+        const auto *remap = FindModeRemap(table, unpacked.mode, unpacked.partition);
+        if (!remap) throw std::invalid_argument(error);
+
+        moved.partition = static_cast<unsigned>(remap->partition);
+        for (unsigned s = 0; s < BC7Block::MaxSubsets; s++) {
+            moved.endpoints[s] = unpacked.endpoints[remap->subsets[s]];
+            moved.pbits[s] = unpacked.pbits[remap->subsets[s]];
+        }
+    }
+
+    block.Pack(moved);
+}
+
+// Swap the endpoints of the channels controlled by an index set, and invert its indices, wherever a subset's anchor index has its top bit set.
+// Weights are symmetric, so this decodes to exactly the same colors
+void NormalizeAnchors(BC7Block::Unpacked &unpacked, BC7Block::IndexArray &indices, unsigned bits, bool color, bool alpha) {
+    const auto &info = BC7Block::Modes[static_cast<unsigned>(unpacked.mode)];
+    const unsigned max = (1U << bits) - 1;
+    const unsigned high = 1U << (bits - 1);
+
+    for (unsigned s = 0; s < info.subsets; s++) {
+        if ((indices[Anchor(info.subsets, unpacked.partition, s)] & high) == 0) continue;
+
+        for (unsigned i = 0; i < 16; i++) {
+            if (Subset(info.subsets, unpacked.partition, i) == s) indices[i] = static_cast<uint8_t>(max - indices[i]);
+        }
+
+        auto &endpoints = unpacked.endpoints[s];
+        for (unsigned c = 0; c < 4; c++) {
+            if ((c < 3 && color) || (c == 3 && alpha)) std::swap(endpoints[0][c], endpoints[1][c]);
+        }
+        std::swap(unpacked.pbits[s][0], unpacked.pbits[s][1]);
+    }
+}
+}  // namespace
+
+int BC7Block::GetMode() const {
+    for (unsigned mode = 0; mode < ModeCount; mode++) {
+        if (_bytes[0] & (1U << mode)) return static_cast<int>(mode);
+    }
+    return -1;
+}
+
+BC7Block::Unpacked BC7Block::Unpack() const {
+    Unpacked unpacked;
+    unpacked.mode = GetMode();
+    if (unpacked.mode < 0) return unpacked;
+
+    const auto &info = Modes[static_cast<unsigned>(unpacked.mode)];
+    BitReader reader(_bytes);
+
+    reader.Read(static_cast<unsigned>(unpacked.mode) + 1);
+    unpacked.partition = reader.Read(info.partition_bits);
+    unpacked.rotation = reader.Read(info.rotation_bits);
+    unpacked.index_selection = reader.Read(info.selection_bits);
+
+    for (unsigned c = 0; c < 4; c++) {
+        const unsigned bits = c < 3 ? info.color_bits : info.alpha_bits;
+        if (bits == 0) continue;
+        for (unsigned s = 0; s < info.subsets; s++) {
+            for (unsigned e = 0; e < 2; e++) unpacked.endpoints[s][e][c] = static_cast<uint8_t>(reader.Read(bits));
+        }
+    }
+
+    for (unsigned s = 0; s < info.subsets; s++) {
+        if (info.endpoint_pbits) {
+            for (unsigned e = 0; e < 2; e++) unpacked.pbits[s][e] = static_cast<uint8_t>(reader.Read(1));
+        }
+    }
+    for (unsigned s = 0; s < info.subsets; s++) {
+        if (info.shared_pbits) unpacked.pbits[s][0] = unpacked.pbits[s][1] = static_cast<uint8_t>(reader.Read(1));
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        const unsigned subset = Subset(info.subsets, unpacked.partition, i);
+        const bool anchor = (Anchor(info.subsets, unpacked.partition, subset) == i);
+        unpacked.indices[i] = static_cast<uint8_t>(reader.Read(info.index_bits - anchor));
+    }
+    if (info.index2_bits > 0) {
+        for (unsigned i = 0; i < 16; i++) unpacked.indices2[i] = static_cast<uint8_t>(reader.Read(info.index2_bits - (i == 0)));
+    }
+
+    return unpacked;
+}
+
+void BC7Block::Pack(Unpacked unpacked) {
+    if (unpacked.mode < 0) {
+        _bytes.fill(0);
+        return;
+    }
+    if (unpacked.mode >= static_cast<int>(ModeCount)) throw std::invalid_argument("Invalid BC7 mode");
+
+    const auto &info = Modes[static_cast<unsigned>(unpacked.mode)];
+    if (unpacked.partition >= (1U << info.partition_bits)) throw std::invalid_argument("Partition out of range for BC7 mode");
+    if (unpacked.rotation >= (1U << info.rotation_bits)) throw std::invalid_argument("Rotation out of range for BC7 mode");
+    if (unpacked.index_selection && info.selection_bits == 0) throw std::invalid_argument("Index selection is only available in BC7 mode 4");
+
+    if (info.index2_bits == 0) {
+        NormalizeAnchors(unpacked, unpacked.indices, info.index_bits, true, true);
+    } else {
+        const bool swap = unpacked.index_selection;
+        NormalizeAnchors(unpacked, unpacked.indices, info.index_bits, !swap, swap);
+        NormalizeAnchors(unpacked, unpacked.indices2, info.index2_bits, swap, !swap);
+    }
+
+    BitWriter writer;
+    writer.Write(1U << static_cast<unsigned>(unpacked.mode), static_cast<unsigned>(unpacked.mode) + 1);
+    writer.Write(unpacked.partition, info.partition_bits);
+    writer.Write(unpacked.rotation, info.rotation_bits);
+    writer.Write(unpacked.index_selection, info.selection_bits);
+
+    for (unsigned c = 0; c < 4; c++) {
+        const unsigned bits = c < 3 ? info.color_bits : info.alpha_bits;
+        if (bits == 0) continue;
+        for (unsigned s = 0; s < info.subsets; s++) {
+            for (unsigned e = 0; e < 2; e++) writer.Write(unpacked.endpoints[s][e][c], bits);
+        }
+    }
+
+    for (unsigned s = 0; s < info.subsets; s++) {
+        if (info.endpoint_pbits) {
+            for (unsigned e = 0; e < 2; e++) writer.Write(unpacked.pbits[s][e], 1);
+        }
+    }
+    for (unsigned s = 0; s < info.subsets; s++) {
+        if (info.shared_pbits) writer.Write(unpacked.pbits[s][0], 1);
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        const unsigned subset = Subset(info.subsets, unpacked.partition, i);
+        const bool anchor = (Anchor(info.subsets, unpacked.partition, subset) == i);
+        writer.Write(unpacked.indices[i], info.index_bits - anchor);
+    }
+    if (info.index2_bits > 0) {
+        for (unsigned i = 0; i < 16; i++) writer.Write(unpacked.indices2[i], info.index2_bits - (i == 0));
+    }
+
+    _bytes = writer.Bytes();
+}
+
+bool BC7Block::CanFlip() const { return CanTransform(*this, FlipTable()); }
+bool BC7Block::CanMirror() const { return CanTransform(*this, MirrorTable()); }
+
+void BC7Block::Flip() { Transform(*this, flip_map, FlipTable(), "BC7 block's partition has no vertically flipped equivalent"); }
+void BC7Block::Mirror() { Transform(*this, mirror_map, MirrorTable(), "BC7 block's partition has no horizontally mirrored equivalent"); }
+
+}  // namespace quicktex::bptc
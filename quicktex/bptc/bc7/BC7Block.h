@@ -0,0 +1,134 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../../Color.h"
+#include "../BitStream.h"
+
+namespace quicktex::bptc {
+
+// Only 4-byte aligned, because BC7 data in a DDS file follows the 148-byte header and DX10 extension,
+// and textures can view memory-mapped files directly
+class alignas(4) BC7Block {
+   public:
+    static constexpr size_t Width = 4;
+    static constexpr size_t Height = 4;
+
+    static constexpr unsigned ModeCount = 8;
+    static constexpr unsigned MaxSubsets = 3;
+
+    /// Layout of one of the 8 BC7 modes
+    struct ModeInfo {
+        unsigned subsets;         // number of subsets, each with its own pair of endpoints
+        unsigned partition_bits;  // bits used to select a partition, which maps pixels to subsets
+        unsigned rotation_bits;   // bits used to select a channel to swap with alpha after decoding
+        unsigned selection_bits;  // bits used to select which index set is used for color and which for alpha
+        unsigned color_bits;      // bits per color channel of each endpoint, not counting p-bits
+        unsigned alpha_bits;      // bits per alpha channel of each endpoint, or 0 if alpha is always 255
+        bool endpoint_pbits;      // true if each endpoint has its own p-bit, used as the least significant bit of every channel
+        bool shared_pbits;        // true if both endpoints of each subset share a p-bit
+        unsigned index_bits;      // bits per index in the primary index set
+        unsigned index2_bits;     // bits per index in the secondary index set, or 0 if there is only one set
+    };
+
+    static constexpr std::array<ModeInfo, ModeCount> Modes = {{
+        {3, 4, 0, 0, 4, 0, true, false, 3, 0},
+        {2, 6, 0, 0, 6, 0, false, true, 3, 0},
+        {3, 6, 0, 0, 5, 0, false, false, 2, 0},
+        {2, 6, 0, 0, 7, 0, true, false, 2, 0},
+        {1, 0, 2, 1, 5, 6, false, false, 2, 3},
+        {1, 0, 2, 0, 7, 8, false, false, 2, 2},
+        {1, 0, 0, 0, 7, 7, true, false, 4, 0},
+        {2, 6, 0, 0, 5, 5, true, false, 2, 0},
+    }};
+
+    using IndexArray = std::array<uint8_t, Width * Height>;
+    using EndpointArray = std::array<std::array<Color, 2>, MaxSubsets>;
+    using PBitArray = std::array<std::array<uint8_t, 2>, MaxSubsets>;
+
+    /// The fields of a block, unpacked from its bitstream
+    struct Unpacked {
+        int mode = -1;                 // the block's mode, or -1 for a reserved mode, which decodes to transparent black
+        unsigned partition = 0;        // the partition mapping pixels to subsets, if the mode has more than one subset
+        unsigned rotation = 0;         // 0 for none, or 1-3 to swap red, green or blue with alpha after decoding
+        bool index_selection = false;  // mode 4 only. if true, color uses the secondary indices and alpha uses the primary indices
+        EndpointArray endpoints = {};  // each subset's endpoints at the mode's precision, without p-bits
+        PBitArray pbits = {};          // the p-bit of each endpoint. In mode 1, both endpoints of a subset have the same p-bit
+        IndexArray indices = {};       // primary index of each pixel in row-major order
+        IndexArray indices2 = {};      // secondary index of each pixel in row-major order, for modes 4 and 5
+    };
+
+    /// Create a new BC7Block. All of its bits are zero, which is a reserved mode that decodes to transparent black
+    constexpr BC7Block() : _bytes() {
+        static_assert(sizeof(BC7Block) == 16);
+        static_assert(sizeof(std::array<BC7Block, 10>) == 16 * 10);
+        static_assert(alignof(BC7Block) >= 4);
+    }
+
+    /// Create a new BC7Block by packing its fields
+    explicit BC7Block(const Unpacked& unpacked) { Pack(unpacked); }
+
+    /// Expand an endpoint channel of the given number of bits to 8 bits, by replicating its high bits into the low bits
+    static constexpr uint8_t Expand(unsigned value, unsigned bits) {
+        value <<= (8 - bits);
+        return static_cast<uint8_t>(value | (value >> bits));
+    }
+
+    /// Unpack the block's fields from its bitstream
+    Unpacked Unpack() const;
+
+    /**
+     * Pack fields into the block's bitstream.
+     * The index of each subset's anchor pixel is stored with one less bit, so subsets whose anchor index has its top bit set
+     * are first normalized by swapping their endpoints and inverting their indices, which decodes to the same colors.
+     */
+    void Pack(Unpacked unpacked);
+
+    /// The block's mode, or -1 for a reserved mode
+    int GetMode() const;
+
+    /// True if the block can be flipped losslessly. Some partitions have no vertically flipped equivalent in the partition table
+    bool CanFlip() const;
+
+    /// True if the block can be mirrored losslessly. Some partitions have no horizontally mirrored equivalent in the partition table
+    bool CanMirror() const;
+
+    /**
+     * Flip the block vertically by reordering its indices and remapping its partition
+     * @throws std::invalid_argument if the block's partition has no flipped equivalent. See CanFlip()
+     */
+    void Flip();
+
+    /**
+     * Mirror the block horizontally by reordering its indices and remapping its partition
+     * @throws std::invalid_argument if the block's partition has no mirrored equivalent. See CanMirror()
+     */
+    void Mirror();
+
+    bool operator==(const BC7Block& Rhs) const { return _bytes == Rhs._bytes; }
+    bool operator!=(const BC7Block& Rhs) const { return !(Rhs == *this); }
+
+   private:
+    BlockBytes _bytes;
+};
+}  // namespace quicktex::bptc
@@ -0,0 +1,87 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "BC7Decoder.h"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "../../Color.h"
+#include "../../ColorBlock.h"
+#include "../Tables.h"
+#include "BC7Block.h"
+
+namespace quicktex::bptc {
+
+ColorBlock<4, 4> BC7Decoder::DecodeBlock(const BC7Block &block) const {
+    auto output = ColorBlock<4, 4>();
+    const auto unpacked = block.Unpack();
+
+    std::array<Color, 16> colors;
+    if (unpacked.mode < 0) {
+        colors.fill(Color(0, 0, 0, 0));
+        for (int y = 0; y < 4; y++) output.SetRow(y, &colors[static_cast<size_t>(y * 4)]);
+        return output;
+    }
+
+    const auto &info = BC7Block::Modes[static_cast<unsigned>(unpacked.mode)];
+
+    // expand each subset's endpoints to 8 bits, including their p-bits
+    const bool has_pbits = info.endpoint_pbits || info.shared_pbits;
+    std::array<std::array<Color, 2>, BC7Block::MaxSubsets> endpoints;
+    for (unsigned s = 0; s < info.subsets; s++) {
+        for (unsigned e = 0; e < 2; e++) {
+            const Color &packed = unpacked.endpoints[s][e];
+            const unsigned pbit = unpacked.pbits[s][e];
+            Color &expanded = endpoints[s][e];
+            for (unsigned c = 0; c < 3; c++) {
+                expanded[c] = has_pbits ? BC7Block::Expand((packed[c] << 1U) | pbit, info.color_bits + 1) : BC7Block::Expand(packed[c], info.color_bits);
+            }
+            if (info.alpha_bits == 0) {
+                expanded.a = 0xFF;
+            } else {
+                expanded.a = has_pbits ? BC7Block::Expand((packed.a << 1U) | pbit, info.alpha_bits + 1) : BC7Block::Expand(packed.a, info.alpha_bits);
+            }
+        }
+    }
+
+    // in modes 4 and 5, color and alpha have their own index sets, which mode 4 can swap
+    const bool split = info.index2_bits > 0;
+    const bool swap = unpacked.index_selection;
+    const auto &color_indices = (split && swap) ? unpacked.indices2 : unpacked.indices;
+    const auto &alpha_indices = (split && !swap) ? unpacked.indices2 : unpacked.indices;
+    const uint8_t *color_weights = Weights((split && swap) ? info.index2_bits : info.index_bits);
+    const uint8_t *alpha_weights = Weights((split && !swap) ? info.index2_bits : info.index_bits);
+
+    for (unsigned i = 0; i < 16; i++) {
+        const auto &pair = endpoints[Subset(info.subsets, unpacked.partition, i)];
+        const int cw = color_weights[color_indices[i]];
+        const int aw = alpha_weights[alpha_indices[i]];
+
+        Color &color = colors[i];
+        for (unsigned c = 0; c < 3; c++) color[c] = static_cast<uint8_t>(Interpolate(pair[0][c], pair[1][c], cw));
+        color.a = static_cast<uint8_t>(Interpolate(pair[0].a, pair[1].a, aw));
+
+        if (unpacked.rotation > 0) std::swap(color[unpacked.rotation - 1], color.a);
+    }
+
+    for (int y = 0; y < 4; y++) output.SetRow(y, &colors[static_cast<size_t>(y * 4)]);
+    return output;
+}
+}  // namespace quicktex::bptc
@@ -0,0 +1,643 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "BC7Encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+
+#include "../../Color.h"
+#include "../../ColorBlock.h"
+#include "../../util.h"
+#include "../Partitions.h"
+#include "../Tables.h"
+#include "BC7Block.h"
+
+namespace quicktex::bptc {
+
+namespace {
+using IndexArray = BC7Block::IndexArray;
+using Endpoints = std::array<std::array<float, 4>, 2>;
+using ModeInfo = BC7Block::ModeInfo;
+
+enum class PBits { None, Endpoint, Shared };
+
+// How a mode stores the endpoints and indices of a set of channels
+struct Precision {
+    unsigned bits;  // bits per endpoint channel, not counting the p-bit
+    PBits pbits;
+    unsigned index_bits;
+};
+
+// The pixels of one subset in planar order, so that loops over them vectorize. Unused channels and pixels are 0
+struct SubsetValues {
+    Planes values = {};
+    unsigned channels = 0;
+    unsigned count = 0;
+    std::array<uint8_t, 16> pixels = {};  // position in the block of each value
+};
+
+// Quantized endpoints for a subset, and the indices and error they produce
+struct Fit {
+    std::array<std::array<int, 4>, 2> codes = {};
+    std::array<uint8_t, 2> pbits = {};
+    IndexArray indices = {};  // index of each value in the subset, not each pixel in the block
+    unsigned error = UINT_MAX;
+};
+
+struct Candidate {
+    BC7Block::Unpacked unpacked;
+    unsigned error = UINT_MAX;
+};
+
+struct Settings {
+    unsigned refine_passes;
+    bool pbit_search;
+};
+
+// region tables
+
+// The closest endpoint code to each 8-bit value, for each number of bits, without a p-bit or with a p-bit of 0 or 1
+using QuantizeTable = std::array<std::array<std::array<uint8_t, 256>, 3>, 9>;
+
+uint8_t ExpandCode(unsigned code, unsigned bits, int pbit) {
+    return pbit < 0 ? BC7Block::Expand(code, bits) : BC7Block::Expand((code << 1U) | static_cast<unsigned>(pbit), bits + 1);
+}
+
+QuantizeTable MakeQuantizeTable() {
+    QuantizeTable table = {};
+    for (unsigned bits = 1; bits <= 8; bits++) {
+        for (int pbit = -1; pbit <= 1; pbit++) {
+            if (pbit >= 0 && bits == 8) continue;
+            for (int value = 0; value < 256; value++) {
+                int best_error = INT_MAX;
+                for (unsigned code = 0; code < (1U << bits); code++) {
+                    const int error = absi(ExpandCode(code, bits, pbit) - value);
+                    if (error < best_error) {
+                        best_error = error;
+                        table[bits][static_cast<size_t>(pbit + 1)][static_cast<size_t>(value)] = static_cast<uint8_t>(code);
+                    }
+                }
+            }
+        }
+    }
+    return table;
+}
+
+const QuantizeTable &GetQuantizeTable() {
+    static const QuantizeTable table = MakeQuantizeTable();
+    return table;
+}
+
+// 7-bit mode 5 endpoints which interpolate to each 8-bit value at index 1, for encoding single-color blocks
+using SolidTable = std::array<std::array<uint8_t, 2>, 256>;
+
+SolidTable MakeSolidTable() {
+    SolidTable table = {};
+    std::array<int, 256> errors;
+    errors.fill(INT_MAX);
+    for (unsigned lo = 0; lo < 128; lo++) {
+        for (unsigned hi = 0; hi < 128; hi++) {
+            const int value = Interpolate(BC7Block::Expand(lo, 7), BC7Block::Expand(hi, 7), weights2[1]);
+            const int error = absi(static_cast<int>(lo) - static_cast<int>(hi));  // prefer endpoints close together
+            if (error < errors[static_cast<size_t>(value)]) {
+                errors[static_cast<size_t>(value)] = error;
+                table[static_cast<size_t>(value)] = {static_cast<uint8_t>(lo), static_cast<uint8_t>(hi)};
+            }
+        }
+    }
+    return table;
+}
+
+const SolidTable &GetSolidTable() {
+    static const SolidTable table = MakeSolidTable();
+    return table;
+}
+
+// Mode 6 endpoints closest to each 8-bit value, for every pair of p-bits and every index up to 7, for encoding single-color blocks when
+// mode 5 is disabled. Higher indices are the same as lower ones with the endpoints swapped. Not every color can be made exactly, since the
+// p-bits and index are shared by all 4 channels
+struct SolidEndpoints {
+    uint8_t lo = 0;
+    uint8_t hi = 0;
+    int error = INT_MAX;
+};
+constexpr unsigned solid6_choices = 8 * 4;  // index * 4 + p-bits, where bit 0 is the low endpoint's p-bit
+using Solid6Table = std::array<std::array<SolidEndpoints, 256>, solid6_choices>;
+
+Solid6Table MakeSolid6Table() {
+    Solid6Table table = {};
+    for (unsigned choice = 0; choice < solid6_choices; choice++) {
+        auto &entries = table[choice];
+        const unsigned weight = weights4[choice / 4];
+        for (unsigned lo = 0; lo < 128; lo++) {
+            for (unsigned hi = 0; hi < 128; hi++) {
+                const int e0 = static_cast<int>((lo << 1) | (choice & 1));
+                const int e1 = static_cast<int>((hi << 1) | ((choice >> 1) & 1));
+                auto &entry = entries[static_cast<size_t>(Interpolate(e0, e1, static_cast<int>(weight)))];
+
+                // prefer endpoints close together
+                if (entry.error == 0 && absi(entry.lo - entry.hi) <= absi(static_cast<int>(lo) - static_cast<int>(hi))) continue;
+                entry = {static_cast<uint8_t>(lo), static_cast<uint8_t>(hi), 0};
+            }
+        }
+
+        // values that can't be made exactly use the closest one that can
+        for (unsigned value = 0; value < 256; value++) {
+            if (entries[value].error == 0) continue;
+            for (unsigned other = 0; other < 256; other++) {
+                if (entries[other].error != 0) continue;
+                const int diff = static_cast<int>(value) - static_cast<int>(other);
+                if (diff * diff < entries[value].error) entries[value] = {entries[other].lo, entries[other].hi, diff * diff};
+            }
+        }
+    }
+    return table;
+}
+
+const Solid6Table &GetSolid6Table() {
+    static const Solid6Table table = MakeSolid6Table();
+    return table;
+}
+// endregion
+
+// region kernels
+
+// Choose the closest palette entry for every value in a subset, returning the total squared error.
+// Loops run over all 16 lanes, including unused ones, so they have a fixed trip count and vectorize
+unsigned SelectIndices(const SubsetValues &subset, const Planes &palette, unsigned entries, IndexArray &indices) {
+    std::array<int, 16> best;
+    best.fill(INT_MAX);
+    indices.fill(0);
+
+    for (unsigned k = 0; k < entries; k++) {
+        const int p0 = palette[0][k], p1 = palette[1][k], p2 = palette[2][k], p3 = palette[3][k];
+        for (unsigned i = 0; i < 16; i++) {
+            const int d0 = subset.values[0][i] - p0;
+            const int d1 = subset.values[1][i] - p1;
+            const int d2 = subset.values[2][i] - p2;
+            const int d3 = subset.values[3][i] - p3;
+            const int error = d0 * d0 + d1 * d1 + d2 * d2 + d3 * d3;
+            if (error < best[i]) {
+                best[i] = error;
+                indices[i] = static_cast<uint8_t>(k);
+            }
+        }
+    }
+
+    unsigned total = 0;
+    for (unsigned i = 0; i < subset.count; i++) total += static_cast<unsigned>(best[i]);
+    return total;
+}
+
+// endregion
+
+// region subset fitting
+
+// Expand a fit's endpoints and interpolate its palette, then choose its indices
+void Evaluate(const SubsetValues &subset, const Precision &precision, Fit &fit) {
+    std::array<std::array<int, 4>, 2> expanded = {};
+    for (unsigned e = 0; e < 2; e++) {
+        const int pbit = precision.pbits == PBits::None ? -1 : fit.pbits[e];
+        for (unsigned c = 0; c < subset.channels; c++) expanded[e][c] = ExpandCode(static_cast<unsigned>(fit.codes[e][c]), precision.bits, pbit);
+    }
+
+    const unsigned entries = 1U << precision.index_bits;
+    const uint8_t *weights = Weights(precision.index_bits);
+    Planes palette = {};
+    for (unsigned c = 0; c < subset.channels; c++) {
+        for (unsigned k = 0; k < entries; k++) palette[c][k] = Interpolate(expanded[0][c], expanded[1][c], weights[k]);
+    }
+
+    fit.error = SelectIndices(subset, palette, entries, fit.indices);
+}
+
+// Quantize unquantized endpoints to the mode's precision, choosing p-bits either by their quantization error or by trying them all
+void Quantize(const SubsetValues &subset, const Precision &precision, const Endpoints &endpoints, bool pbit_search, Fit &best) {
+    const auto &table = GetQuantizeTable()[precision.bits];
+
+    std::array<std::array<int, 4>, 2> values = {};
+    for (unsigned e = 0; e < 2; e++) {
+        for (unsigned c = 0; c < subset.channels; c++) values[e][c] = clampi(static_cast<int>(std::lround(endpoints[e][c])), 0, 255);
+    }
+
+    // quantization error of one endpoint with a given p-bit
+    auto endpoint_error = [&](unsigned e, int pbit) {
+        int error = 0;
+        for (unsigned c = 0; c < subset.channels; c++) {
+            const unsigned code = table[static_cast<size_t>(pbit + 1)][static_cast<size_t>(values[e][c])];
+            error += squarei(ExpandCode(code, precision.bits, pbit) - values[e][c]);
+        }
+        return error;
+    };
+
+    auto try_pbits = [&](uint8_t p0, uint8_t p1) {
+        Fit fit;
+        fit.pbits = {p0, p1};
+        for (unsigned e = 0; e < 2; e++) {
+            const int pbit = precision.pbits == PBits::None ? -1 : fit.pbits[e];
+            for (unsigned c = 0; c < subset.channels; c++) fit.codes[e][c] = table[static_cast<size_t>(pbit + 1)][static_cast<size_t>(values[e][c])];
+        }
+        Evaluate(subset, precision, fit);
+        if (fit.error < best.error) best = fit;
+    };
+
+    switch (precision.pbits) {
+        case PBits::None:
+            try_pbits(0, 0);
+            break;
+        case PBits::Shared:
+            if (pbit_search) {
+                try_pbits(0, 0);
+                try_pbits(1, 1);
+            } else {
+                const uint8_t p = (endpoint_error(0, 1) + endpoint_error(1, 1) < endpoint_error(0, 0) + endpoint_error(1, 0));
+                try_pbits(p, p);
+            }
+            break;
+        case PBits::Endpoint:
+            if (pbit_search) {
+                for (uint8_t p = 0; p < 4; p++) try_pbits(p & 1, p >> 1);
+            } else {
+                try_pbits(endpoint_error(0, 1) < endpoint_error(0, 0), endpoint_error(1, 1) < endpoint_error(1, 0));
+            }
+            break;
+    }
+}
+
+// Solve for the unquantized endpoints that best fit the subset with its current indices
+bool LeastSquares(const SubsetValues &subset, const Precision &precision, const IndexArray &indices, Endpoints &endpoints) {
+    const uint8_t *weights = Weights(precision.index_bits);
+    float aa = 0, ab = 0, bb = 0;
+    std::array<float, 4> ax = {}, bx = {};
+
+    for (unsigned i = 0; i < subset.count; i++) {
+        const float t = static_cast<float>(weights[indices[i]]) / 64.0f;
+        const float s = 1.0f - t;
+        aa += s * s;
+        ab += s * t;
+        bb += t * t;
+        for (unsigned c = 0; c < subset.channels; c++) {
+            ax[c] += s * static_cast<float>(subset.values[c][i]);
+            bx[c] += t * static_cast<float>(subset.values[c][i]);
+        }
+    }
+
+    const float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) return false;  // every value has the same index
+
+    for (unsigned c = 0; c < subset.channels; c++) {
+        endpoints[0][c] = clampf((bb * ax[c] - ab * bx[c]) / det, 0.0f, 255.0f);
+        endpoints[1][c] = clampf((aa * bx[c] - ab * ax[c]) / det, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// Fit endpoints to a subset along its principal axis, then refine them with least squares
+Fit FitSubset(const SubsetValues &subset, const Precision &precision, const Settings &settings) {
+    const unsigned channels = subset.channels;
+    const float count = static_cast<float>(subset.count);
+
+    std::array<float, 4> mean = {};
+    for (unsigned c = 0; c < channels; c++) {
+        for (unsigned i = 0; i < subset.count; i++) mean[c] += static_cast<float>(subset.values[c][i]);
+        mean[c] /= count;
+    }
+
+    std::array<std::array<float, 4>, 4> covariance = {};
+    for (unsigned i = 0; i < subset.count; i++) {
+        for (unsigned a = 0; a < channels; a++) {
+            for (unsigned b = a; b < channels; b++) {
+                covariance[a][b] += (static_cast<float>(subset.values[a][i]) - mean[a]) * (static_cast<float>(subset.values[b][i]) - mean[b]);
+            }
+        }
+    }
+    for (unsigned a = 0; a < channels; a++) {
+        for (unsigned b = 0; b < a; b++) covariance[a][b] = covariance[b][a];
+    }
+
+    // principal axis by power iteration, starting from the channel with the most variance
+    std::array<float, 4> axis = {};
+    unsigned start = 0;
+    for (unsigned c = 1; c < channels; c++) {
+        if (covariance[c][c] > covariance[start][start]) start = c;
+    }
+    axis[start] = 1.0f;
+    for (unsigned iter = 0; iter < 6; iter++) {
+        std::array<float, 4> next = {};
+        for (unsigned a = 0; a < channels; a++) {
+            for (unsigned b = 0; b < channels; b++) next[a] += covariance[a][b] * axis[b];
+        }
+        float length = 0;
+        for (unsigned c = 0; c < channels; c++) length = std::max(length, std::fabs(next[c]));
+        if (length <= 0) break;
+        for (unsigned c = 0; c < channels; c++) axis[c] = next[c] / length;
+    }
+
+    float low = 0, high = 0;
+    float norm = 0;
+    for (unsigned c = 0; c < channels; c++) norm += axis[c] * axis[c];
+    if (norm > 0) {
+        low = high = 0;
+        for (unsigned i = 0; i < subset.count; i++) {
+            float t = 0;
+            for (unsigned c = 0; c < channels; c++) t += (static_cast<float>(subset.values[c][i]) - mean[c]) * axis[c];
+            t /= norm;
+            if (i == 0 || t < low) low = t;
+            if (i == 0 || t > high) high = t;
+        }
+    }
+
+    Endpoints endpoints = {};
+    for (unsigned c = 0; c < channels; c++) {
+        endpoints[0][c] = clampf(mean[c] + low * axis[c], 0.0f, 255.0f);
+        endpoints[1][c] = clampf(mean[c] + high * axis[c], 0.0f, 255.0f);
+    }
+
+    Fit best;
+    Quantize(subset, precision, endpoints, settings.pbit_search, best);
+
+    for (unsigned pass = 0; pass < settings.refine_passes && best.error > 0; pass++) {
+        if (!LeastSquares(subset, precision, best.indices, endpoints)) break;
+
+        const unsigned before = best.error;
+        Quantize(subset, precision, endpoints, settings.pbit_search, best);
+        if (best.error >= before) break;
+    }
+
+    return best;
+}
+
+// Gather the pixels of one subset of a partition from the block
+SubsetValues GatherSubset(const Planes &block, unsigned subsets, unsigned partition, unsigned subset_index, unsigned channels) {
+    SubsetValues subset;
+    subset.channels = channels;
+    for (unsigned i = 0; i < 16; i++) {
+        if (Subset(subsets, partition, i) != subset_index) continue;
+        for (unsigned c = 0; c < channels; c++) subset.values[c][subset.count] = block[c][i];
+        subset.pixels[subset.count++] = static_cast<uint8_t>(i);
+    }
+    return subset;
+}
+// endregion
+
+// region modes
+
+// Encode a block with one of the modes that interpolate all channels together, giving up once its error reaches a bound
+QUICKTEX_TARGET_CLONES Candidate FitPartition(const Planes &block, unsigned mode, unsigned partition, const Settings &settings, unsigned bound) {
+    const ModeInfo &info = BC7Block::Modes[mode];
+    const Precision precision = {info.color_bits, info.endpoint_pbits ? PBits::Endpoint : (info.shared_pbits ? PBits::Shared : PBits::None), info.index_bits};
+    const unsigned channels = info.alpha_bits > 0 ? 4 : 3;
+
+    Candidate candidate;
+    auto &unpacked = candidate.unpacked;
+    unpacked.mode = static_cast<int>(mode);
+    unpacked.partition = partition;
+
+    unsigned error = 0;
+    for (unsigned s = 0; s < info.subsets; s++) {
+        const auto subset = GatherSubset(block, info.subsets, partition, s, channels);
+        const auto fit = FitSubset(subset, precision, settings);
+
+        error += fit.error;
+        if (error >= bound) return candidate;
+
+        for (unsigned e = 0; e < 2; e++) {
+            for (unsigned c = 0; c < channels; c++) unpacked.endpoints[s][e][c] = static_cast<uint8_t>(fit.codes[e][c]);
+            unpacked.pbits[s][e] = fit.pbits[e];
+        }
+        for (unsigned i = 0; i < subset.count; i++) unpacked.indices[subset.pixels[i]] = fit.indices[i];
+    }
+
+    candidate.error = error;
+    return candidate;
+}
+
+// Encode a block with mode 4 or 5, which interpolate color and alpha with separate indices, after swapping a channel with alpha
+QUICKTEX_TARGET_CLONES Candidate FitSeparateAlpha(const Planes &block, unsigned mode, unsigned rotation, bool index_selection, const Settings &settings) {
+    const ModeInfo &info = BC7Block::Modes[mode];
+
+    Planes rotated = block;
+    if (rotation > 0) std::swap(rotated[rotation - 1], rotated[3]);
+
+    SubsetValues color;
+    color.channels = 3;
+    color.count = 16;
+    std::iota(color.pixels.begin(), color.pixels.end(), 0);
+    for (unsigned c = 0; c < 3; c++) color.values[c] = rotated[c];
+
+    SubsetValues alpha;
+    alpha.channels = 1;
+    alpha.count = 16;
+    alpha.pixels = color.pixels;
+    alpha.values[0] = rotated[3];
+
+    const unsigned color_index_bits = index_selection ? info.index2_bits : info.index_bits;
+    const unsigned alpha_index_bits = index_selection ? info.index_bits : info.index2_bits;
+    const auto color_fit = FitSubset(color, {info.color_bits, PBits::None, color_index_bits}, settings);
+    const auto alpha_fit = FitSubset(alpha, {info.alpha_bits, PBits::None, alpha_index_bits}, settings);
+
+    Candidate candidate;
+    auto &unpacked = candidate.unpacked;
+    unpacked.mode = static_cast<int>(mode);
+    unpacked.rotation = rotation;
+    unpacked.index_selection = index_selection;
+    for (unsigned e = 0; e < 2; e++) {
+        for (unsigned c = 0; c < 3; c++) unpacked.endpoints[0][e][c] = static_cast<uint8_t>(color_fit.codes[e][c]);
+        unpacked.endpoints[0][e].a = static_cast<uint8_t>(alpha_fit.codes[e][0]);
+    }
+    unpacked.indices = index_selection ? alpha_fit.indices : color_fit.indices;
+    unpacked.indices2 = index_selection ? color_fit.indices : alpha_fit.indices;
+
+    candidate.error = color_fit.error + alpha_fit.error;
+    return candidate;
+}
+
+// Encode a single-color block exactly with mode 5, using 8-bit alpha and color endpoints that interpolate to the color at index 1
+BC7Block EncodeSolid(Color color) {
+    const auto &table = GetSolidTable();
+
+    BC7Block::Unpacked unpacked;
+    unpacked.mode = 5;
+    for (unsigned c = 0; c < 3; c++) {
+        unpacked.endpoints[0][0][c] = table[color[c]][0];
+        unpacked.endpoints[0][1][c] = table[color[c]][1];
+    }
+    unpacked.endpoints[0][0].a = unpacked.endpoints[0][1].a = color.a;
+    unpacked.indices.fill(1);
+
+    return BC7Block(unpacked);
+}
+
+// Encode a single-color block with mode 6, using the index and p-bits that come closest to the color in every channel
+BC7Block EncodeSolid6(Color color) {
+    const auto &table = GetSolid6Table();
+
+    unsigned best = 0;
+    int best_error = INT_MAX;
+    for (unsigned choice = 0; choice < solid6_choices && best_error > 0; choice++) {
+        int error = 0;
+        for (unsigned c = 0; c < 4; c++) error += table[choice][color[c]].error;
+        if (error < best_error) {
+            best = choice;
+            best_error = error;
+        }
+    }
+
+    BC7Block::Unpacked unpacked;
+    unpacked.mode = 6;
+    for (unsigned c = 0; c < 4; c++) {
+        unpacked.endpoints[0][0][c] = table[best][color[c]].lo;
+        unpacked.endpoints[0][1][c] = table[best][color[c]].hi;
+    }
+    unpacked.pbits[0] = {static_cast<uint8_t>(best & 1), static_cast<uint8_t>((best >> 1) & 1)};
+    unpacked.indices.fill(static_cast<uint8_t>(best / 4));
+
+    return BC7Block(unpacked);
+}
+
+// endregion
+}  // namespace
+
+void BC7Encoder::SetLevel(unsigned level) {
+    if (level > max_level) throw std::invalid_argument("Level out of range, must be between 0 and 6 inclusive");
+
+    _pbit_search = false;
+    _rotation_search = false;
+
+    switch (level) {
+        case 0:
+            // single subset with 4-bit indices, which is good enough for most smooth content
+            _mode_mask = 0x40;
+            _partitions = 1;
+            _refine_passes = 1;
+            break;
+        case 1:
+            // adds 2-subset mode 1 with the best estimated partition, for hard edges in opaque blocks
+            _mode_mask = 0x42;
+            _partitions = 1;
+            _refine_passes = 1;
+            break;
+        case 2:
+            _mode_mask = 0xEA;
+            _partitions = 4;
+            _refine_passes = 1;
+            break;
+        default:
+        case 3:
+            _mode_mask = 0xFF;
+            _partitions = 8;
+            _refine_passes = 2;
+            break;
+        case 4:
+            _mode_mask = 0xFF;
+            _partitions = 16;
+            _refine_passes = 2;
+            _pbit_search = true;
+            break;
+        case 5:
+            _mode_mask = 0xFF;
+            _partitions = 32;
+            _refine_passes = 3;
+            _pbit_search = true;
+            _rotation_search = true;
+            break;
+        case 6:
+            _mode_mask = 0xFF;
+            _partitions = 64;
+            _refine_passes = 4;
+            _pbit_search = true;
+            _rotation_search = true;
+            break;
+    }
+}
+
+void BC7Encoder::SetModeMask(uint8_t mode_mask) {
+    if ((mode_mask & alpha_modes) == 0) throw std::invalid_argument("At least one of modes 4-7 must be enabled, to encode blocks with alpha");
+    _mode_mask = mode_mask;
+}
+
+void BC7Encoder::SetPartitions(unsigned partitions) {
+    if (partitions < 1 || partitions > max_partitions) throw std::invalid_argument("Partitions out of range, must be between 1 and 64 inclusive");
+    _partitions = partitions;
+}
+
+void BC7Encoder::SetRefinePasses(unsigned refine_passes) {
+    if (refine_passes > max_refine_passes) throw std::invalid_argument("Refine passes out of range, must be between 0 and 8 inclusive");
+    _refine_passes = refine_passes;
+}
+
+BC7Block BC7Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
+    std::array<Color, 16> colors;
+    for (int y = 0; y < 4; y++) pixels.GetRow(y, &colors[static_cast<size_t>(y * 4)]);
+
+    const bool solid = std::all_of(colors.begin(), colors.end(), [&](const Color &c) { return c == colors[0]; });
+    if (solid && (_mode_mask & (1U << 5))) return EncodeSolid(colors[0]);
+    if (solid && (_mode_mask & (1U << 6))) return EncodeSolid6(colors[0]);
+
+    Planes block;
+    for (unsigned i = 0; i < 16; i++) {
+        for (unsigned c = 0; c < 4; c++) block[c][i] = colors[i][c];
+    }
+
+    // modes 0-3 decode alpha as 255, and mode 7 is only worthwhile with alpha unless it's the only mode enabled
+    const bool opaque = std::all_of(colors.begin(), colors.end(), [](const Color &c) { return c.a == UINT8_MAX; });
+    uint8_t mask = opaque ? _mode_mask : (_mode_mask & alpha_modes);
+    if (opaque && (mask & 0x7F)) mask &= 0x7F;
+    const Settings settings = {_refine_passes, _pbit_search};
+
+    Candidate best;
+    auto consider = [&best](Candidate &&candidate) {
+        if (candidate.error < best.error) best = std::move(candidate);
+    };
+
+    // modes are tried from cheapest to most expensive, so that the best error so far can end partitioned fits early
+    if (mask & (1U << 6)) consider(FitPartition(block, 6, 0, settings, best.error));
+
+    for (unsigned mode : {5U, 4U}) {
+        if (!(mask & (1U << mode)) || best.error == 0) continue;
+        const unsigned rotations = _rotation_search ? 4 : 1;
+        for (unsigned rotation = 0; rotation < rotations; rotation++) {
+            consider(FitSeparateAlpha(block, mode, rotation, false, settings));
+            if (mode == 4) consider(FitSeparateAlpha(block, mode, rotation, true, settings));
+        }
+    }
+
+    // partitions are estimated once for all modes with the same number of subsets
+    std::array<float, 64> estimates2, estimates3;
+    if ((mask & 0x8A) && best.error > 0) EstimatePartitions(block, 2, opaque ? 3 : 4, estimates2);
+    if ((mask & 0x05) && best.error > 0) EstimatePartitions(block, 3, opaque ? 3 : 4, estimates3);
+
+    for (unsigned mode : {1U, 3U, 7U, 0U, 2U}) {
+        if (!(mask & (1U << mode)) || best.error == 0) continue;
+
+        const ModeInfo &info = BC7Block::Modes[mode];
+        std::array<uint8_t, 64> partitions;
+        const unsigned count = BestPartitions(info.subsets == 2 ? estimates2 : estimates3, 1U << info.partition_bits, _partitions, partitions);
+
+        for (unsigned r = 0; r < count && best.error > 0; r++) consider(FitPartition(block, mode, partitions[r], settings, best.error));
+    }
+
+    return BC7Block(best.unpacked);
+}
+}  // namespace quicktex::bptc
@@ -0,0 +1,78 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../../ColorBlock.h"
+#include "../../Encoder.h"
+#include "../../Texture.h"
+#include "BC7Block.h"
+
+namespace quicktex::bptc {
+
+class BC7Encoder final : public BlockEncoder<BlockTexture<BC7Block>> {
+   public:
+    /// Highest quality level. Level 0 only uses mode 6, and each level after it tries more modes and partitions
+    static constexpr unsigned max_level = 6;
+
+    static constexpr unsigned max_partitions = 64;
+    static constexpr unsigned max_refine_passes = 8;
+
+    /// Modes that can store alpha. At least one of them must be enabled
+    static constexpr uint8_t alpha_modes = 0xF0;
+
+    explicit BC7Encoder(unsigned level = 3) { SetLevel(level); }
+
+    /// Set all settings from a preset level between 0 and max_level inclusive
+    void SetLevel(unsigned level);
+
+    /// Bitmask of the modes the encoder may use, where bit 0 is mode 0. Modes 0-3 are only used for fully opaque blocks
+    uint8_t GetModeMask() const { return _mode_mask; }
+    void SetModeMask(uint8_t mode_mask);
+
+    /// Number of partitions fully fitted for each mode with more than one subset, chosen from the best estimates of all of them
+    unsigned GetPartitions() const { return _partitions; }
+    void SetPartitions(unsigned partitions);
+
+    /// Number of least-squares passes used to refine each subset's endpoints after its indices are chosen
+    unsigned GetRefinePasses() const { return _refine_passes; }
+    void SetRefinePasses(unsigned refine_passes);
+
+    /// If true, try every combination of p-bits instead of choosing each one by how well it quantizes its endpoint
+    bool GetPBitSearch() const { return _pbit_search; }
+    void SetPBitSearch(bool pbit_search) { _pbit_search = pbit_search; }
+
+    /// If true, modes 4 and 5 also try storing red, green or blue in the alpha channel's endpoints
+    bool GetRotationSearch() const { return _rotation_search; }
+    void SetRotationSearch(bool rotation_search) { _rotation_search = rotation_search; }
+
+    BC7Block EncodeBlock(const ColorBlock<4, 4> &pixels) const override;
+
+    virtual size_t MTThreshold() const override { return 16; }
+
+   private:
+    uint8_t _mode_mask;
+    unsigned _partitions;
+    unsigned _refine_passes;
+    bool _pbit_search;
+    bool _rotation_search;
+};
+}  // namespace quicktex::bptc
@@ -0,0 +1 @@
+from _quicktex._bptc._bc7 import *
@@ -0,0 +1,154 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "../../_bindings.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "../../Decoder.h"
+#include "../../Encoder.h"
+#include "BC7Block.h"
+#include "BC7Decoder.h"
+#include "BC7Encoder.h"
+
+namespace py = pybind11;
+namespace quicktex::bindings {
+
+using namespace quicktex::bptc;
+using namespace pybind11::literals;
+
+void InitBC7(py::module_ &bptc) {
+    auto bc7 = bptc.def_submodule("_bc7", "internal bc7 module");
+
+    // region BC7Block
+    auto bc7_block = BindBlock<BC7Block>(bc7, "BC7Block");
+    bc7_block.doc() = R"doc(
+        A single BC7 block. All of its bits are zero by default, which is a reserved mode that decodes to transparent black.
+
+        The fields of a block are packed into a 128-bit stream whose layout depends on its mode, so they are exposed as readonly properties.
+    )doc";
+
+    bc7_block.def(py::init<>());
+
+    bc7_block.def_property_readonly("mode", &BC7Block::GetMode, "The block's mode between 0 and 7 inclusive, or -1 for a reserved mode. Readonly.");
+    bc7_block.def_property_readonly(
+        "partition", [](const BC7Block &self) { return self.Unpack().partition; },
+        "The partition mapping pixels to subsets, or 0 if the block's mode only has one subset. Readonly.");
+    bc7_block.def_property_readonly(
+        "rotation", [](const BC7Block &self) { return self.Unpack().rotation; },
+        "The channel swapped with alpha after decoding: 0 for none, or 1, 2 or 3 for red, green or blue. Only used by modes 4 and 5. Readonly.");
+    bc7_block.def_property_readonly(
+        "index_selection", [](const BC7Block &self) { return self.Unpack().index_selection; },
+        "If true, color uses the secondary index set and alpha uses the primary one. Only used by mode 4. Readonly.");
+
+    bc7_block.def_property_readonly("can_flip", &BC7Block::CanFlip, R"doc(
+        True if the block can be flipped losslessly. Some partitions have no vertically flipped equivalent, so flipping them raises a ValueError. Readonly.
+    )doc");
+    bc7_block.def_property_readonly("can_mirror", &BC7Block::CanMirror, R"doc(
+        True if the block can be mirrored losslessly. Some partitions have no horizontally mirrored equivalent, so mirroring them raises a ValueError. Readonly.
+    )doc");
+    // endregion
+
+    // region BC7Texture
+    auto bc7_texture = BindBlockTexture<BC7Block>(bc7, "BC7Texture");
+    bc7_texture.doc() = "A texture comprised of BC7 blocks.";
+    // endregion
+
+    // region BC7Encoder
+    py::class_<BC7Encoder> bc7_encoder(bc7, "BC7Encoder", R"doc(
+        Encodes RGBA textures to BC7
+    )doc");
+
+    bc7_encoder.def(py::init<unsigned>(), "level"_a = 3, R"doc(
+        Create a new BC7 encoder with the specified preset level.
+
+        :param int level: The preset level of the resulting encoder, between 0 and :py:const:`BC7Encoder.max_level` inclusive.
+            See :py:meth:`set_level` for more information. Default: 3.
+    )doc");
+
+    DefEncode(bc7_encoder, "BC7Texture", [](const BC7Encoder &) { return std::make_pair(BC7Decoder(), ErrorMetrics::AllChannels); });
+
+    DefEncodeInto(bc7_encoder);
+    DefEncodeBatch(bc7_encoder);
+    DefEncodeMulti(bc7_encoder);
+    DefEncodeStream(bc7_encoder);
+
+    bc7_encoder.def("set_level", &BC7Encoder::SetLevel, "level"_a, R"doc(
+        Select a preset quality level, between 0 and :py:const:`BC7Encoder.max_level` inclusive.
+        Higher quality levels are slower, but produce blocks that are a closer match to input.
+        This sets :py:attr:`mode_mask`, :py:attr:`partitions`, :py:attr:`refine_passes`, :py:attr:`pbit_search` and :py:attr:`rotation_search`.
+
+        Level 0 only uses mode 6, and encodes at about half the speed of BC3. Level 1 adds mode 1 for opaque blocks,
+        and each level after it tries more modes and partitions.
+
+        :param int level: The preset level of the resulting encoder, between 0 and :py:const:`BC7Encoder.max_level` inclusive. Default: 3.
+    )doc");
+
+    bc7_encoder.def_readonly_static("max_level", &BC7Encoder::max_level);
+    bc7_encoder.def_readonly_static("max_partitions", &BC7Encoder::max_partitions);
+    bc7_encoder.def_readonly_static("max_refine_passes", &BC7Encoder::max_refine_passes);
+    bc7_encoder.def_readonly_static("alpha_modes", &BC7Encoder::alpha_modes);
+
+    bc7_encoder.def_property("mode_mask", &BC7Encoder::GetModeMask, &BC7Encoder::SetModeMask, R"doc(
+        Bitmask of the modes the encoder may use, where bit 0 is mode 0.
+        Modes 0 to 3 can't store alpha, so they are only used for fully opaque blocks.
+        At least one of the modes in :py:const:`BC7Encoder.alpha_modes` must be enabled.
+    )doc");
+
+    bc7_encoder.def_property("partitions", &BC7Encoder::GetPartitions, &BC7Encoder::SetPartitions, R"doc(
+        Number of partitions fully fitted for each mode with more than one subset, between 1 and :py:const:`BC7Encoder.max_partitions` inclusive.
+        Every partition is estimated at once, and only the ones with the lowest estimates are fitted.
+    )doc");
+
+    bc7_encoder.def_property("refine_passes", &BC7Encoder::GetRefinePasses, &BC7Encoder::SetRefinePasses, R"doc(
+        Number of least-squares passes used to refine each subset's endpoints after its indices are chosen,
+        between 0 and :py:const:`BC7Encoder.max_refine_passes` inclusive.
+    )doc");
+
+    bc7_encoder.def_property("pbit_search", &BC7Encoder::GetPBitSearch, &BC7Encoder::SetPBitSearch, R"doc(
+        If true, try every combination of p-bits instead of choosing each one by how well it quantizes its endpoint.
+    )doc");
+
+    bc7_encoder.def_property("rotation_search", &BC7Encoder::GetRotationSearch, &BC7Encoder::SetRotationSearch, R"doc(
+        If true, modes 4 and 5 also try storing red, green or blue in the alpha channel's endpoints.
+    )doc");
+    // endregion
+
+    // region BC7Decoder
+    py::class_<BC7Decoder> bc7_decoder(bc7, "BC7Decoder", R"doc(
+        Decodes BC7 textures to RGBA
+    )doc");
+
+    bc7_decoder.def(py::init<>());
+
+    bc7_decoder.def("decode", &BC7Decoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Decode a BC7 texture into a new RawTexture.
+
+        :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
+        :returns: A new RawTexture with the same dimensions as the input
+    )doc");
+
+    DefCompare(bc7_decoder, [](const BC7Decoder &) { return ErrorMetrics::AllChannels; });
+    // endregion
+}
+}  // namespace quicktex::bindings
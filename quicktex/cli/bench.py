@@ -0,0 +1,151 @@
+import json
+import math
+import os
+import time
+
+import click
+from PIL import Image
+
+import quicktex
+import quicktex.bptc.bc7 as bc7
+import quicktex.s3tc.bc1 as bc1
+import quicktex.s3tc.bc2 as bc2
+import quicktex.s3tc.bc3 as bc3
+import quicktex.s3tc.bc4 as bc4
+import quicktex.s3tc.bc5 as bc5
+
+
+def corpus(size):
+    """Generate a synthetic image corpus covering smooth gradients, noise, hard edges and alpha"""
+    gradient = Image.linear_gradient('L').resize((size, size))
+    noise = Image.merge('RGB', [Image.effect_noise((size, size), 64 + 32 * i) for i in range(3)])
+    checker = Image.new('RGB', (size, size), (20, 20, 200))
+    for y in range(0, size, 16):
+        for x in range(0, size, 16):
+            checker.paste((230, 40, 40), (x, y, x + 8, y + 8))
+            checker.paste((230, 40, 40), (x + 8, y + 8, x + 16, y + 16))
+
+    return {
+        'gradient': Image.merge('RGB', (gradient, gradient.transpose(Image.ROTATE_90), gradient.transpose(Image.FLIP_TOP_BOTTOM))),
+        'noise': noise,
+        'checker': checker,
+        'alpha': Image.merge('RGBA', (*noise.split(), gradient)),
+    }
+
+
+def cases():
+    """Generate tuples of (name, encoder, decoder, bands) for every benchmark"""
+    for level in range(19):
+        yield f'bc1/level{level}', bc1.BC1Encoder(level), bc1.BC1Decoder(), 'RGB'
+
+    for mode in bc1.BC1Encoder.EndpointMode.__members__.values():
+        encoder = bc1.BC1Encoder(5)
+        encoder.endpoint_mode = mode
+        yield f'bc1/endpoint_mode/{mode.name}', encoder, bc1.BC1Decoder(), 'RGB'
+
+    for mode in bc1.BC1Encoder.ErrorMode.__members__.values():
+        encoder = bc1.BC1Encoder(5)
+        encoder.error_mode = mode
+        yield f'bc1/error_mode/{mode.name}', encoder, bc1.BC1Decoder(), 'RGB'
+
+    yield 'bc2', bc2.BC2Encoder(5), bc2.BC2Decoder(), 'RGBA'
+    yield 'bc2/dither', bc2.BC2Encoder(5, True), bc2.BC2Decoder(), 'RGBA'
+    yield 'bc3', bc3.BC3Encoder(5), bc3.BC3Decoder(), 'RGBA'
+    yield 'bc4', bc4.BC4Encoder(0), bc4.BC4Decoder(0), 'R'
+    yield 'bc5', bc5.BC5Encoder(0, 1), bc5.BC5Decoder(0, 1), 'RG'
+
+    for level in range(1, bc4.BC4Encoder.max_level + 1):
+        yield f'bc4/level{level}', bc4.BC4Encoder(0, level), bc4.BC4Decoder(0), 'R'
+        yield f'bc5/level{level}', bc5.BC5Encoder(0, 1, level), bc5.BC5Decoder(0, 1), 'RG'
+
+    for level in range(bc7.BC7Encoder.max_level + 1):
+        yield f'bc7/level{level}', bc7.BC7Encoder(level), bc7.BC7Decoder(), 'RGBA'
+
+
+def best_time(repetitions, func):
+    """Time the fastest of several repetitions of a function"""
+    best = math.inf
+    for _ in range(repetitions):
+        start = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def result(name, image_name, size, threads, seconds, psnr=None):
+    """A benchmark result. JSON has no infinity, so lossless results have a PSNR of None and are flagged instead"""
+    lossless = psnr == math.inf
+    return dict(
+        name=name,
+        image=image_name,
+        size=size,
+        threads=threads,
+        seconds=seconds,
+        mpix_per_second=size[0] * size[1] / 1e6 / seconds,
+        psnr=None if lossless else psnr,
+        lossless=lossless,
+    )
+
+
+@click.command()
+@click.option(
+    '-s', '--size', 'sizes', type=int, multiple=True, default=[256, 1024], show_default=True, help="Image sizes to test."
+)
+@click.option(
+    '-t',
+    '--threads',
+    type=click.IntRange(min=1),
+    multiple=True,
+    default=lambda: sorted({1, os.cpu_count() or 1}),
+    show_default='1 and the number of CPUs',
+    help="Thread counts to test.",
+)
+@click.option('-r', '--repetitions', type=int, default=3, show_default=True, help="Number of times to run each benchmark.")
+@click.option('-k', '--filter', 'name_filter', type=str, default='', help="Only run benchmarks containing this string.")
+@click.option('-o', '--output', type=click.File('w'), default='-', help="File to write JSON results to. Default: stdout")
+@click.argument('filenames', nargs=-1, type=click.Path(exists=True, readable=True, dir_okay=False))
+def bench(sizes, threads, repetitions, name_filter, output, filenames):
+    """Measure encoder and decoder speed and quality.
+
+    Images in FILENAMES are used as the corpus, or a synthetic corpus at each size if none are given.
+    Each benchmark is run with every thread count. Results are written as JSON, with a null PSNR and a lossless flag for
+    results that are lossless."""
+
+    if filenames:
+        corpora = [{str(f): Image.open(f) for f in filenames}]
+    else:
+        corpora = [corpus(size) for size in sizes]
+
+    results = []
+    for name, encoder, decoder, bands in cases():
+        for images in corpora:
+            for image_name, image in images.items():
+                image = image.convert('RGBA')
+                rawtex = quicktex.RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+                run_encoder = name_filter in name
+                run_decoder = name_filter in name + '/decode'
+                if not (run_encoder or run_decoder):
+                    continue
+
+                encoded = encoder.encode(rawtex)
+                channels = sum(1 << 'RGBA'.index(band) for band in bands)
+                quality = decoder.compare(rawtex, encoded, channels=channels).psnr
+
+                for thread_count in threads:
+                    quicktex.set_thread_count(thread_count)
+
+                    if run_encoder:
+                        seconds = best_time(repetitions, lambda: encoder.encode(rawtex))
+                        results.append(result(name, image_name, image.size, thread_count, seconds, quality))
+
+                    if run_decoder:
+                        seconds = best_time(repetitions, lambda: decoder.decode(encoded))
+                        results.append(result(name + '/decode', image_name, image.size, thread_count, seconds))
+
+    json.dump({'context': {'repetitions': repetitions}, 'benchmarks': results}, output, indent=2)
+    output.write('\n')
+
+
+if __name__ == '__main__':
+    bench()
@@ -1,9 +1,13 @@
+import concurrent.futures
+import os
 import pathlib
-from typing import List
+from typing import Callable, List, Tuple
 
 import click
 from PIL import Image
 
+import quicktex
+
 
 def get_decoded_extensions(feature: str = 'open') -> List[str]:
     """Gets a list of extensions for Pillow formats supporting a supplied feature"""
@@ -61,3 +65,54 @@ def path_pairs(inputs, output, suffix, extension):
         else:
             # decode to directory
             return [(inpath, outpath / (inpath.stem + suffix + extension)) for inpath in inpaths]
+
+
+# noinspection PyUnusedLocal
+def validate_jobs(ctx, param, value) -> int:
+    """Convert a job count of 0 to the number of CPUs"""
+    return value if value > 0 else (os.cpu_count() or 1)
+
+
+def run_jobs(path_pairs: List[Tuple[pathlib.Path, pathlib.Path]], func: Callable, jobs: int = 1) -> None:
+    """
+    Call ``func(inpath, outpath)`` for each pair of paths, showing a progress bar.
+    With more than one job, files are converted on a pool of worker threads. The encoders and decoders release the GIL,
+    so reading, resizing, encoding and writing different files all overlap. At most ``2 * jobs`` files are queued at once,
+    so memory use stays bounded no matter how many files there are. Each worker limits the encoders it calls to its share of
+    the CPU cores, so the workers don't all start a thread for every core at once.
+
+    :param path_pairs: A list of pairs of (inpath, outpath), such as returned by :py:func:`path_pairs`
+    :param func: Function to convert a single file
+    :param jobs: Number of files to convert in parallel
+    """
+
+    with click.progressbar(
+        length=len(path_pairs), show_eta=False, show_pos=True, item_show_func=lambda x: str(x[0]) if x else ''
+    ) as bar:
+        if jobs <= 1:
+            for pair in path_pairs:
+                func(*pair)
+                bar.update(1, pair)
+            return
+
+        threads = max(1, (os.cpu_count() or 1) // jobs)
+        with concurrent.futures.ThreadPoolExecutor(
+            max_workers=jobs, initializer=quicktex.set_thread_count, initargs=(threads,)
+        ) as executor:
+            pending = {}
+
+            def finish(futures):
+                for future in futures:
+                    pair = pending.pop(future)
+                    future.result()  # re-raise any exception from the worker
+                    bar.update(1, pair)
+
+            for pair in path_pairs:
+                if len(pending) >= 2 * jobs:
+                    done, _ = concurrent.futures.wait(pending, return_when=concurrent.futures.FIRST_COMPLETED)
+                    finish(done)
+
+                pending[executor.submit(func, *pair)] = pair
+
+            done, _ = concurrent.futures.wait(pending)
+            finish(done)
@@ -1,7 +1,6 @@
 import os.path
 
 import click
-from PIL import Image
 
 import quicktex.cli.common as common
 import quicktex.dds as dds
@@ -12,6 +11,15 @@ import quicktex.dds as dds
     '-f/-F', '--flip/--no-flip', default=True, show_default=True, help="Vertically flip image after converting."
 )
 @click.option('-r', '--remove', is_flag=True, help="Remove input images after converting.")
+@click.option(
+    '-j',
+    '--jobs',
+    type=click.IntRange(min=0),
+    default=1,
+    show_default=True,
+    callback=common.validate_jobs,
+    help="Number of files to convert in parallel. 0 uses one job per CPU.",
+)
 @click.option(
     '-s',
     '--suffix',
@@ -36,27 +44,24 @@ import quicktex.dds as dds
     help="Output file or directory. If outputting to a file, input filenames must be only a single item. By default, files are decoded in place.",
 )
 @click.argument('filenames', nargs=-1, type=click.Path(exists=True, readable=True, dir_okay=False))
-def decode(flip, remove, suffix, extension, output, filenames):
+def decode(flip, remove, jobs, suffix, extension, output, filenames):
     """Decode DDS files to images."""
 
     path_pairs = common.path_pairs(filenames, output, suffix, extension)
 
-    with click.progressbar(
-        path_pairs, show_eta=False, show_pos=True, item_show_func=lambda x: str(x[0]) if x else ''
-    ) as bar:
-        for inpath, outpath in bar:
-            if inpath.suffix != '.dds':
-                raise click.BadArgumentUsage(f"Input file '{inpath}' is not a DDS file.")
+    for inpath, _ in path_pairs:
+        if inpath.suffix != '.dds':
+            raise click.BadArgumentUsage(f"Input file '{inpath}' is not a DDS file.")
 
-            image = dds.read(inpath).decode()
+    def convert(inpath, outpath):
+        image = dds.read(inpath).decode(flip=flip)
 
-            if flip:
-                image = image.transpose(Image.FLIP_TOP_BOTTOM)
+        image.save(outpath)
 
-            image.save(outpath)
+        if remove:
+            os.remove(inpath)
 
-            if remove:
-                os.remove(inpath)
+    common.run_jobs(path_pairs, convert, jobs)
 
 
 if __name__ == '__main__':
@@ -4,8 +4,10 @@ import click
 from PIL import Image
 
 import quicktex.cli.common as common
+import quicktex.bptc.bc7
 import quicktex.dds as dds
 import quicktex.s3tc.bc1
+import quicktex.s3tc.bc2
 import quicktex.s3tc.bc3
 import quicktex.s3tc.bc4
 import quicktex.s3tc.bc5
@@ -21,6 +23,15 @@ def encode():
     '-f/-F', '--flip/--no-flip', default=True, show_default=True, help="Vertically flip image before converting."
 )
 @click.option('-r', '--remove', is_flag=True, help="Remove input images after converting.")
+@click.option(
+    '-j',
+    '--jobs',
+    type=click.IntRange(min=0),
+    default=1,
+    show_default=True,
+    callback=common.validate_jobs,
+    help="Number of files to convert in parallel. 0 uses one job per CPU.",
+)
 @click.option(
     '-s',
     '--suffix',
@@ -36,28 +47,24 @@ def encode():
     help="Output file or directory. If outputting to a file, input filenames must be only a single item. By default, files are decoded in place.",
 )
 @click.argument('filenames', nargs=-1, type=click.Path(exists=True, readable=True, dir_okay=False))
-def encode_format(encoder, four_cc, flip, remove, suffix, output, filenames, swizzle=False):
+def encode_format(encoder, four_cc, flip, remove, jobs, suffix, output, filenames, swizzle=False):
     filenames = [f for f in filenames if not f.endswith('.dds')]
     path_pairs = common.path_pairs(filenames, output, suffix, '.dds')
 
-    with click.progressbar(
-        path_pairs, show_eta=False, show_pos=True, item_show_func=lambda x: str(x[0]) if x else ''
-    ) as bar:
-        for inpath, outpath in bar:
-            image = Image.open(inpath)
+    def convert(inpath, outpath):
+        image = Image.open(inpath)
 
-            if flip:
-                image = image.transpose(Image.FLIP_TOP_BOTTOM)
+        if swizzle:
+            bands = image.split()
+            one = Image.new('L', image.size, 0xFF)
+            image = Image.merge('RGBA', (one, bands[1], bands[1], bands[0]))
 
-            if swizzle:
-                bands = image.split()
-                one = Image.new('L', image.size, 0xFF)
-                image = Image.merge('RGBA', (one, bands[1], bands[1], bands[0]))
+        dds.encode_file(outpath, image, encoder, four_cc, flip=flip)
 
-            dds.encode(image, encoder, four_cc).save(outpath)
+        if remove:
+            os.remove(inpath)
 
-            if remove:
-                os.remove(inpath)
+    common.run_jobs(path_pairs, convert, jobs)
 
 
 @click.command('auto')
@@ -81,10 +88,27 @@ def encode_format(encoder, four_cc, flip, remove, suffix, output, filenames, swi
     default=True,
     help='[BC1 only] Enable 3-color mode for non-black pixels. Higher quality, but slightly slower.',
 )
+@click.option(
+    '-p/-P',
+    '--punchthrough/--no-punchthrough',
+    default=True,
+    show_default=True,
+    help='Encode images whose alpha is only ever fully transparent or fully opaque to BC1 with punch-through alpha instead of BC3.'
+    ' Ignored if --black is enabled.',
+)
 @click.option(
     '-f/-F', '--flip/--no-flip', default=True, show_default=True, help="Vertically flip image before converting."
 )
 @click.option('-r', '--remove', is_flag=True, help="Remove input images after converting.")
+@click.option(
+    '-j',
+    '--jobs',
+    type=click.IntRange(min=0),
+    default=1,
+    show_default=True,
+    callback=common.validate_jobs,
+    help="Number of files to convert in parallel. 0 uses one job per CPU.",
+)
 @click.option(
     '-s',
     '--suffix',
@@ -100,7 +124,7 @@ def encode_format(encoder, four_cc, flip, remove, suffix, output, filenames, swi
     help="Output file or directory. If outputting to a file, input filenames must be only a single item. By default, files are decoded in place.",
 )
 @click.argument('filenames', nargs=-1, type=click.Path(exists=True, readable=True, dir_okay=False))
-def encode_auto(level, black, threecolor, flip, remove, suffix, output, filenames):
+def encode_auto(level, black, threecolor, punchthrough, flip, remove, jobs, suffix, output, filenames):
     """Encode images to BC1 or BC3, with the format chosen based on each image's alpha channel."""
 
     color_mode = quicktex.s3tc.bc1.BC1Encoder.ColorMode
@@ -111,35 +135,20 @@ def encode_auto(level, black, threecolor, flip, remove, suffix, output, filename
     else:
         mode = color_mode.ThreeColorBlack
 
-    bc1_encoder = quicktex.s3tc.bc1.BC1Encoder(level, mode)
-    bc3_encoder = quicktex.s3tc.bc3.BC3Encoder(level)
+    encoder = quicktex.s3tc.AutoEncoder(level, mode, punchthrough and not black)
     filenames = [f for f in filenames if not f.endswith('.dds')]
     path_pairs = common.path_pairs(filenames, output, suffix, '.dds')
 
     assert len(filenames) > 0
 
-    with click.progressbar(
-        path_pairs, show_eta=False, show_pos=True, item_show_func=lambda x: str(x[0]) if x else ''
-    ) as bar:
-        for inpath, outpath in bar:
-            image = Image.open(inpath)
-
-            if flip:
-                image = image.transpose(Image.FLIP_TOP_BOTTOM)
+    def convert(inpath, outpath):
+        image = Image.open(inpath)
+        dds.encode_auto(image, encoder, flip=flip).save(outpath)
 
-            if 'A' not in image.mode:
-                has_alpha = False
-            else:
-                alpha_hist = image.getchannel('A').histogram()
-                has_alpha = any([a > 0 for a in alpha_hist[:-1]])
+        if remove:
+            os.remove(inpath)
 
-            if has_alpha:
-                dds.encode(image, bc3_encoder, 'DXT5').save(outpath)
-            else:
-                dds.encode(image, bc1_encoder, 'DXT1').save(outpath)
-
-            if remove:
-                os.remove(inpath)
+    common.run_jobs(path_pairs, convert, jobs)
 
 
 @click.command('bc1')
@@ -163,8 +172,32 @@ def encode_auto(level, black, threecolor, flip, remove, suffix, output, filename
     default=True,
     help='Enable 3-color mode for non-black pixels. Higher quality, but slightly slower.',
 )
-def encode_bc1(level, black, threecolor, **kwargs):
-    """Encode images to BC1 (RGB, no alpha)."""
+@click.option(
+    '-p/-P',
+    '--perceptual/--no-perceptual',
+    default=False,
+    help='Weigh color channels by their contribution to luma when measuring error [default: no-perceptual]',
+)
+@click.option(
+    '-a',
+    '--alpha-threshold',
+    type=click.IntRange(0, 255),
+    default=0,
+    show_default=True,
+    help='Write pixels with alpha below this value as transparent, using punch-through alpha. 0 disables punch-through.'
+    ' Can\'t be combined with --black.',
+)
+@click.option(
+    '--rdo',
+    'rdo_lambda',
+    type=click.FloatRange(min=0),
+    default=0,
+    show_default=True,
+    help='Strength of rate-distortion optimization. Higher values compress better with zstd or deflate, at a lower quality.'
+    ' Values from 1 to 10 are typical. 0 disables it.',
+)
+def encode_bc1(level, black, threecolor, perceptual, alpha_threshold, rdo_lambda, **kwargs):
+    """Encode images to BC1 (RGB, with optional 1-bit alpha)."""
     color_mode = quicktex.s3tc.bc1.BC1Encoder.ColorMode
     if not threecolor:
         mode = color_mode.FourColor
@@ -173,7 +206,45 @@ def encode_bc1(level, black, threecolor, **kwargs):
     else:
         mode = color_mode.ThreeColorBlack
 
-    encode_format.callback(encoder=quicktex.s3tc.bc1.BC1Encoder(level, mode), four_cc='DXT1', **kwargs)
+    encoder = quicktex.s3tc.bc1.BC1Encoder(level, mode)
+    if perceptual:
+        encoder.channel_weights = quicktex.s3tc.bc1.BC1Encoder.perceptual_weights
+    if alpha_threshold > 0:
+        if black:
+            raise click.BadParameter('Punch-through alpha can\'t be combined with --black', param_hint='--alpha-threshold')
+        encoder.alpha_threshold = alpha_threshold
+    encoder.rdo_lambda = rdo_lambda
+
+    encode_format.callback(encoder=encoder, four_cc='DXT1', **kwargs)
+
+
+@click.command('bc2')
+@click.option(
+    '-l',
+    '--level',
+    type=click.IntRange(0, 18),
+    default=18,
+    help='Quality level to use. Higher values = higher quality, but slower.',
+)
+@click.option(
+    '-d/-D',
+    '--dither/--no-dither',
+    default=False,
+    help='Dither alpha when quantizing it to 4 bits, which hides banding in smooth gradients [default: no-dither]',
+)
+@click.option(
+    '-p/-P',
+    '--perceptual/--no-perceptual',
+    default=False,
+    help='Weigh color channels by their contribution to luma when measuring error [default: no-perceptual]',
+)
+def encode_bc2(level, dither, perceptual, **kwargs):
+    """Encode images to BC2 (RGBA, 4-bit explicit alpha)."""
+    encoder = quicktex.s3tc.bc2.BC2Encoder(level, dither)
+    if perceptual:
+        encoder.bc1_encoder.channel_weights = quicktex.s3tc.bc1.BC1Encoder.perceptual_weights
+
+    encode_format.callback(encoder, 'DXT3', **kwargs)
 
 
 @click.command('bc3')
@@ -191,30 +262,84 @@ def encode_bc1(level, black, threecolor, **kwargs):
     default=False,
     help='Perform a BC3nm swizzle, copying the red channel into the alpha [default: no-normal]',
 )
-def encode_bc3(level, normal, **kwargs):
+@click.option(
+    '-p/-P',
+    '--perceptual/--no-perceptual',
+    default=False,
+    help='Weigh color channels by their contribution to luma when measuring error [default: no-perceptual]',
+)
+def encode_bc3(level, normal, perceptual, **kwargs):
     """Encode images to BC4 (RGBA, 8-bit interpolated alpha)."""
-    encode_format.callback(quicktex.s3tc.bc3.BC3Encoder(level), 'DXT5', swizzle=normal, **kwargs)
+    encoder = quicktex.s3tc.bc3.BC3Encoder(level)
+    if perceptual:
+        encoder.bc1_encoder.channel_weights = quicktex.s3tc.bc1.BC1Encoder.perceptual_weights
+
+    encode_format.callback(encoder, 'DXT5', swizzle=normal, **kwargs)
 
 
 @click.command('bc4')
-def encode_bc4(**kwargs):
+@click.option(
+    '-l',
+    '--level',
+    type=click.IntRange(0, quicktex.s3tc.bc4.BC4Encoder.max_level),
+    default=quicktex.s3tc.bc4.BC4Encoder.max_level,
+    help='Quality level to use. Higher values = higher quality, but slower.',
+)
+@click.option(
+    '--rdo',
+    'rdo_lambda',
+    type=click.FloatRange(min=0),
+    default=0,
+    show_default=True,
+    help='Strength of rate-distortion optimization. Higher values compress better with zstd or deflate, at a lower quality.'
+    ' Values from 1 to 10 are typical. 0 disables it.',
+)
+def encode_bc4(level, rdo_lambda, **kwargs):
     """Encode images to BC4 (Single channel, 8-bit interpolated red channel)."""
-    encode_format.callback(quicktex.s3tc.bc4.BC4Encoder(), 'ATI1', **kwargs)
+    encoder = quicktex.s3tc.bc4.BC4Encoder(level=level)
+    encoder.rdo_lambda = rdo_lambda
+
+    encode_format.callback(encoder, 'ATI1', **kwargs)
 
 
 @click.command('bc5')
-def encode_bc5(**kwargs):
+@click.option(
+    '-l',
+    '--level',
+    type=click.IntRange(0, quicktex.s3tc.bc4.BC4Encoder.max_level),
+    default=quicktex.s3tc.bc4.BC4Encoder.max_level,
+    help='Quality level to use. Higher values = higher quality, but slower.',
+)
+def encode_bc5(level, **kwargs):
     """Encode images to BC5 (2-channel, 8-bit interpolated red and green channels)."""
-    encode_format.callback(quicktex.s3tc.bc5.BC5Encoder(), 'ATI2', **kwargs)
+    encode_format.callback(quicktex.s3tc.bc5.BC5Encoder(level=level), 'ATI2', **kwargs)
+
+
+@click.command('bc7')
+@click.option(
+    '-l',
+    '--level',
+    type=click.IntRange(0, quicktex.bptc.bc7.BC7Encoder.max_level),
+    default=3,
+    show_default=True,
+    help='Quality level to use. Higher values = higher quality, but slower.',
+)
+def encode_bc7(level, **kwargs):
+    """Encode images to BC7 (RGBA, with modes chosen per block)."""
+    encode_format.callback(quicktex.bptc.bc7.BC7Encoder(level), 'BC7', **kwargs)
 
 
 encode_bc1.params += encode_format.params
+encode_bc2.params += encode_format.params
 encode_bc3.params += encode_format.params
 encode_bc4.params += encode_format.params
 encode_bc5.params += encode_format.params
+encode_bc7.params += encode_format.params
 
 encode.add_command(encode_bc1)
+encode.add_command(encode_bc2)
 encode.add_command(encode_bc3)
 encode.add_command(encode_bc4)
 encode.add_command(encode_bc5)
+encode.add_command(encode_bc7)
 encode.add_command(encode_auto)
@@ -1,21 +1,28 @@
 from __future__ import annotations
 
+import contextlib
 import enum
+import functools
+import mmap
 import os
 import struct
 import typing
 
 from PIL import Image
 
+import quicktex.bptc.bc6h as bc6h
+import quicktex.bptc.bc7 as bc7
 import quicktex.image_utils
 import quicktex.s3tc.bc1 as bc1
+import quicktex.s3tc.bc2 as bc2
 import quicktex.s3tc.bc3 as bc3
 import quicktex.s3tc.bc4 as bc4
 import quicktex.s3tc.bc5 as bc5
 
 
 class DDSFormat:
-    def __init__(self, name: str, texture, encoder, decoder, four_cc: str = None):
+    def __init__(self, name: str, texture, encoder, decoder, four_cc: str = None, dxgi_formats: typing.Tuple[int, ...] = ()):
+        self.dxgi_formats = dxgi_formats
         self.four_cc = four_cc
         self.decoder = decoder
         self.encoder = encoder
@@ -24,10 +31,21 @@ class DDSFormat:
 
 
 dds_formats = [
-    DDSFormat('BC1', bc1.BC1Texture, bc1.BC1Encoder, bc1.BC1Decoder, 'DXT1'),
-    DDSFormat('BC3', bc3.BC3Texture, bc3.BC3Encoder, bc3.BC3Decoder, 'DXT5'),
-    DDSFormat('BC4', bc4.BC4Texture, bc4.BC4Encoder, bc4.BC4Decoder, 'ATI1'),
-    DDSFormat('BC5', bc5.BC5Texture, bc5.BC5Encoder, bc5.BC5Decoder, 'ATI2'),
+    DDSFormat('BC1', bc1.BC1Texture, bc1.BC1Encoder, bc1.BC1Decoder, 'DXT1', (71, 72)),
+    DDSFormat('BC2', bc2.BC2Texture, bc2.BC2Encoder, bc2.BC2Decoder, 'DXT3', (74, 75)),
+    DDSFormat('BC3', bc3.BC3Texture, bc3.BC3Encoder, bc3.BC3Decoder, 'DXT5', (77, 78)),
+    DDSFormat('BC4', bc4.BC4Texture, bc4.BC4Encoder, bc4.BC4Decoder, 'ATI1', (80,)),
+    DDSFormat('BC5', bc5.BC5Texture, bc5.BC5Encoder, bc5.BC5Decoder, 'ATI2', (83,)),
+    DDSFormat('BC6H_UF16', bc6h.BC6HTexture, bc6h.BC6HEncoder, bc6h.BC6HDecoder, None, (95,)),
+    DDSFormat(
+        'BC6H_SF16',
+        bc6h.BC6HTexture,
+        functools.partial(bc6h.BC6HEncoder, is_signed=True),
+        functools.partial(bc6h.BC6HDecoder, is_signed=True),
+        None,
+        (96,),
+    ),
+    DDSFormat('BC7', bc7.BC7Texture, bc7.BC7Encoder, bc7.BC7Decoder, None, (98, 99)),
 ]
 
 
@@ -102,6 +120,41 @@ class Caps0(enum.IntFlag):
     """Required"""
 
 
+class Caps1(enum.IntFlag):
+    """Additional detail about the surfaces stored"""
+
+    CUBEMAP = 0x200
+    """Required for a cube map."""
+
+    CUBEMAP_POSITIVEX = 0x400
+    CUBEMAP_NEGATIVEX = 0x800
+    CUBEMAP_POSITIVEY = 0x1000
+    CUBEMAP_NEGATIVEY = 0x2000
+    CUBEMAP_POSITIVEZ = 0x4000
+    CUBEMAP_NEGATIVEZ = 0x8000
+
+    CUBEMAP_ALL_FACES = 0xFE00
+    """A cube map with all six faces stored."""
+
+    VOLUME = 0x200000
+    """Required for a volume texture."""
+
+
+class ResourceDimension(enum.IntEnum):
+    """Type of resource stored in a file with a DX10 header"""
+
+    TEXTURE1D = 2
+    TEXTURE2D = 3
+    TEXTURE3D = 4
+
+
+class MiscFlags(enum.IntFlag):
+    """Miscellaneous resource flags in a DX10 header"""
+
+    TEXTURECUBE = 0x4
+    """The 2D texture is a cube map, or an array of cube maps."""
+
+
 @typing.final
 class DDSFile:
     """
@@ -119,6 +172,9 @@ class DDSFile:
     header_bytes = 124
     """The size of a DDS header in bytes."""
 
+    dx10_header_bytes = 20
+    """The size of a DX10 header in bytes, which immediately follows the DDS header if :py:attr:`four_cc` is ``DX10``."""
+
     def __init__(self):
         self.flags: DDSFlags = DDSFlags.TEXTURE
         """Flags to indicate which members contain valid data."""
@@ -141,7 +197,7 @@ class DDSFile:
 
         self.four_cc: str = "NONE"
         """FourCC code of the texture format. Valid texture format strings are ``DXT1``, ``DXT2``, ``DXT3``, ``DXT4``, or ``DXT5``. 
-        If a DirectX 10 header is used, this is ``DX10``."""
+        If a DirectX 10 header is used, this is ``DX10``, which is always the case for formats without a FourCC code such as BC7."""
 
         self.pixel_size: int = 0
         """Number of bits in each pixel if the texture is uncompressed"""
@@ -152,71 +208,150 @@ class DDSFile:
         self.caps: typing.Tuple[Caps0, int, int, int] = (Caps0.TEXTURE, 0, 0, 0)
         """Specifies the complexity of the surfaces stored."""
 
+        self.dxgi_format: int = 0
+        """DXGI_FORMAT value of the texture format. Only used if a DX10 header is present."""
+
+        self.resource_dimension: ResourceDimension = ResourceDimension.TEXTURE2D
+        """Type of the resource. Only used if a DX10 header is present."""
+
+        self.misc_flag: MiscFlags = MiscFlags(0)
+        """Miscellaneous resource flags. Only used if a DX10 header is present."""
+
+        self.array_size: int = 1
+        """Number of elements in a texture array. For an array of cube maps, this is the number of cube maps.
+        Only used if a DX10 header is present."""
+
+        self.misc_flags2: int = 0
+        """Additional resource flags, such as the alpha mode. Only used if a DX10 header is present."""
+
         self.textures: typing.List = []
-        """A list of bytes objects for each texture in the file"""
+        """A list of bytes objects for each texture in the file. Each array slice or cube face is stored with all of its mip levels
+        before the next one, so the texture for a given mip level and layer is at ``layer * mipmap_count + mip``"""
 
         self.format: DDSFormat = DDSFormat('NONE', None, None, None)
         """The format used by this dds file"""
 
+    @property
+    def cubemap(self) -> bool:
+        """True if the file contains one or more cube maps"""
+        if self.four_cc == 'DX10':
+            return MiscFlags.TEXTURECUBE in MiscFlags(self.misc_flag)
+        return bool(self.caps[1] & Caps1.CUBEMAP)
+
+    @property
+    def layer_count(self) -> int:
+        """The number of 2D surfaces in the file not counting mip levels, i.e. every array slice or cube face"""
+        array_size = self.array_size if self.four_cc == 'DX10' else 1
+        return array_size * (6 if self.cubemap else 1)
+
     def save(self, path: os.PathLike) -> None:
         """
         Save the DDSFile to a file
         :param path: string or path-like object to write to
         """
         with open(path, 'wb') as file:
-            file.write(DDSFile.magic)
+            self.write_header(file)
 
-            # WRITE HEADER
-            file.write(
-                struct.pack(
-                    '<7I44x',
-                    DDSFile.header_bytes,
-                    int(self.flags),
-                    self.size[1],
-                    self.size[0],
-                    self.pitch,
-                    self.depth,
-                    self.mipmap_count,
-                )
+            for texture in self.textures:
+                file.write(texture)
+
+    def write_header(self, file: typing.BinaryIO) -> None:
+        """
+        Write the magic bytes and header of the DDSFile to a file object, without any texture data
+        :param file: binary file object to write to
+        """
+        file.write(DDSFile.magic)
+
+        # WRITE HEADER
+        file.write(
+            struct.pack(
+                '<7I44x',
+                DDSFile.header_bytes,
+                int(self.flags),
+                self.size[1],
+                self.size[0],
+                self.pitch,
+                self.depth,
+                self.mipmap_count,
+            )
+        )
+        file.write(
+            struct.pack(
+                '<2I4s5I',
+                32,
+                int(self.pf_flags),
+                bytes(self.four_cc, 'ascii'),
+                self.pixel_size,
+                *self.pixel_bitmasks,
             )
+        )
+        file.write(struct.pack('<4I4x', *self.caps))
+
+        assert file.tell() == 4 + DDSFile.header_bytes, 'error writing file: incorrect header size'
+
+        # WRITE DX10_HEADER
+        if self.four_cc == 'DX10':
             file.write(
                 struct.pack(
-                    '<2I4s5I',
-                    32,
-                    int(self.pf_flags),
-                    bytes(self.four_cc, 'ascii'),
-                    self.pixel_size,
-                    *self.pixel_bitmasks,
+                    '<5I',
+                    self.dxgi_format,
+                    int(self.resource_dimension),
+                    int(self.misc_flag),
+                    self.array_size,
+                    self.misc_flags2,
                 )
             )
-            file.write(struct.pack('<4I4x', *self.caps))
 
-            assert file.tell() == 4 + DDSFile.header_bytes, 'error writing file: incorrect header size'
-
-            for texture in self.textures:
-                file.write(texture)
+            assert file.tell() == 4 + DDSFile.header_bytes + DDSFile.dx10_header_bytes, 'error writing file: incorrect header size'
 
-    def decode(self, mip: int = 0, *args, **kwargs) -> Image.Image:
+    def decode(self, mip: int = 0, layer: int = 0, *args, flip: bool = False, **kwargs) -> Image.Image:
         """
         Decode a single texture in the file to images
         :param mip: the mip level to decode. Default: 0
+        :param layer: the array slice or cube face to decode. Default: 0
+        :param flip: If true, vertically flip the image while decoding. Default: False
         :return: The decoded image
+        :raises ValueError: if the format is HDR, such as BC6H, which can't be stored in an RGBA image.
+            Use :py:meth:`decode_texture` instead.
         """
-        decoder = self.format.decoder(*args, **kwargs)
-        texture = decoder.decode(self.textures[mip])
+        texture = self.decode_texture(mip, layer, *args, flip=flip, **kwargs)
+        if not isinstance(texture, quicktex.RawTexture):
+            raise ValueError(f'{self.format.name} textures are HDR and can\'t be decoded to an image. Use decode_texture instead.')
         return Image.frombuffer('RGBA', texture.size, texture)
 
-    def decode_all(self, *args, **kwargs) -> typing.List[Image.Image]:
+    def decode_texture(self, mip: int = 0, layer: int = 0, *args, flip: bool = False, **kwargs):
+        """
+        Decode a single texture in the file, without converting it to an image
+        :param mip: the mip level to decode. Default: 0
+        :param layer: the array slice or cube face to decode. Default: 0
+        :param flip: If true, vertically flip the texture while decoding. Default: False
+        :return: The decoded texture, which is a :py:class:`~quicktex.HalfTexture` for HDR formats such as BC6H
+            and a :py:class:`~quicktex.RawTexture` otherwise
+        """
+        decoder = self.format.decoder(*args, **kwargs)
+        return decoder.decode(self.textures[layer * self.mipmap_count + mip], flip)
+
+    def decode_all(self, *args, flip: bool = False, **kwargs) -> typing.List[Image.Image]:
         """
         Decade all textures in the file to images
+        :param flip: If true, vertically flip the images while decoding. Default: False
         :return: the decoded images
         """
         decoder = self.format.decoder(*args, **kwargs)
-        textures = [decoder.decode(encoded) for encoded in self.textures]
+        textures = [decoder.decode(encoded, flip) for encoded in self.textures]
+        if not all(isinstance(texture, quicktex.RawTexture) for texture in textures):
+            raise ValueError(f'{self.format.name} textures are HDR and can\'t be decoded to images. Use decode_texture instead.')
         return [Image.frombuffer('RGBA', tex.size, tex) for tex in textures]
 
 
-def read(path: os.PathLike) -> DDSFile:
+def read(path: os.PathLike, use_mmap: bool = True) -> DDSFile:
+    """
+    Read a DDS file from disk
+    :param path: string or path-like object to read from
+    :param use_mmap: If true, map the file into memory and create textures that view the mapping directly instead of
+        copying each texture into its own buffer. The mapping is copy-on-write, so modifying the textures never modifies the file.
+    :return: The DDSFile
+    """
     with open(path, 'rb') as file:
         assert file.read(4) == DDSFile.magic, "Incorrect magic bytes in DDS file."
 
@@ -251,16 +386,45 @@ def read(path: os.PathLike) -> DDSFile:
 
         # READ DX10_HEADER
         if dds.four_cc == 'DX10':
-            raise NotImplementedError('DX10 headers are not yet supported')
+            dds.dxgi_format, resource_dimension, misc_flag, dds.array_size, dds.misc_flags2 = struct.unpack(
+                '<5I', file.read(DDSFile.dx10_header_bytes)
+            )
+            dds.resource_dimension = ResourceDimension(resource_dimension)
+            dds.misc_flag = MiscFlags(misc_flag)
 
-        # identify the format used
-        dds.format = next(entry for entry in dds_formats if entry.four_cc == dds.four_cc)
+            if dds.resource_dimension != ResourceDimension.TEXTURE2D:
+                raise NotImplementedError('Only 2D textures and cube maps are supported')
 
-        # calculate the size of each level of the texture
-        sizes = quicktex.image_utils.mip_sizes(dds.size, dds.mipmap_count)
+            # identify the format used
+            dds.format = next(entry for entry in dds_formats if dds.dxgi_format in entry.dxgi_formats)
+        else:
+            # identify the format used
+            dds.format = next(entry for entry in dds_formats if entry.four_cc == dds.four_cc)
+
+        # calculate the size of each level of the texture, repeated for each array slice or cube face
+        sizes = quicktex.image_utils.mip_sizes(dds.size, dds.mipmap_count) * dds.layer_count
 
         # READ TEXTURES
         dds.textures = []
+
+        if use_mmap:
+            mapping = memoryview(mmap.mmap(file.fileno(), 0, access=mmap.ACCESS_COPY))
+            offset = file.tell()
+
+            for size in sizes:
+                nbytes = _texture_nbytes(dds.format, size)
+                assert offset + nbytes <= len(mapping), 'Unexpected end of file'
+
+                try:
+                    texture = dds.format.texture.from_buffer(mapping[offset : offset + nbytes], *size)
+                except ValueError:  # misaligned data, fall back to copying
+                    texture = dds.format.texture.from_bytes(mapping[offset : offset + nbytes], *size)
+
+                dds.textures.append(texture)
+                offset += nbytes
+
+            return dds
+
         for size in sizes:
             texture = dds.format.texture(*size)  # make a new blocktexture of the current mip size
             nbytes = file.readinto(texture)
@@ -272,7 +436,14 @@ def read(path: os.PathLike) -> DDSFile:
         return dds
 
 
-def encode(image: Image.Image, encoder, four_cc: str, mip_count: typing.Optional[int] = None) -> DDSFile:
+def _texture_nbytes(dds_format: DDSFormat, size: typing.Tuple[int, int]) -> int:
+    """Size in bytes of a texture of the given format and dimensions, without allocating it"""
+    block_bytes = dds_format.texture(1, 1).nbytes  # a texture of a single block
+    return ((size[0] + 3) // 4) * ((size[1] + 3) // 4) * block_bytes
+
+
+def _mip_textures(image: Image.Image, mip_count: typing.Optional[int]) -> typing.List:
+    """Convert an image to RGBA and generate RawTextures for each of its mip levels"""
     if image.mode != 'RGBA' or image.mode != 'RGBX':
         mode = 'RGBA' if 'A' in image.mode else 'RGBX'
         image.apply_transparency()  # why is this necessary what
@@ -280,24 +451,225 @@ def encode(image: Image.Image, encoder, four_cc: str, mip_count: typing.Optional
 
     sizes = quicktex.image_utils.mip_sizes(image.size, mip_count)
     images = [image] + [quicktex.image_utils.resize_no_premultiply(image, size) for size in sizes[1:]]
-    dds = DDSFile()
 
-    for i in images:
-        rawtex = quicktex.RawTexture.frombytes(i.tobytes('raw', mode), *i.size)
-        dds.textures.append(encoder.encode(rawtex))
+    return [quicktex.RawTexture.frombytes(i.tobytes('raw', mode), *i.size) for i in images]
+
 
+def _find_format(four_cc: str) -> DDSFormat:
+    """Find a format by its FourCC code, or by its name for formats without one such as BC7"""
+    try:
+        return next(entry for entry in dds_formats if four_cc in (entry.four_cc, entry.name))
+    except StopIteration:
+        raise ValueError(f'Unknown texture format {four_cc}') from None
+
+
+def _init_header(dds: DDSFile, size: typing.Tuple[int, int], pitch: int, mip_count: int) -> None:
     dds.flags = DDSFlags.TEXTURE | DDSFlags.LINEAR_SIZE
     caps0 = Caps0.TEXTURE
 
-    if len(images) > 1:
+    if mip_count > 1:
         dds.flags |= DDSFlags.MIPMAPCOUNT
         caps0 |= Caps0.MIPMAP | Caps0.COMPLEX
 
     dds.caps = (caps0, 0, 0, 0)
-    dds.mipmap_count = len(images)
-    dds.pitch = dds.textures[0].nbytes
-    dds.size = dds.textures[0].size
+    dds.mipmap_count = mip_count
+    dds.pitch = pitch
+    dds.size = size
     dds.pf_flags = PFFlags.FOURCC
-    dds.four_cc = four_cc
+
+    if dds.format.four_cc is None:
+        # formats newer than DX9 have no FourCC code, and are only identified by the DX10 header
+        dds.four_cc = 'DX10'
+        dds.dxgi_format = dds.format.dxgi_formats[0]
+    else:
+        dds.four_cc = dds.format.four_cc
+
+
+def encode(
+    image: Image.Image, encoder, four_cc: str, mip_count: typing.Optional[int] = None, flip: bool = False
+) -> DDSFile:
+    return encode_layers([image], encoder, four_cc, mip_count, flip=flip)
+
+
+def encode_layers(
+    images: typing.Sequence[Image.Image],
+    encoder,
+    four_cc: str,
+    mip_count: typing.Optional[int] = None,
+    cubemap: bool = False,
+    dx10: bool = False,
+    flip: bool = False,
+) -> DDSFile:
+    """
+    Encode a texture array or cube map. Every mip level of every layer is encoded in a single parallel batch.
+
+    :param images: The array slices or cube faces to encode, which must all be the same size.
+        Cube faces are in the order +X, -X, +Y, -Y, +Z, -Z, and an array of cube maps has 6 faces for each array element.
+    :param encoder: The encoder to use, such as :py:class:`~quicktex.s3tc.bc1.BC1Encoder`
+    :param four_cc: FourCC code of the texture format, or its name for formats without one such as ``BC7``
+    :param mip_count: Number of mip levels to generate. By default, generate until the last mip level is 1x1.
+    :param cubemap: If true, the images are the faces of one or more cube maps
+    :param dx10: If true, always write a DX10 header. A DX10 header is required for arrays, and is used for them regardless.
+    :param flip: If true, vertically flip every image while encoding, without making a flipped copy
+    :return: The encoded DDSFile
+    """
+    assert len(images) > 0, 'No images to encode'
+    assert all(image.size == images[0].size for image in images), 'All layers must be the same size'
+    assert not cubemap or len(images) % 6 == 0, 'Cube maps must have 6 faces'
+
+    rawtexs = [rawtex for image in images for rawtex in _mip_textures(image, mip_count)]
+
+    dds = DDSFile()
+    dds.format = _find_format(four_cc)
+    dds.textures = encoder.encode_batch(rawtexs, flip)
+
+    _init_header(dds, dds.textures[0].size, dds.textures[0].nbytes, len(rawtexs) // len(images))
+
+    array_size = len(images) // 6 if cubemap else len(images)
+
+    if cubemap:
+        dds.caps = (dds.caps[0] | Caps0.COMPLEX, Caps1.CUBEMAP_ALL_FACES, 0, 0)
+
+    if dx10 or array_size > 1:
+        dds.four_cc = 'DX10'
+
+    # formats without a FourCC code always have a DX10 header, even when neither of the above asked for one
+    if dds.four_cc == 'DX10':
+        dds.dxgi_format = dds.format.dxgi_formats[0]
+        dds.array_size = array_size
+        dds.misc_flag = MiscFlags.TEXTURECUBE if cubemap else MiscFlags(0)
+
+    return dds
+
+
+def encode_textures(textures: typing.Sequence, encoder, four_cc: str, flip: bool = False) -> DDSFile:
+    """
+    Encode textures that have already been converted from an image, such as :py:class:`~quicktex.HalfTexture` for BC6H,
+    which Pillow can't produce. Every mip level is encoded in a single parallel batch.
+
+    :param textures: The mip levels of a single texture to encode, from largest to smallest.
+        Each level is generated by the caller, such as by halving the size of the level before it.
+    :param encoder: The encoder to use, such as :py:class:`~quicktex.bptc.bc6h.BC6HEncoder`
+    :param four_cc: FourCC code of the texture format, or its name for formats without one such as ``BC6H_UF16``
+    :param flip: If true, vertically flip every texture while encoding
+    :return: The encoded DDSFile
+    """
+    assert len(textures) > 0, 'No textures to encode'
+
+    dds = DDSFile()
+    dds.format = _find_format(four_cc)
+    dds.textures = encoder.encode_batch(textures, flip)
+
+    _init_header(dds, dds.textures[0].size, dds.textures[0].nbytes, len(textures))
+    return dds
+
+
+def encode_auto(image: Image.Image, encoder, mip_count: typing.Optional[int] = None, flip: bool = False) -> DDSFile:
+    """
+    Encode an image to BC1 if it is fully opaque, or BC3 if it has alpha.
+    The format is chosen while encoding the first mip level, and the remaining levels are encoded in a single batch with the chosen format.
+
+    :param image: The image to encode
+    :param encoder: The :py:class:`~quicktex.s3tc.AutoEncoder` to use
+    :param mip_count: Number of mip levels to generate. By default, generate until the last mip level is 1x1.
+    :param flip: If true, vertically flip the image while encoding, without making a flipped copy
+    :return: The encoded DDSFile
+    """
+    rawtexs = _mip_textures(image, mip_count)
+    top = encoder.encode(rawtexs[0], flip)
+
+    dds = DDSFile()
+    dds.format = next(entry for entry in dds_formats if isinstance(top, entry.texture))
+    mip_encoder = encoder.bc3_encoder if isinstance(top, bc3.BC3Texture) else encoder.bc1_encoder
+    dds.textures = [top] + (mip_encoder.encode_batch(rawtexs[1:], flip) if len(rawtexs) > 1 else [])
+
+    _init_header(dds, top.size, top.nbytes, len(rawtexs))
+    return dds
+
+
+def encode_file(
+    path: os.PathLike,
+    image: Image.Image,
+    encoder,
+    four_cc: str,
+    mip_count: typing.Optional[int] = None,
+    flip: bool = False,
+) -> DDSFile:
+    """
+    Encode an image directly into a DDS file on disk. The file is preallocated and memory-mapped,
+    and each mip level is encoded in place into the mapping, so the encoded data is never copied.
+
+    :param path: string or path-like object to write to
+    :param image: The image to encode
+    :param encoder: The encoder to use, such as :py:class:`~quicktex.s3tc.bc1.BC1Encoder`
+    :param four_cc: FourCC code of the texture format, or its name for formats without one such as ``BC7``
+    :param mip_count: Number of mip levels to generate. By default, generate until the last mip level is 1x1.
+    :param flip: If true, vertically flip the image while encoding, without making a flipped copy
+    :return: The DDSFile that was written, with textures that view the mapped file
+    """
+    dds = DDSFile()
+    dds.format = _find_format(four_cc)
+
+    rawtexs = _mip_textures(image, mip_count)
+    nbytes = [_texture_nbytes(dds.format, rawtex.size) for rawtex in rawtexs]
+
+    _init_header(dds, rawtexs[0].size, nbytes[0], len(rawtexs))
+
+    with open(path, 'w+b') as file:
+        dds.write_header(file)
+        offset = file.tell()
+        file.truncate(offset + sum(nbytes))
+
+        mapping = mmap.mmap(file.fileno(), 0, access=mmap.ACCESS_WRITE)
+        view = memoryview(mapping)
+
+        for rawtex, size in zip(rawtexs, nbytes):
+            texture = dds.format.texture.from_buffer(view[offset : offset + size], *rawtex.size)
+            encoder.encode_into(rawtex, texture, flip)
+            dds.textures.append(texture)
+            offset += size
+
+        mapping.flush()
+
+    return dds
+
+
+def encode_stream(path: os.PathLike, strips: typing.Iterable, size: typing.Tuple[int, int], encoder, four_cc: str) -> DDSFile:
+    """
+    Encode an image to a DDS file one horizontal strip at a time, without ever holding the whole image or texture in memory.
+    Only a single mip level is written, since generating mipmaps requires the entire image.
+
+    :param path: string or path-like object to write to
+    :param strips: An iterable of bytes-like objects containing RGBA rows of the image, from top to bottom.
+        All strips except the last must contain a multiple of 4 rows.
+    :param size: The dimensions of the full image in pixels
+    :param encoder: The encoder to use, such as :py:class:`~quicktex.s3tc.bc1.BC1Encoder`
+    :param four_cc: FourCC code of the texture format, or its name for formats without one such as ``BC7``
+    :return: A DDSFile containing the header that was written, but no textures
+    :raises ValueError: If the strips don't add up to exactly ``size[1]`` rows. The partially written file is removed
+    """
+    dds = DDSFile()
+    dds.format = _find_format(four_cc)
+    _init_header(dds, size, _texture_nbytes(dds.format, size), 1)
+
+    rows = 0
+
+    def write_strip(file, texture):
+        nonlocal rows
+        rows += texture.size[1]
+        if rows > size[1]:
+            raise ValueError(f'Strips contain more than the {size[1]} rows of the image')
+        file.write(texture)
+
+    try:
+        with open(path, 'wb') as file:
+            dds.write_header(file)
+            encoder.encode_stream(strips, size[0], functools.partial(write_strip, file))
+        if rows != size[1]:
+            raise ValueError(f'Strips contain {rows} rows, but the image has {size[1]}')
+    except BaseException:
+        with contextlib.suppress(OSError):
+            os.remove(path)
+        raise
 
     return dds
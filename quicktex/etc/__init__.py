@@ -0,0 +1,5 @@
+"""
+The etc module provides encoders and decoders for the Ericsson Texture Compression formats used by OpenGL ES and Vulkan
+on mobile GPUs: ETC2 RGB (which includes ETC1), ETC2 RGBA, and the EAC formats R11 and RG11.
+"""
+from _quicktex._etc import *
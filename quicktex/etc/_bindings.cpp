@@ -0,0 +1,35 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "../_bindings.h"
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+namespace quicktex::bindings {
+
+void InitEAC(py::module_ &etc);
+void InitETC2(py::module_ &etc);
+
+void InitETC(py::module_ &m) {
+    py::module_ etc = m.def_submodule("_etc", "etc compression library for the ETC2 and EAC formats");
+
+    InitEAC(etc);
+    InitETC2(etc);
+}
+}  // namespace quicktex::bindings
@@ -0,0 +1,114 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "EACBlock.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace quicktex::etc {
+
+namespace {
+// bit offset of the selector of the pixel at x, y in the packed selectors
+constexpr unsigned Shift(unsigned x, unsigned y) { return 45 - 3 * (x * 4 + y); }
+}  // namespace
+
+EACBlock::EACBlock(uint8_t base, unsigned multiplier, unsigned table, const SelectorArray& selectors) : _bytes() {
+    SetBase(base);
+    SetMultiplier(multiplier);
+    SetTable(table);
+    SetSelectors(selectors);
+}
+
+void EACBlock::SetMultiplier(unsigned multiplier) {
+    if (multiplier > 15) throw std::invalid_argument("EAC multiplier out of range, must be between 0 and 15 inclusive");
+    _bytes[1] = static_cast<uint8_t>((multiplier << 4) | (_bytes[1] & 0xF));
+}
+
+void EACBlock::SetTable(unsigned table) {
+    if (table > 15) throw std::invalid_argument("EAC table out of range, must be between 0 and 15 inclusive");
+    _bytes[1] = static_cast<uint8_t>((_bytes[1] & 0xF0) | table);
+}
+
+uint64_t EACBlock::GetPackedSelectors() const {
+    uint64_t packed = 0;
+    for (unsigned i = 2; i < 8; i++) packed = (packed << 8) | _bytes[i];
+    return packed;
+}
+
+void EACBlock::SetPackedSelectors(uint64_t packed) {
+    for (unsigned i = 7; i >= 2; i--) {
+        _bytes[i] = static_cast<uint8_t>(packed);
+        packed >>= 8;
+    }
+}
+
+EACBlock::SelectorArray EACBlock::GetSelectors() const {
+    const uint64_t packed = GetPackedSelectors();
+    SelectorArray unpacked;
+    for (unsigned y = 0; y < Height; y++) {
+        for (unsigned x = 0; x < Width; x++) unpacked[y][x] = static_cast<uint8_t>((packed >> Shift(x, y)) & SelectorMax);
+    }
+    return unpacked;
+}
+
+void EACBlock::SetSelectors(const SelectorArray& unpacked) {
+    uint64_t packed = 0;
+    for (unsigned y = 0; y < Height; y++) {
+        if (std::any_of(unpacked[y].begin(), unpacked[y].end(), [](uint8_t i) { return i > SelectorMax; }))
+            throw std::invalid_argument("Selector value out of bounds.");
+        for (unsigned x = 0; x < Width; x++) packed |= static_cast<uint64_t>(unpacked[y][x]) << Shift(x, y);
+    }
+    SetPackedSelectors(packed);
+}
+
+std::array<uint8_t, 8> EACBlock::GetAlphaValues() const {
+    const auto& table = Tables[GetTable()];
+    const int base = GetBase();
+    const int multiplier = static_cast<int>(GetMultiplier());
+
+    std::array<uint8_t, 8> values;
+    for (unsigned i = 0; i < 8; i++) values[i] = static_cast<uint8_t>(std::clamp(base + table[i] * multiplier, 0, 255));
+    return values;
+}
+
+std::array<uint16_t, 8> EACBlock::GetR11Values() const {
+    const auto& table = Tables[GetTable()];
+    const int base = GetBase() * 8 + 4;
+    // a multiplier of 0 uses the modifiers as-is, for a finer step than any other multiplier
+    const int multiplier = GetMultiplier() == 0 ? 1 : static_cast<int>(GetMultiplier()) * 8;
+
+    std::array<uint16_t, 8> values;
+    for (unsigned i = 0; i < 8; i++) values[i] = static_cast<uint16_t>(std::clamp(base + table[i] * multiplier, 0, 2047));
+    return values;
+}
+
+void EACBlock::Flip() {
+    // each column is 12 bits, with the top pixel in the most significant bits
+    const uint64_t packed = GetPackedSelectors();
+    const uint64_t flipped = ((packed & 0x007007007007) << 9) | ((packed & 0x038038038038) << 3) | ((packed & 0x1C01C01C01C0) >> 3) |
+                             ((packed & 0xE00E00E00E00) >> 9);
+    SetPackedSelectors(flipped);
+}
+
+void EACBlock::Mirror() {
+    const uint64_t packed = GetPackedSelectors();
+    const uint64_t mirrored = ((packed & 0xFFF) << 36) | ((packed & 0xFFF000) << 12) | ((packed >> 12) & 0xFFF000) | ((packed >> 36) & 0xFFF);
+    SetPackedSelectors(mirrored);
+}
+}  // namespace quicktex::etc
@@ -0,0 +1,118 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace quicktex::etc {
+
+/// A single EAC block, which stores one channel. Used on its own for R11 and RG11, and for the alpha of ETC2 RGBA
+class alignas(8) EACBlock {
+   public:
+    static constexpr size_t Width = 4;
+    static constexpr size_t Height = 4;
+
+    static constexpr unsigned SelectorBits = 3;                       // size of a selector in bits
+    static constexpr unsigned SelectorMax = (1 << SelectorBits) - 1;  // maximum value of a selector
+
+    using SelectorArray = std::array<std::array<uint8_t, Width>, Height>;
+
+    /// How the block's values are decoded, which isn't stored in the block itself
+    enum class Precision : uint8_t {
+        Alpha,  // 8-bit values, for the alpha of ETC2 RGBA
+        R11,    // unsigned 11-bit values, for R11 and RG11
+    };
+
+    /// Modifier tables, each of which is multiplied by the block's multiplier and added to its base value
+    static constexpr std::array<std::array<int8_t, 8>, 16> Tables = {{
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8},
+    }};
+
+    /// Create a new EACBlock. All of its bits are zero, which decodes to 0 in alpha blocks and to 4/2047 in R11 blocks
+    constexpr EACBlock() : _bytes() {
+        static_assert(sizeof(EACBlock) == 8);
+        static_assert(sizeof(std::array<EACBlock, 10>) == 8 * 10);
+        static_assert(alignof(EACBlock) >= 8);
+    }
+
+    /**
+     * Create a new EACBlock
+     * @param base the base value
+     * @param multiplier the multiplier of the modifier table, between 0 and 15 inclusive
+     * @param table the index of the modifier table, between 0 and 15 inclusive
+     * @param selectors the selectors as a 4x4 array of integers, between 0 and 7 inclusive
+     */
+    EACBlock(uint8_t base, unsigned multiplier, unsigned table, const SelectorArray& selectors);
+
+    uint8_t GetBase() const { return _bytes[0]; }
+    void SetBase(uint8_t base) { _bytes[0] = base; }
+
+    unsigned GetMultiplier() const { return _bytes[1] >> 4; }
+    void SetMultiplier(unsigned multiplier);
+
+    unsigned GetTable() const { return _bytes[1] & 0xF; }
+    void SetTable(unsigned table);
+
+    /// Get the block's selectors as a 4x4 array of integers between 0 and 7 inclusive.
+    SelectorArray GetSelectors() const;
+
+    /// Set the block's selectors from a 4x4 array of integers between 0 and 7 inclusive.
+    void SetSelectors(const SelectorArray& unpacked);
+
+    /// The 8 values of this block when it stores 8-bit alpha, as in ETC2 RGBA
+    std::array<uint8_t, 8> GetAlphaValues() const;
+
+    /// The 8 values of this block when it stores an unsigned 11-bit channel, as in R11 and RG11
+    std::array<uint16_t, 8> GetR11Values() const;
+
+    /// Flip the block vertically by reversing the order of the selectors in each column
+    void Flip();
+
+    /// Mirror the block horizontally by reversing the order of its columns of selectors
+    void Mirror();
+
+    bool operator==(const EACBlock& Rhs) const { return _bytes == Rhs._bytes; }
+    bool operator!=(const EACBlock& Rhs) const { return !(Rhs == *this); }
+
+   private:
+    // base, then the multiplier and table, then 48 bits of selectors in big-endian order.
+    // Selectors are stored by column, with the top-left pixel's in the most significant bits
+    std::array<uint8_t, 8> _bytes;
+
+    uint64_t GetPackedSelectors() const;
+    void SetPackedSelectors(uint64_t packed);
+};
+}  // namespace quicktex::etc
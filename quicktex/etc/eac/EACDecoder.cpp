@@ -0,0 +1,54 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "EACDecoder.h"
+
+#include <array>
+#include <cstdint>
+
+#include "../../Color.h"
+#include "../../ColorBlock.h"
+#include "EACBlock.h"
+
+namespace quicktex::etc {
+void EACDecoder::DecodeInto(ColorBlock<4, 4> &dest, const EACBlock &block) const {
+    std::array<uint8_t, 8> values;
+    if (_precision == Precision::Alpha) {
+        values = block.GetAlphaValues();
+    } else {
+        const auto r11 = block.GetR11Values();
+        for (unsigned i = 0; i < 8; i++) values[i] = static_cast<uint8_t>((r11[i] * 255 + 1023) / 2047);
+    }
+
+    const auto selectors = block.GetSelectors();
+    for (unsigned y = 0; y < 4; y++) {
+        for (unsigned x = 0; x < 4; x++) {
+            auto color = dest.Get(x, y);
+            color[_channel] = values[selectors[y][x]];
+            dest.Set(x, y, color);
+        }
+    }
+}
+
+ColorBlock<4, 4> EACDecoder::DecodeBlock(const EACBlock &block) const {
+    auto output = ColorBlock<4, 4>();
+    DecodeInto(output, block);
+
+    return output;
+}
+}  // namespace quicktex::etc
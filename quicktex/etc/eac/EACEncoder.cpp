@@ -0,0 +1,206 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "EACEncoder.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+
+#include "../../Color.h"
+#include "../../ColorBlock.h"
+#include "../../util.h"
+#include "EACBlock.h"
+
+namespace quicktex::etc {
+
+namespace {
+using ValueArray = EACEncoder::ValueArray;
+using Precision = EACBlock::Precision;
+using TargetArray = std::array<int, 16>;
+using Palette = std::array<int, 8>;
+
+struct Candidate {
+    int base;
+    int multiplier;
+    unsigned table;
+    unsigned error;
+};
+
+// The most and least negative modifiers of each table, which bound the range of values it can reach
+constexpr unsigned low_modifier = 3;
+constexpr unsigned high_modifier = 7;
+
+EACBlock MakeBlock(int base, int multiplier, unsigned table) {
+    EACBlock block;
+    block.SetBase(static_cast<uint8_t>(base));
+    block.SetMultiplier(static_cast<unsigned>(multiplier));
+    block.SetTable(table);
+    return block;
+}
+
+// The values a block decodes to, in the same units as the targets
+Palette GetPalette(Precision precision, int base, int multiplier, unsigned table) {
+    const auto block = MakeBlock(base, multiplier, table);
+    Palette palette;
+    if (precision == Precision::Alpha) {
+        const auto values = block.GetAlphaValues();
+        std::copy(values.begin(), values.end(), palette.begin());
+    } else {
+        const auto values = block.GetR11Values();
+        std::copy(values.begin(), values.end(), palette.begin());
+    }
+    return palette;
+}
+
+// Total squared error of every target to its closest palette entry
+unsigned TotalError(const TargetArray &targets, const Palette &palette) {
+    unsigned total = 0;
+    for (unsigned i = 0; i < 16; i++) {
+        int best = INT_MAX;
+        for (unsigned s = 0; s < 8; s++) {
+            const int diff = targets[i] - palette[s];
+            best = std::min(best, diff * diff);
+        }
+        total += static_cast<unsigned>(best);
+    }
+    return total;
+}
+
+EACBlock::SelectorArray FindSelectors(const TargetArray &targets, const Palette &palette) {
+    EACBlock::SelectorArray selectors;
+    for (unsigned i = 0; i < 16; i++) {
+        int best = INT_MAX;
+        uint8_t best_selector = 0;
+        for (uint8_t s = 0; s < 8; s++) {
+            const int diff = targets[i] - palette[s];
+            if (diff * diff < best) {
+                best = diff * diff;
+                best_selector = s;
+            }
+        }
+        selectors[i / 4][i % 4] = best_selector;
+    }
+    return selectors;
+}
+
+// Solid blocks are exact. In alpha blocks, table 13 has a modifier of 0.
+// In R11 blocks with a multiplier of 0, the modifiers of table 6 cover every remainder of the 8-unit step of the base
+std::optional<EACBlock> EncodeSolid(Precision precision, int target) {
+    EACBlock::SelectorArray selectors;
+    if (precision == Precision::Alpha) {
+        for (auto &row : selectors) row.fill(4);
+        return EACBlock(static_cast<uint8_t>(target), 1, 13, selectors);
+    }
+
+    const auto &modifiers = EACBlock::Tables[6];
+    for (uint8_t s = 0; s < 8; s++) {
+        const int offset = target - 4 - modifiers[s];
+        if (offset < 0 || offset > 255 * 8 || offset % 8 != 0) continue;
+        for (auto &row : selectors) row.fill(s);
+        return EACBlock(static_cast<uint8_t>(offset / 8), 0, 6, selectors);
+    }
+    return std::nullopt;
+}
+
+// Try every base and multiplier within the given radii of a starting point for one table
+QUICKTEX_TARGET_CLONES void Search(const TargetArray &targets, Precision precision, unsigned table, int base, int multiplier, int base_radius,
+                                   int multiplier_radius, Candidate &best) {
+    const int min_multiplier = precision == Precision::Alpha ? 1 : 0;
+    for (int m = std::max(multiplier - multiplier_radius, min_multiplier); m <= std::min(multiplier + multiplier_radius, 15); m++) {
+        for (int b = std::max(base - base_radius, 0); b <= std::min(base + base_radius, 255); b++) {
+            const unsigned error = TotalError(targets, GetPalette(precision, b, m, table));
+            if (error < best.error) best = {b, m, table, error};
+        }
+    }
+}
+
+// Fit the base to the candidate's selectors by least squares
+void RefineBase(const TargetArray &targets, Precision precision, Candidate &candidate) {
+    const auto &modifiers = EACBlock::Tables[candidate.table];
+    const auto selectors = FindSelectors(targets, GetPalette(precision, candidate.base, candidate.multiplier, candidate.table));
+    const int scale = (precision == Precision::Alpha) ? candidate.multiplier : (candidate.multiplier == 0 ? 1 : candidate.multiplier * 8);
+
+    int sum = 0;
+    for (unsigned i = 0; i < 16; i++) sum += targets[i] - modifiers[selectors[i / 4][i % 4]] * scale;
+
+    const float mean = static_cast<float>(sum) / 16.0f;
+    const int base = std::clamp(static_cast<int>(std::lround(precision == Precision::Alpha ? mean : (mean - 4.0f) / 8.0f)), 0, 255);
+    if (base == candidate.base) return;
+
+    const unsigned error = TotalError(targets, GetPalette(precision, base, candidate.multiplier, candidate.table));
+    if (error < candidate.error) {
+        candidate.base = base;
+        candidate.error = error;
+    }
+}
+}  // namespace
+
+EACBlock EACEncoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
+    std::array<Color, 16> colors;
+    for (int y = 0; y < 4; y++) pixels.GetRow(y, &colors[static_cast<size_t>(y * 4)]);
+
+    ValueArray values;
+    for (unsigned i = 0; i < 16; i++) values[i] = colors[i][_channel];
+
+    return EncodeValues(values);
+}
+
+EACBlock EACEncoder::EncodeValues(const ValueArray &values) const {
+    // R11 blocks are fit to the 11-bit value closest to each 8-bit one
+    TargetArray targets;
+    for (unsigned i = 0; i < 16; i++) targets[i] = (_precision == Precision::Alpha) ? values[i] : (values[i] * 2047 + 127) / 255;
+
+    const auto [min, max] = std::minmax_element(targets.begin(), targets.end());
+    if (*min == *max) {
+        if (auto solid = EncodeSolid(_precision, *min)) return *solid;
+    }
+
+    const float center = static_cast<float>(*min + *max) / 2.0f;
+    const float range = static_cast<float>(*max - *min);
+    const int radius = static_cast<int>(_level);
+
+    // start each table from the base and multiplier that stretch its modifiers over the range of the block
+    Candidate best = {0, 0, 0, UINT_MAX};
+    for (unsigned table = 0; table < 16; table++) {
+        const auto &modifiers = EACBlock::Tables[table];
+        const float span = static_cast<float>(modifiers[high_modifier] - modifiers[low_modifier]);
+        const float middle = static_cast<float>(modifiers[high_modifier] + modifiers[low_modifier]) / 2.0f;
+
+        int base, multiplier;
+        if (_precision == Precision::Alpha) {
+            multiplier = std::clamp(static_cast<int>(std::lround(range / span)), 1, 15);
+            base = static_cast<int>(std::lround(center - middle * static_cast<float>(multiplier)));
+        } else {
+            multiplier = std::clamp(static_cast<int>(std::lround(range / (span * 8.0f))), 0, 15);
+            const float scale = multiplier == 0 ? 1.0f : static_cast<float>(multiplier * 8);
+            base = static_cast<int>(std::lround((center - 4.0f - middle * scale) / 8.0f));
+        }
+
+        Search(targets, _precision, table, std::clamp(base, 0, 255), multiplier, radius, std::min(radius, 1), best);
+    }
+
+    if (_level >= 2) RefineBase(targets, _precision, best);
+
+    const auto selectors = FindSelectors(targets, GetPalette(_precision, best.base, best.multiplier, best.table));
+    return EACBlock(static_cast<uint8_t>(best.base), static_cast<unsigned>(best.multiplier), best.table, selectors);
+}
+}  // namespace quicktex::etc
@@ -0,0 +1,70 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+#include "../../ColorBlock.h"
+#include "../../Encoder.h"
+#include "../../Texture.h"
+#include "EACBlock.h"
+
+namespace quicktex::etc {
+
+class EACEncoder : public BlockEncoder<BlockTexture<EACBlock>> {
+   public:
+    using ValueArray = std::array<uint8_t, 16>;
+    using Precision = EACBlock::Precision;
+
+    /// Highest quality level. Level 0 fits each modifier table to the range of the block, higher levels search around it
+    static constexpr unsigned max_level = 2;
+
+    /**
+     * @param channel the channel to encode, between 0 and 3 inclusive
+     * @param level the quality level. See SetLevel()
+     * @param precision how the encoded blocks will be decoded. R11 for R11 and RG11 textures, or Alpha for the alpha of ETC2 RGBA
+     */
+    EACEncoder(uint8_t channel, unsigned level = 1, Precision precision = Precision::R11) : _precision(precision) {
+        if (channel >= 4) throw std::invalid_argument("Channel out of range");
+        _channel = channel;
+        SetLevel(level);
+    }
+
+    EACBlock EncodeBlock(const ColorBlock<4, 4> &pixels) const override;
+
+    /// Encode a block from the 16 values of its channel, in row-major order
+    EACBlock EncodeValues(const ValueArray &values) const;
+
+    uint8_t GetChannel() const { return _channel; }
+    Precision GetPrecision() const { return _precision; }
+
+    unsigned GetLevel() const { return _level; }
+    void SetLevel(unsigned level) {
+        if (level > max_level) throw std::invalid_argument("Level out of range, must be between 0 and 2 inclusive");
+        _level = level;
+    }
+
+   private:
+    uint8_t _channel;
+    Precision _precision;
+    unsigned _level;
+};
+}  // namespace quicktex::etc
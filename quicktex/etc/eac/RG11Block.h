@@ -0,0 +1,72 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include "EACBlock.h"
+
+namespace quicktex::etc {
+
+/// A single RG11 block, made of two EAC blocks storing unsigned 11-bit red and green
+class alignas(8) RG11Block {
+   public:
+    static constexpr int Width = 4;
+    static constexpr int Height = 4;
+
+    using BlockPair = std::pair<EACBlock, EACBlock>;
+
+    EACBlock chan0_block;
+    EACBlock chan1_block;
+
+    constexpr RG11Block() : chan0_block(EACBlock()), chan1_block(EACBlock()) {
+        static_assert(sizeof(RG11Block) == 16);
+        static_assert(sizeof(std::array<RG11Block, 10>) == 16 * 10);
+        static_assert(alignof(RG11Block) >= 8);
+    }
+
+    RG11Block(const EACBlock &chan0, const EACBlock &chan1) {
+        chan0_block = chan0;
+        chan1_block = chan1;
+    }
+
+    BlockPair GetBlocks() const { return BlockPair(chan0_block, chan1_block); }
+
+    void SetBlocks(const BlockPair &pair) {
+        chan0_block = pair.first;
+        chan1_block = pair.second;
+    }
+
+    /// Flip the block vertically
+    void Flip() {
+        chan0_block.Flip();
+        chan1_block.Flip();
+    }
+
+    /// Mirror the block horizontally
+    void Mirror() {
+        chan0_block.Mirror();
+        chan1_block.Mirror();
+    }
+
+    bool operator==(const RG11Block &Rhs) const { return chan0_block == Rhs.chan0_block && chan1_block == Rhs.chan1_block; }
+    bool operator!=(const RG11Block &Rhs) const { return !(Rhs == *this); }
+};
+}  // namespace quicktex::etc
@@ -0,0 +1,52 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+
+#include "../../ColorBlock.h"
+#include "../../Decoder.h"
+#include "../../Texture.h"
+#include "EACDecoder.h"
+#include "RG11Block.h"
+
+namespace quicktex::etc {
+
+class RG11Decoder : public BlockDecoder<BlockTexture<RG11Block>> {
+   public:
+    using ChannelPair = std::tuple<uint8_t, uint8_t>;
+    using EACDecoderPtr = std::shared_ptr<EACDecoder>;
+    using EACDecoderPair = std::tuple<EACDecoderPtr, EACDecoderPtr>;
+
+    RG11Decoder(uint8_t chan0 = 0, uint8_t chan1 = 1) : RG11Decoder(std::make_shared<EACDecoder>(chan0), std::make_shared<EACDecoder>(chan1)) {}
+    RG11Decoder(EACDecoderPtr chan0_decoder, EACDecoderPtr chan1_decoder) : _chan0_decoder(chan0_decoder), _chan1_decoder(chan1_decoder) {}
+
+    ColorBlock<4, 4> DecodeBlock(const RG11Block &block) const override;
+
+    ChannelPair GetChannels() const { return ChannelPair(_chan0_decoder->GetChannel(), _chan1_decoder->GetChannel()); }
+
+    EACDecoderPair GetEACDecoders() const { return EACDecoderPair(_chan0_decoder, _chan1_decoder); }
+
+   private:
+    const EACDecoderPtr _chan0_decoder;
+    const EACDecoderPtr _chan1_decoder;
+};
+}  // namespace quicktex::etc
@@ -0,0 +1,52 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+
+#include "../../ColorBlock.h"
+#include "../../Encoder.h"
+#include "../../Texture.h"
+#include "EACEncoder.h"
+#include "RG11Block.h"
+
+namespace quicktex::etc {
+class RG11Encoder : public BlockEncoder<BlockTexture<RG11Block>> {
+   public:
+    using ChannelPair = std::tuple<uint8_t, uint8_t>;
+    using EACEncoderPtr = std::shared_ptr<EACEncoder>;
+    using EACEncoderPair = std::tuple<EACEncoderPtr, EACEncoderPtr>;
+
+    RG11Encoder(uint8_t chan0 = 0, uint8_t chan1 = 1, unsigned level = 1)
+        : RG11Encoder(std::make_shared<EACEncoder>(chan0, level), std::make_shared<EACEncoder>(chan1, level)) {}
+    RG11Encoder(EACEncoderPtr chan0_encoder, EACEncoderPtr chan1_encoder) : _chan0_encoder(chan0_encoder), _chan1_encoder(chan1_encoder) {}
+
+    RG11Block EncodeBlock(const ColorBlock<4, 4> &pixels) const override;
+
+    ChannelPair GetChannels() const { return ChannelPair(_chan0_encoder->GetChannel(), _chan1_encoder->GetChannel()); }
+
+    EACEncoderPair GetEACEncoders() const { return EACEncoderPair(_chan0_encoder, _chan1_encoder); }
+
+   private:
+    const EACEncoderPtr _chan0_encoder;
+    const EACEncoderPtr _chan1_encoder;
+};
+}  // namespace quicktex::etc
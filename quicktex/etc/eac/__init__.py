@@ -0,0 +1 @@
+from _quicktex._etc._eac import *
@@ -0,0 +1,228 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "../../_bindings.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "../../Decoder.h"
+#include "../../Encoder.h"
+#include "EACBlock.h"
+#include "EACDecoder.h"
+#include "EACEncoder.h"
+#include "RG11Decoder.h"
+#include "RG11Encoder.h"
+
+namespace py = pybind11;
+namespace quicktex::bindings {
+
+using namespace quicktex::etc;
+using namespace pybind11::literals;
+
+void InitEAC(py::module_ &etc) {
+    auto eac = etc.def_submodule("_eac", "internal eac module");
+
+    // region EACBlock
+    auto eac_block = BindBlock<EACBlock>(eac, "EACBlock");
+    eac_block.doc() = "A single EAC block, storing one channel as 8-bit alpha or unsigned 11-bit values.";
+
+    py::enum_<EACBlock::Precision>(eac_block, "Precision", "Enum representing how EAC blocks are decoded, which isn't stored in the blocks themselves.")
+        .value("Alpha", EACBlock::Precision::Alpha, "8-bit values, used for the alpha channel of ETC2 RGBA textures.")
+        .value("R11", EACBlock::Precision::R11, "Unsigned 11-bit values, used for R11 and RG11 textures.");
+
+    eac_block.def(py::init<>());
+    eac_block.def(py::init<uint8_t, unsigned, unsigned, EACBlock::SelectorArray>(), "base"_a, "multiplier"_a, "table"_a, "selectors"_a, R"doc(
+        Create a new EACBlock with the specified base value, multiplier, modifier table and selectors.
+
+        :param int base: The base value, between 0 and 255 inclusive.
+        :param int multiplier: The multiplier of the modifier table, between 0 and 15 inclusive.
+        :param int table: The index of the modifier table, between 0 and 15 inclusive.
+        :param selectors: the selectors as a 4x4 list of integers, between 0 and 7 inclusive.
+    )doc");
+
+    eac_block.def_property("base", &EACBlock::GetBase, &EACBlock::SetBase, "The block's base value, between 0 and 255 inclusive.");
+    eac_block.def_property("multiplier", &EACBlock::GetMultiplier, &EACBlock::SetMultiplier, R"doc(
+        The multiplier of the block's modifier table, between 0 and 15 inclusive.
+        Alpha blocks with a multiplier of 0 are a single value, and R11 blocks use the modifiers unscaled.
+    )doc");
+    eac_block.def_property("table", &EACBlock::GetTable, &EACBlock::SetTable, "The index of the block's modifier table, between 0 and 15 inclusive.");
+    eac_block.def_property("selectors", &EACBlock::GetSelectors, &EACBlock::SetSelectors, R"doc(
+        The block's selectors as a 4x4 list of integers between 0 and 7 inclusive.
+
+        .. note::
+            This is a property, so directly modifying its value will not propogate back to the block.
+            Instead you must read, modify, then write the new list back to the property.
+    )doc");
+    eac_block.def_property_readonly("alpha_values", &EACBlock::GetAlphaValues, R"doc(
+        The 8-bit values used to decode the block as alpha, coresponding with the indices in :py:attr:`selectors`. Readonly.
+    )doc");
+    eac_block.def_property_readonly("r11_values", &EACBlock::GetR11Values, R"doc(
+        The 11-bit values used to decode the block as R11, coresponding with the indices in :py:attr:`selectors`. Readonly.
+    )doc");
+    // endregion
+
+    // region EACTexture
+    auto eac_texture = BindBlockTexture<EACBlock>(eac, "EACTexture");
+    eac_texture.doc() = "A texture comprised of EAC blocks, such as an R11 texture.";
+    // endregion
+
+    // region EACEncoder
+    py::class_<EACEncoder, std::shared_ptr<EACEncoder>> eac_encoder(eac, "EACEncoder", R"doc(
+        Encodes single-channel textures to EAC, for R11 textures or the alpha of ETC2 RGBA textures.
+    )doc");
+
+    eac_encoder.def(py::init<uint8_t, unsigned, EACBlock::Precision>(), "channel"_a = 0, "level"_a = 1, "precision"_a = EACBlock::Precision::R11, R"doc(
+        Create a new EAC encoder with the specified channel, quality level and precision
+
+        :param int channel: the channel that will be read from. 0 to 3 inclusive. Default: 0 (red).
+        :param int level: The quality level of the encoder. 0 to :py:const:`EACEncoder.max_level` inclusive. See :py:attr:`level`. Default: 1.
+        :param EACBlock.Precision precision: How the blocks will be decoded. Default: R11.
+    )doc");
+
+    DefEncode(eac_encoder, "EACTexture", [](const EACEncoder &self) {
+        return std::make_pair(EACDecoder(self.GetChannel(), self.GetPrecision()), 1U << self.GetChannel());
+    });
+
+    DefEncodeInto(eac_encoder);
+    DefEncodeBatch(eac_encoder);
+    DefEncodeMulti(eac_encoder);
+    DefEncodeStream(eac_encoder);
+
+    eac_encoder.def_property_readonly("channel", &EACEncoder::GetChannel, "The channel that will be read from. 0 to 3 inclusive. Readonly.");
+    eac_encoder.def_property_readonly("precision", &EACEncoder::GetPrecision, "How the encoded blocks will be decoded. Readonly.");
+    eac_encoder.def_readonly_static("max_level", &EACEncoder::max_level);
+    eac_encoder.def_property("level", &EACEncoder::GetLevel, &EACEncoder::SetLevel, R"doc(
+        The quality level of the encoder, between 0 and :py:const:`EACEncoder.max_level` inclusive.
+
+        Level 0 fits each of the 16 modifier tables to the range of the block, and keeps the best one.
+        Level 1 also searches the neighbouring base values and multipliers, and level 2 refines the base by least squares.
+    )doc");
+    // endregion
+
+    // region EACDecoder
+    py::class_<EACDecoder, std::shared_ptr<EACDecoder>> eac_decoder(eac, "EACDecoder", R"doc(
+        Decodes EAC textures to a single channel.
+    )doc");
+
+    eac_decoder.def(py::init<uint8_t, EACBlock::Precision>(), "channel"_a = 0, "precision"_a = EACBlock::Precision::R11, R"doc(
+        Create a new EAC decoder with the specified channel and precision
+
+        :param int channel: The channel that will be written to. 0 to 3 inclusive. Default: 0 (red).
+        :param EACBlock.Precision precision: How to decode blocks. R11 values are rounded to the nearest 8-bit value. Default: R11.
+    )doc");
+
+    eac_decoder.def("decode", &EACDecoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Decode an EAC texture into a new RawTexture using the decoder's current settings.
+
+        :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
+        :returns: A new RawTexture with the same dimensions as the input
+    )doc");
+
+    DefCompare(eac_decoder, [](const EACDecoder &self) { return 1U << self.GetChannel(); });
+
+    eac_decoder.def_property_readonly("channel", &EACDecoder::GetChannel, "The channel that will be written to. 0 to 3 inclusive. Readonly.");
+    eac_decoder.def_property_readonly("precision", &EACDecoder::GetPrecision, "How blocks are decoded. Readonly.");
+    // endregion
+
+    // region RG11Block
+    auto rg11_block = BindBlock<RG11Block>(eac, "RG11Block");
+    rg11_block.doc() = "A single RG11 block.";
+
+    rg11_block.def(py::init<>());
+    rg11_block.def(py::init<EACBlock, EACBlock>(), "chan0_block"_a, "chan1_block"_a, R"doc(
+        Create a new RG11Block out of two EAC blocks.
+
+        :param EACBlock chan0_block: The EAC block used for the first channel.
+        :param EACBlock chan1_block: The EAC block used for the second channel.
+    )doc");
+
+    rg11_block.def_readwrite("chan0_block", &RG11Block::chan0_block, "The EAC block used for the first channel.");
+    rg11_block.def_readwrite("chan1_block", &RG11Block::chan1_block, "The EAC block used for the second channel.");
+    rg11_block.def_property("blocks", &RG11Block::GetBlocks, &RG11Block::SetBlocks, "The EAC blocks that make up this block as a 2-tuple.");
+    // endregion
+
+    // region RG11Texture
+    auto rg11_texture = BindBlockTexture<RG11Block>(eac, "RG11Texture");
+    rg11_texture.doc() = "A texture comprised of RG11 blocks.";
+    // endregion
+
+    // region RG11Encoder
+    py::class_<RG11Encoder> rg11_encoder(eac, "RG11Encoder", R"doc(
+        Encodes dual-channel textures to RG11.
+    )doc");
+
+    rg11_encoder.def(py::init<uint8_t, uint8_t, unsigned>(), "chan0"_a = 0, "chan1"_a = 1, "level"_a = 1, R"doc(
+        Create a new RG11 encoder with the specified channels and quality level
+
+        :param int chan0: the first channel that will be read from. 0 to 3 inclusive. Default: 0 (red).
+        :param int chan1: the second channel that will be read from. 0 to 3 inclusive. Default: 1 (green).
+        :param int level: The quality level of both channels' encoders. See :py:attr:`EACEncoder.level`. Default: 1.
+    )doc");
+
+    DefEncode(rg11_encoder, "RG11Texture", [](const RG11Encoder &self) {
+        auto [chan0, chan1] = self.GetChannels();
+        return std::make_pair(RG11Decoder(chan0, chan1), (1U << chan0) | (1U << chan1));
+    });
+
+    DefEncodeInto(rg11_encoder);
+    DefEncodeBatch(rg11_encoder);
+    DefEncodeMulti(rg11_encoder);
+    DefEncodeStream(rg11_encoder);
+
+    rg11_encoder.def_property_readonly("channels", &RG11Encoder::GetChannels, "A 2-tuple of channels that will be read from. 0 to 3 inclusive. Readonly.");
+    rg11_encoder.def_property_readonly("eac_encoders", &RG11Encoder::GetEACEncoders,
+                                       "2-tuple of internal :py:class:`~quicktex.etc.eac.EACEncoder` s used for each channel. Readonly.");
+    // endregion
+
+    // region RG11Decoder
+    py::class_<RG11Decoder> rg11_decoder(eac, "RG11Decoder", R"doc(
+        Decodes RG11 textures to two channels.
+    )doc");
+
+    rg11_decoder.def(py::init<uint8_t, uint8_t>(), "chan0"_a = 0, "chan1"_a = 1, R"doc(
+        Create a new RG11 decoder with the specified channels
+
+        :param int chan0: the first channel that will be written to. 0 to 3 inclusive. Default: 0 (red).
+        :param int chan1: the second channel that will be written to. 0 to 3 inclusive. Default: 1 (green).
+    )doc");
+
+    rg11_decoder.def("decode", &RG11Decoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Decode an RG11 texture into a new RawTexture using the decoder's current settings.
+
+        :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
+        :returns: A new RawTexture with the same dimensions as the input
+    )doc");
+
+    DefCompare(rg11_decoder, [](const RG11Decoder &self) {
+        auto [chan0, chan1] = self.GetChannels();
+        return (1U << chan0) | (1U << chan1);
+    });
+
+    rg11_decoder.def_property_readonly("channels", &RG11Decoder::GetChannels, "A 2-tuple of channels that will be written to. 0 to 3 inclusive. Readonly.");
+    rg11_decoder.def_property_readonly("eac_decoders", &RG11Decoder::GetEACDecoders,
+                                       "2-tuple of internal :py:class:`~quicktex.etc.eac.EACDecoder` s used for each channel. Readonly.");
+    // endregion
+}
+}  // namespace quicktex::bindings
@@ -0,0 +1,357 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "ETC2Block.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace quicktex::etc {
+
+namespace {
+using Mode = ETC2Block::Mode;
+
+constexpr uint64_t Get(uint64_t bits, unsigned shift, unsigned count) { return (bits >> shift) & ((1ULL << count) - 1); }
+constexpr void Set(uint64_t &bits, unsigned shift, uint64_t value) { bits |= value << shift; }
+
+// sign-extend a 3-bit delta from a differential block
+constexpr int Delta(uint64_t value) { return static_cast<int>(value) - ((value & 4) ? 8 : 0); }
+
+// Overflowing the 5-bit base plus 3-bit delta of a channel is what selects the T, H and planar modes. When the low 2 bits of the base (a)
+// and of the delta (c) are used by the mode, the remaining 3 high bits of the base and 1 high bit of the delta are chosen to always overflow
+void SetOverflow(uint64_t &bits, unsigned base_shift, unsigned delta_shift, uint64_t a, uint64_t c) {
+    if (a + c < 4) {
+        Set(bits, delta_shift + 2, 1);  // 000aa + 1cc < 0
+    } else {
+        Set(bits, base_shift + 2, 7);  // 111aa + 0cc > 31
+    }
+}
+
+// When a channel's base is a 4-bit field and its delta is a full 3-bit field, the base's remaining high bit is chosen to never overflow
+void SetNoOverflow(uint64_t &bits, unsigned base_shift, uint64_t base, uint64_t delta) {
+    if (static_cast<int>(base) + Delta(delta) < 0) Set(bits, base_shift + 4, 1);
+}
+
+unsigned Pack444(const ETC2Block::Color3 &c) { return (static_cast<unsigned>(c[0]) << 8) | (static_cast<unsigned>(c[1]) << 4) | c[2]; }
+
+void CheckRange(const ETC2Block::Color3 &color, unsigned bits) {
+    if (std::any_of(color.begin(), color.end(), [bits](uint8_t c) { return c >= (1U << bits); }))
+        throw std::invalid_argument("ETC2 color out of range for block mode");
+}
+
+// Index of the pixel at x, y in the least significant 16 bits of the index data
+constexpr unsigned IndexShift(unsigned i) { return (i % 4) * 4 + (i / 4); }
+
+// Remap an unpacked block's indices and swap its subblocks if they change places, for flipping or mirroring.
+// Vertical flips swap stacked subblocks, and horizontal mirrors swap side-by-side ones
+ETC2Block::Unpacked Transform(const ETC2Block::Unpacked &unpacked, bool vertical) {
+    auto moved = unpacked;
+    if (unpacked.mode == Mode::Planar) return moved;  // only transformed when the gradient is symmetric, which leaves the block unchanged
+
+    for (unsigned y = 0; y < 4; y++) {
+        for (unsigned x = 0; x < 4; x++) {
+            const unsigned src = vertical ? (3 - y) * 4 + x : y * 4 + (3 - x);
+            moved.indices[y * 4 + x] = unpacked.indices[src];
+        }
+    }
+
+    if ((unpacked.mode == Mode::Individual || unpacked.mode == Mode::Differential) && unpacked.flip == vertical) {
+        std::swap(moved.colors[0], moved.colors[1]);
+        std::swap(moved.tables[0], moved.tables[1]);
+    }
+    return moved;
+}
+
+bool CanTransform(const ETC2Block::Unpacked &unpacked, bool vertical) {
+    switch (unpacked.mode) {
+        case Mode::Differential:
+            // swapping subblocks negates the delta, and +4 can't be stored
+            if (unpacked.flip != vertical) return true;
+            for (unsigned c = 0; c < 3; c++) {
+                if (unpacked.colors[1][c] - unpacked.colors[0][c] == -4) return false;
+            }
+            return true;
+        case Mode::Planar:
+            return unpacked.colors[vertical ? 2 : 1] == unpacked.colors[0];
+        default:
+            return true;
+    }
+}
+}  // namespace
+
+uint64_t ETC2Block::GetBits() const {
+    uint64_t bits = 0;
+    for (auto byte : _bytes) bits = (bits << 8) | byte;
+    return bits;
+}
+
+void ETC2Block::SetBits(uint64_t bits) {
+    for (unsigned i = 8; i-- > 0;) {
+        _bytes[i] = static_cast<uint8_t>(bits);
+        bits >>= 8;
+    }
+}
+
+ETC2Block::Mode ETC2Block::GetMode() const {
+    const uint64_t bits = GetBits();
+    if (Get(bits, 33, 1) == 0) return Mode::Individual;
+
+    const auto overflows = [bits](unsigned shift) {
+        const int sum = static_cast<int>(Get(bits, shift + 3, 5)) + Delta(Get(bits, shift, 3));
+        return sum < 0 || sum > 31;
+    };
+    if (overflows(56)) return Mode::T;
+    if (overflows(48)) return Mode::H;
+    if (overflows(40)) return Mode::Planar;
+    return Mode::Differential;
+}
+
+ETC2Block::Unpacked ETC2Block::Unpack() const {
+    const uint64_t bits = GetBits();
+    const auto u8 = [](uint64_t v) { return static_cast<uint8_t>(v); };
+
+    Unpacked unpacked;
+    unpacked.mode = GetMode();
+
+    switch (unpacked.mode) {
+        case Mode::Individual:
+            for (unsigned c = 0; c < 3; c++) {
+                unpacked.colors[0][c] = u8(Get(bits, 60 - 8 * c, 4));
+                unpacked.colors[1][c] = u8(Get(bits, 56 - 8 * c, 4));
+            }
+            break;
+        case Mode::Differential:
+            for (unsigned c = 0; c < 3; c++) {
+                const uint64_t base = Get(bits, 59 - 8 * c, 5);
+                unpacked.colors[0][c] = u8(base);
+                unpacked.colors[1][c] = u8(static_cast<int>(base) + Delta(Get(bits, 56 - 8 * c, 3)));
+            }
+            break;
+        case Mode::T:
+            unpacked.colors[0] = {u8(Get(bits, 59, 2) << 2 | Get(bits, 56, 2)), u8(Get(bits, 52, 4)), u8(Get(bits, 48, 4))};
+            unpacked.colors[1] = {u8(Get(bits, 44, 4)), u8(Get(bits, 40, 4)), u8(Get(bits, 36, 4))};
+            unpacked.distance = u8(Get(bits, 34, 2) << 1 | Get(bits, 32, 1));
+            break;
+        case Mode::H:
+            unpacked.colors[0] = {u8(Get(bits, 59, 4)), u8(Get(bits, 56, 3) << 1 | Get(bits, 52, 1)), u8(Get(bits, 51, 1) << 3 | Get(bits, 47, 3))};
+            unpacked.colors[1] = {u8(Get(bits, 43, 4)), u8(Get(bits, 39, 4)), u8(Get(bits, 35, 4))};
+            unpacked.distance = u8(Get(bits, 34, 1) << 2 | Get(bits, 32, 1) << 1 | (Pack444(unpacked.colors[0]) >= Pack444(unpacked.colors[1])));
+            break;
+        case Mode::Planar:
+            unpacked.colors[0] = {u8(Get(bits, 57, 6)), u8(Get(bits, 56, 1) << 6 | Get(bits, 49, 6)),
+                                  u8(Get(bits, 48, 1) << 5 | Get(bits, 43, 2) << 3 | Get(bits, 39, 3))};
+            unpacked.colors[1] = {u8(Get(bits, 34, 5) << 1 | Get(bits, 32, 1)), u8(Get(bits, 25, 7)), u8(Get(bits, 19, 6))};
+            unpacked.colors[2] = {u8(Get(bits, 13, 6)), u8(Get(bits, 6, 7)), u8(Get(bits, 0, 6))};
+            return unpacked;
+    }
+
+    if (unpacked.mode == Mode::Individual || unpacked.mode == Mode::Differential) {
+        unpacked.tables = {u8(Get(bits, 37, 3)), u8(Get(bits, 34, 3))};
+        unpacked.flip = Get(bits, 32, 1);
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        const unsigned shift = IndexShift(i);
+        unpacked.indices[i] = u8(Get(bits, 16 + shift, 1) << 1 | Get(bits, shift, 1));
+    }
+    return unpacked;
+}
+
+void ETC2Block::Pack(Unpacked unpacked) {
+    uint64_t bits = 0;
+
+    if (std::any_of(unpacked.indices.begin(), unpacked.indices.end(), [](uint8_t i) { return i > 3; }))
+        throw std::invalid_argument("ETC2 index out of range, must be between 0 and 3 inclusive");
+    if (unpacked.tables[0] > 7 || unpacked.tables[1] > 7) throw std::invalid_argument("ETC2 table out of range, must be between 0 and 7 inclusive");
+    if (unpacked.distance > 7) throw std::invalid_argument("ETC2 distance out of range, must be between 0 and 7 inclusive");
+
+    switch (unpacked.mode) {
+        case Mode::Individual:
+            CheckRange(unpacked.colors[0], 4);
+            CheckRange(unpacked.colors[1], 4);
+            for (unsigned c = 0; c < 3; c++) {
+                Set(bits, 60 - 8 * c, unpacked.colors[0][c]);
+                Set(bits, 56 - 8 * c, unpacked.colors[1][c]);
+            }
+            break;
+        case Mode::Differential:
+            CheckRange(unpacked.colors[0], 5);
+            CheckRange(unpacked.colors[1], 5);
+            for (unsigned c = 0; c < 3; c++) {
+                const int delta = unpacked.colors[1][c] - unpacked.colors[0][c];
+                if (delta < -4 || delta > 3) throw std::invalid_argument("ETC2 differential colors too far apart, must be within -4 and +3");
+                Set(bits, 59 - 8 * c, unpacked.colors[0][c]);
+                Set(bits, 56 - 8 * c, static_cast<uint64_t>(delta) & 7);
+            }
+            Set(bits, 33, 1);
+            break;
+        case Mode::T: {
+            const auto &c1 = unpacked.colors[0], &c2 = unpacked.colors[1];
+            CheckRange(c1, 4);
+            CheckRange(c2, 4);
+            Set(bits, 59, c1[0] >> 2);
+            Set(bits, 56, c1[0] & 3);
+            SetOverflow(bits, 59, 56, c1[0] >> 2, c1[0] & 3);
+            Set(bits, 52, c1[1]);
+            Set(bits, 48, c1[2]);
+            Set(bits, 44, c2[0]);
+            Set(bits, 40, c2[1]);
+            Set(bits, 36, c2[2]);
+            Set(bits, 34, unpacked.distance >> 1);
+            Set(bits, 33, 1);
+            Set(bits, 32, unpacked.distance & 1);
+            break;
+        }
+        case Mode::H: {
+            CheckRange(unpacked.colors[0], 4);
+            CheckRange(unpacked.colors[1], 4);
+            // the lowest bit of the distance is stored in the order of the colors
+            if ((Pack444(unpacked.colors[0]) >= Pack444(unpacked.colors[1])) != (unpacked.distance & 1)) {
+                if (unpacked.colors[0] == unpacked.colors[1]) throw std::invalid_argument("ETC2 H-mode block with equal colors must have an odd distance");
+                std::swap(unpacked.colors[0], unpacked.colors[1]);
+                for (auto &index : unpacked.indices) index ^= 2;
+            }
+
+            const auto &c1 = unpacked.colors[0], &c2 = unpacked.colors[1];
+            Set(bits, 59, c1[0]);
+            Set(bits, 56, c1[1] >> 1);
+            SetNoOverflow(bits, 59, c1[0], c1[1] >> 1);
+            Set(bits, 52, c1[1] & 1);
+            Set(bits, 51, c1[2] >> 3);
+            Set(bits, 47, c1[2] & 7);
+            SetOverflow(bits, 51, 48, (c1[1] & 1) << 1 | c1[2] >> 3, (c1[2] & 7) >> 1);
+            Set(bits, 43, c2[0]);
+            Set(bits, 39, c2[1]);
+            Set(bits, 35, c2[2]);
+            Set(bits, 34, unpacked.distance >> 2);
+            Set(bits, 33, 1);
+            Set(bits, 32, (unpacked.distance >> 1) & 1);
+            break;
+        }
+        case Mode::Planar: {
+            const auto &o = unpacked.colors[0], &h = unpacked.colors[1], &v = unpacked.colors[2];
+            for (const auto &color : unpacked.colors) {
+                if (color[0] >= 64 || color[1] >= 128 || color[2] >= 64) throw std::invalid_argument("ETC2 color out of range for block mode");
+            }
+            Set(bits, 57, o[0]);
+            SetNoOverflow(bits, 59, o[0] >> 2, (o[0] & 3) << 1 | o[1] >> 6);
+            Set(bits, 56, o[1] >> 6);
+            Set(bits, 49, o[1] & 0x3F);
+            SetNoOverflow(bits, 51, (o[1] >> 2) & 0xF, (o[1] & 3) << 1 | o[2] >> 5);
+            Set(bits, 48, o[2] >> 5);
+            Set(bits, 43, (o[2] >> 3) & 3);
+            Set(bits, 39, o[2] & 7);
+            SetOverflow(bits, 43, 40, (o[2] >> 3) & 3, (o[2] & 7) >> 1);
+            Set(bits, 34, h[0] >> 1);
+            Set(bits, 33, 1);
+            Set(bits, 32, h[0] & 1);
+            Set(bits, 25, h[1]);
+            Set(bits, 19, h[2]);
+            Set(bits, 13, v[0]);
+            Set(bits, 6, v[1]);
+            Set(bits, 0, v[2]);
+            SetBits(bits);
+            return;
+        }
+        default:
+            throw std::invalid_argument("Invalid ETC2 mode");
+    }
+
+    if (unpacked.mode == Mode::Individual || unpacked.mode == Mode::Differential) {
+        Set(bits, 37, unpacked.tables[0]);
+        Set(bits, 34, unpacked.tables[1]);
+        Set(bits, 32, unpacked.flip);
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        const unsigned shift = IndexShift(i);
+        Set(bits, 16 + shift, unpacked.indices[i] >> 1);
+        Set(bits, shift, unpacked.indices[i] & 1);
+    }
+    SetBits(bits);
+}
+
+std::array<Color, 16> ETC2Block::GetColors() const {
+    const auto unpacked = Unpack();
+    const auto color = [](int r, int g, int b) { return Color(std::clamp(r, 0, 255), std::clamp(g, 0, 255), std::clamp(b, 0, 255)); };
+    const auto shift = [&color](const Color3 &c, int d) { return color(Expand(c[0], 4) + d, Expand(c[1], 4) + d, Expand(c[2], 4) + d); };
+
+    std::array<Color, 16> colors;
+    switch (unpacked.mode) {
+        case Mode::Individual:
+        case Mode::Differential: {
+            const unsigned bits = unpacked.mode == Mode::Individual ? 4 : 5;
+            for (unsigned i = 0; i < 16; i++) {
+                const unsigned subblock = unpacked.flip ? (i / 4 >= 2) : (i % 4 >= 2);
+                const auto &base = unpacked.colors[subblock];
+                const auto &table = Tables[unpacked.tables[subblock]];
+                const uint8_t index = unpacked.indices[i];
+                const int modifier = (index & 2) ? -table[index & 1] : table[index & 1];
+                colors[i] = color(Expand(base[0], bits) + modifier, Expand(base[1], bits) + modifier, Expand(base[2], bits) + modifier);
+            }
+            return colors;
+        }
+        case Mode::T:
+        case Mode::H: {
+            const int d = Distances[unpacked.distance];
+            const auto &c1 = unpacked.colors[0], &c2 = unpacked.colors[1];
+            std::array<Color, 4> paints;
+            if (unpacked.mode == Mode::T) {
+                paints = {shift(c1, 0), shift(c2, d), shift(c2, 0), shift(c2, -d)};
+            } else {
+                paints = {shift(c1, d), shift(c1, -d), shift(c2, d), shift(c2, -d)};
+            }
+            for (unsigned i = 0; i < 16; i++) colors[i] = paints[unpacked.indices[i]];
+            return colors;
+        }
+        case Mode::Planar: {
+            std::array<std::array<int, 3>, 3> expanded;
+            for (unsigned p = 0; p < 3; p++) {
+                const auto &c = unpacked.colors[p];
+                expanded[p] = {Expand(c[0], 6), Expand(c[1], 7), Expand(c[2], 6)};
+            }
+            const auto &[o, h, v] = expanded;
+            for (int y = 0; y < 4; y++) {
+                for (int x = 0; x < 4; x++) {
+                    std::array<int, 3> c;
+                    for (unsigned ch = 0; ch < 3; ch++) c[ch] = (x * (h[ch] - o[ch]) + y * (v[ch] - o[ch]) + 4 * o[ch] + 2) >> 2;
+                    colors[static_cast<unsigned>(y * 4 + x)] = color(c[0], c[1], c[2]);
+                }
+            }
+            return colors;
+        }
+    }
+    return colors;
+}
+
+bool ETC2Block::CanFlip() const { return CanTransform(Unpack(), true); }
+bool ETC2Block::CanMirror() const { return CanTransform(Unpack(), false); }
+
+void ETC2Block::Flip() {
+    const auto unpacked = Unpack();
+    if (!CanTransform(unpacked, true)) throw std::invalid_argument("ETC2 block can't be flipped losslessly");
+    Pack(Transform(unpacked, true));
+}
+
+void ETC2Block::Mirror() {
+    const auto unpacked = Unpack();
+    if (!CanTransform(unpacked, false)) throw std::invalid_argument("ETC2 block can't be mirrored losslessly");
+    Pack(Transform(unpacked, false));
+}
+}  // namespace quicktex::etc
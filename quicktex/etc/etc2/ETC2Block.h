@@ -0,0 +1,128 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../../Color.h"
+
+namespace quicktex::etc {
+
+/// A single ETC2 RGB block. ETC1 blocks are ETC2 blocks that only use the individual and differential modes
+class alignas(8) ETC2Block {
+   public:
+    static constexpr size_t Width = 4;
+    static constexpr size_t Height = 4;
+
+    enum class Mode : uint8_t {
+        Individual,    // two 2x4 or 4x2 subblocks with 4-bit base colors, shifted by a modifier table. Also in ETC1
+        Differential,  // the same as individual, with 5-bit base colors where the second is stored as a delta from the first. Also in ETC1
+        T,             // one color, and three colors along a line through another color
+        H,             // two pairs of colors, one on each side of two colors
+        Planar,        // a gradient across the whole block
+    };
+
+    /// Modifier tables of the individual and differential modes. Each pixel adds +a, +b, -a or -b to every channel of its subblock's base color
+    static constexpr std::array<std::array<int, 2>, 8> Tables = {{{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}}};
+
+    /// Distances of the T and H modes, which are added to and subtracted from every channel of a color
+    static constexpr std::array<int, 8> Distances = {3, 6, 11, 16, 23, 32, 41, 64};
+
+    /// Expand a color channel stored with 4 to 7 bits to 8 bits, by repeating its high bits in the low bits
+    static constexpr int Expand(int value, unsigned bits) { return (value << (8 - bits)) | (value >> (2 * bits - 8)); }
+
+    using Color3 = std::array<uint8_t, 3>;
+    using IndexArray = std::array<uint8_t, 16>;
+
+    struct Unpacked {
+        Mode mode = Mode::Individual;
+
+        /// Individual and differential modes: if true the subblocks are stacked 4x2 halves, otherwise they are side-by-side 2x4 halves
+        bool flip = false;
+
+        /// Colors at the precision they are stored with. Two 4-bit base colors in individual mode, two 5-bit base colors in differential mode,
+        /// two 4-bit colors in T and H modes, or the 6/7/6-bit colors at the origin, right edge and bottom edge in planar mode
+        std::array<Color3, 3> colors = {};
+
+        /// Individual and differential modes: the modifier table of each subblock
+        std::array<uint8_t, 2> tables = {};
+
+        /// T and H modes: the index of the distance
+        uint8_t distance = 0;
+
+        /// 2-bit index of each pixel in row-major order. In the individual and differential modes these select +a, +b, -a or -b,
+        /// and in the T and H modes they select one of four colors. Unused in planar mode
+        IndexArray indices = {};
+    };
+
+    /// Create a new ETC2Block. All of its bits are zero, which is an individual mode block that decodes to a gray of 2
+    constexpr ETC2Block() : _bytes() {
+        static_assert(sizeof(ETC2Block) == 8);
+        static_assert(sizeof(std::array<ETC2Block, 10>) == 8 * 10);
+        static_assert(alignof(ETC2Block) >= 8);
+    }
+
+    explicit ETC2Block(const Unpacked& unpacked) : _bytes() { Pack(unpacked); }
+
+    Mode GetMode() const;
+
+    /// Unpack the block's fields from its bitstream
+    Unpacked Unpack() const;
+
+    /**
+     * Pack fields into the block's bitstream
+     * @throws std::invalid_argument if a field is out of range, if the base colors of a differential block are too far apart,
+     * or if an H block's distance is even and its colors are equal. The low bit of an H block's distance is stored in the order of its colors,
+     * so they are swapped along with the indices when needed
+     */
+    void Pack(Unpacked unpacked);
+
+    /// The decoded color of every pixel in row-major order, with an alpha of 255
+    std::array<Color, 16> GetColors() const;
+
+    /// True if the block can be flipped losslessly. Planar blocks with a vertical gradient, and some differential blocks, can't be
+    bool CanFlip() const;
+
+    /// True if the block can be mirrored losslessly. Planar blocks with a horizontal gradient, and some differential blocks, can't be
+    bool CanMirror() const;
+
+    /**
+     * Flip the block vertically
+     * @throws std::invalid_argument if the block can't be flipped. See CanFlip()
+     */
+    void Flip();
+
+    /**
+     * Mirror the block horizontally
+     * @throws std::invalid_argument if the block can't be mirrored. See CanMirror()
+     */
+    void Mirror();
+
+    bool operator==(const ETC2Block& Rhs) const { return _bytes == Rhs._bytes; }
+    bool operator!=(const ETC2Block& Rhs) const { return !(Rhs == *this); }
+
+   private:
+    std::array<uint8_t, 8> _bytes;  // big-endian 64-bit value
+
+    uint64_t GetBits() const;
+    void SetBits(uint64_t bits);
+};
+}  // namespace quicktex::etc
@@ -0,0 +1,33 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include "../../ColorBlock.h"
+#include "../../Decoder.h"
+#include "../../Texture.h"
+#include "ETC2Block.h"
+
+namespace quicktex::etc {
+
+class ETC2Decoder final : public BlockDecoder<BlockTexture<ETC2Block>> {
+   public:
+    /// Decode a block, with an alpha of 255. ETC1 blocks decode the same as they would with an ETC1 decoder
+    ColorBlock<4, 4> DecodeBlock(const ETC2Block &block) const override;
+};
+}  // namespace quicktex::etc
@@ -0,0 +1,560 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "ETC2Encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "../../Color.h"
+#include "../../ColorBlock.h"
+#include "ETC2Block.h"
+
+namespace quicktex::etc {
+
+namespace {
+using Mode = ETC2Block::Mode;
+using Color3 = ETC2Block::Color3;
+using Unpacked = ETC2Block::Unpacked;
+using Pixel = std::array<int, 3>;
+using Pixels = std::array<Pixel, 16>;
+using Center = std::array<float, 3>;
+using Members = std::array<uint8_t, 8>;
+
+// Every color within the largest radius of a center, and every split of the block into two groups
+constexpr unsigned max_neighbors = (2 * ETC2Encoder::max_color_radius + 1) * (2 * ETC2Encoder::max_color_radius + 1) * (2 * ETC2Encoder::max_color_radius + 1);
+constexpr unsigned max_splits = 15;
+
+struct Candidate {
+    Unpacked unpacked;
+    unsigned error = UINT_MAX;
+};
+
+void Consider(Candidate &best, const Unpacked &unpacked, unsigned error) {
+    if (error < best.error) best = {unpacked, error};
+}
+
+unsigned Error(const Pixel &a, const Pixel &b) {
+    unsigned error = 0;
+    for (unsigned c = 0; c < 3; c++) {
+        const int diff = a[c] - b[c];
+        error += static_cast<unsigned>(diff * diff);
+    }
+    return error;
+}
+
+Pixel Expand(const Color3 &color, unsigned bits) {
+    return {ETC2Block::Expand(color[0], bits), ETC2Block::Expand(color[1], bits), ETC2Block::Expand(color[2], bits)};
+}
+
+Pixel Shift(const Pixel &color, int d) { return {std::clamp(color[0] + d, 0, 255), std::clamp(color[1] + d, 0, 255), std::clamp(color[2] + d, 0, 255)}; }
+
+int Modifier(const std::array<int, 2> &table, uint8_t index) { return (index & 2) ? -table[index & 1] : table[index & 1]; }
+
+// The closest stored value to an 8-bit value, for a channel stored with the given number of bits
+int Quantize(float value, unsigned bits) {
+    const int max = (1 << bits) - 1;
+    return std::clamp(static_cast<int>(std::lround(value * static_cast<float>(max) / 255.0f)), 0, max);
+}
+
+Color3 Quantize(const Center &center, unsigned bits) {
+    return {static_cast<uint8_t>(Quantize(center[0], bits)), static_cast<uint8_t>(Quantize(center[1], bits)), static_cast<uint8_t>(Quantize(center[2], bits))};
+}
+
+Center Mean(const Pixels &pixels, uint16_t mask) {
+    Center mean = {};
+    unsigned count = 0;
+    for (unsigned i = 0; i < 16; i++) {
+        if (((mask >> i) & 1) == 0) continue;
+        for (unsigned c = 0; c < 3; c++) mean[c] += static_cast<float>(pixels[i][c]);
+        count++;
+    }
+    for (auto &m : mean) m /= static_cast<float>(std::max(count, 1U));
+    return mean;
+}
+
+// Every color within a radius of the closest one to a center, skipping any out of range. Returns the number of colors written
+unsigned Neighborhood(const Center &center, unsigned bits, unsigned radius, std::array<Color3, max_neighbors> &colors) {
+    const int max = (1 << bits) - 1;
+    const int r = static_cast<int>(radius);
+    const auto closest = Quantize(center, bits);
+
+    unsigned count = 0;
+    for (int dr = -r; dr <= r; dr++) {
+        for (int dg = -r; dg <= r; dg++) {
+            for (int db = -r; db <= r; db++) {
+                const Pixel color = {closest[0] + dr, closest[1] + dg, closest[2] + db};
+                if (std::any_of(color.begin(), color.end(), [max](int c) { return c < 0 || c > max; })) continue;
+                colors[count++] = {static_cast<uint8_t>(color[0]), static_cast<uint8_t>(color[1]), static_cast<uint8_t>(color[2])};
+            }
+        }
+    }
+    return count;
+}
+
+// region individual and differential modes
+
+// A base color for one subblock, with the modifier table and indices that fit it best
+struct SubblockFit {
+    Color3 base = {};
+    uint8_t table = 0;
+    std::array<uint8_t, 8> indices = {};  // in the order of the subblock's members
+    unsigned error = UINT_MAX;
+};
+
+// Fits of one subblock to each color in a neighborhood
+using Fits = std::array<SubblockFit, max_neighbors>;
+
+SubblockFit FitSubblock(const Pixels &pixels, const Members &members, const Color3 &base, unsigned bits) {
+    const Pixel color = Expand(base, bits);
+    const int low = std::min({color[0], color[1], color[2]});
+    const int high = std::max({color[0], color[1], color[2]});
+
+    // When no channel clamps, the error of a pixel p against the color shifted by m is |p - color|^2 + m * (3m - 2 * sum(p - color)),
+    // so each pixel's distance and offset sum are all that's needed to pick its modifier
+    std::array<int, 8> distances;
+    std::array<int, 8> sums;
+    for (unsigned j = 0; j < 8; j++) {
+        const auto &pixel = pixels[members[j]];
+        distances[j] = static_cast<int>(Error(pixel, color));
+        sums[j] = pixel[0] + pixel[1] + pixel[2] - color[0] - color[1] - color[2];
+    }
+
+    SubblockFit best;
+    best.base = base;
+    for (uint8_t t = 0; t < 8; t++) {
+        const auto &table = ETC2Block::Tables[t];
+        unsigned error = 0;
+        std::array<uint8_t, 8> indices = {};
+
+        if (low >= table[1] && high + table[1] <= 255) {
+            // the modifier with the sign of the sum is always closer, and the larger one is closer once twice the sum passes 3 times their total
+            for (unsigned j = 0; j < 8 && error < best.error; j++) {
+                const int sum = sums[j];
+                const bool larger = 2 * std::abs(sum) > 3 * (table[0] + table[1]);
+                const uint8_t index = static_cast<uint8_t>((sum < 0 ? 2 : 0) + (larger ? 1 : 0));
+                const int modifier = Modifier(table, index);
+                indices[j] = index;
+                error += static_cast<unsigned>(distances[j] + modifier * (3 * modifier - 2 * sum));
+            }
+        } else {
+            const std::array<Pixel, 4> palette = {Shift(color, table[0]), Shift(color, table[1]), Shift(color, -table[0]), Shift(color, -table[1])};
+            for (unsigned j = 0; j < 8 && error < best.error; j++) {
+                unsigned best_error = UINT_MAX;
+                for (uint8_t i = 0; i < 4; i++) {
+                    const unsigned e = Error(palette[i], pixels[members[j]]);
+                    if (e < best_error) {
+                        best_error = e;
+                        indices[j] = i;
+                    }
+                }
+                error += best_error;
+            }
+        }
+
+        if (error < best.error) {
+            best.table = t;
+            best.indices = indices;
+            best.error = error;
+        }
+    }
+    return best;
+}
+
+// The base color that centers a subblock's pixels on the modifiers they use
+Center Recenter(const Pixels &pixels, const Members &members, const SubblockFit &fit) {
+    Center center = {};
+    for (unsigned j = 0; j < 8; j++) {
+        const int modifier = Modifier(ETC2Block::Tables[fit.table], fit.indices[j]);
+        for (unsigned c = 0; c < 3; c++) center[c] += static_cast<float>(pixels[members[j]][c] - modifier) / 8.0f;
+    }
+    return center;
+}
+
+bool Storable(const Color3 &first, const Color3 &second) {
+    for (unsigned c = 0; c < 3; c++) {
+        const int delta = second[c] - first[c];
+        if (delta < -4 || delta > 3) return false;
+    }
+    return true;
+}
+
+// The pair of fits with the lowest total error whose colors are close enough to store in a differential block. If there are none,
+// one subblock keeps its best fit and the other is fit to the closest color to its center that can be stored alongside it
+std::array<SubblockFit, 2> PairDifferential(const Pixels &pixels, const std::array<Members, 2> &members, std::array<Fits, 2> &fits,
+                                            const std::array<unsigned, 2> &counts, const std::array<Center, 2> &centers) {
+    for (unsigned s = 0; s < 2; s++) {
+        std::sort(fits[s].begin(), fits[s].begin() + counts[s], [](const SubblockFit &a, const SubblockFit &b) { return a.error < b.error; });
+    }
+
+    std::array<SubblockFit, 2> best;
+    unsigned best_error = UINT_MAX;
+    for (unsigned i = 0; i < counts[0]; i++) {
+        const auto &first = fits[0][i];
+        if (first.error + fits[1][0].error >= best_error) break;
+        for (unsigned j = 0; j < counts[1]; j++) {
+            const auto &second = fits[1][j];
+            if (first.error + second.error >= best_error) break;
+            if (Storable(first.base, second.base)) {
+                best = {first, second};
+                best_error = first.error + second.error;
+                break;
+            }
+        }
+    }
+    if (best_error < UINT_MAX) return best;
+
+    for (unsigned s = 0; s < 2; s++) {
+        const auto &anchor = fits[s][0];
+        const int low = (s == 0) ? -4 : -3;
+        Color3 color;
+        for (unsigned c = 0; c < 3; c++) {
+            const int closest = Quantize(centers[1 - s][c], 5);
+            color[c] = static_cast<uint8_t>(std::clamp(closest, std::max(anchor.base[c] + low, 0), std::min(anchor.base[c] + low + 7, 31)));
+        }
+
+        const auto other = FitSubblock(pixels, members[1 - s], color, 5);
+        if (anchor.error + other.error < best_error) {
+            best[s] = anchor;
+            best[1 - s] = other;
+            best_error = anchor.error + other.error;
+        }
+    }
+    return best;
+}
+
+void EncodeETC1(const Pixels &pixels, Mode mode, unsigned radius, unsigned refine_passes, Candidate &best) {
+    const unsigned bits = (mode == Mode::Individual) ? 4 : 5;
+
+    for (bool flip : {false, true}) {
+        std::array<Members, 2> members;
+        std::array<unsigned, 2> counts = {0, 0};
+        std::array<uint16_t, 2> masks = {0, 0};
+        for (uint8_t i = 0; i < 16; i++) {
+            const unsigned s = flip ? (i / 4 >= 2) : (i % 4 >= 2);
+            members[s][counts[s]++] = i;
+            masks[s] |= static_cast<uint16_t>(1U << i);
+        }
+        std::array<Center, 2> centers = {Mean(pixels, masks[0]), Mean(pixels, masks[1])};
+
+        for (unsigned pass = 0; pass <= refine_passes; pass++) {
+            std::array<Fits, 2> fits;
+            std::array<unsigned, 2> fit_counts;
+            for (unsigned s = 0; s < 2; s++) {
+                std::array<Color3, max_neighbors> colors;
+                fit_counts[s] = Neighborhood(centers[s], bits, radius, colors);
+                for (unsigned n = 0; n < fit_counts[s]; n++) fits[s][n] = FitSubblock(pixels, members[s], colors[n], bits);
+            }
+
+            std::array<SubblockFit, 2> chosen;
+            if (mode == Mode::Individual) {
+                for (unsigned s = 0; s < 2; s++) {
+                    chosen[s] = *std::min_element(fits[s].begin(), fits[s].begin() + fit_counts[s],
+                                                  [](const SubblockFit &a, const SubblockFit &b) { return a.error < b.error; });
+                }
+            } else {
+                chosen = PairDifferential(pixels, members, fits, fit_counts, centers);
+            }
+
+            Unpacked unpacked;
+            unpacked.mode = mode;
+            unpacked.flip = flip;
+            for (unsigned s = 0; s < 2; s++) {
+                unpacked.colors[s] = chosen[s].base;
+                unpacked.tables[s] = chosen[s].table;
+                for (unsigned j = 0; j < 8; j++) unpacked.indices[members[s][j]] = chosen[s].indices[j];
+                centers[s] = Recenter(pixels, members[s], chosen[s]);
+            }
+            Consider(best, unpacked, chosen[0].error + chosen[1].error);
+        }
+    }
+}
+
+// endregion
+
+// region planar mode
+
+unsigned PlanarError(const Pixels &pixels, unsigned c, int o, int h, int v) {
+    unsigned error = 0;
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            const int value = std::clamp((x * (h - o) + y * (v - o) + 4 * o + 2) >> 2, 0, 255);
+            const int diff = value - pixels[static_cast<unsigned>(y * 4 + x)][c];
+            error += static_cast<unsigned>(diff * diff);
+        }
+    }
+    return error;
+}
+
+// Fit a plane to each channel by least squares, and search around its quantized colors. Channels are independent in this mode
+void EncodePlanar(const Pixels &pixels, unsigned radius, Candidate &best) {
+    Unpacked unpacked;
+    unpacked.mode = Mode::Planar;
+    unsigned total = 0;
+
+    for (unsigned c = 0; c < 3; c++) {
+        float sum = 0, sum_x = 0, sum_y = 0;
+        for (unsigned i = 0; i < 16; i++) {
+            const auto value = static_cast<float>(pixels[i][c]);
+            sum += value;
+            sum_x += (static_cast<float>(i % 4) - 1.5f) * value;
+            sum_y += (static_cast<float>(i / 4) - 1.5f) * value;
+        }
+        const float slope_x = sum_x / 20.0f;  // the sum of (x - 1.5)^2 over the block
+        const float slope_y = sum_y / 20.0f;
+        const float origin = sum / 16.0f - 1.5f * (slope_x + slope_y);
+
+        // the stored colors are at the origin and one pixel past the right and bottom edges
+        const unsigned bits = (c == 1) ? 7 : 6;
+        const int max = (1 << bits) - 1;
+        const int r = static_cast<int>(radius);
+        const std::array<int, 3> closest = {Quantize(origin, bits), Quantize(origin + 4 * slope_x, bits), Quantize(origin + 4 * slope_y, bits)};
+
+        unsigned best_error = UINT_MAX;
+        for (int o = std::max(closest[0] - r, 0); o <= std::min(closest[0] + r, max); o++) {
+            for (int h = std::max(closest[1] - r, 0); h <= std::min(closest[1] + r, max); h++) {
+                for (int v = std::max(closest[2] - r, 0); v <= std::min(closest[2] + r, max); v++) {
+                    const unsigned error = PlanarError(pixels, c, ETC2Block::Expand(o, bits), ETC2Block::Expand(h, bits), ETC2Block::Expand(v, bits));
+                    if (error < best_error) {
+                        best_error = error;
+                        unpacked.colors[0][c] = static_cast<uint8_t>(o);
+                        unpacked.colors[1][c] = static_cast<uint8_t>(h);
+                        unpacked.colors[2][c] = static_cast<uint8_t>(v);
+                    }
+                }
+            }
+        }
+        total += best_error;
+    }
+
+    Consider(best, unpacked, total);
+}
+
+// endregion
+
+// region T and H modes
+
+// Masks of the first group of pixels for each split of the block along its principal axis, from the tightest split to the loosest.
+// Returns the number of masks written
+unsigned Splits(const Pixels &pixels, bool all, std::array<uint16_t, max_splits> &masks) {
+    const Center mean = Mean(pixels, 0xFFFF);
+    std::array<std::array<float, 3>, 3> covariance = {};
+    for (const auto &pixel : pixels) {
+        for (unsigned a = 0; a < 3; a++) {
+            for (unsigned b = 0; b < 3; b++) covariance[a][b] += (static_cast<float>(pixel[a]) - mean[a]) * (static_cast<float>(pixel[b]) - mean[b]);
+        }
+    }
+
+    Center axis = {1.0f, 1.0f, 1.0f};
+    for (unsigned iteration = 0; iteration < 8; iteration++) {
+        Center next = {};
+        for (unsigned a = 0; a < 3; a++) {
+            for (unsigned b = 0; b < 3; b++) next[a] += covariance[a][b] * axis[b];
+        }
+        const float scale = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+        if (scale <= 0.0f) break;  // every pixel is the same color
+        for (unsigned a = 0; a < 3; a++) axis[a] = next[a] / scale;
+    }
+
+    std::array<float, 16> projections;
+    std::array<uint8_t, 16> order;
+    for (unsigned i = 0; i < 16; i++) projections[i] = std::inner_product(axis.begin(), axis.end(), pixels[i].begin(), 0.0f);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&projections](uint8_t a, uint8_t b) { return projections[a] < projections[b]; });
+
+    // score each split by the squared spread of its groups along the axis
+    std::array<std::pair<float, uint16_t>, max_splits> splits;
+    uint16_t mask = 0;
+    for (unsigned k = 1; k < 16; k++) {
+        mask |= static_cast<uint16_t>(1U << order[k - 1]);
+        float spread = 0;
+        for (unsigned group = 0; group < 2; group++) {
+            const unsigned begin = group ? k : 0, end = group ? 16 : k;
+            float sum = 0, sum_squares = 0;
+            for (unsigned j = begin; j < end; j++) {
+                sum += projections[order[j]];
+                sum_squares += projections[order[j]] * projections[order[j]];
+            }
+            spread += sum_squares - sum * sum / static_cast<float>(end - begin);
+        }
+        splits[k - 1] = {spread, mask};
+    }
+    std::stable_sort(splits.begin(), splits.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    const unsigned count = all ? max_splits : 1;
+    for (unsigned k = 0; k < count; k++) masks[k] = splits[k].second;
+    return count;
+}
+
+// The offset from its color of each index, and which color it belongs to
+int Offset(Mode mode, uint8_t index, int d) {
+    if (mode == Mode::T) return std::array<int, 4>{0, d, 0, -d}[index];
+    return (index & 1) ? -d : d;
+}
+
+unsigned Group(Mode mode, uint8_t index) { return (mode == Mode::T) ? (index > 0) : (index >> 1); }
+
+// Fit two colors to a split of the block, where the pixels in the mask belong to the first color. In T mode the first color is used alone
+void FitTH(const Pixels &pixels, Mode mode, uint16_t mask, unsigned refine_passes, Candidate &best) {
+    std::array<Center, 2> centers = {Mean(pixels, mask), Mean(pixels, static_cast<uint16_t>(~mask))};
+
+    for (unsigned pass = 0; pass <= refine_passes; pass++) {
+        Candidate fit;
+        Unpacked unpacked;
+        unpacked.mode = mode;
+        unpacked.colors[0] = Quantize(centers[0], 4);
+        unpacked.colors[1] = Quantize(centers[1], 4);
+
+        const Pixel first = Expand(unpacked.colors[0], 4);
+        const Pixel second = Expand(unpacked.colors[1], 4);
+        for (uint8_t d = 0; d < 8; d++) {
+            // H blocks store the lowest bit of the distance in the order of their colors, so equal colors need an odd distance
+            if (mode == Mode::H && unpacked.colors[0] == unpacked.colors[1] && (d & 1) == 0) continue;
+
+            const int distance = ETC2Block::Distances[d];
+            std::array<Pixel, 4> paints;
+            for (uint8_t i = 0; i < 4; i++) paints[i] = Shift(Group(mode, i) ? second : first, Offset(mode, i, distance));
+
+            unsigned error = 0;
+            for (unsigned p = 0; p < 16 && error < fit.error; p++) {
+                unsigned best_error = UINT_MAX;
+                for (uint8_t i = 0; i < 4; i++) {
+                    const unsigned e = Error(paints[i], pixels[p]);
+                    if (e < best_error) {
+                        best_error = e;
+                        unpacked.indices[p] = i;
+                    }
+                }
+                error += best_error;
+            }
+            unpacked.distance = d;
+            Consider(fit, unpacked, error);
+        }
+        if (fit.error == UINT_MAX) return;
+        Consider(best, fit.unpacked, fit.error);
+
+        // re-center each color on the pixels that use it
+        std::array<Center, 2> sums = {};
+        std::array<unsigned, 2> counts = {0, 0};
+        const int distance = ETC2Block::Distances[fit.unpacked.distance];
+        for (unsigned p = 0; p < 16; p++) {
+            const uint8_t index = fit.unpacked.indices[p];
+            const unsigned group = Group(mode, index);
+            for (unsigned c = 0; c < 3; c++) sums[group][c] += static_cast<float>(pixels[p][c] - Offset(mode, index, distance));
+            counts[group]++;
+        }
+        for (unsigned group = 0; group < 2; group++) {
+            if (counts[group] == 0) continue;
+            for (unsigned c = 0; c < 3; c++) centers[group][c] = sums[group][c] / static_cast<float>(counts[group]);
+        }
+    }
+}
+
+// endregion
+}  // namespace
+
+void ETC2Encoder::SetLevel(unsigned level) {
+    switch (level) {
+        case 0:
+            // ETC1-compatible output, with each base color rounded from its subblock's average
+            _mode_mask = etc1_modes;
+            _color_radius = 0;
+            _refine_passes = 0;
+            _split_search = false;
+            break;
+        case 1:
+            _mode_mask = all_modes;
+            _color_radius = 0;
+            _refine_passes = 1;
+            _split_search = false;
+            break;
+        case 2:
+            _mode_mask = all_modes;
+            _color_radius = 1;
+            _refine_passes = 1;
+            _split_search = false;
+            break;
+        case 3:
+            _mode_mask = all_modes;
+            _color_radius = 1;
+            _refine_passes = 2;
+            _split_search = true;
+            break;
+        case 4:
+            _mode_mask = all_modes;
+            _color_radius = 2;
+            _refine_passes = 2;
+            _split_search = true;
+            break;
+        default:
+            throw std::invalid_argument("Level out of range, must be between 0 and 4 inclusive");
+    }
+}
+
+void ETC2Encoder::SetModeMask(uint8_t mode_mask) {
+    if (mode_mask == 0 || (mode_mask & ~all_modes)) throw std::invalid_argument("Mode mask must enable at least one mode, using only bits 0 to 4");
+    _mode_mask = mode_mask;
+}
+
+void ETC2Encoder::SetColorRadius(unsigned color_radius) {
+    if (color_radius > max_color_radius) throw std::invalid_argument("Color radius out of range, must be between 0 and 2 inclusive");
+    _color_radius = color_radius;
+}
+
+void ETC2Encoder::SetRefinePasses(unsigned refine_passes) {
+    if (refine_passes > max_refine_passes) throw std::invalid_argument("Refine passes out of range, must be between 0 and 4 inclusive");
+    _refine_passes = refine_passes;
+}
+
+ETC2Block ETC2Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
+    Pixels values;
+    for (unsigned i = 0; i < 16; i++) {
+        const auto color = pixels.Get(static_cast<int>(i));
+        values[i] = {color[0], color[1], color[2]};
+    }
+
+    const auto enabled = [this](Mode mode) { return ((_mode_mask >> static_cast<unsigned>(mode)) & 1) != 0; };
+
+    Candidate best;
+    for (Mode mode : {Mode::Individual, Mode::Differential}) {
+        if (enabled(mode)) EncodeETC1(values, mode, _color_radius, _refine_passes, best);
+    }
+    if (enabled(Mode::Planar) && best.error > 0) EncodePlanar(values, _color_radius, best);
+
+    if ((enabled(Mode::T) || enabled(Mode::H)) && best.error > 0) {
+        std::array<uint16_t, max_splits> masks;
+        const unsigned split_count = Splits(values, _split_search, masks);
+        for (unsigned k = 0; k < split_count; k++) {
+            const uint16_t mask = masks[k];
+            if (enabled(Mode::T)) {
+                FitTH(values, Mode::T, mask, _refine_passes, best);
+                FitTH(values, Mode::T, static_cast<uint16_t>(~mask), _refine_passes, best);
+            }
+            if (enabled(Mode::H)) FitTH(values, Mode::H, mask, _refine_passes, best);
+        }
+    }
+
+    return ETC2Block(best.unpacked);
+}
+}  // namespace quicktex::etc
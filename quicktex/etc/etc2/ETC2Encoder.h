@@ -0,0 +1,76 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../../ColorBlock.h"
+#include "../../Encoder.h"
+#include "../../Texture.h"
+#include "ETC2Block.h"
+
+namespace quicktex::etc {
+
+class ETC2Encoder final : public BlockEncoder<BlockTexture<ETC2Block>> {
+   public:
+    using Mode = ETC2Block::Mode;
+
+    /// Highest quality level. Level 0 only uses the ETC1 modes, and each level after it searches more colors and splits
+    static constexpr unsigned max_level = 4;
+
+    static constexpr unsigned max_color_radius = 2;
+    static constexpr unsigned max_refine_passes = 4;
+
+    /// The individual and differential modes, which are the only ones ETC1 decoders support
+    static constexpr uint8_t etc1_modes = 0x03;
+    static constexpr uint8_t all_modes = 0x1F;
+
+    explicit ETC2Encoder(unsigned level = 1) { SetLevel(level); }
+
+    /// Set all settings from a preset level between 0 and max_level inclusive
+    void SetLevel(unsigned level);
+
+    /// Bitmask of the modes the encoder may use, where bit 0 is the individual mode and bit 4 is the planar mode. See Mode
+    uint8_t GetModeMask() const { return _mode_mask; }
+    void SetModeMask(uint8_t mode_mask);
+
+    /// Distance searched around each quantized base color in every channel, in steps of the precision it's stored with
+    unsigned GetColorRadius() const { return _color_radius; }
+    void SetColorRadius(unsigned color_radius);
+
+    /// Number of passes that re-center each color on the pixels that use it and search again
+    unsigned GetRefinePasses() const { return _refine_passes; }
+    void SetRefinePasses(unsigned refine_passes);
+
+    /// If true, the T and H modes try every split of the pixels along the block's principal axis, instead of only the tightest one
+    bool GetSplitSearch() const { return _split_search; }
+    void SetSplitSearch(bool split_search) { _split_search = split_search; }
+
+    ETC2Block EncodeBlock(const ColorBlock<4, 4> &pixels) const override;
+
+    virtual size_t MTThreshold() const override { return 16; }
+
+   private:
+    uint8_t _mode_mask;
+    unsigned _color_radius;
+    unsigned _refine_passes;
+    bool _split_search;
+};
+}  // namespace quicktex::etc
@@ -0,0 +1,79 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include "../eac/EACBlock.h"
+#include "ETC2Block.h"
+
+namespace quicktex::etc {
+
+/// A single ETC2 RGBA block, made of an EAC block storing alpha followed by an ETC2 block storing color
+class alignas(8) ETC2RGBABlock {
+   public:
+    static constexpr int Width = 4;
+    static constexpr int Height = 4;
+
+    using BlockPair = std::pair<EACBlock, ETC2Block>;
+
+    EACBlock alpha_block;
+    ETC2Block color_block;
+
+    constexpr ETC2RGBABlock() : alpha_block(EACBlock()), color_block(ETC2Block()) {
+        static_assert(sizeof(ETC2RGBABlock) == 16);
+        static_assert(sizeof(std::array<ETC2RGBABlock, 10>) == 16 * 10);
+        static_assert(alignof(ETC2RGBABlock) >= 8);
+    }
+
+    ETC2RGBABlock(const EACBlock &alpha, const ETC2Block &color) {
+        alpha_block = alpha;
+        color_block = color;
+    }
+
+    BlockPair GetBlocks() const { return BlockPair(alpha_block, color_block); }
+
+    void SetBlocks(const BlockPair &blocks) {
+        alpha_block = blocks.first;
+        color_block = blocks.second;
+    }
+
+    /// True if the block can be flipped losslessly, which depends only on its color block
+    bool CanFlip() const { return color_block.CanFlip(); }
+
+    /// True if the block can be mirrored losslessly, which depends only on its color block
+    bool CanMirror() const { return color_block.CanMirror(); }
+
+    /// Flip the block vertically
+    void Flip() {
+        color_block.Flip();  // may throw, so it goes first
+        alpha_block.Flip();
+    }
+
+    /// Mirror the block horizontally
+    void Mirror() {
+        color_block.Mirror();
+        alpha_block.Mirror();
+    }
+
+    bool operator==(const ETC2RGBABlock &Rhs) const { return alpha_block == Rhs.alpha_block && color_block == Rhs.color_block; }
+    bool operator!=(const ETC2RGBABlock &Rhs) const { return !(Rhs == *this); }
+};
+}  // namespace quicktex::etc
@@ -0,0 +1,30 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "ETC2RGBADecoder.h"
+
+#include "../../ColorBlock.h"
+#include "ETC2RGBABlock.h"
+
+namespace quicktex::etc {
+ColorBlock<4, 4> ETC2RGBADecoder::DecodeBlock(const ETC2RGBABlock &block) const {
+    auto output = _etc2_decoder->DecodeBlock(block.color_block);
+    _eac_decoder->DecodeInto(output, block.alpha_block);
+    return output;
+}
+}  // namespace quicktex::etc
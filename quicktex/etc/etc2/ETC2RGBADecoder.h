@@ -0,0 +1,48 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "../../ColorBlock.h"
+#include "../../Decoder.h"
+#include "../../Texture.h"
+#include "../eac/EACDecoder.h"
+#include "ETC2Decoder.h"
+#include "ETC2RGBABlock.h"
+
+namespace quicktex::etc {
+
+class ETC2RGBADecoder : public BlockDecoder<BlockTexture<ETC2RGBABlock>> {
+   public:
+    using ETC2DecoderPtr = std::shared_ptr<ETC2Decoder>;
+    using EACDecoderPtr = std::shared_ptr<EACDecoder>;
+
+    ETC2RGBADecoder() : _etc2_decoder(std::make_shared<ETC2Decoder>()), _eac_decoder(std::make_shared<EACDecoder>(3, EACDecoder::Precision::Alpha)) {}
+
+    ColorBlock<4, 4> DecodeBlock(const ETC2RGBABlock &block) const override;
+
+    ETC2DecoderPtr GetETC2Decoder() const { return _etc2_decoder; }
+    EACDecoderPtr GetEACDecoder() const { return _eac_decoder; }
+
+   private:
+    const ETC2DecoderPtr _etc2_decoder;
+    const EACDecoderPtr _eac_decoder;
+};
+}  // namespace quicktex::etc
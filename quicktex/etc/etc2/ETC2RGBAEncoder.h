@@ -0,0 +1,61 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+#include "../../ColorBlock.h"
+#include "../../Encoder.h"
+#include "../../Texture.h"
+#include "../eac/EACEncoder.h"
+#include "ETC2Encoder.h"
+#include "ETC2RGBABlock.h"
+
+namespace quicktex::etc {
+
+class ETC2RGBAEncoder : public BlockEncoder<BlockTexture<ETC2RGBABlock>> {
+   public:
+    using ETC2EncoderPtr = std::shared_ptr<ETC2Encoder>;
+    using EACEncoderPtr = std::shared_ptr<EACEncoder>;
+
+    /// Quality levels go up to ETC2Encoder::max_level. The alpha encoder uses the same level, up to EACEncoder::max_level
+    ETC2RGBAEncoder(unsigned level = 1)
+        : ETC2RGBAEncoder(std::make_shared<ETC2Encoder>(level),
+                          std::make_shared<EACEncoder>(3, std::min(level, EACEncoder::max_level), EACEncoder::Precision::Alpha)) {}
+
+    ETC2RGBAEncoder(ETC2EncoderPtr etc2_encoder, EACEncoderPtr eac_encoder) : _etc2_encoder(etc2_encoder), _eac_encoder(eac_encoder) {
+        if (!_etc2_encoder || !_eac_encoder) throw std::invalid_argument("Encoders cannot be null");
+        if (_eac_encoder->GetPrecision() != EACEncoder::Precision::Alpha) throw std::invalid_argument("ETC2 RGBA alpha blocks must use alpha precision");
+    }
+
+    ETC2RGBABlock EncodeBlock(const ColorBlock<4, 4> &pixels) const override;
+
+    ETC2EncoderPtr GetETC2Encoder() const { return _etc2_encoder; }
+    EACEncoderPtr GetEACEncoder() const { return _eac_encoder; }
+
+    virtual size_t MTThreshold() const override { return 16; }
+
+   private:
+    const ETC2EncoderPtr _etc2_encoder;
+    const EACEncoderPtr _eac_encoder;
+};
+}  // namespace quicktex::etc
@@ -0,0 +1,230 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "../../_bindings.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "../../Decoder.h"
+#include "../../Encoder.h"
+#include "../eac/EACEncoder.h"
+#include "ETC2Block.h"
+#include "ETC2Decoder.h"
+#include "ETC2Encoder.h"
+#include "ETC2RGBADecoder.h"
+#include "ETC2RGBAEncoder.h"
+
+namespace py = pybind11;
+namespace quicktex::bindings {
+
+using namespace quicktex::etc;
+using namespace pybind11::literals;
+using ETC2EncoderPtr = std::shared_ptr<ETC2Encoder>;
+using EACEncoderPtr = std::shared_ptr<EACEncoder>;
+
+void InitETC2(py::module_ &etc) {
+    auto etc2 = etc.def_submodule("_etc2", "internal etc2 module");
+
+    // region ETC2Block
+    auto etc2_block = BindBlock<ETC2Block>(etc2, "ETC2Block");
+    etc2_block.doc() = R"doc(
+        A single ETC2 RGB block. All of its bits are zero by default, which is an individual mode block that decodes to a gray of 2.
+
+        The fields of a block are packed into a 64-bit stream whose layout depends on its mode, so they are exposed as readonly properties.
+    )doc";
+
+    py::enum_<ETC2Block::Mode>(etc2_block, "Mode", "Enum representing the modes of an ETC2 block.")
+        .value("Individual", ETC2Block::Mode::Individual, "Two subblocks with 4-bit base colors. Also supported by ETC1.")
+        .value("Differential", ETC2Block::Mode::Differential, "Two subblocks with 5-bit base colors close to each other. Also supported by ETC1.")
+        .value("T", ETC2Block::Mode::T, "One color, and three colors along a line through another.")
+        .value("H", ETC2Block::Mode::H, "Two pairs of colors, each on either side of a color.")
+        .value("Planar", ETC2Block::Mode::Planar, "A smooth gradient across the whole block.");
+
+    etc2_block.def(py::init<>());
+
+    etc2_block.def_property_readonly("mode", &ETC2Block::GetMode, "The block's mode. Readonly.");
+    etc2_block.def_property_readonly("colors", &ETC2Block::GetColors, "The decoded color of every pixel in row-major order, with an alpha of 255. Readonly.");
+
+    etc2_block.def_property_readonly("can_flip", &ETC2Block::CanFlip, R"doc(
+        True if the block can be flipped losslessly. Planar blocks with a vertical gradient can't be, and neither can some differential blocks,
+        so flipping them raises a ValueError. Readonly.
+    )doc");
+    etc2_block.def_property_readonly("can_mirror", &ETC2Block::CanMirror, R"doc(
+        True if the block can be mirrored losslessly. Planar blocks with a horizontal gradient can't be, and neither can some differential blocks,
+        so mirroring them raises a ValueError. Readonly.
+    )doc");
+    // endregion
+
+    // region ETC2Texture
+    auto etc2_texture = BindBlockTexture<ETC2Block>(etc2, "ETC2Texture");
+    etc2_texture.doc() = "A texture comprised of ETC2 RGB blocks.";
+    // endregion
+
+    // region ETC2Encoder
+    py::class_<ETC2Encoder, ETC2EncoderPtr> etc2_encoder(etc2, "ETC2Encoder", R"doc(
+        Encodes RGB textures to ETC2, or to ETC1 by limiting :py:attr:`mode_mask` to :py:const:`ETC2Encoder.etc1_modes`.
+    )doc");
+
+    etc2_encoder.def(py::init<unsigned>(), "level"_a = 1, R"doc(
+        Create a new ETC2 encoder with the specified preset level.
+
+        :param int level: The preset level of the resulting encoder, between 0 and :py:const:`ETC2Encoder.max_level` inclusive.
+            See :py:meth:`set_level` for more information. Default: 1.
+    )doc");
+
+    DefEncode(etc2_encoder, "ETC2Texture", [](const ETC2Encoder &) { return std::make_pair(ETC2Decoder(), 0x7U); });
+
+    DefEncodeInto(etc2_encoder);
+    DefEncodeBatch(etc2_encoder);
+    DefEncodeMulti(etc2_encoder);
+    DefEncodeStream(etc2_encoder);
+
+    etc2_encoder.def("set_level", &ETC2Encoder::SetLevel, "level"_a, R"doc(
+        Select a preset quality level, between 0 and :py:const:`ETC2Encoder.max_level` inclusive.
+        Higher quality levels are slower, but produce blocks that are a closer match to input.
+        This sets :py:attr:`mode_mask`, :py:attr:`color_radius`, :py:attr:`refine_passes` and :py:attr:`split_search`.
+
+        Level 0 only uses the ETC1 modes, so its output can be read by ETC1 decoders. Level 1 adds the T, H and planar modes,
+        and each level after it searches more colors and splits. Level 2 searches every base color next to the closest ones,
+        which makes it about 9 times slower than level 1 for around 0.7dB more PSNR.
+
+        :param int level: The preset level of the resulting encoder, between 0 and :py:const:`ETC2Encoder.max_level` inclusive. Default: 1.
+    )doc");
+
+    etc2_encoder.def_readonly_static("max_level", &ETC2Encoder::max_level);
+    etc2_encoder.def_readonly_static("max_color_radius", &ETC2Encoder::max_color_radius);
+    etc2_encoder.def_readonly_static("max_refine_passes", &ETC2Encoder::max_refine_passes);
+    etc2_encoder.def_readonly_static("etc1_modes", &ETC2Encoder::etc1_modes);
+    etc2_encoder.def_readonly_static("all_modes", &ETC2Encoder::all_modes);
+
+    etc2_encoder.def_property("mode_mask", &ETC2Encoder::GetModeMask, &ETC2Encoder::SetModeMask, R"doc(
+        Bitmask of the modes the encoder may use, where each bit is the value of a :py:class:`ETC2Block.Mode`.
+        Set it to :py:const:`ETC2Encoder.etc1_modes` for textures that will be read by ETC1 decoders.
+    )doc");
+
+    etc2_encoder.def_property("color_radius", &ETC2Encoder::GetColorRadius, &ETC2Encoder::SetColorRadius, R"doc(
+        Distance searched around each quantized base color in every channel, in steps of the precision it's stored with,
+        between 0 and :py:const:`ETC2Encoder.max_color_radius` inclusive.
+    )doc");
+
+    etc2_encoder.def_property("refine_passes", &ETC2Encoder::GetRefinePasses, &ETC2Encoder::SetRefinePasses, R"doc(
+        Number of passes that re-center each color on the pixels that use it and search again,
+        between 0 and :py:const:`ETC2Encoder.max_refine_passes` inclusive.
+    )doc");
+
+    etc2_encoder.def_property("split_search", &ETC2Encoder::GetSplitSearch, &ETC2Encoder::SetSplitSearch, R"doc(
+        If true, the T and H modes try every split of the pixels along the block's principal axis, instead of only the tightest one.
+    )doc");
+    // endregion
+
+    // region ETC2Decoder
+    py::class_<ETC2Decoder> etc2_decoder(etc2, "ETC2Decoder", R"doc(
+        Decodes ETC2 and ETC1 textures to RGB, with an alpha of 255.
+    )doc");
+
+    etc2_decoder.def(py::init<>());
+
+    etc2_decoder.def("decode", &ETC2Decoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Decode an ETC2 texture into a new RawTexture.
+
+        :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
+        :returns: A new RawTexture with the same dimensions as the input
+    )doc");
+
+    DefCompare(etc2_decoder, [](const ETC2Decoder &) { return 0x7U; });
+    // endregion
+
+    // region ETC2RGBABlock
+    auto rgba_block = BindBlock<ETC2RGBABlock>(etc2, "ETC2RGBABlock");
+    rgba_block.doc() = "A single ETC2 RGBA block.";
+
+    rgba_block.def(py::init<>());
+    rgba_block.def(py::init<EACBlock, ETC2Block>(), "alpha_block"_a, "color_block"_a, R"doc(
+        Create a new ETC2RGBABlock out of an EAC block and an ETC2 block.
+
+        :param EACBlock alpha_block: The EAC block used for alpha data.
+        :param ETC2Block color_block: The ETC2 block used for RGB data.
+    )doc");
+
+    rgba_block.def_readwrite("alpha_block", &ETC2RGBABlock::alpha_block, "The EAC block used for alpha data.");
+    rgba_block.def_readwrite("color_block", &ETC2RGBABlock::color_block, "The ETC2 block used for rgb data.");
+    rgba_block.def_property("blocks", &ETC2RGBABlock::GetBlocks, &ETC2RGBABlock::SetBlocks, "The EAC and ETC2 blocks that make up this block as a 2-tuple.");
+    rgba_block.def_property_readonly("can_flip", &ETC2RGBABlock::CanFlip, "True if the block's color block can be flipped losslessly. Readonly.");
+    rgba_block.def_property_readonly("can_mirror", &ETC2RGBABlock::CanMirror, "True if the block's color block can be mirrored losslessly. Readonly.");
+    // endregion
+
+    // region ETC2RGBATexture
+    auto rgba_texture = BindBlockTexture<ETC2RGBABlock>(etc2, "ETC2RGBATexture");
+    rgba_texture.doc() = "A texture comprised of ETC2 RGBA blocks.";
+    // endregion
+
+    // region ETC2RGBAEncoder
+    py::class_<ETC2RGBAEncoder> rgba_encoder(etc2, "ETC2RGBAEncoder", R"doc(
+        Encodes RGBA textures to ETC2 RGBA.
+    )doc");
+
+    rgba_encoder.def(py::init<unsigned>(), "level"_a = 1, R"doc(
+        Create a new ETC2 RGBA encoder with the specified preset level.
+
+        :param int level: The preset level of the color encoder, between 0 and :py:const:`ETC2Encoder.max_level` inclusive.
+            The alpha encoder uses the same level, up to :py:const:`~quicktex.etc.eac.EACEncoder.max_level`. Default: 1.
+    )doc");
+    rgba_encoder.def(py::init<ETC2EncoderPtr, EACEncoderPtr>(), "etc2_encoder"_a, "eac_encoder"_a, R"doc(
+        Create a new ETC2 RGBA encoder out of an ETC2 encoder and an EAC encoder.
+
+        :param ETC2Encoder etc2_encoder: The encoder used for RGB data.
+        :param EACEncoder eac_encoder: The encoder used for alpha data. It must use alpha precision.
+    )doc");
+
+    DefEncode(rgba_encoder, "ETC2RGBATexture", [](const ETC2RGBAEncoder &) { return std::make_pair(ETC2RGBADecoder(), ErrorMetrics::AllChannels); });
+
+    DefEncodeInto(rgba_encoder);
+    DefEncodeBatch(rgba_encoder);
+    DefEncodeMulti(rgba_encoder);
+    DefEncodeStream(rgba_encoder);
+
+    rgba_encoder.def_property_readonly("etc2_encoder", &ETC2RGBAEncoder::GetETC2Encoder, "Internal :py:class:`ETC2Encoder` used for RGB data. Readonly.");
+    rgba_encoder.def_property_readonly("eac_encoder", &ETC2RGBAEncoder::GetEACEncoder,
+                                       "Internal :py:class:`~quicktex.etc.eac.EACEncoder` used for alpha data. Readonly.");
+    // endregion
+
+    // region ETC2RGBADecoder
+    py::class_<ETC2RGBADecoder> rgba_decoder(etc2, "ETC2RGBADecoder", R"doc(
+        Decodes ETC2 RGBA textures to RGBA.
+    )doc");
+
+    rgba_decoder.def(py::init<>());
+
+    rgba_decoder.def("decode", &ETC2RGBADecoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Decode an ETC2 RGBA texture into a new RawTexture.
+
+        :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
+        :returns: A new RawTexture with the same dimensions as the input
+    )doc");
+
+    DefCompare(rgba_decoder, [](const ETC2RGBADecoder &) { return ErrorMetrics::AllChannels; });
+    // endregion
+}
+}  // namespace quicktex::bindings
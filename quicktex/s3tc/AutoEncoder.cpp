@@ -0,0 +1,121 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+
+#include "AutoEncoder.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../ColorBlock.h"
+#include "../Texture.h"
+#include "bc1/BC1Block.h"
+#include "bc1/BC1Encoder.h"
+#include "bc3/BC3Block.h"
+#include "bc3/BC3Encoder.h"
+#include "bc4/BC4Block.h"
+#include "bc4/BC4Encoder.h"
+
+namespace quicktex::s3tc {
+
+namespace {
+// alpha threshold used by the BC1 encoder when AutoEncoder is allowed to use punch-through alpha
+constexpr uint8_t punchthrough_threshold = 128;
+
+// true if every pixel in the block is either fully transparent or fully opaque, so punch-through alpha encodes it losslessly
+bool IsBinaryAlpha(const ColorBlock<4, 4> &pixels) {
+    for (unsigned i = 0; i < 16; i++) {
+        const uint8_t a = pixels.Get(i).a;
+        if (a != 0 && a != UINT8_MAX) return false;
+    }
+    return true;
+}
+
+std::shared_ptr<BC1Encoder> MakeBC1Encoder(unsigned level, BC1Encoder::ColorMode color_mode, bool punchthrough) {
+    auto encoder = std::make_shared<BC1Encoder>(level, color_mode);
+    // ThreeColorBlack mode already writes black pixels as transparent, so it can't also write transparent pixels
+    if (punchthrough && color_mode != BC1Encoder::ColorMode::ThreeColorBlack) encoder->SetAlphaThreshold(punchthrough_threshold);
+    return encoder;
+}
+}  // namespace
+
+AutoEncoder::AutoEncoder(BC1EncoderPtr bc1_encoder, BC3EncoderPtr bc3_encoder) : _bc1_encoder(bc1_encoder), _bc3_encoder(bc3_encoder) {
+    if (!_bc1_encoder || !_bc3_encoder) throw std::invalid_argument("Encoders cannot be null");
+}
+
+AutoEncoder::AutoEncoder(unsigned level, BC1Encoder::ColorMode color_mode, bool punchthrough)
+    : _bc1_encoder(MakeBC1Encoder(level, color_mode, punchthrough)),
+      // BC3 color blocks are always 4-color, so that's the only case where the BC1 encoder can be shared. BC3 ignores its alpha threshold
+      _bc3_encoder(color_mode == BC1Encoder::ColorMode::FourColor ? std::make_shared<BC3Encoder>(_bc1_encoder, std::make_shared<BC4Encoder>(3))
+                                                                  : std::make_shared<BC3Encoder>(level)) {}
+
+AutoEncoder::EncodedTexture AutoEncoder::Encode(const RawTexture &decoded, bool flip) const {
+    auto bc1 = BlockTexture<BC1Block>(decoded.Width(), decoded.Height());
+    const int blocks_x = bc1.BlocksX();
+    const int blocks_y = bc1.BlocksY();
+    const bool multithread = static_cast<size_t>(blocks_x * blocks_y) >= _bc1_encoder->MTThreshold();
+    const bool punchthrough = _bc1_encoder->GetAlphaThreshold() > 0;
+
+    // blocks that were encoded to BC1 before alpha was found. Once any thread finds alpha, the rest stop gathering blocks.
+    // With punch-through, only alpha other than 0 or 255 counts, and blocks with 1-bit alpha are encoded to BC1 but aren't opaque
+    std::vector<uint8_t> opaque(static_cast<size_t>(blocks_x * blocks_y), 0);
+    std::atomic<bool> has_alpha = false;
+
+#pragma omp parallel for if (multithread)
+    for (int y = 0; y < blocks_y; y++) {
+        for (int x = 0; x < blocks_x; x++) {
+            if (has_alpha.load(std::memory_order_relaxed)) break;
+
+            auto pixels = decoded.GetBlock<4, 4>(x, y, flip);
+            auto metrics = pixels.GetMetrics();
+            const bool block_opaque = (metrics.min.a == UINT8_MAX);
+            if (!block_opaque && !(punchthrough && IsBinaryAlpha(pixels))) {
+                has_alpha.store(true, std::memory_order_relaxed);
+                break;
+            }
+
+            bc1.SetBlock(x, y, _bc1_encoder->EncodeBlock(pixels, metrics));
+            opaque[static_cast<size_t>(x + y * blocks_x)] = block_opaque;
+        }
+    }
+
+    if (!has_alpha) {
+        _bc1_encoder->OptimizeTexture(decoded, bc1, flip);
+        return bc1;
+    }
+
+    const bool reuse_color = (_bc3_encoder->GetBC1Encoder() == _bc1_encoder);
+    auto bc3 = BlockTexture<BC3Block>(decoded.Width(), decoded.Height());
+
+#pragma omp parallel for if (multithread)
+    for (int y = 0; y < blocks_y; y++) {
+        for (int x = 0; x < blocks_x; x++) {
+            if (reuse_color && opaque[static_cast<size_t>(x + y * blocks_x)]) {
+                bc3.SetBlock(x, y, BC3Block(BC4Block(UINT8_MAX), bc1.GetBlock(x, y)));
+            } else {
+                bc3.SetBlock(x, y, _bc3_encoder->EncodeBlock(decoded.GetBlock<4, 4>(x, y, flip)));
+            }
+        }
+    }
+
+    return bc3;
+}
+}  // namespace quicktex::s3tc
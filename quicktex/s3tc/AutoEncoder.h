@@ -0,0 +1,69 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <variant>
+
+#include "../Texture.h"
+#include "bc1/BC1Block.h"
+#include "bc1/BC1Encoder.h"
+#include "bc3/BC3Block.h"
+#include "bc3/BC3Encoder.h"
+
+namespace quicktex::s3tc {
+
+/**
+ * Encodes textures to BC1 if they are fully opaque, or to BC3 if any pixel has alpha.
+ * If the BC1 encoder has an alpha threshold, textures whose alpha is only ever 0 or 255 are encoded to BC1 with punch-through alpha instead of BC3.
+ * Alpha is checked as each block is gathered for encoding, so choosing the format doesn't take its own pass over the texture.
+ */
+class AutoEncoder {
+   public:
+    using BC1EncoderPtr = std::shared_ptr<BC1Encoder>;
+    using BC3EncoderPtr = std::shared_ptr<BC3Encoder>;
+    using EncodedTexture = std::variant<BlockTexture<BC1Block>, BlockTexture<BC3Block>>;
+
+    AutoEncoder(BC1EncoderPtr bc1_encoder, BC3EncoderPtr bc3_encoder);
+
+    /**
+     * Create an encoder with the given preset level and BC1 color mode
+     * @param punchthrough If true, encode textures with 1-bit alpha to BC1 with punch-through alpha. Ignored in ThreeColorBlack mode
+     */
+    AutoEncoder(unsigned level = 5, BC1Encoder::ColorMode color_mode = BC1Encoder::ColorMode::FourColor, bool punchthrough = true);
+
+    /**
+     * Encode a texture, choosing its format by its alpha channel.
+     * Blocks are encoded to BC1 until one with alpha that BC1 can't represent is found, and the rest of the texture is then encoded to BC3.
+     * If the BC3 encoder shares the BC1 encoder, BC1 blocks that were already encoded are reused as the color halves of their BC3 blocks.
+     * @param decoded The texture to encode
+     * @param flip If true, vertically flip the texture while encoding
+     * @return A BC1 texture if the input is fully opaque or has 1-bit alpha that the BC1 encoder can punch through, otherwise a BC3 texture
+     */
+    EncodedTexture Encode(const RawTexture &decoded, bool flip = false) const;
+
+    BC1EncoderPtr GetBC1Encoder() const { return _bc1_encoder; }
+    BC3EncoderPtr GetBC3Encoder() const { return _bc3_encoder; }
+
+   private:
+    const BC1EncoderPtr _bc1_encoder;
+    const BC3EncoderPtr _bc3_encoder;
+};
+}  // namespace quicktex::s3tc
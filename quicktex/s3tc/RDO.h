@@ -0,0 +1,175 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+#include "../ColorBlock.h"
+#include "../Texture.h"
+
+namespace quicktex::s3tc {
+
+/**
+ * Rate-distortion optimization of 8-byte block formats, so that textures compress better with an LZ-based compressor such as zstd or deflate.
+ *
+ * Once a texture has been encoded, each block is compared with the blocks before it in a sliding window.
+ * Candidates that copy a recent block, copy its selectors, or use its endpoints with new selectors replace the block if they lower its cost D + lambda * R,
+ * where D is the sum of squared errors of the block and R estimates its compressed size in bits:
+ * 8 bits for each byte of the endpoints or selectors that doesn't repeat a block in the window, and match_bits for each that does.
+ *
+ * Blocks are processed in raster order in chunks of chunk_blocks, which are optimized independently and in parallel,
+ * so the output doesn't depend on the number of threads.
+ * @tparam B The block type, which must be 8 bytes with its endpoints before its selectors
+ */
+template <typename B> class RDOptimizer {
+   public:
+    using Pixels = ColorBlock<4, 4>;
+
+    static_assert(sizeof(B) == 8, "Rate-distortion optimization requires 8-byte blocks");
+
+    /// Estimated cost in bits of an LZ match, covering its offset and length
+    static constexpr unsigned match_bits = 12;
+
+    /// Number of blocks in each chunk. Matches are only looked for within a chunk
+    static constexpr int chunk_blocks = 1024;
+
+    /**
+     * @param endpoint_bytes Number of bytes at the start of each block that hold its endpoints
+     * @param lambda Weight of the rate against the squared error. Higher values lower the quality and make the texture more compressible
+     * @param window Number of preceding blocks to look for matches in
+     */
+    RDOptimizer(size_t endpoint_bytes, float lambda, unsigned window) : _lambda(lambda), _window(window) {
+        std::array<uint8_t, 8> mask = {0};
+        std::fill_n(mask.begin(), endpoint_bytes, UINT8_MAX);
+        std::memcpy(&_endpoint_mask, mask.data(), 8);
+        _endpoint_bits = 8 * static_cast<unsigned>(endpoint_bytes);
+        _selector_bits = 64 - _endpoint_bits;
+    }
+
+    /**
+     * Optimize an encoded texture in place
+     * @param decoded The texture that was encoded
+     * @param encoded The encoded texture
+     * @param flip True if the texture was vertically flipped while encoding
+     * @param error Function taking the pixels of a block, a candidate and the original encoded block, and returning the squared error of the candidate,
+     * or nullopt if it can't replace the original
+     * @param reselect Function taking the pixels of a block, a block to take endpoints from and the original encoded block,
+     * and returning a block with those endpoints and the best selectors for the pixels
+     * @return true if any blocks were changed
+     */
+    template <typename E, typename S> bool Optimize(const RawTexture &decoded, BlockTexture<B> &encoded, bool flip, E &&error, S &&reselect) const {
+        const int blocks_x = encoded.BlocksX();
+        const int total = blocks_x * encoded.BlocksY();
+        const int chunks = (total + chunk_blocks - 1) / chunk_blocks;
+        bool changed = false;
+
+#pragma omp parallel for reduction(|| : changed) if (chunks > 1)
+        for (int chunk = 0; chunk < chunks; chunk++) {
+            const int begin = chunk * chunk_blocks;
+            const int end = std::min(begin + chunk_blocks, total);
+
+            // the final bytes of each block in the chunk so far, which later blocks look for matches in
+            std::vector<uint64_t> history;
+            history.reserve(static_cast<size_t>(end - begin));
+
+            for (int i = begin; i < end; i++) {
+                const int x = i % blocks_x;
+                const int y = i / blocks_x;
+                const auto pixels = decoded.GetBlock<4, 4>(x, y, flip);
+                const auto original = encoded.GetBlock(x, y);
+
+                const size_t window_end = history.size();
+                const size_t window_begin = window_end - std::min(window_end, _window);
+
+                auto best = original;
+                float best_cost = static_cast<float>(error(pixels, original, original).value_or(0)) +
+                                  _lambda * static_cast<float>(Rate(ToBits(original), history, window_begin, window_end));
+
+                auto consider = [&](const B &candidate) {
+                    if (candidate == best) return;
+                    const std::optional<unsigned> distortion = error(pixels, candidate, original);
+                    if (!distortion) return;
+
+                    // the rate is at least a single match, so most candidates can be ruled out without estimating it
+                    const float distortion_cost = static_cast<float>(*distortion);
+                    if (distortion_cost + _lambda * static_cast<float>(match_bits) >= best_cost) return;
+
+                    const float cost = distortion_cost + _lambda * static_cast<float>(Rate(ToBits(candidate), history, window_begin, window_end));
+                    if (cost < best_cost) {
+                        best = candidate;
+                        best_cost = cost;
+                    }
+                };
+
+                for (size_t j = window_begin; j < window_end; j++) {
+                    const auto previous = ToBlock(history[j]);
+                    consider(previous);
+                    consider(ToBlock((ToBits(original) & _endpoint_mask) | (history[j] & ~_endpoint_mask)));
+                    consider(reselect(pixels, previous, original));
+                }
+
+                if (best != original) {
+                    encoded.SetBlock(x, y, best);
+                    changed = true;
+                }
+                history.push_back(ToBits(best));
+            }
+        }
+
+        return changed;
+    }
+
+   private:
+    static uint64_t ToBits(const B &block) {
+        uint64_t bits;
+        std::memcpy(&bits, &block, 8);
+        return bits;
+    }
+
+    static B ToBlock(uint64_t bits) {
+        B block;
+        std::memcpy(static_cast<void *>(&block), &bits, 8);
+        return block;
+    }
+
+    // estimated size in bits of a block after LZ compression, given the blocks before it
+    unsigned Rate(uint64_t bits, const std::vector<uint64_t> &history, size_t window_begin, size_t window_end) const {
+        bool endpoints_match = false;
+        bool selectors_match = false;
+        for (size_t j = window_begin; j < window_end; j++) {
+            const uint64_t diff = bits ^ history[j];
+            if (diff == 0) return match_bits;  // the whole block is a single match
+            endpoints_match |= (diff & _endpoint_mask) == 0;
+            selectors_match |= (diff & ~_endpoint_mask) == 0;
+        }
+        return (endpoints_match ? match_bits : _endpoint_bits) + (selectors_match ? match_bits : _selector_bits);
+    }
+
+    float _lambda;
+    size_t _window;
+    uint64_t _endpoint_mask;
+    unsigned _endpoint_bits;
+    unsigned _selector_bits;
+};
+}  // namespace quicktex::s3tc
@@ -0,0 +1,539 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Supercompress.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Texture.h"
+#include "bc1/BC1Block.h"
+#include "bc3/BC3Block.h"
+#include "bc4/BC4Block.h"
+#include "bc5/BC5Block.h"
+
+namespace quicktex::s3tc {
+
+namespace {
+constexpr std::array<uint8_t, 4> magic = {'Q', 'T', 'X', 'S'};
+constexpr uint8_t version = 1;
+constexpr size_t header_size = 24;  // magic, version, format, 2 reserved bytes, width, height, blocks per chunk, chunk count
+constexpr unsigned max_chunk_blocks = 1U << 20;
+constexpr uint32_t raw_chunk = 1U << 31;  // set in a chunk's size when its blocks are stored as-is because coding them didn't make them smaller
+
+// number of recent values of a field that can be referenced by index, which covers every candidate of the default RDO window.
+// the token after the last index means the value is written as literal bytes instead
+constexpr unsigned recent_values = 64;
+constexpr unsigned literal_token = recent_values;
+constexpr unsigned token_symbols = recent_values + 1;
+constexpr unsigned byte_symbols = 256;
+
+constexpr unsigned max_code_length = 12;
+constexpr unsigned length_bits = 4;
+constexpr unsigned symbol_count_bits = 9;
+constexpr unsigned zero_run_bits = 5;  // a length of 0 is followed by the number of further unused symbols, so sparse tables stay small
+
+// a run of bytes within each block that is coded as its own stream
+struct Field {
+    unsigned offset;
+    unsigned size;
+};
+
+// the fields of each format, with endpoints and selectors kept apart. BC3 and BC5 blocks are a BC4 block followed by a BC1 or BC4 block
+template <typename B> struct Layout;
+template <> struct Layout<BC1Block> {
+    static constexpr uint8_t format = 1;
+    static constexpr std::array<Field, 2> fields = {{{0, 4}, {4, 4}}};
+};
+template <> struct Layout<BC3Block> {
+    static constexpr uint8_t format = 3;
+    static constexpr std::array<Field, 4> fields = {{{0, 2}, {2, 6}, {8, 4}, {12, 4}}};
+};
+template <> struct Layout<BC4Block> {
+    static constexpr uint8_t format = 4;
+    static constexpr std::array<Field, 2> fields = {{{0, 2}, {2, 6}}};
+};
+template <> struct Layout<BC5Block> {
+    static constexpr uint8_t format = 5;
+    static constexpr std::array<Field, 4> fields = {{{0, 2}, {2, 6}, {8, 2}, {10, 6}}};
+};
+
+void PutU32(uint8_t *data, uint32_t value) {
+    for (unsigned i = 0; i < 4; i++) data[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+void AppendU32(std::vector<uint8_t> &out, uint32_t value) {
+    for (unsigned i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+uint32_t GetU32(const uint8_t *data) {
+    uint32_t value = 0;
+    for (unsigned i = 0; i < 4; i++) value |= static_cast<uint32_t>(data[i]) << (8 * i);
+    return value;
+}
+
+uint64_t LoadField(const uint8_t *block, const Field &field) {
+    uint64_t value = 0;
+    for (unsigned b = 0; b < field.size; b++) value |= static_cast<uint64_t>(block[field.offset + b]) << (8 * b);
+    return value;
+}
+
+void StoreField(uint8_t *block, const Field &field, uint64_t value) {
+    for (unsigned b = 0; b < field.size; b++) block[field.offset + b] = static_cast<uint8_t>(value >> (8 * b));
+}
+
+// Writes codes starting from the least significant bit of each byte
+class BitWriter {
+   public:
+    void Write(uint32_t value, unsigned bits) {
+        _buffer |= static_cast<uint64_t>(value) << _count;
+        _count += bits;
+        while (_count >= 8) {
+            _bytes.push_back(static_cast<uint8_t>(_buffer));
+            _buffer >>= 8;
+            _count -= 8;
+        }
+    }
+
+    std::vector<uint8_t> Finish() {
+        if (_count > 0) _bytes.push_back(static_cast<uint8_t>(_buffer));
+        _buffer = 0;
+        _count = 0;
+        return std::move(_bytes);
+    }
+
+   private:
+    std::vector<uint8_t> _bytes;
+    uint64_t _buffer = 0;
+    unsigned _count = 0;
+};
+
+// Reads codes written by BitWriter. Reading past the end returns zeros, and is caught afterwards by Overrun()
+class BitReader {
+   public:
+    BitReader(const uint8_t *data, size_t size) : _data(data), _size(size) {}
+
+    uint32_t Peek(unsigned bits) {
+        while (_count <= 56) {
+            const uint64_t byte = _pos < _size ? _data[_pos] : 0;
+            _buffer |= byte << _count;
+            _pos++;
+            _count += 8;
+        }
+        return static_cast<uint32_t>(_buffer & ((uint64_t(1) << bits) - 1));
+    }
+
+    void Skip(unsigned bits) {
+        _buffer >>= bits;
+        _count -= bits;
+        _consumed += bits;
+    }
+
+    uint32_t Read(unsigned bits) {
+        const uint32_t value = Peek(bits);
+        Skip(bits);
+        return value;
+    }
+
+    bool Overrun() const { return _consumed > _size * 8; }
+
+   private:
+    const uint8_t *_data;
+    size_t _size;
+    size_t _pos = 0;
+    size_t _consumed = 0;
+    uint64_t _buffer = 0;
+    unsigned _count = 0;
+};
+
+// Huffman code lengths for the given symbol counts, limited to max_code_length bits by halving the counts until the tree is shallow enough
+std::vector<uint8_t> CodeLengths(std::vector<uint32_t> counts) {
+    std::vector<uint8_t> lengths(counts.size(), 0);
+    std::vector<unsigned> used;
+    for (unsigned s = 0; s < counts.size(); s++) {
+        if (counts[s] > 0) used.push_back(s);
+    }
+
+    if (used.empty()) return lengths;
+    if (used.size() == 1) {
+        lengths[used[0]] = 1;
+        return lengths;
+    }
+
+    using Entry = std::pair<uint64_t, unsigned>;  // weight and node index, so ties are broken the same way every time
+    while (true) {
+        std::vector<int> parents(used.size(), -1);
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+        for (unsigned i = 0; i < used.size(); i++) queue.emplace(counts[used[i]], i);
+
+        while (queue.size() > 1) {
+            const auto [weight_a, a] = queue.top();
+            queue.pop();
+            const auto [weight_b, b] = queue.top();
+            queue.pop();
+
+            const auto parent = static_cast<unsigned>(parents.size());
+            parents.push_back(-1);
+            parents[a] = parents[b] = static_cast<int>(parent);
+            queue.emplace(weight_a + weight_b, parent);
+        }
+
+        unsigned longest = 0;
+        for (unsigned i = 0; i < used.size(); i++) {
+            unsigned depth = 0;
+            for (int p = parents[i]; p >= 0; p = parents[static_cast<unsigned>(p)]) depth++;
+            lengths[used[i]] = static_cast<uint8_t>(depth);
+            longest = std::max(longest, depth);
+        }
+        if (longest <= max_code_length) return lengths;
+
+        for (unsigned s : used) counts[s] = (counts[s] + 1) / 2;
+    }
+}
+
+// Canonical codes for the given lengths, with their bits reversed so they can be written least significant bit first
+std::vector<uint16_t> CanonicalCodes(const std::vector<uint8_t> &lengths) {
+    std::array<unsigned, max_code_length + 1> length_counts = {};
+    for (uint8_t length : lengths) {
+        if (length > 0) length_counts[length]++;
+    }
+
+    std::array<unsigned, max_code_length + 1> next_code = {};
+    unsigned code = 0;
+    for (unsigned length = 1; length <= max_code_length; length++) {
+        code = (code + length_counts[length - 1]) << 1;
+        next_code[length] = code;
+    }
+
+    std::vector<uint16_t> codes(lengths.size(), 0);
+    for (unsigned s = 0; s < lengths.size(); s++) {
+        const unsigned length = lengths[s];
+        if (length == 0) continue;
+
+        const unsigned canonical = next_code[length]++;
+        unsigned reversed = 0;
+        for (unsigned bit = 0; bit < length; bit++) reversed |= ((canonical >> bit) & 1U) << (length - 1 - bit);
+        codes[s] = static_cast<uint16_t>(reversed);
+    }
+    return codes;
+}
+
+class HuffmanEncoder {
+   public:
+    // Build a code for the given symbol counts, and write its lengths so the decoder can rebuild it
+    HuffmanEncoder(const std::vector<uint32_t> &counts, BitWriter &writer) : _lengths(CodeLengths(counts)), _codes(CanonicalCodes(_lengths)) {
+        unsigned symbols = 0;
+        for (unsigned s = 0; s < _lengths.size(); s++) {
+            if (_lengths[s] > 0) symbols = s + 1;
+        }
+
+        writer.Write(symbols, symbol_count_bits);
+        for (unsigned s = 0; s < symbols; s++) {
+            writer.Write(_lengths[s], length_bits);
+            if (_lengths[s] > 0) continue;
+
+            unsigned run = 0;
+            while (run < (1U << zero_run_bits) - 1 && s + 1 < symbols && _lengths[s + 1] == 0) {
+                run++;
+                s++;
+            }
+            writer.Write(run, zero_run_bits);
+        }
+    }
+
+    void Write(BitWriter &writer, unsigned symbol) const { writer.Write(_codes[symbol], _lengths[symbol]); }
+
+   private:
+    std::vector<uint8_t> _lengths;
+    std::vector<uint16_t> _codes;
+};
+
+class HuffmanDecoder {
+   public:
+    // Read code lengths written by HuffmanEncoder. Returns false if they don't form a valid code
+    bool Read(BitReader &reader, unsigned alphabet) {
+        const unsigned symbols = reader.Read(symbol_count_bits);
+        if (symbols > alphabet) return false;
+
+        std::vector<uint8_t> lengths(symbols, 0);
+        unsigned kraft = 0;
+        for (unsigned s = 0; s < symbols; s++) {
+            lengths[s] = static_cast<uint8_t>(reader.Read(length_bits));
+            if (lengths[s] > max_code_length) return false;
+            if (lengths[s] > 0) {
+                kraft += 1U << (max_code_length - lengths[s]);
+            } else {
+                s += reader.Read(zero_run_bits);
+            }
+        }
+        if (kraft > (1U << max_code_length)) return false;
+
+        // every code is repeated in each table entry whose low bits match it. entries left at 0 belong to no code and are rejected when decoding
+        _table.assign(1U << max_code_length, 0);
+        const auto codes = CanonicalCodes(lengths);
+        for (unsigned s = 0; s < symbols; s++) {
+            if (lengths[s] == 0) continue;
+            for (unsigned i = codes[s]; i < _table.size(); i += 1U << lengths[s]) _table[i] = static_cast<uint16_t>((s << length_bits) | lengths[s]);
+        }
+        return true;
+    }
+
+    // Decode the next symbol, or return UINT_MAX for bits that aren't a code
+    unsigned Decode(BitReader &reader) const {
+        const uint16_t entry = _table[reader.Peek(max_code_length)];
+        if (entry == 0) return UINT_MAX;
+        reader.Skip(entry & ((1U << length_bits) - 1));
+        return entry >> length_bits;
+    }
+
+   private:
+    std::vector<uint16_t> _table;
+};
+
+// The most recently used values of a field, most recent first, kept identically by the coder and the transcoder
+class RecentValues {
+   public:
+    // The index of a value, or literal_token if it isn't one of the recent values
+    unsigned Find(uint64_t value) const {
+        for (unsigned i = 0; i < _count; i++) {
+            if (_values[i] == value) return i;
+        }
+        return literal_token;
+    }
+
+    uint64_t Get(unsigned index) const { return _values[index]; }
+    unsigned Count() const { return _count; }
+
+    // Move a value to the front, given the index returned by Find()
+    void Use(uint64_t value, unsigned index) {
+        if (index == literal_token) index = std::min(_count++, recent_values - 1);
+        _count = std::min(_count, recent_values);
+        std::copy_backward(_values.begin(), _values.begin() + index, _values.begin() + index + 1);
+        _values[0] = value;
+    }
+
+   private:
+    std::array<uint64_t, recent_values> _values = {};
+    unsigned _count = 0;
+};
+
+void EncodeField(BitWriter &writer, const uint8_t *blocks, size_t block_size, size_t count, const Field &field) {
+    std::vector<uint8_t> tokens(count);
+    std::vector<uint32_t> token_counts(token_symbols, 0);
+    std::vector<std::vector<uint32_t>> byte_counts(field.size, std::vector<uint32_t>(byte_symbols, 0));
+
+    RecentValues recent;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *block = blocks + i * block_size;
+        const uint64_t value = LoadField(block, field);
+        const unsigned token = recent.Find(value);
+
+        tokens[i] = static_cast<uint8_t>(token);
+        token_counts[token]++;
+        if (token == literal_token) {
+            for (unsigned b = 0; b < field.size; b++) byte_counts[b][block[field.offset + b]]++;
+        }
+        recent.Use(value, token);
+    }
+
+    const HuffmanEncoder token_code(token_counts, writer);
+    std::vector<HuffmanEncoder> byte_codes;
+    byte_codes.reserve(field.size);
+    for (unsigned b = 0; b < field.size; b++) byte_codes.emplace_back(byte_counts[b], writer);
+
+    for (size_t i = 0; i < count; i++) {
+        token_code.Write(writer, tokens[i]);
+        if (tokens[i] == literal_token) {
+            const uint8_t *block = blocks + i * block_size;
+            for (unsigned b = 0; b < field.size; b++) byte_codes[b].Write(writer, block[field.offset + b]);
+        }
+    }
+}
+
+bool DecodeField(BitReader &reader, uint8_t *blocks, size_t block_size, size_t count, const Field &field) {
+    HuffmanDecoder token_code;
+    if (!token_code.Read(reader, token_symbols)) return false;
+
+    std::array<HuffmanDecoder, 8> byte_codes;
+    for (unsigned b = 0; b < field.size; b++) {
+        if (!byte_codes[b].Read(reader, byte_symbols)) return false;
+    }
+
+    RecentValues recent;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t *block = blocks + i * block_size;
+        const unsigned token = token_code.Decode(reader);
+
+        uint64_t value = 0;
+        if (token == literal_token) {
+            for (unsigned b = 0; b < field.size; b++) {
+                const unsigned byte = byte_codes[b].Decode(reader);
+                if (byte == UINT_MAX) return false;
+                value |= static_cast<uint64_t>(byte) << (8 * b);
+            }
+        } else if (token < recent.Count()) {
+            value = recent.Get(token);
+        } else {
+            return false;
+        }
+
+        StoreField(block, field, value);
+        recent.Use(value, token);
+    }
+    return !reader.Overrun();
+}
+
+template <typename B> BlockTexture<B> TranscodeBlocks(const uint8_t *data, size_t size) {
+    const int width = static_cast<int>(GetU32(data + 8));
+    const int height = static_cast<int>(GetU32(data + 12));
+    const size_t chunk_blocks = GetU32(data + 16);
+    const size_t chunk_count = GetU32(data + 20);
+    if (width <= 0 || height <= 0) throw std::invalid_argument("Supercompressed texture has an invalid size");
+    if (chunk_blocks == 0 || chunk_blocks > max_chunk_blocks) throw std::invalid_argument("Supercompressed texture has an invalid chunk size");
+    if (header_size + 4 * chunk_count > size) throw std::invalid_argument("Supercompressed data is truncated");
+
+    // reject sizes that disagree with the chunk count before allocating the texture
+    const size_t blocks_x = (static_cast<size_t>(width) + B::Width - 1) / B::Width;
+    const size_t blocks_y = (static_cast<size_t>(height) + B::Height - 1) / B::Height;
+    if ((blocks_x * blocks_y + chunk_blocks - 1) / chunk_blocks != chunk_count)
+        throw std::invalid_argument("Supercompressed texture's chunk count doesn't match its size");
+
+    const size_t blocks = blocks_x * blocks_y;
+    std::vector<size_t> offsets(chunk_count + 1);
+    std::vector<bool> raw(chunk_count);
+    offsets[0] = header_size + 4 * chunk_count;
+    for (size_t c = 0; c < chunk_count; c++) {
+        const uint32_t entry = GetU32(data + header_size + 4 * c);
+        raw[c] = (entry & raw_chunk) != 0;
+        offsets[c + 1] = offsets[c] + (entry & ~raw_chunk);
+    }
+    if (offsets[chunk_count] > size) throw std::invalid_argument("Supercompressed data is truncated");
+
+    // every coded block takes at least one bit per field, so a header can't claim more blocks than the data could hold
+    for (size_t c = 0; c < chunk_count; c++) {
+        const size_t count = std::min(chunk_blocks, blocks - c * chunk_blocks);
+        const size_t chunk_size = offsets[c + 1] - offsets[c];
+        if (raw[c] ? chunk_size != count * sizeof(B) : count * Layout<B>::fields.size() > chunk_size * 8)
+            throw std::invalid_argument("Supercompressed texture has more blocks than its data can hold");
+    }
+
+    auto texture = BlockTexture<B>(width, height);
+    uint8_t *out = texture.Data();
+    bool valid = true;
+
+#pragma omp parallel for reduction(&& : valid) if (chunk_count > 1)
+    for (int c = 0; c < static_cast<int>(chunk_count); c++) {
+        const auto chunk = static_cast<size_t>(c);
+        const size_t first = chunk * chunk_blocks;
+        const size_t count = std::min(chunk_blocks, blocks - first);
+
+        if (raw[chunk]) {
+            std::memcpy(out + first * sizeof(B), data + offsets[chunk], count * sizeof(B));
+            continue;
+        }
+
+        BitReader reader(data + offsets[chunk], offsets[chunk + 1] - offsets[chunk]);
+        for (const auto &field : Layout<B>::fields) valid = valid && DecodeField(reader, out + first * sizeof(B), sizeof(B), count, field);
+    }
+
+    if (!valid) throw std::invalid_argument("Supercompressed data is corrupt");
+    return texture;
+}
+}  // namespace
+
+template <typename B> std::vector<uint8_t> Supercompress(const BlockTexture<B> &texture, unsigned chunk_blocks) {
+    if (chunk_blocks == 0 || chunk_blocks > max_chunk_blocks)
+        throw std::invalid_argument("Chunk size must be between 1 and " + std::to_string(max_chunk_blocks) + " blocks");
+
+    const size_t blocks = static_cast<size_t>(texture.BlocksX()) * static_cast<size_t>(texture.BlocksY());
+    const size_t chunk_count = (blocks + chunk_blocks - 1) / chunk_blocks;
+    const uint8_t *data = texture.Data();
+
+    std::vector<std::vector<uint8_t>> chunks(chunk_count);
+    std::vector<uint8_t> raw(chunk_count, 0);
+#pragma omp parallel for if (chunk_count > 1)
+    for (int c = 0; c < static_cast<int>(chunk_count); c++) {
+        const auto chunk = static_cast<size_t>(c);
+        const size_t first = chunk * chunk_blocks;
+        const size_t count = std::min<size_t>(chunk_blocks, blocks - first);
+
+        BitWriter writer;
+        for (const auto &field : Layout<B>::fields) EncodeField(writer, data + first * sizeof(B), sizeof(B), count, field);
+        chunks[chunk] = writer.Finish();
+
+        if (chunks[chunk].size() >= count * sizeof(B)) {
+            const uint8_t *begin = data + first * sizeof(B);
+            chunks[chunk].assign(begin, begin + count * sizeof(B));
+            raw[chunk] = 1;
+        }
+    }
+
+    std::array<uint8_t, header_size> header = {};
+    std::copy(magic.begin(), magic.end(), header.begin());
+    header[4] = version;
+    header[5] = Layout<B>::format;
+    PutU32(header.data() + 8, static_cast<uint32_t>(texture.Width()));
+    PutU32(header.data() + 12, static_cast<uint32_t>(texture.Height()));
+    PutU32(header.data() + 16, chunk_blocks);
+    PutU32(header.data() + 20, static_cast<uint32_t>(chunk_count));
+
+    size_t total = header_size + 4 * chunk_count;
+    for (const auto &chunk : chunks) total += chunk.size();
+
+    std::vector<uint8_t> out;
+    out.reserve(total);
+    out.insert(out.end(), header.begin(), header.end());
+    for (size_t c = 0; c < chunk_count; c++) AppendU32(out, static_cast<uint32_t>(chunks[c].size()) | (raw[c] ? raw_chunk : 0));
+    for (const auto &chunk : chunks) out.insert(out.end(), chunk.begin(), chunk.end());
+    return out;
+}
+
+SupercompressedTexture Transcode(const uint8_t *data, size_t size) {
+    if (size < header_size || !std::equal(magic.begin(), magic.end(), data)) throw std::invalid_argument("Data is not a supercompressed texture");
+    if (data[4] != version) throw std::invalid_argument("Unsupported supercompressed texture version " + std::to_string(data[4]));
+
+    switch (data[5]) {
+        case Layout<BC1Block>::format:
+            return TranscodeBlocks<BC1Block>(data, size);
+        case Layout<BC3Block>::format:
+            return TranscodeBlocks<BC3Block>(data, size);
+        case Layout<BC4Block>::format:
+            return TranscodeBlocks<BC4Block>(data, size);
+        case Layout<BC5Block>::format:
+            return TranscodeBlocks<BC5Block>(data, size);
+        default:
+            throw std::invalid_argument("Unsupported supercompressed texture format " + std::to_string(data[5]));
+    }
+}
+
+template std::vector<uint8_t> Supercompress(const BlockTexture<BC1Block> &, unsigned);
+template std::vector<uint8_t> Supercompress(const BlockTexture<BC3Block> &, unsigned);
+template std::vector<uint8_t> Supercompress(const BlockTexture<BC4Block> &, unsigned);
+template std::vector<uint8_t> Supercompress(const BlockTexture<BC5Block> &, unsigned);
+
+}  // namespace quicktex::s3tc
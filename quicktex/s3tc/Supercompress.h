@@ -0,0 +1,65 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include "../Texture.h"
+#include "bc1/BC1Block.h"
+#include "bc3/BC3Block.h"
+#include "bc4/BC4Block.h"
+#include "bc5/BC5Block.h"
+
+namespace quicktex::s3tc {
+
+/**
+ * Supercompression stores a BC1, BC3, BC4 or BC5 texture in a compact form for loading from disk.
+ * Each block is split into its endpoint and selector fields, and every field is gathered into its own stream, so runs of repeated endpoints
+ * or selectors sit next to each other. This works best on textures encoded with rate-distortion optimization.
+ *
+ * Blocks are coded in chunks that don't depend on each other, each with its own Huffman tables, so both coding and transcoding run in parallel.
+ * Within a chunk, each field of each block is coded as either the index of one of the recent values of that field, or as literal bytes.
+ * Chunks that coding wouldn't make smaller, such as those of small or noisy textures, are stored as plain blocks instead.
+ * Transcoding writes every field directly to its place in the output blocks, which are ready to upload to the GPU.
+ */
+using SupercompressedTexture = std::variant<BlockTexture<BC1Block>, BlockTexture<BC3Block>, BlockTexture<BC4Block>, BlockTexture<BC5Block>>;
+
+/// Default number of blocks in each independently coded chunk
+constexpr unsigned supercompress_chunk_blocks = 4096;
+
+/**
+ * Supercompress a block texture
+ * @param texture The texture to compress. Must be a BC1, BC3, BC4 or BC5 texture
+ * @param chunk_blocks The number of blocks in each chunk. Smaller chunks transcode across more threads, but compress less
+ * @return The supercompressed data, including a header with the texture's format and size
+ */
+template <typename B> std::vector<uint8_t> Supercompress(const BlockTexture<B> &texture, unsigned chunk_blocks = supercompress_chunk_blocks);
+
+/**
+ * Transcode supercompressed data back to a block texture of the format it was compressed from
+ * @param data Pointer to the supercompressed data
+ * @param size The size of the data in bytes
+ * @return The original texture, with exactly the same blocks
+ */
+SupercompressedTexture Transcode(const uint8_t *data, size_t size);
+
+}  // namespace quicktex::s3tc
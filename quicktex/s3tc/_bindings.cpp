@@ -16,8 +16,18 @@
     limitations under the License.
  */
 
+#include "../_bindings.h"
+
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
 
+#include "AutoEncoder.h"
+#include "Supercompress.h"
+#include "bc1/BC1Encoder.h"
 #include "interpolator/Interpolator.h"
 
 namespace py = pybind11;
@@ -28,17 +38,110 @@ using namespace quicktex::s3tc;
 
 void InitInterpolator(py::module_ &s3tc);
 void InitBC1(py::module_ &s3tc);
+void InitBC2(py::module_ &s3tc);
 void InitBC3(py::module_ &s3tc);
 void InitBC4(py::module_ &s3tc);
 void InitBC5(py::module_ &s3tc);
 
+template <typename B> void DefSupercompress(py::module_ &s3tc, const char *doc) {
+    s3tc.def(
+        "supercompress",
+        [](const BlockTexture<B> &texture, unsigned chunk_blocks) {
+            std::vector<uint8_t> data;
+            {
+                py::gil_scoped_release release;
+                data = Supercompress(texture, chunk_blocks);
+            }
+            return py::bytes(reinterpret_cast<const char *>(data.data()), data.size());
+        },
+        "texture"_a, "chunk_blocks"_a = supercompress_chunk_blocks, doc);
+}
+
 void InitS3TC(py::module_ &m) {
     py::module_ s3tc = m.def_submodule("_s3tc", "s3tc compression library based on rgbcx.h written by Richard Goldreich");
 
     InitInterpolator(s3tc);
     InitBC1(s3tc);
+    InitBC2(s3tc);
     InitBC4(s3tc);
     InitBC3(s3tc);
     InitBC5(s3tc);
+
+    // region AutoEncoder
+    py::class_<AutoEncoder> auto_encoder(s3tc, "AutoEncoder", R"doc(
+        Encodes textures to BC1 if they are fully opaque, or to BC3 if any pixel has alpha.
+        If the BC1 encoder has an alpha threshold, textures whose alpha is only ever 0 or 255 are encoded to BC1 with punch-through alpha instead of BC3.
+        Alpha is checked as each block is gathered for encoding, so choosing the format doesn't take its own pass over the texture.
+    )doc");
+
+    auto_encoder.def(py::init<unsigned, BC1Encoder::ColorMode, bool>(), "level"_a = 5, "color_mode"_a = BC1Encoder::ColorMode::FourColor,
+                     "punchthrough"_a = true, R"doc(
+        Create a new automatic encoder with the specified preset level and BC1 color mode.
+
+        :param int level: The preset level of both encoders, between 0 and 18 inclusive.
+            See :py:meth:`~quicktex.s3tc.bc1.BC1Encoder.set_level` for more information. Default: 5.
+        :param color_mode: The color mode used for opaque textures. BC3 always uses 4-color mode, and shares the BC1 encoder if this is
+            :py:attr:`~quicktex.s3tc.bc1.BC1Encoder.ColorMode.FourColor` and punch-through is disabled. Default: FourColor.
+        :param bool punchthrough: If true, textures with 1-bit alpha are encoded to BC1 with punch-through alpha, by setting the BC1 encoder's
+            :py:attr:`~quicktex.s3tc.bc1.BC1Encoder.alpha_threshold` to 128. Ignored in ThreeColorBlack mode. Default: True.
+    )doc");
+
+    auto_encoder.def("encode", &AutoEncoder::Encode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Encode a raw texture, choosing BC1 or BC3 by its alpha channel.
+
+        Blocks are encoded to BC1 until one with alpha that BC1 can't represent is found, and the rest of the texture is then encoded to BC3.
+        If the BC3 encoder shares the BC1 encoder, the blocks already encoded are reused as the color halves of their BC3 blocks.
+
+        :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while encoding, at no extra cost. Default: False
+        :returns: A new :py:class:`~quicktex.s3tc.bc1.BC1Texture` if the texture is fully opaque or has 1-bit alpha that the BC1 encoder
+            can punch through, otherwise a new :py:class:`~quicktex.s3tc.bc3.BC3Texture`
+    )doc");
+
+    auto_encoder.def_property_readonly("bc1_encoder", &AutoEncoder::GetBC1Encoder,
+                                       "Internal :py:class:`~quicktex.s3tc.bc1.BC1Encoder` used for opaque and 1-bit alpha textures. Readonly.");
+    auto_encoder.def_property_readonly("bc3_encoder", &AutoEncoder::GetBC3Encoder,
+                                       "Internal :py:class:`~quicktex.s3tc.bc3.BC3Encoder` used for textures with alpha. Readonly.");
+    // endregion
+
+    // region Supercompression
+    DefSupercompress<BC1Block>(s3tc, R"doc(
+        Supercompress a BC1, BC3, BC4 or BC5 texture into a compact form for storing on disk, which :py:func:`transcode` turns back into the same texture.
+
+        Each block's endpoints and selectors are split into separate streams, which are entropy coded in chunks that don't depend on each other,
+        so both compressing and transcoding run in parallel. Textures encoded with rate-distortion optimization, such as with
+        :py:attr:`~quicktex.s3tc.bc1.BC1Encoder.rdo_lambda`, compress much further.
+
+        :param texture: The texture to compress.
+        :param int chunk_blocks: The number of blocks in each chunk. Smaller chunks transcode across more threads, but compress less. Default: 4096.
+        :returns: The supercompressed data as bytes, including a header with the texture's format and size.
+    )doc");
+    DefSupercompress<BC3Block>(s3tc, "");
+    DefSupercompress<BC4Block>(s3tc, "");
+    DefSupercompress<BC5Block>(s3tc, "");
+
+    s3tc.def(
+        "transcode",
+        [](py::buffer data) {
+            auto info = data.request(false);
+            if (info.format != py::format_descriptor<uint8_t>::format())
+                throw std::runtime_error("Incompatible format in python buffer: expected a byte array.");
+            if (info.ndim != 1) throw std::runtime_error("Incompatible format in python buffer: Incorrect number of dimensions.");
+            if (info.strides[0] != 1) throw std::runtime_error("Incompatible format in python buffer: 1-D buffer is not contiguous.");
+
+            py::gil_scoped_release release;
+            return Transcode(reinterpret_cast<const uint8_t *>(info.ptr), static_cast<size_t>(info.size));
+        },
+        "data"_a, R"doc(
+        Transcode data written by :py:func:`supercompress` back into a block texture, ready to upload to the GPU.
+
+        Chunks are decoded in parallel, and each field is written straight to its place in the output blocks.
+
+        :param data: The supercompressed data, as bytes or another byte buffer.
+        :returns: A new :py:class:`~quicktex.s3tc.bc1.BC1Texture`, :py:class:`~quicktex.s3tc.bc3.BC3Texture`,
+            :py:class:`~quicktex.s3tc.bc4.BC4Texture` or :py:class:`~quicktex.s3tc.bc5.BC5Texture`, with exactly the same blocks as the compressed texture.
+        :raises ValueError: If the data isn't a supercompressed texture, or is truncated or corrupt.
+    )doc");
+    // endregion
 }
 }  // namespace quicktex::bindings
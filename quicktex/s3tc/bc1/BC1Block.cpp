@@ -40,6 +40,15 @@ void BC1Block::SetSelectors(const BC1Block::SelectorArray& unpacked) {
     _selectors = MapArray(unpacked, Pack<uint8_t, uint8_t, SelectorBits, Width>);
 }
 
+void BC1Block::Flip() { std::reverse(_selectors.begin(), _selectors.end()); }
+
+void BC1Block::Mirror() {
+    for (auto& row : _selectors) {
+        // swap the 2-bit selectors in each byte end-for-end
+        row = static_cast<uint8_t>(((row & 0x03) << 6) | ((row & 0x0C) << 2) | ((row & 0x30) >> 2) | ((row & 0xC0) >> 6));
+    }
+}
+
 bool BC1Block::operator==(const BC1Block& Rhs) const { return _color0 == Rhs._color0 && _color1 == Rhs._color1 && _selectors == Rhs._selectors; }
 bool BC1Block::operator!=(const BC1Block& Rhs) const { return !(Rhs == *this); }
 
@@ -120,6 +120,12 @@ class alignas(8) BC1Block {
 
     bool Is3Color() const { return GetColor0Raw() <= GetColor1Raw(); }
 
+    /// Flip the block vertically by reversing the order of its selector rows
+    void Flip();
+
+    /// Mirror the block horizontally by reversing the order of the selectors in each row
+    void Mirror();
+
     bool operator==(const BC1Block& Rhs) const;
     bool operator!=(const BC1Block& Rhs) const;
 };
@@ -22,10 +22,13 @@
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 
 #include "../../Color.h"
@@ -36,12 +39,76 @@
 #include "../../Vector4Int.h"
 #include "../../bitwiseEnums.h"
 #include "../../util.h"
+#include "../RDO.h"
 #include "Histogram.h"
 #include "OrderTable.h"
 #include "SingleColorTable.h"
 
 namespace quicktex::s3tc {
 
+namespace {
+// Records the time taken by a stage of EncodeBlock and how much it lowered the block's error.
+// Does nothing if stage is null, so encoding without stats only pays for a branch
+class StageTimer {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    StageTimer(BC1Encoder::Stats::Stage *stage, const unsigned &error) : StageTimer(stage, error, error) {}
+
+    // Measure the improvement from a given starting error, for stages that produce the block's first result
+    StageTimer(BC1Encoder::Stats::Stage *stage, const unsigned &error, unsigned before) : _stage(stage), _error(error), _before(before) {
+        if (_stage) _start = Clock::now();
+    }
+
+    ~StageTimer() {
+        if (!_stage) return;
+        _stage->seconds += std::chrono::duration<double>(Clock::now() - _start).count();
+        _stage->blocks++;
+        if (_before != UINT_MAX && _error < _before) {
+            _stage->improved++;
+            _stage->error_reduction += _before - _error;
+        }
+    }
+
+    StageTimer(const StageTimer &) = delete;
+    StageTimer &operator=(const StageTimer &) = delete;
+
+   private:
+    BC1Encoder::Stats::Stage *_stage;
+    const unsigned &_error;
+    unsigned _before;
+    Clock::time_point _start;
+};
+}  // namespace
+
+// stats
+
+BC1Encoder::Stats::Stage &BC1Encoder::Stats::Stage::operator+=(const Stage &rhs) {
+    blocks += rhs.blocks;
+    improved += rhs.improved;
+    error_reduction += rhs.error_reduction;
+    seconds += rhs.seconds;
+    return *this;
+}
+
+BC1Encoder::Stats &BC1Encoder::Stats::operator+=(const Stats &rhs) {
+    blocks += rhs.blocks;
+    solid_blocks += rhs.solid_blocks;
+    four_color_blocks += rhs.four_color_blocks;
+    three_color_blocks += rhs.three_color_blocks;
+    three_color_black_blocks += rhs.three_color_black_blocks;
+    punchthrough_blocks += rhs.punchthrough_blocks;
+    orderings += rhs.orderings;
+    search_rounds += rhs.search_rounds;
+    total_error += rhs.total_error;
+    endpoints += rhs.endpoints;
+    cluster_fit += rhs.cluster_fit;
+    three_color += rhs.three_color;
+    three_color_black += rhs.three_color_black;
+    endpoint_search += rhs.endpoint_search;
+    return *this;
+}
+
 // constructors
 
 BC1Encoder::BC1Encoder(unsigned int level, ColorMode color_mode, InterpolatorPtr interpolator) : _interpolator(interpolator), _color_mode(color_mode) {
@@ -257,14 +324,55 @@ void BC1Encoder::SetOrderings(OrderingPair orderings) {
 
 void BC1Encoder::SetPowerIterations(unsigned int power_iters) { _power_iterations = clamp(power_iters, min_power_iterations, max_power_iterations); }
 
+void BC1Encoder::SetChannelWeights(ChannelWeights weights) {
+    for (unsigned w : weights) {
+        if (w > max_channel_weight) throw std::invalid_argument("Channel weights must be at most " + std::to_string(max_channel_weight));
+    }
+    if (weights[0] == 0 && weights[1] == 0 && weights[2] == 0) throw std::invalid_argument("At least one channel weight must be nonzero");
+
+    _weights = Vector4Int((int)weights[0], (int)weights[1], (int)weights[2], 0);
+}
+
+void BC1Encoder::SetAlphaThreshold(uint8_t alpha_threshold) {
+    if (alpha_threshold > 0 && _color_mode == ColorMode::ThreeColorBlack) {
+        throw std::invalid_argument("Punch-through alpha can't be used in ThreeColorBlack mode, which already writes black pixels as transparent");
+    }
+    _alpha_threshold = alpha_threshold;
+}
+
+void BC1Encoder::SetRDOLambda(float rdo_lambda) {
+    if (!(rdo_lambda >= 0)) throw std::invalid_argument("RDO lambda must be at least 0");
+    _rdo_lambda = rdo_lambda;
+}
+
+void BC1Encoder::SetRDOWindow(unsigned rdo_window) {
+    if (rdo_window < 1 || rdo_window > max_rdo_window) throw std::invalid_argument("RDO window must be between 1 and " + std::to_string(max_rdo_window));
+    _rdo_window = rdo_window;
+}
+
 // Public methods
-BC1Block BC1Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
-    if (pixels.IsSingleColor()) {
-        // single-color pixel block, do it the fast way
-        return WriteBlockSolid(pixels.Get(0, 0));
+BC1Block BC1Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const { return EncodeBlock(pixels, nullptr); }
+
+BC1Block BC1Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels, Stats *stats) const { return EncodeBlock(pixels, pixels.GetMetrics(), stats); }
+
+BC1Block BC1Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels, const BlockMetrics &metrics, Stats *stats) const {
+    if (metrics.min.a < _alpha_threshold) {
+        // block has transparent pixels, which can only be written using selector 3 of a 3-color block
+        if (stats) stats->blocks++;
+        return EncodeBlockPunchthrough(pixels, stats);
     }
 
-    auto metrics = pixels.GetMetrics();
+    return EncodeBlockOpaque(pixels, metrics, stats);
+}
+
+BC1Block BC1Encoder::EncodeBlockOpaque(const ColorBlock<4, 4> &pixels, const BlockMetrics &metrics, Stats *stats) const {
+    if (stats) stats->blocks++;
+
+    if (metrics.min == metrics.max) {
+        // every channel including alpha has a single value, so this is a single-color pixel block. do it the fast way
+        if (stats) stats->solid_blocks++;
+        return WriteBlockSolid(metrics.min);
+    }
 
     const bool use_likely_orderings = (exhaustive || _orderings3 > 0 || _orderings4 > 0);
 
@@ -284,30 +392,47 @@ BC1Block BC1Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
     // Initial block generation
     EncodeResults orig;
     EncodeResults result;
-    for (unsigned round = 0; round < total_ep_passes; round++) {
-        EndpointMode endpoint_mode = (round == 1) ? EndpointMode::BoundingBox : _endpoint_mode;
+    {
+        // the block starts out as if it was filled with its average color, rounded to 5:6:5
+        unsigned flat_error = UINT_MAX;
+        if (stats && needs_block_error) {
+            const auto flat = Vector4Int(scale5To8(scale8To5(metrics.avg.r)), scale6To8(scale8To6(metrics.avg.g)), scale5To8(scale8To5(metrics.avg.b)), 0);
+            flat_error = 0;
+            for (int i = 0; i < 16; i++) flat_error += ((Vector4Int)pixels.Get(i) - flat).SqrMag(_weights);
+        }
 
-        EncodeResults trial_orig;
-        FindEndpoints(trial_orig, pixels, metrics, endpoint_mode);
+        StageTimer timer(stats ? &stats->endpoints : nullptr, result.error, flat_error);
+        for (unsigned round = 0; round < total_ep_passes; round++) {
+            EndpointMode endpoint_mode = (round == 1) ? EndpointMode::BoundingBox : _endpoint_mode;
 
-        EncodeResults trial_result = trial_orig;
+            EncodeResults trial_orig;
+            FindEndpoints(trial_orig, pixels, metrics, endpoint_mode);
 
-        FindSelectors<ColorMode::FourColor>(trial_result, pixels, error_mode);
-        RefineBlockLS<ColorMode::FourColor>(trial_result, pixels, metrics, error_mode, total_ls_passes);
+            EncodeResults trial_result = trial_orig;
 
-        if (!needs_block_error || trial_result.error < result.error) {
-            result = trial_result;
-            orig = trial_orig;
+            FindSelectors<ColorMode::FourColor>(trial_result, pixels, error_mode);
+            RefineBlockLS<ColorMode::FourColor>(trial_result, pixels, metrics, error_mode, total_ls_passes);
+
+            if (!needs_block_error || trial_result.error < result.error) {
+                result = trial_result;
+                orig = trial_orig;
+            }
         }
     }
 
+    unsigned orderings = 0;
+
     // First refinement pass using ordered cluster fit
     if (result.error > 0 && use_likely_orderings) {
-        for (unsigned iter = 0; iter < total_cf_passes; iter++) { RefineBlockCF<ColorMode::FourColor>(result, pixels, metrics, _error_mode, _orderings4); }
+        StageTimer timer(stats ? &stats->cluster_fit : nullptr, result.error);
+        for (unsigned iter = 0; iter < total_cf_passes; iter++) {
+            orderings += RefineBlockCF<ColorMode::FourColor>(result, pixels, metrics, _error_mode, _orderings4);
+        }
     }
 
     // try for 3-color block
     if (result.error > 0 && (bool)(_color_mode & ColorMode::ThreeColor)) {
+        StageTimer timer(stats ? &stats->three_color : nullptr, result.error);
         EncodeResults trial_result = orig;
 
         FindSelectors<ColorMode::ThreeColor>(trial_result, pixels, ErrorMode::Full);
@@ -316,7 +441,7 @@ BC1Block BC1Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
         // First refinement pass using ordered cluster fit
         if (trial_result.error > 0 && use_likely_orderings) {
             for (unsigned iter = 0; iter < total_cf_passes; iter++) {
-                RefineBlockCF<ColorMode::ThreeColor>(trial_result, pixels, metrics, ErrorMode::Full, _orderings3);
+                orderings += RefineBlockCF<ColorMode::ThreeColor>(trial_result, pixels, metrics, ErrorMode::Full, _orderings3);
             }
         }
 
@@ -325,6 +450,7 @@ BC1Block BC1Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
 
     // try for 3-color block with black
     if (result.error > 0 && (_color_mode == ColorMode::ThreeColorBlack) && metrics.has_black && !metrics.max.IsBlack()) {
+        StageTimer timer(stats ? &stats->three_color_black : nullptr, result.error);
         EncodeResults trial_result;
         BlockMetrics metrics_no_black = pixels.GetMetrics(true);
 
@@ -336,12 +462,151 @@ BC1Block BC1Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
     }
 
     // refine endpoints by searching for nearby colors
-    if (result.error > 0 && _search_rounds > 0) { EndpointSearch(result, pixels); }
+    unsigned search_rounds = 0;
+    if (result.error > 0 && _search_rounds > 0) {
+        StageTimer timer(stats ? &stats->endpoint_search : nullptr, result.error);
+        search_rounds = EndpointSearch(result, pixels);
+    }
+
+    if (stats) {
+        stats->orderings += orderings;
+        stats->search_rounds += search_rounds;
+        if (result.error != UINT_MAX) stats->total_error += result.error;
+        switch (result.color_mode) {
+            case ColorMode::ThreeColor:
+                stats->three_color_blocks++;
+                break;
+            case ColorMode::ThreeColorBlack:
+                stats->three_color_black_blocks++;
+                break;
+            default:
+                stats->four_color_blocks++;
+                break;
+        }
+    }
 
     return WriteBlock(result);
 }
 
+std::pair<BlockTexture<BC1Block>, BC1Encoder::Stats> BC1Encoder::EncodeWithStats(const RawTexture &decoded, bool flip) const {
+    auto encoded = BlockTexture<BC1Block>(decoded.Width(), decoded.Height());
+    int blocks_x = encoded.BlocksX();
+    int blocks_y = encoded.BlocksY();
+
+    // each thread collects its own stats, which are merged at the end
+    Stats stats;
+#pragma omp declare reduction(merge:Stats : omp_out += omp_in)
+#pragma omp parallel for reduction(merge : stats) if (static_cast<size_t>(blocks_x * blocks_y) >= MTThreshold())
+    for (int y = 0; y < blocks_y; y++) {
+        for (int x = 0; x < blocks_x; x++) {
+            auto pixels = decoded.GetBlock<4, 4>(x, y, flip);
+            encoded.SetBlock(x, y, EncodeBlock(pixels, &stats));
+        }
+    }
+
+    OptimizeTexture(decoded, encoded, flip);  // stats only cover EncodeBlock
+    return {std::move(encoded), stats};
+}
+
+bool BC1Encoder::OptimizeTexture(const RawTexture &decoded, BlockTexture<BC1Block> &encoded, bool flip) const {
+    if (_rdo_lambda <= 0) return false;
+
+    // pixels decoded as transparent, which candidates must keep so that punch-through and black pixels are unchanged
+    auto transparent = [](const BC1Block &block) {
+        if (!block.Is3Color()) return 0U;
+        const auto selectors = block.GetSelectors();
+        unsigned mask = 0;
+        for (unsigned i = 0; i < 16; i++) mask |= static_cast<unsigned>(selectors[i / 4][i % 4] == 3) << i;
+        return mask;
+    };
+
+    // squared distance between two colors, weighted like the errors EncodeBlock minimizes
+    auto distance = [this](const Color &a, const Color &b) { return ((Vector4Int)a - (Vector4Int)b).SqrMag(_weights); };
+
+    auto error = [&](const CBlock &pixels, const BC1Block &candidate, const BC1Block &original) -> std::optional<unsigned> {
+        if (transparent(candidate) != transparent(original)) return std::nullopt;
+
+        const auto colors = _interpolator->Interpolate565BC1(candidate.GetColor0Raw(), candidate.GetColor1Raw());
+        const auto selectors = candidate.GetSelectors();
+        unsigned total = 0;
+        for (unsigned i = 0; i < 16; i++) total += distance(pixels.Get(static_cast<int>(i)), colors[selectors[i / 4][i % 4]]);
+        return total;
+    };
+
+    auto reselect = [&](const CBlock &pixels, const BC1Block &endpoints, const BC1Block &original) {
+        const auto colors = _interpolator->Interpolate565BC1(endpoints.GetColor0Raw(), endpoints.GetColor1Raw());
+        const unsigned opaque_colors = endpoints.Is3Color() ? 3 : 4;
+        const unsigned mask = transparent(original);
+
+        BC1Block::SelectorArray selectors;
+        for (unsigned i = 0; i < 16; i++) {
+            uint8_t best = 3;
+            if (!(mask & (1U << i))) {
+                unsigned best_distance = UINT_MAX;
+                for (uint8_t s = 0; s < opaque_colors; s++) {
+                    const unsigned d = distance(pixels.Get(static_cast<int>(i)), colors[s]);
+                    if (d < best_distance) {
+                        best = s;
+                        best_distance = d;
+                    }
+                }
+            }
+            selectors[i / 4][i % 4] = best;
+        }
+        return BC1Block(endpoints.GetColor0Raw(), endpoints.GetColor1Raw(), selectors);
+    };
+
+    const RDOptimizer<BC1Block> optimizer(2 * BC1Block::EndpointSize, _rdo_lambda, _rdo_window);
+    return optimizer.Optimize(decoded, encoded, flip, error, reselect);
+}
+
 // Private methods
+BC1Block BC1Encoder::EncodeBlockPunchthrough(const CBlock &pixels, Stats *stats) const {
+    // transparent pixels are replaced with black, so the ignore_black path used for ThreeColorBlack blocks fits the endpoints to the rest
+    CBlock opaque_pixels = pixels;
+    uint16_t transparent = 0;
+    for (unsigned i = 0; i < 16; i++) {
+        if (pixels.Get(i).a < _alpha_threshold) {
+            transparent |= (uint16_t)(1U << i);
+            opaque_pixels.Set(i, Color(0, 0, 0, 0));
+        }
+    }
+
+    const BlockMetrics metrics = opaque_pixels.GetMetrics(true);
+    const unsigned total_ls_passes = two_ls_passes ? 2 : 1;
+
+    EncodeResults result;
+    if (metrics.max.IsBlack()) {
+        // every pixel is transparent or black
+        result.low = Color(0, 0, 0);
+        result.high = result.low;
+    } else if ((metrics.min.r == metrics.max.r && metrics.min.g == metrics.max.g && metrics.min.b == metrics.max.b) ||
+               (metrics.is_greyscale && metrics.max.r - metrics.min.r < 2)) {
+        // single color, matched using the midpoint of the 3-color palette
+        FindEndpointsSingleColor(result, metrics.avg, true);
+    } else {
+        FindEndpoints(result, opaque_pixels, metrics, EndpointMode::PCA, true);
+    }
+
+    FindSelectorsPunchthrough(result, opaque_pixels, transparent);
+
+    for (unsigned pass = 0; pass < total_ls_passes && result.error > 0; pass++) {
+        EncodeResults trial_result = result;
+        if (!RefineEndpointsLS<ColorMode::ThreeColorBlack>(trial_result, opaque_pixels, metrics)) break;
+
+        FindSelectorsPunchthrough(trial_result, opaque_pixels, transparent);
+        if (trial_result.error >= result.error) break;
+        result = trial_result;
+    }
+
+    if (stats) {
+        stats->punchthrough_blocks++;
+        stats->total_error += result.error;
+    }
+
+    return WriteBlock(result);
+}
+
 BC1Block BC1Encoder::WriteBlockSolid(Color color) const {
     uint8_t mask = 0xAA;  // 2222
     uint16_t min16, max16;
@@ -449,7 +714,7 @@ void BC1Encoder::FindEndpointsSingleColor(EncodeResults &result, Color color, bo
     BC1MatchEntry match_b = match5->at(color.b);
 
     result.color_mode = is_3color ? ColorMode::ThreeColor : ColorMode::FourColor;
-    result.error = match_r.error + match_g.error + match_b.error;
+    result.error = match_r.error * (unsigned)_weights[0] + match_g.error * (unsigned)_weights[1] + match_b.error * (unsigned)_weights[2];
     result.low = Color(match_r.low, match_g.low, match_b.low);
     result.high = Color(match_r.high, match_g.high, match_b.high);
     // selectors decided when writing, no point deciding them now
@@ -465,7 +730,7 @@ void BC1Encoder::FindEndpointsSingleColor(EncodeResults &result, const CBlock &p
     for (int i = 0; i < 16; i++) {
         Vector4Int pixel_vector = (Vector4Int)pixels.Get(i);
         auto diff = pixel_vector - result_vector;
-        result.error += diff.SqrMag();
+        result.error += diff.SqrMag(_weights);
         result.selectors[i] = 1;
     }
 }
@@ -695,7 +960,7 @@ template <BC1Encoder::ColorMode M> void BC1Encoder::FindSelectors(EncodeResults
     unsigned total_error = 0;
 
     if (error_mode == ErrorMode::None || error_mode == ErrorMode::Faster) {
-        Vector4Int axis = color_vectors[3] - color_vectors[0];
+        Vector4Int axis = (color_vectors[3] - color_vectors[0]) * _weights;
         std::array<int, 4> dots;
         for (int i = 0; i < 4; i++) { dots[i] = axis.Dot(color_vectors[i]); }
         int t0 = dots[0] + dots[1], t1 = dots[1] + dots[2], t2 = dots[2] + dots[3];
@@ -712,7 +977,7 @@ template <BC1Encoder::ColorMode M> void BC1Encoder::FindSelectors(EncodeResults
             if (error_mode == ErrorMode::Faster) {
                 // llvm is just going to unswitch this anyways so its not an issue
                 auto diff = pixel_vector - color_vectors[selector];
-                total_error += diff.SqrMag();
+                total_error += diff.SqrMag(_weights);
                 if (i % 4 != 0 && total_error >= result.error) break;  // check only once per row if we're generating too much error
             }
 
@@ -720,16 +985,17 @@ template <BC1Encoder::ColorMode M> void BC1Encoder::FindSelectors(EncodeResults
         }
     } else if (error_mode == ErrorMode::Check2) {
         Vector4Int axis = color_vectors[3] - color_vectors[0];
-        const float f = 4.0f / ((float)axis.SqrMag() + .00000125f);
+        Vector4Int weighted_axis = axis * _weights;
+        const float f = 4.0f / ((float)axis.SqrMag(_weights) + .00000125f);
 
         for (int i = 0; i < 16; i++) {
             Vector4Int pixel_vector = Vector4Int::FromColorRGB(pixels.Get(i));
             auto diff = pixel_vector - color_vectors[0];
-            float sel_f = (float)diff.Dot(axis) * f + 0.5f;
+            float sel_f = (float)diff.Dot(weighted_axis) * f + 0.5f;
             uint8_t sel = (uint8_t)clampi((int)sel_f, 1, 3);
 
-            unsigned err0 = (color_vectors[sel - 1] - pixel_vector).SqrMag();
-            unsigned err1 = (color_vectors[sel] - pixel_vector).SqrMag();
+            unsigned err0 = (color_vectors[sel - 1] - pixel_vector).SqrMag(_weights);
+            unsigned err1 = (color_vectors[sel] - pixel_vector).SqrMag(_weights);
 
             uint8_t best_sel = sel;
             unsigned best_err = err1;
@@ -758,7 +1024,7 @@ template <BC1Encoder::ColorMode M> void BC1Encoder::FindSelectors(EncodeResults
             // exhasustively check every pixel's distance from each color, and calculate the error
             for (uint8_t j = 0; j < max_sel; j++) {
                 auto diff = color_vectors[j] - pixel_vector;
-                unsigned err = diff.SqrMag();
+                unsigned err = diff.SqrMag(_weights);
                 if (err < best_error || ((err == best_error) && (j == 3))) {
                     best_error = err;
                     best_sel = j;
@@ -778,6 +1044,38 @@ template <BC1Encoder::ColorMode M> void BC1Encoder::FindSelectors(EncodeResults
     result.color_mode = M;
 }
 
+void BC1Encoder::FindSelectorsPunchthrough(EncodeResults &result, const CBlock &pixels, uint16_t transparent) const {
+    std::array<Color, 4> colors = _interpolator->InterpolateBC1(result.low, result.high, true);
+    std::array<Vector4Int, 3> color_vectors = {Vector4Int::FromColorRGB(colors[0]), Vector4Int::FromColorRGB(colors[2]),
+                                               Vector4Int::FromColorRGB(colors[1])};
+
+    unsigned total_error = 0;
+    for (unsigned i = 0; i < 16; i++) {
+        if (transparent & (1U << i)) {
+            // transparent pixels are always selector 3, and their color doesn't count towards the error
+            result.selectors[i] = 3;
+            continue;
+        }
+
+        Vector4Int pixel_vector = Vector4Int::FromColorRGB(pixels.Get(i));
+        unsigned best_error = UINT_MAX;
+        uint8_t best_sel = 0;
+        for (uint8_t j = 0; j < 3; j++) {
+            unsigned err = (color_vectors[j] - pixel_vector).SqrMag(_weights);
+            if (err < best_error) {
+                best_error = err;
+                best_sel = j;
+            }
+        }
+
+        total_error += best_error;
+        result.selectors[i] = best_sel;
+    }
+
+    result.error = total_error;
+    result.color_mode = ColorMode::ThreeColorBlack;
+}
+
 template <BC1Encoder::ColorMode M> bool BC1Encoder::RefineEndpointsLS(EncodeResults &result, const CBlock &pixels, BlockMetrics metrics) const {
     const int color_count = (unsigned)M & 0x0F;
     static_assert(color_count == 3 || color_count == 4);
@@ -875,7 +1173,7 @@ void BC1Encoder::RefineBlockLS(EncodeResults &result, const CBlock &pixels, cons
 }
 
 template <BC1Encoder::ColorMode M>
-void BC1Encoder::RefineBlockCF(EncodeResults &result, const CBlock &pixels, const BlockMetrics &metrics, ErrorMode error_mode, unsigned orderings) const {
+unsigned BC1Encoder::RefineBlockCF(EncodeResults &result, const CBlock &pixels, const BlockMetrics &metrics, ErrorMode error_mode, unsigned orderings) const {
     const int color_count = (unsigned)M & 0x0F;
     static_assert(color_count == 3 || color_count == 4);
     assert(result.color_mode != ColorMode::Incomplete);
@@ -923,12 +1221,13 @@ void BC1Encoder::RefineBlockCF(EncodeResults &result, const CBlock &pixels, cons
         }
 
         if (trial_result.error < result.error) { result = trial_result; }
-        if (trial_result.error == 0) break;
+        if (trial_result.error == 0) return q + 1U;
     }
+    return q_total;
 }
 
-void BC1Encoder::EndpointSearch(EncodeResults &result, const CBlock &pixels) const {
-    if (result.solid) return;
+unsigned BC1Encoder::EndpointSearch(EncodeResults &result, const CBlock &pixels) const {
+    if (result.solid) return 0;
 
     static const std::array<Vector4Int, 16> Voxels = {{
         {1, 0, 0, 3},    // 0
@@ -951,6 +1250,7 @@ void BC1Encoder::EndpointSearch(EncodeResults &result, const CBlock &pixels) con
 
     unsigned prev_improvement_index = 0;
     int forbidden_direction = -1;
+    unsigned rounds = 0;
 
     for (unsigned i = 0; i < _search_rounds; i++) {
         const unsigned voxel_index = (unsigned)(i & 15);
@@ -960,6 +1260,7 @@ void BC1Encoder::EndpointSearch(EncodeResults &result, const CBlock &pixels) con
 
         Vector4Int delta = Voxels[voxel_index];
         EncodeResults trial_result = result;
+        rounds++;
 
         if (i & 16) {
             trial_result.low.r = (uint8_t)clamp(trial_result.low.r + delta[0], 0, 31);
@@ -993,5 +1294,6 @@ void BC1Encoder::EndpointSearch(EncodeResults &result, const CBlock &pixels) con
 
         if (i - prev_improvement_index > 32) break;
     }
+    return rounds;
 }
 }  // namespace quicktex::s3tc
\ No newline at end of file
@@ -24,11 +24,13 @@
 #include <cstdint>
 #include <memory>
 #include <tuple>
+#include <utility>
 
 #include "../../Color.h"
 #include "../../ColorBlock.h"
 #include "../../Encoder.h"
 #include "../../Texture.h"
+#include "../../Vector4Int.h"
 #include "../interpolator/Interpolator.h"
 #include "BC1Block.h"
 #include "SingleColorTable.h"
@@ -43,11 +45,19 @@ class BC1Encoder final : public BlockEncoder<BlockTexture<BC1Block>> {
    public:
     using InterpolatorPtr = std::shared_ptr<Interpolator>;
     using OrderingPair = std::tuple<unsigned, unsigned>;
+    using ChannelWeights = std::array<unsigned, 3>;
     using CBlock = ColorBlock<4, 4>;
 
     static constexpr unsigned min_power_iterations = 4;
     static constexpr unsigned max_power_iterations = 10;
 
+    static constexpr unsigned max_channel_weight = 256;
+    // Rec.709 luma weights, matching Color::GetLuma, scaled to integers
+    static constexpr ChannelWeights perceptual_weights = {14, 46, 5};
+
+    // largest number of preceding blocks that rate-distortion optimization looks for matches in
+    static constexpr unsigned max_rdo_window = 256;
+
     enum class ColorMode {
         // An incomplete block with invalid selectors or endpoints
         Incomplete = 0x00,
@@ -93,6 +103,36 @@ class BC1Encoder final : public BlockEncoder<BlockTexture<BC1Block>> {
         PCA
     };
 
+    // Counters and timers for each stage of EncodeBlock, collected by EncodeWithStats
+    struct Stats {
+        struct Stage {
+            uint64_t blocks = 0;           // blocks that ran this stage
+            uint64_t improved = 0;         // blocks where this stage lowered the error
+            uint64_t error_reduction = 0;  // total error removed by this stage
+            double seconds = 0;            // time spent in this stage, summed over all threads
+
+            Stage &operator+=(const Stage &rhs);
+        };
+
+        uint64_t blocks = 0;             // total blocks encoded
+        uint64_t solid_blocks = 0;       // blocks that took the single-color shortcut
+        uint64_t four_color_blocks = 0;  // blocks written in 4-color mode, excluding solid blocks
+        uint64_t three_color_blocks = 0;
+        uint64_t three_color_black_blocks = 0;
+        uint64_t punchthrough_blocks = 0;  // blocks with transparent pixels, written in 3-color mode with selector 3
+        uint64_t orderings = 0;      // cluster fit orderings tried
+        uint64_t search_rounds = 0;  // endpoint search rounds run
+        uint64_t total_error = 0;    // sum of the final error of each block, if error was computed
+
+        Stage endpoints;  // FindEndpoints, FindSelectors and least-squares refinement for the initial block
+        Stage cluster_fit;
+        Stage three_color;
+        Stage three_color_black;
+        Stage endpoint_search;
+
+        Stats &operator+=(const Stats &rhs);
+    };
+
     bool exhaustive;
     bool two_ls_passes;
     bool two_ep_passes;
@@ -129,14 +169,43 @@ class BC1Encoder final : public BlockEncoder<BlockTexture<BC1Block>> {
     unsigned GetPowerIterations() const { return _power_iterations; }
     void SetPowerIterations(unsigned power_iters);
 
+    ChannelWeights GetChannelWeights() const { return {(unsigned)_weights[0], (unsigned)_weights[1], (unsigned)_weights[2]}; }
+    void SetChannelWeights(ChannelWeights weights);
+
+    uint8_t GetAlphaThreshold() const { return _alpha_threshold; }
+    void SetAlphaThreshold(uint8_t alpha_threshold);
+
+    float GetRDOLambda() const { return _rdo_lambda; }
+    void SetRDOLambda(float rdo_lambda);
+
+    unsigned GetRDOWindow() const { return _rdo_window; }
+    void SetRDOWindow(unsigned rdo_window);
+
     // Public Methods
     BC1Block EncodeBlock(const CBlock &pixels) const override;
 
+    // Encode a block, adding counters and timers for each stage to stats if it isn't null
+    BC1Block EncodeBlock(const CBlock &pixels, Stats *stats) const;
+
+    // Encode a block using metrics already computed by pixels.GetMetrics(), so encoders for other parts of a format can share them
+    BC1Block EncodeBlock(const CBlock &pixels, const BlockMetrics &metrics, Stats *stats = nullptr) const;
+    BC1Block EncodeBlockWithMetrics(const CBlock &pixels, const BlockMetrics &metrics) const override { return EncodeBlock(pixels, metrics); }
+
+    // Encode a block without punch-through alpha, ignoring the alpha threshold.
+    // BC2 and BC3 use this for their color blocks, which are always decoded in 4-color mode
+    BC1Block EncodeBlockOpaque(const CBlock &pixels, const BlockMetrics &metrics, Stats *stats = nullptr) const;
+
+    // Rate-distortion optimize an encoded texture if the RDO lambda is above 0, trading quality for better compression with zstd or deflate
+    bool OptimizeTexture(const RawTexture &decoded, BlockTexture<BC1Block> &encoded, bool flip) const override;
+
+    // Encode a texture and collect statistics about how each block was encoded.
+    // Slower than Encode due to the timers, so only use it for profiling
+    std::pair<BlockTexture<BC1Block>, Stats> EncodeWithStats(const RawTexture &decoded, bool flip = false) const;
+
     virtual size_t MTThreshold() const override { return 16; }
 
    private:
     using Hash = uint16_t;
-    using BlockMetrics = CBlock::Metrics;
 
     // Unpacked BC1 block with metadata
     struct EncodeResults {
@@ -168,15 +237,29 @@ class BC1Encoder final : public BlockEncoder<BlockTexture<BC1Block>> {
     unsigned _orderings4;
     unsigned _orderings3;
 
+    // per-channel weights applied to the squared error of each pixel. The alpha weight is always 0
+    Vector4Int _weights = {1, 1, 1, 0};
+
+    // pixels with alpha below this are written as transparent black using selector 3 of a 3-color block. 0 disables punch-through alpha
+    uint8_t _alpha_threshold = 0;
+
+    // weight of the estimated compressed size of each block against its squared error when rate-distortion optimizing. 0 disables it
+    float _rdo_lambda = 0;
+    unsigned _rdo_window = 64;
+
     BC1Block WriteBlockSolid(Color color) const;
     BC1Block WriteBlock(EncodeResults &result) const;
 
+    BC1Block EncodeBlockPunchthrough(const CBlock &pixels, Stats *stats) const;
+
     void FindEndpoints(EncodeResults &result, const CBlock &pixels, const BlockMetrics &metrics, EndpointMode endpoint_mode, bool ignore_black = false) const;
     void FindEndpointsSingleColor(EncodeResults &result, Color color, bool is_3color = false) const;
     void FindEndpointsSingleColor(EncodeResults &result, const CBlock &pixels, Color color, bool is_3color) const;
 
     template <ColorMode M> void FindSelectors(EncodeResults &result, const CBlock &pixels, ErrorMode error_mode) const;
 
+    void FindSelectorsPunchthrough(EncodeResults &result, const CBlock &pixels, uint16_t transparent) const;
+
     template <ColorMode M> bool RefineEndpointsLS(EncodeResults &result, const CBlock &pixels, BlockMetrics metrics) const;
 
     template <ColorMode M> void RefineEndpointsLS(EncodeResults &result, std::array<Vector4, 17> &sums, Vector4 &matrix, Hash hash) const;
@@ -185,8 +268,8 @@ class BC1Encoder final : public BlockEncoder<BlockTexture<BC1Block>> {
     void RefineBlockLS(EncodeResults &result, const CBlock &pixels, const BlockMetrics &metrics, ErrorMode error_mode, unsigned passes) const;
 
     template <ColorMode M>
-    void RefineBlockCF(EncodeResults &result, const CBlock &pixels, const BlockMetrics &metrics, ErrorMode error_mode, unsigned orderings) const;
+    unsigned RefineBlockCF(EncodeResults &result, const CBlock &pixels, const BlockMetrics &metrics, ErrorMode error_mode, unsigned orderings) const;
 
-    void EndpointSearch(EncodeResults &result, const CBlock &pixels) const;
+    unsigned EndpointSearch(EncodeResults &result, const CBlock &pixels) const;
 };
 }  // namespace quicktex::s3tc
@@ -24,8 +24,10 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "../../Decoder.h"
 #include "../../Encoder.h"
@@ -110,13 +112,75 @@ void InitBC1(py::module_ &s3tc) {
         :param Interpolator interpolator: The interpolation mode to use for encoding. Default: :py:class:`~quicktex.s3tc.interpolator.Interpolator`.
     )doc");
 
-    bc1_encoder.def("encode", &BC1Encoder::Encode, "texture"_a, R"doc(
+    py::class_<BC1Encoder::Stats> bc1_stats(bc1_encoder, "Stats", R"doc(
+        Statistics about how each block of a texture was encoded, returned by :py:meth:`encode` when ``stats=True``.
+        Times are summed over all threads, so they can exceed the wall-clock time of the encode.
+    )doc");
+
+    py::class_<BC1Encoder::Stats::Stage>(bc1_stats, "Stage", "Counters and timers for a single stage of the encoder.")
+        .def_readonly("blocks", &BC1Encoder::Stats::Stage::blocks, "Number of blocks that ran this stage.")
+        .def_readonly("improved", &BC1Encoder::Stats::Stage::improved, "Number of blocks where this stage lowered the error.")
+        .def_readonly("error_reduction", &BC1Encoder::Stats::Stage::error_reduction, "Total error removed by this stage.")
+        .def_readonly("seconds", &BC1Encoder::Stats::Stage::seconds, "Total time spent in this stage.")
+        .def_property_readonly(
+            "average_error_reduction",
+            [](const BC1Encoder::Stats::Stage &s) { return s.blocks ? static_cast<double>(s.error_reduction) / static_cast<double>(s.blocks) : 0.0; },
+            "Average error removed per block that ran this stage.");
+
+    bc1_stats.def_readonly("blocks", &BC1Encoder::Stats::blocks, "Total number of blocks encoded.")
+        .def_readonly("solid_blocks", &BC1Encoder::Stats::solid_blocks, "Number of single-color blocks that skipped the rest of the encoder.")
+        .def_readonly("four_color_blocks", &BC1Encoder::Stats::four_color_blocks, "Number of non-solid blocks written in 4-color mode.")
+        .def_readonly("three_color_blocks", &BC1Encoder::Stats::three_color_blocks, "Number of blocks written in 3-color mode.")
+        .def_readonly("three_color_black_blocks", &BC1Encoder::Stats::three_color_black_blocks, "Number of blocks written in 3-color mode with black pixels.")
+        .def_readonly("punchthrough_blocks", &BC1Encoder::Stats::punchthrough_blocks,
+                      "Number of blocks with pixels below :py:attr:`BC1Encoder.alpha_threshold`, written in 3-color mode with transparent pixels.")
+        .def_readonly("orderings", &BC1Encoder::Stats::orderings, "Number of cluster fit orderings tried.")
+        .def_readonly("search_rounds", &BC1Encoder::Stats::search_rounds, "Number of endpoint search rounds run.")
+        .def_readonly("total_error", &BC1Encoder::Stats::total_error, "Sum of the final error of every block. 0 if the error mode is None.")
+        .def_readonly("endpoints", &BC1Encoder::Stats::endpoints, "Finding the initial endpoints and selectors, including least-squares refinement.")
+        .def_readonly("cluster_fit", &BC1Encoder::Stats::cluster_fit, "Refining 4-color blocks with ordered cluster fit.")
+        .def_readonly("three_color", &BC1Encoder::Stats::three_color, "Trying 3-color blocks.")
+        .def_readonly("three_color_black", &BC1Encoder::Stats::three_color_black, "Trying 3-color blocks with black pixels.")
+        .def_readonly("endpoint_search", &BC1Encoder::Stats::endpoint_search, "Searching for nearby endpoints.");
+
+    bc1_encoder.def(
+        "encode",
+        [](const BC1Encoder &self, const RawTexture &texture, bool flip, bool stats, bool report) -> py::object {
+            const unsigned channels = 0x7;  // BC1 doesn't store alpha
+            if (!stats) {
+                if (report) return EncodeWithReport(self, texture, flip, BC1Decoder(self.GetInterpolator()), channels);
+                return EncodeTexture(self, texture, flip);
+            }
+
+            std::pair<BlockTexture<BC1Block>, BC1Encoder::Stats> result;
+            std::optional<ErrorReport> error_report;
+            {
+                py::gil_scoped_release release;
+                result = self.EncodeWithStats(texture, flip);
+                if (report) error_report = ErrorReport::Measure(texture, result.first, BC1Decoder(self.GetInterpolator()), channels, flip);
+            }
+
+            if (report) return py::make_tuple(std::move(result.first), result.second, std::move(*error_report));
+            return py::cast(std::move(result));
+        },
+        "texture"_a, "flip"_a = false, "stats"_a = false, "report"_a = false, R"doc(
         Encode a raw texture into a new BC1Texture using the encoder's current settings.
 
         :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while encoding, at no extra cost. Default: False
+        :param bool stats: If true, also collect a :py:class:`~quicktex.s3tc.bc1.BC1Encoder.Stats` object describing how each stage of the encoder performed.
+            This makes encoding slightly slower. Default: False
+        :param bool report: If true, also measure the error of each block while encoding and return an :py:class:`~quicktex.ErrorReport`.
+            The alpha channel is not included in the overall metrics. Default: False
         :returns: A new BC1Texture with the same dimension as the input.
+            If ``stats`` or ``report`` are True, a tuple of the texture followed by the stats and/or report that were requested.
     )doc");
 
+    DefEncodeInto(bc1_encoder);
+    DefEncodeBatch(bc1_encoder);
+    DefEncodeMulti(bc1_encoder);
+    DefEncodeStream(bc1_encoder);
+
     bc1_encoder.def("set_level", &BC1Encoder::SetLevel, "level"_a, R"doc(
         Select a preset quality level, between 0 and 18 inclusive.  Higher quality levels are slower, but produce blocks that are a closer match to input.
         This has no effect on the size of the resulting texture, since BC1 is a fixed-ratio compression method. For better control, see the advanced API below
@@ -162,6 +226,38 @@ void InitBC1(py::module_ &s3tc) {
     bc1_encoder.def_property("power_iterations", &BC1Encoder::GetPowerIterations, &BC1Encoder::SetPowerIterations,
                              "Number of power iterations used with the PCA endpoint mode. Value should be around 4 to 6. "
                              "Automatically clamped to between :py:const:`BC1Encoder.min_power_iterations` and :py:const:`BC1Encoder.max_power_iterations`");
+
+    bc1_encoder.def_readonly_static("perceptual_weights", &BC1Encoder::perceptual_weights);
+    bc1_encoder.def_readonly_static("max_channel_weight", &BC1Encoder::max_channel_weight);
+
+    bc1_encoder.def_property("channel_weights", &BC1Encoder::GetChannelWeights, &BC1Encoder::SetChannelWeights,
+                             "Weights applied to the squared error of the red, green and blue channels when choosing selectors and endpoints, as a 3-tuple. "
+                             "Set to :py:const:`BC1Encoder.perceptual_weights` to weigh channels by their contribution to luma, "
+                             "which reaches a given perceived quality at a lower level. Each weight must be at most "
+                             ":py:const:`BC1Encoder.max_channel_weight`. Default: (1, 1, 1)");
+
+    bc1_encoder.def_property("alpha_threshold", &BC1Encoder::GetAlphaThreshold, &BC1Encoder::SetAlphaThreshold,
+                             "Pixels with alpha below this value are written as transparent using punch-through alpha, "
+                             "where selector 3 of a 3-color block decodes to transparent black. Blocks with transparent pixels are always 3-color, "
+                             "and their endpoints are fit only to the opaque pixels. Can't be used in ThreeColorBlack mode, "
+                             "or by the BC1 encoder of a :py:class:`~quicktex.s3tc.bc3.BC3Encoder`. Set to 0 to disable. Default: 0");
+
+    bc1_encoder.def_readonly_static("max_rdo_window", &BC1Encoder::max_rdo_window);
+
+    bc1_encoder.def_property("rdo_lambda", &BC1Encoder::GetRDOLambda, &BC1Encoder::SetRDOLambda, R"doc(
+        Strength of rate-distortion optimization, which makes encoded textures compress better with zstd, deflate or other LZ-based compressors.
+        Once a texture is encoded, each block is replaced by a copy of a recent block, or by its endpoints or selectors, where that lowers
+        its squared error, weighted by :py:attr:`channel_weights`, plus ``rdo_lambda`` times an estimate of its compressed size in bits.
+        Transparent pixels are never changed. Higher values give smaller files at a lower quality, with values from 1 to 10 being typical.
+        Rate-distortion optimization is slow: on one core it makes encoding roughly 20 to 50 times slower with the default
+        :py:attr:`rdo_window`, and the cost grows with the window.
+        Only applies when encoding BC1 textures, not the color of BC3 textures. Set to 0 to disable. Default: 0
+    )doc");
+
+    bc1_encoder.def_property("rdo_window", &BC1Encoder::GetRDOWindow, &BC1Encoder::SetRDOWindow, R"doc(
+        Number of preceding blocks that rate-distortion optimization looks for matches in,
+        between 1 and :py:const:`BC1Encoder.max_rdo_window` inclusive. Larger windows find more matches but are slower. Default: 64
+    )doc");
     // endregion
 
     // region BC1Decoder
@@ -177,13 +273,16 @@ void InitBC1(py::module_ &s3tc) {
         :param Interpolator interpolator: The interpolation mode to use for decoding. Default: :py:class:`~quicktex.s3tc.interpolator.Interpolator`.
     )doc");
 
-    bc1_decoder.def("decode", &BC1Decoder::Decode, "texture"_a, R"doc(
+    bc1_decoder.def("decode", &BC1Decoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
         Decode a BC1 texture into a new RawTexture using the decoder's current settings.
 
         :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
         :returns: A new RawTexture with the same dimensions as the input
     )doc");
 
+    DefCompare(bc1_decoder, [](const BC1Decoder &self) { return self.write_alpha ? ErrorMetrics::AllChannels : 0x7U; });
+
     bc1_decoder.def_property_readonly("interpolator", &BC1Decoder::GetInterpolator, "The interpolator used by this decoder. This is a readonly property.");
     bc1_decoder.def_readwrite("write_alpha", &BC1Decoder::write_alpha, "Determines if the alpha channel of the output is written to.");
     // endregion
@@ -0,0 +1,112 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "../bc1/BC1Block.h"
+
+namespace quicktex::s3tc {
+
+class alignas(8) BC2Block {
+   public:
+    static constexpr size_t Width = 4;
+    static constexpr size_t Height = 4;
+
+    static constexpr size_t AlphaSize = 8;                     // size of the alpha array in bytes
+    static constexpr size_t AlphaBits = 4;                     // size of an alpha value in bits
+    static constexpr uint8_t AlphaMax = (1 << AlphaBits) - 1;  // maximum value of an alpha value
+
+    using AlphaArray = std::array<std::array<uint8_t, Width>, Height>;
+
+   private:
+    std::array<uint8_t, AlphaSize> _alpha;  // internal array of alpha bytes
+
+   public:
+    BC1Block color_block;
+
+    /// Create a new BC2Block
+    constexpr BC2Block() : _alpha(), color_block(BC1Block()) {
+        static_assert(sizeof(BC2Block) == 16);
+        static_assert(sizeof(std::array<BC2Block, 10>) == 16 * 10);
+        static_assert(alignof(BC2Block) >= 8);
+    }
+
+    /**
+     * Create a new BC2Block
+     * @param alphas the alpha values as a 4x4 array of integers, between 0 and 15 inclusive.
+     * @param color the BC1 block used for RGB data
+     */
+    BC2Block(const AlphaArray& alphas, const BC1Block& color) : color_block(color) { SetAlphas(alphas); }
+
+    /// Get the block's alpha values as a 4x4 array of integers between 0 and 15 inclusive.
+    AlphaArray GetAlphas() const {
+        AlphaArray unpacked;
+        const uint64_t packed = GetPackedAlpha();
+        for (unsigned i = 0; i < Width * Height; i++) unpacked[i / Width][i % Width] = static_cast<uint8_t>((packed >> (AlphaBits * i)) & AlphaMax);
+        return unpacked;
+    }
+
+    /// Set the block's alpha values from a 4x4 array of integers between 0 and 15 inclusive.
+    void SetAlphas(const AlphaArray& unpacked) {
+        uint64_t packed = 0;
+        for (unsigned i = 0; i < Width * Height; i++) packed |= static_cast<uint64_t>(unpacked[i / Width][i % Width] & AlphaMax) << (AlphaBits * i);
+        SetPackedAlpha(packed);
+    }
+
+    /// Get the block's alpha values packed into 64 bits, 4 bits each in row-major order starting from the least significant bit
+    uint64_t GetPackedAlpha() const {
+        uint64_t packed = 0;
+        for (unsigned i = 0; i < AlphaSize; i++) packed |= static_cast<uint64_t>(_alpha[i]) << (8 * i);
+        return packed;
+    }
+
+    /// Set the block's alpha values from 64 packed bits, 4 bits each in row-major order starting from the least significant bit
+    void SetPackedAlpha(uint64_t packed) {
+        for (unsigned i = 0; i < AlphaSize; i++) _alpha[i] = static_cast<uint8_t>(packed >> (8 * i));
+    }
+
+    /// Flip the block vertically by reversing the order of its 16-bit alpha rows and its selector rows
+    void Flip() {
+        std::swap(_alpha[0], _alpha[6]);
+        std::swap(_alpha[1], _alpha[7]);
+        std::swap(_alpha[2], _alpha[4]);
+        std::swap(_alpha[3], _alpha[5]);
+        color_block.Flip();
+    }
+
+    /// Mirror the block horizontally by reversing the order of the alpha values and selectors in each row
+    void Mirror() {
+        for (unsigned y = 0; y < Height; y++) {
+            // each row is two bytes holding two values each, so swap the bytes and then the nibbles within them
+            const uint8_t lo = _alpha[y * 2];
+            const uint8_t hi = _alpha[y * 2 + 1];
+            _alpha[y * 2] = static_cast<uint8_t>((hi >> 4) | (hi << 4));
+            _alpha[y * 2 + 1] = static_cast<uint8_t>((lo >> 4) | (lo << 4));
+        }
+        color_block.Mirror();
+    }
+
+    bool operator==(const BC2Block& Rhs) const { return _alpha == Rhs._alpha && color_block == Rhs.color_block; }
+    bool operator!=(const BC2Block& Rhs) const { return !(Rhs == *this); }
+};
+}  // namespace quicktex::s3tc
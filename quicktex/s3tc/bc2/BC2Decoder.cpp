@@ -0,0 +1,50 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "BC2Decoder.h"
+
+#include <array>
+#include <cstdint>
+
+#include "../../Color.h"
+#include "../../ColorBlock.h"
+#include "BC2Block.h"
+
+namespace quicktex::s3tc {
+
+namespace {
+// Expand each 4-bit alpha to 8 bits by repeating it in both nibbles. Written over flat lanes so it vectorizes
+std::array<uint8_t, 16> ExpandAlpha(uint64_t packed) {
+    std::array<uint8_t, 16> alphas;
+    for (unsigned i = 0; i < 16; i++) alphas[i] = static_cast<uint8_t>(((packed >> (4 * i)) & BC2Block::AlphaMax) * 17);
+    return alphas;
+}
+}  // namespace
+
+ColorBlock<4, 4> BC2Decoder::DecodeBlock(const BC2Block &block) const {
+    auto output = _bc1_decoder->DecodeBlock(block.color_block, false);
+    const auto alphas = ExpandAlpha(block.GetPackedAlpha());
+
+    std::array<Color, 16> colors;
+    for (int y = 0; y < 4; y++) output.GetRow(y, &colors[static_cast<size_t>(y * 4)]);
+    for (unsigned i = 0; i < 16; i++) colors[i].a = alphas[i];
+    for (int y = 0; y < 4; y++) output.SetRow(y, &colors[static_cast<size_t>(y * 4)]);
+
+    return output;
+}
+}  // namespace quicktex::s3tc
@@ -0,0 +1,85 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "BC2Encoder.h"
+
+#include <array>
+#include <cstdint>
+
+#include "../../Color.h"
+#include "../../ColorBlock.h"
+#include "../../util.h"
+#include "BC2Block.h"
+
+namespace quicktex::s3tc {
+
+namespace {
+using AlphaValues = std::array<uint8_t, 16>;
+
+// Round each alpha to the nearest multiple of 17, which is what each 4-bit value decodes to.
+// Written over flat 16-bit lanes so the division vectorizes
+uint64_t QuantizeAlpha(const AlphaValues &alphas) {
+    std::array<uint16_t, 16> levels;
+    for (unsigned i = 0; i < 16; i++) levels[i] = static_cast<uint16_t>((alphas[i] + 8U) / 17U);
+
+    uint64_t packed = 0;
+    for (unsigned i = 0; i < 16; i++) packed |= static_cast<uint64_t>(levels[i]) << (4 * i);
+    return packed;
+}
+
+// Quantize alpha with Floyd-Steinberg error diffusion, kept within the block so blocks can still be encoded in parallel.
+// Errors are accumulated at 16x scale to stay in integers
+uint64_t QuantizeAlphaDithered(const AlphaValues &alphas) {
+    std::array<int, 16> diffused = {0};
+
+    uint64_t packed = 0;
+    for (unsigned i = 0; i < 16; i++) {
+        const unsigned x = i % 4;
+        const unsigned y = i / 4;
+
+        const int value = alphas[i] * 16 + diffused[i];
+        const int level = clampi((value + 17 * 8) / (17 * 16), 0, BC2Block::AlphaMax);
+        const int error = value - level * 17 * 16;
+
+        if (x < 3) diffused[i + 1] += error * 7 / 16;
+        if (y < 3) {
+            if (x > 0) diffused[i + 3] += error * 3 / 16;
+            diffused[i + 4] += error * 5 / 16;
+            if (x < 3) diffused[i + 5] += error / 16;
+        }
+
+        packed |= static_cast<uint64_t>(level) << (4 * i);
+    }
+    return packed;
+}
+}  // namespace
+
+BC2Block BC2Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
+    auto output = BC2Block();
+    output.color_block = _bc1_encoder->EncodeBlockOpaque(pixels, pixels.GetMetrics());  // the BC1 encoder's alpha threshold doesn't apply to BC2
+
+    std::array<Color, 16> colors;
+    for (int y = 0; y < 4; y++) pixels.GetRow(y, &colors[static_cast<size_t>(y * 4)]);
+
+    AlphaValues alphas;
+    for (unsigned i = 0; i < 16; i++) alphas[i] = colors[i].a;
+
+    output.SetPackedAlpha(_dither ? QuantizeAlphaDithered(alphas) : QuantizeAlpha(alphas));
+    return output;
+}
+}  // namespace quicktex::s3tc
@@ -0,0 +1,59 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include "../../ColorBlock.h"
+#include "../../Encoder.h"
+#include "../../Texture.h"
+#include "../bc1/BC1Encoder.h"
+#include "../interpolator/Interpolator.h"
+#include "BC2Block.h"
+
+namespace quicktex::s3tc {
+
+class BC2Encoder : public BlockEncoder<BlockTexture<BC2Block>> {
+   public:
+    using BC1EncoderPtr = std::shared_ptr<BC1Encoder>;
+    using InterpolatorPtr = std::shared_ptr<Interpolator>;
+
+    BC2Encoder(unsigned level, bool dither, InterpolatorPtr interpolator)
+        : _bc1_encoder(std::make_shared<BC1Encoder>(level, BC1Encoder::ColorMode::FourColor, interpolator)), _dither(dither) {}
+
+    BC2Encoder(unsigned level = 5, bool dither = false) : BC2Encoder(level, dither, std::make_shared<Interpolator>()) {}
+
+    BC2Encoder(BC1EncoderPtr bc1_encoder, bool dither = false) : _bc1_encoder(bc1_encoder), _dither(dither) {
+        if (!_bc1_encoder) throw std::invalid_argument("Encoders cannot be null");
+        if (_bc1_encoder->GetColorMode() != BC1Encoder::ColorMode::FourColor) throw std::invalid_argument("BC2 color blocks must use 4-color mode");
+    }
+
+    BC2Block EncodeBlock(const ColorBlock<4, 4>& pixels) const override;
+
+    BC1EncoderPtr GetBC1Encoder() const { return _bc1_encoder; }
+
+    bool GetDither() const { return _dither; }
+    void SetDither(bool dither) { _dither = dither; }
+
+   private:
+    const BC1EncoderPtr _bc1_encoder;
+    bool _dither;
+};
+}  // namespace quicktex::s3tc
@@ -0,0 +1 @@
+from _quicktex._s3tc._bc2 import *
@@ -0,0 +1,136 @@
+/*  Quicktex Texture Compression Library
+    Copyright (C) 2021-2024 Andrew Cassidy <drewcassidy@me.com>
+    Partially derived from rgbcx.h written by Richard Geldreich <richgel99@gmail.com>
+    and licenced under the public domain
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "../../_bindings.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "../../Decoder.h"
+#include "../../Encoder.h"
+#include "../interpolator/Interpolator.h"
+#include "BC2Decoder.h"
+#include "BC2Encoder.h"
+
+namespace py = pybind11;
+namespace quicktex::bindings {
+
+using namespace quicktex::s3tc;
+using namespace pybind11::literals;
+using InterpolatorPtr = std::shared_ptr<Interpolator>;
+using BC1EncoderPtr = std::shared_ptr<BC1Encoder>;
+
+void InitBC2(py::module_ &s3tc) {
+    auto bc2 = s3tc.def_submodule("_bc2", "internal bc2 module");
+
+    // region BC2Block
+    auto bc2_block = BindBlock<BC2Block>(bc2, "BC2Block");
+    bc2_block.doc() = "A single BC2 block.";
+
+    bc2_block.def(py::init<>());
+    bc2_block.def(py::init<BC2Block::AlphaArray, BC1Block>(), "alphas"_a, "color_block"_a, R"doc(
+        Create a new BC2Block out of explicit alpha values and a BC1 block.
+
+        :param alphas: The alpha values as a 4x4 list of integers, between 0 and 15 inclusive.
+        :param BC1Block color_block: The BC1 block used for RGB data.
+    )doc");
+
+    bc2_block.def_property("alphas", &BC2Block::GetAlphas, &BC2Block::SetAlphas, R"doc(
+        The block's 4-bit alpha values as a 4x4 list of integers between 0 and 15 inclusive. Each value decodes to 17 times itself.
+
+        .. note::
+            This is a property, so directly modifying its value will not propogate back to the block.
+            Instead you must read, modify, then write the new list back to the property, like so::
+
+                alphas = block.alphas
+                alphas[0,0] = 0
+                block.alphas = alphas
+    )doc");
+    bc2_block.def_readwrite("color_block", &BC2Block::color_block, "The BC1 block used for rgb data.");
+    // endregion
+
+    // region BC2Texture
+    auto bc2_texture = BindBlockTexture<BC2Block>(bc2, "BC2Texture");
+    bc2_texture.doc() = "A texture comprised of BC2 blocks.";
+    // endregion
+
+    // region BC2Encoder
+    py::class_<BC2Encoder> bc2_encoder(bc2, "BC2Encoder", R"doc(
+        Encodes RGBA textures to BC2
+    )doc");
+
+    bc2_encoder.def(py::init<unsigned, bool>(), "level"_a = 5, "dither"_a = false);
+    bc2_encoder.def(py::init<unsigned, bool, InterpolatorPtr>(), "level"_a, "dither"_a, "interpolator"_a, R"doc(
+        Create a new BC2 encoder with the specified preset level, alpha dithering, and interpolator.
+
+        :param int level: The preset level of the resulting encoder, between 0 and 18 inclusive.
+            See :py:meth:`~quicktex.s3tc.bc1.BC1Encoder.set_level` for more information. Default: 5.
+        :param bool dither: If true, dither alpha when quantizing it to 4 bits. See :py:attr:`dither`. Default: False.
+        :param Interpolator interpolator: The interpolation mode to use for encoding. Default: :py:class:`~quicktex.s3tc.interpolator.Interpolator`.
+    )doc");
+
+    DefEncode(bc2_encoder, "BC2Texture", [](const BC2Encoder &self) {
+        return std::make_pair(BC2Decoder(self.GetBC1Encoder()->GetInterpolator()), ErrorMetrics::AllChannels);
+    });
+
+    DefEncodeInto(bc2_encoder);
+    DefEncodeBatch(bc2_encoder);
+    DefEncodeMulti(bc2_encoder);
+    DefEncodeStream(bc2_encoder);
+
+    bc2_encoder.def_property_readonly("bc1_encoder", &BC2Encoder::GetBC1Encoder,
+                                      "Internal :py:class:`~quicktex.s3tc.bc1.BC1Encoder` used for RGB data. Its alpha threshold is ignored. Readonly.");
+    bc2_encoder.def_property("dither", &BC2Encoder::GetDither, &BC2Encoder::SetDither, R"doc(
+        If true, alpha is quantized to 4 bits with Floyd-Steinberg error diffusion, which hides banding in smooth gradients.
+        Error is only diffused within each block, so blocks are still encoded independently. Default: False.
+    )doc");
+    // endregion
+
+    // region BC2Decoder
+    py::class_<BC2Decoder> bc2_decoder(bc2, "BC2Decoder", R"doc(
+        Decodes BC2 textures to RGBA
+    )doc");
+
+    bc2_decoder.def(py::init<>());
+    bc2_decoder.def(py::init<InterpolatorPtr>(), "interpolator"_a, R"doc(
+        Create a new BC2 decoder with the specified interpolator.
+
+        :param Interpolator interpolator: The interpolation mode to use for decoding. Default: :py:class:`~quicktex.s3tc.interpolator.Interpolator`.
+    )doc");
+
+    bc2_decoder.def("decode", &BC2Decoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
+        Decode a BC2 texture into a new RawTexture using the decoder's current settings.
+
+        :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
+        :returns: A new RawTexture with the same dimensions as the input
+    )doc");
+
+    DefCompare(bc2_decoder, [](const BC2Decoder &) { return ErrorMetrics::AllChannels; });
+
+    bc2_decoder.def_property_readonly("bc1_decoder", &BC2Decoder::GetBC1Decoder,
+                                      "Internal :py:class:`~quicktex.s3tc.bc1.BC1Decoder` used for RGB data. Readonly.");
+    // endregion
+}
+}  // namespace quicktex::bindings
@@ -53,6 +53,18 @@ class alignas(8) BC3Block {
         color_block = blocks.second;
     }
 
+    /// Flip the block vertically
+    void Flip() {
+        alpha_block.Flip();
+        color_block.Flip();
+    }
+
+    /// Mirror the block horizontally
+    void Mirror() {
+        alpha_block.Mirror();
+        color_block.Mirror();
+    }
+
     bool operator==(const BC3Block &Rhs) const { return alpha_block == Rhs.alpha_block && color_block == Rhs.color_block; }
     bool operator!=(const BC3Block &Rhs) const { return !(Rhs == *this); }
 };
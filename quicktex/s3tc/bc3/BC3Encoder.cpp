@@ -18,16 +18,34 @@
 
 #include "BC3Encoder.h"
 
+#include <array>
+
+#include "../../Color.h"
 #include "../../ColorBlock.h"
 #include "../bc1/BC1Block.h"
 #include "../bc4/BC4Block.h"
 #include "BC3Block.h"
 
 namespace quicktex::s3tc {
-BC3Block BC3Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
+// a single pass finds the color metrics for the BC1 half and the alpha range for the BC4 half
+BC3Block BC3Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const { return EncodeBlockWithMetrics(pixels, pixels.GetMetrics()); }
+
+BC3Block BC3Encoder::EncodeBlockWithMetrics(const ColorBlock<4, 4> &pixels, const BlockMetrics &metrics) const {
     auto output = BC3Block();
-    output.color_block = _bc1_encoder->EncodeBlock(pixels);
-    output.alpha_block = _bc4_encoder->EncodeBlock(pixels);
+    output.color_block = _bc1_encoder->EncodeBlockOpaque(pixels, metrics);  // the BC1 encoder's alpha threshold doesn't apply to BC3
+
+    if (metrics.min.a == metrics.max.a) {
+        output.alpha_block = BC4Block(metrics.min.a);  // solid alpha, including fully opaque blocks
+        return output;
+    }
+
+    std::array<Color, 16> colors;
+    for (int y = 0; y < 4; y++) pixels.GetRow(y, &colors[static_cast<size_t>(y * 4)]);
+
+    BC4Encoder::ValueArray alphas;
+    for (unsigned i = 0; i < 16; i++) alphas[i] = colors[i].a;
+
+    output.alpha_block = _bc4_encoder->EncodeValues(alphas);
     return output;
 }
-}  // namespace quicktex::s3tc
\ No newline at end of file
+}  // namespace quicktex::s3tc
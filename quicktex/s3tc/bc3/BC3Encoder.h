@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <stdexcept>
 
 #include "../../ColorBlock.h"
 #include "../../Encoder.h"
@@ -41,7 +42,13 @@ class BC3Encoder : public BlockEncoder<BlockTexture<BC3Block>> {
 
     BC3Encoder(unsigned level = 5) : BC3Encoder(level, std::make_shared<Interpolator>()) {}
 
+    BC3Encoder(BC1EncoderPtr bc1_encoder, BC4EncoderPtr bc4_encoder) : _bc1_encoder(bc1_encoder), _bc4_encoder(bc4_encoder) {
+        if (!_bc1_encoder || !_bc4_encoder) throw std::invalid_argument("Encoders cannot be null");
+        if (_bc1_encoder->GetColorMode() != BC1Encoder::ColorMode::FourColor) throw std::invalid_argument("BC3 color blocks must use 4-color mode");
+    }
+
     BC3Block EncodeBlock(const ColorBlock<4, 4>& pixels) const override;
+    BC3Block EncodeBlockWithMetrics(const ColorBlock<4, 4>& pixels, const BlockMetrics& metrics) const override;
 
     BC1EncoderPtr GetBC1Encoder() const { return _bc1_encoder; }
     BC4EncoderPtr GetBC4Encoder() const { return _bc4_encoder; }
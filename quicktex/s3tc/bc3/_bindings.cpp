@@ -80,15 +80,17 @@ void InitBC3(py::module_ &s3tc) {
         :param Interpolator interpolator: The interpolation mode to use for encoding. Default: :py:class:`~quicktex.s3tc.interpolator.Interpolator`.
     )doc");
 
-    bc3_encoder.def("encode", &BC3Encoder::Encode, "texture"_a, R"doc(
-        Encode a raw texture into a new BC3Texture using the encoder's current settings.
+    DefEncode(bc3_encoder, "BC3Texture", [](const BC3Encoder &self) {
+        return std::make_pair(BC3Decoder(self.GetBC1Encoder()->GetInterpolator()), ErrorMetrics::AllChannels);
+    });
 
-        :param RawTexture texture: Input texture to encode.
-        :returns: A new BC3Texture with the same dimension as the input.
-    )doc");
+    DefEncodeInto(bc3_encoder);
+    DefEncodeBatch(bc3_encoder);
+    DefEncodeMulti(bc3_encoder);
+    DefEncodeStream(bc3_encoder);
 
     bc3_encoder.def_property_readonly("bc1_encoder", &BC3Encoder::GetBC1Encoder,
-                                      "Internal :py:class:`~quicktex.s3tc.bc1.BC1Encoder` used for RGB data. Readonly.");
+                                      "Internal :py:class:`~quicktex.s3tc.bc1.BC1Encoder` used for RGB data. Its alpha threshold is ignored. Readonly.");
     bc3_encoder.def_property_readonly("bc4_encoder", &BC3Encoder::GetBC4Encoder,
                                       "Internal :py:class:`~quicktex.s3tc.bc4.BC4Encoder` used for alpha data. Readonly.");
     // endregion
@@ -105,13 +107,16 @@ void InitBC3(py::module_ &s3tc) {
         :param Interpolator interpolator: The interpolation mode to use for decoding. Default: :py:class:`~quicktex.s3tc.interpolator.Interpolator`.
     )doc");
 
-    bc3_decoder.def("decode", &BC3Decoder::Decode, "texture"_a, R"doc(
+    bc3_decoder.def("decode", &BC3Decoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
         Decode a BC3 texture into a new RawTexture using the decoder's current settings.
 
         :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
         :returns: A new RawTexture with the same dimensions as the input
     )doc");
 
+    DefCompare(bc3_decoder, [](const BC3Decoder &) { return ErrorMetrics::AllChannels; });
+
     bc3_decoder.def_property_readonly("bc1_decoder", &BC3Decoder::GetBC1Decoder,
                                       "Internal :py:class:`~quicktex.s3tc.bc1.BC1Decoder` used for RGB data. Readonly.");
     bc3_decoder.def_property_readonly("bc4_decoder", &BC3Decoder::GetBC4Decoder,
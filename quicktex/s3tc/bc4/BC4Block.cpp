@@ -41,6 +41,20 @@ void BC4Block::SetSelectors(const BC4Block::SelectorArray& unpacked) {
     _selectors = Unpack<uint64_t, uint8_t, 8, SelectorSize>(packed);
 }
 
+void BC4Block::Flip() {
+    // each row is 12 bits, with the first row in the least significant bits
+    auto packed = Pack<uint8_t, uint64_t, 8, SelectorSize>(_selectors);
+    packed = ((packed & 0xFFF) << 36) | ((packed & 0xFFF000) << 12) | ((packed >> 12) & 0xFFF000) | ((packed >> 36) & 0xFFF);
+    _selectors = Unpack<uint64_t, uint8_t, 8, SelectorSize>(packed);
+}
+
+void BC4Block::Mirror() {
+    // swap the 3-bit selectors in all 4 rows at once
+    auto packed = Pack<uint8_t, uint64_t, 8, SelectorSize>(_selectors);
+    packed = ((packed & 0x007007007007) << 9) | ((packed & 0x038038038038) << 3) | ((packed & 0x1C01C01C01C0) >> 3) | ((packed & 0xE00E00E00E00) >> 9);
+    _selectors = Unpack<uint64_t, uint8_t, 8, SelectorSize>(packed);
+}
+
 std::array<uint8_t, 8> BC4Block::GetValues6() const {
     return {alpha0,
             alpha1,
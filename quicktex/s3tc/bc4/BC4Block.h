@@ -90,12 +90,30 @@ class alignas(8) BC4Block {
     /// Get the block's selectors as a 4x4 array of integers between 0 and 7 inclusive.
     void SetSelectors(const SelectorArray& unpacked);
 
+    /// Get the block's selectors packed into 48 bits, 3 bits each in row-major order starting from the least significant bit
+    uint64_t GetPackedSelectors() const {
+        uint64_t packed = 0;
+        for (unsigned i = 0; i < SelectorSize; i++) packed |= static_cast<uint64_t>(_selectors[i]) << (8 * i);
+        return packed;
+    }
+
+    /// Set the block's selectors from 48 packed bits, 3 bits each in row-major order starting from the least significant bit
+    void SetPackedSelectors(uint64_t packed) {
+        for (unsigned i = 0; i < SelectorSize; i++) _selectors[i] = static_cast<uint8_t>(packed >> (8 * i));
+    }
+
     /// True if the block uses 6-value interpolation, i.e. alpha0 <= alpha1.
     bool Is6Value() const { return alpha0 <= alpha1; }
 
     /// The interpolated values of this block as an array of 8 integers.
     std::array<uint8_t, 8> GetValues() const { return Is6Value() ? GetValues6() : GetValues8(); }
 
+    /// Flip the block vertically by reversing the order of its 12-bit selector rows
+    void Flip();
+
+    /// Mirror the block horizontally by reversing the order of the selectors in each row
+    void Mirror();
+
     bool operator==(const BC4Block& Rhs) const;
     bool operator!=(const BC4Block& Rhs) const;
 
@@ -20,54 +20,280 @@
 
 #include <algorithm>
 #include <array>
+#include <climits>
+#include <cmath>
 #include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
 
 #include "../../Color.h"
 #include "../../ColorBlock.h"
+#include "../../util.h"
+#include "../RDO.h"
 #include "BC4Block.h"
 
 namespace quicktex::s3tc {
-BC4Block BC4Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
+
+namespace {
+using ValueArray = BC4Encoder::ValueArray;
+
+struct Candidate {
+    uint8_t alpha0;
+    uint8_t alpha1;
+    BC4Block::SelectorArray selectors;
+    unsigned error;
+
+    bool Is6Value() const { return alpha0 <= alpha1; }
+};
+
+// The values of a single channel of a block, in row-major order
+ValueArray ChannelValues(const ColorBlock<4, 4> &pixels, uint8_t channel) {
+    std::array<Color, 16> colors;
+    for (int y = 0; y < 4; y++) pixels.GetRow(y, &colors[static_cast<size_t>(y * 4)]);
+
+    ValueArray values;
+    for (unsigned i = 0; i < 16; i++) values[i] = colors[i][channel];
+    return values;
+}
+
+// Choose the closest palette entry for every value, returning the candidate and its total squared error
+Candidate Evaluate(const ValueArray &values, uint8_t alpha0, uint8_t alpha1) {
+    BC4Block endpoints;
+    endpoints.SetAlphas({alpha0, alpha1});
+    const auto palette = endpoints.GetValues();
+
+    Candidate result = {alpha0, alpha1, {}, 0};
+    for (unsigned i = 0; i < 16; i++) {
+        unsigned best_error = UINT_MAX;
+        uint8_t best_selector = 0;
+        for (uint8_t s = 0; s < 8; s++) {
+            int diff = (int)values[i] - (int)palette[s];
+            auto error = (unsigned)(diff * diff);
+            if (error < best_error) {
+                best_error = error;
+                best_selector = s;
+            }
+        }
+        result.selectors[i / 4][i % 4] = best_selector;
+        result.error += best_error;
+    }
+    return result;
+}
+
+// Move endpoints into the order that selects the candidate's mode: alpha0 > alpha1 for 8 values, alpha0 <= alpha1 for 6
+Candidate EvaluateOrdered(const ValueArray &values, int alpha0, int alpha1, bool six_value) {
+    alpha0 = std::clamp(alpha0, 0, 255);
+    alpha1 = std::clamp(alpha1, 0, 255);
+    if (six_value == (alpha0 > alpha1)) std::swap(alpha0, alpha1);
+    if (!six_value && alpha0 == alpha1) {
+        if (alpha0 < 255) {
+            alpha0++;
+        } else {
+            alpha1--;
+        }
+    }
+    return Evaluate(values, (uint8_t)alpha0, (uint8_t)alpha1);
+}
+
+// Fit endpoints to the candidate's selectors by least squares. Selectors for the fixed 0 and 255 values of 6-value mode are ignored
+bool RefineEndpoints(const ValueArray &values, Candidate &candidate) {
+    const bool six_value = candidate.Is6Value();
+    const int denominator = six_value ? 5 : 7;
+
+    // each value is approximated as (alpha0 * w0 + alpha1 * w1) / denominator
+    int64_t aa = 0, ab = 0, bb = 0, av = 0, bv = 0;
+    for (unsigned i = 0; i < 16; i++) {
+        int selector = candidate.selectors[i / 4][i % 4];
+        if (six_value && selector >= 6) continue;
+
+        int w1 = (selector == 0) ? 0 : (selector == 1) ? denominator : selector - 1;
+        int w0 = denominator - w1;
+        int v = values[i] * denominator;
+        aa += w0 * w0;
+        ab += w0 * w1;
+        bb += w1 * w1;
+        av += w0 * v;
+        bv += w1 * v;
+    }
+
+    int64_t det = aa * bb - ab * ab;
+    if (det == 0) return false;
+
+    auto alpha0 = (int)std::lround((double)(av * bb - bv * ab) / (double)det);
+    auto alpha1 = (int)std::lround((double)(aa * bv - ab * av) / (double)det);
+
+    auto refined = EvaluateOrdered(values, alpha0, alpha1, six_value);
+    if (refined.error >= candidate.error) return false;
+    candidate = refined;
+    return true;
+}
+
+// Try every endpoint pair within radius of the current one, until none is an improvement
+void SearchEndpoints(const ValueArray &values, Candidate &candidate, int radius) {
+    const bool six_value = candidate.Is6Value();
+    for (unsigned pass = 0; pass < 4 && candidate.error > 0; pass++) {
+        const int alpha0 = candidate.alpha0;
+        const int alpha1 = candidate.alpha1;
+        bool improved = false;
+
+        for (int d0 = -radius; d0 <= radius; d0++) {
+            for (int d1 = -radius; d1 <= radius; d1++) {
+                int new0 = alpha0 + d0, new1 = alpha1 + d1;
+                if (new0 < 0 || new0 > 255 || new1 < 0 || new1 > 255) continue;
+                if ((d0 == 0 && d1 == 0) || six_value != (new0 <= new1)) continue;
+
+                auto trial = Evaluate(values, (uint8_t)new0, (uint8_t)new1);
+                if (trial.error < candidate.error) {
+                    candidate = trial;
+                    improved = true;
+                }
+            }
+        }
+        if (!improved) break;
+    }
+}
+
+void Optimize(const ValueArray &values, Candidate &candidate, unsigned level) {
+    for (unsigned pass = 0; pass < 2 && candidate.error > 0; pass++) {
+        if (!RefineEndpoints(values, candidate)) break;
+    }
+    if (level >= 2) SearchEndpoints(values, candidate, (int)level - 1);
+}
+}  // namespace
+
+void BC4Encoder::SetRDOLambda(float rdo_lambda) {
+    if (!(rdo_lambda >= 0)) throw std::invalid_argument("RDO lambda must be at least 0");
+    _rdo_lambda = rdo_lambda;
+}
+
+void BC4Encoder::SetRDOWindow(unsigned rdo_window) {
+    if (rdo_window < 1 || rdo_window > max_rdo_window) throw std::invalid_argument("RDO window must be between 1 and " + std::to_string(max_rdo_window));
+    _rdo_window = rdo_window;
+}
+
+BC4Block BC4Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const { return EncodeValues(ChannelValues(pixels, _channel)); }
+
+BC4Block BC4Encoder::EncodeValues(const ValueArray &values) const {
+    if (_level == 0) return EncodeFast<1>({values})[0];
+
     uint8_t min = UINT8_MAX;
     uint8_t max = 0;
 
-    for (int i = 0; i < 16; i++) {
-        auto value = pixels.Get(i)[_channel];
-        min = std::min(min, value);
-        max = std::max(max, value);
+    for (unsigned i = 0; i < 16; i++) {
+        min = std::min(min, values[i]);
+        max = std::max(max, values[i]);
     }
 
     if (max == min) {
         return BC4Block(min);  // solid block
     }
 
-    auto selectors = BC4Block::SelectorArray();
-    const static std::array<uint8_t, 8> Levels = {1U, 7U, 6U, 5U, 4U, 3U, 2U, 0U};  // selector value options in linear order
+    // start from the same endpoints as level 0 and refine them
+    auto best = Evaluate(values, max, min);
+    Optimize(values, best, _level);
+
+    // 6-value mode spends two selectors on exact 0 and 255, leaving the endpoints to fit the remaining values
+    if (best.error > 0 && (min == 0 || max == 255)) {
+        uint8_t inner_min = UINT8_MAX;
+        uint8_t inner_max = 0;
+        for (unsigned i = 0; i < 16; i++) {
+            if (values[i] == 0 || values[i] == 255) continue;
+            inner_min = std::min(inner_min, values[i]);
+            inner_max = std::max(inner_max, values[i]);
+        }
+
+        if (inner_min <= inner_max) {
+            auto six_value = Evaluate(values, inner_min, inner_max);
+            Optimize(values, six_value, _level);
+            if (six_value.error < best.error) best = six_value;
+        }
+    }
+
+    return BC4Block(best.alpha0, best.alpha1, best.selectors);
+}
+
+template <size_t N> std::array<BC4Block, N> BC4Encoder::EncodeFast(const std::array<ValueArray, N> &values) {
+    std::array<uint8_t, N> mins;
+    std::array<uint8_t, N> maxes;
+    for (size_t b = 0; b < N; b++) {
+        uint8_t min = UINT8_MAX;
+        uint8_t max = 0;
+        for (unsigned i = 0; i < 16; i++) {
+            min = std::min(min, values[b][i]);
+            max = std::max(max, values[b][i]);
+        }
+        mins[b] = min;
+        maxes[b] = max;
+    }
 
     // BC4 floors in its divisions, which we compensate for with the 4 bias.
     // This function is optimal for all possible inputs (i.e. it outputs the same results as checking all 8 values and choosing the closest one).
-    const int bias = 4 - min * 14;
-    const int delta = max - min;
-
-    // Min is now 0. Compute thresholds between values by scaling max. It's x14 because we're adding two x7 scale factors.
-    // bias is applied here
-    std::array<int, 7> thresholds = {};
-    for (unsigned i = 0; i < 7; i++) thresholds[i] = delta * (1 + (2 * (int)i)) - bias;
+    // Min is moved to 0, and each value is compared against thresholds between values found by scaling max.
+    // It's x14 because we're adding two x7 scale factors. Every intermediate fits in 16 bits, and the values of all N blocks
+    // are laid out side by side, so each step below is a single loop over N * 16 lanes.
+    constexpr size_t Lanes = N * 16;
+    std::array<int16_t, Lanes> offsets;
+    std::array<int16_t, Lanes> deltas;
+    for (size_t b = 0; b < N; b++) {
+        for (unsigned i = 0; i < 16; i++) {
+            offsets[b * 16 + i] = static_cast<int16_t>((values[b][i] - mins[b]) * 14 + 4);
+            deltas[b * 16 + i] = static_cast<int16_t>(maxes[b] - mins[b]);
+        }
+    }
 
-    // iterate over all values and calculate selectors
-    for (int y = 0; y < 4; y++) {
-        for (int x = 0; x < 4; x++) {
-            int value = (int)pixels.Get(x, y)[_channel] * 14;  // multiply by demonimator
+    // level = number of thresholds this value is greater than
+    std::array<int16_t, Lanes> levels = {};
+    for (int16_t t = 1; t < 14; t += 2) {
+        for (size_t i = 0; i < Lanes; i++) levels[i] = static_cast<int16_t>(levels[i] + (offsets[i] >= deltas[i] * t));
+    }
 
-            // level = number of thresholds this value is greater than
-            unsigned level = 0;
-            for (unsigned c = 0; c < 7; c++) level += value >= thresholds[c];
+    // selector value options in linear order are {1, 7, 6, 5, 4, 3, 2, 0}
+    std::array<uint8_t, Lanes> selectors;
+    for (size_t i = 0; i < Lanes; i++) {
+        auto level = static_cast<uint8_t>(levels[i]);
+        selectors[i] = static_cast<uint8_t>(((8 - level) & 7) ^ (level == 0 || level == 7));
+    }
 
-            selectors[(unsigned)y][(unsigned)x] = Levels[level];
+    std::array<BC4Block, N> blocks;
+    for (size_t b = 0; b < N; b++) {
+        if (maxes[b] == mins[b]) {
+            blocks[b] = BC4Block(mins[b]);  // solid block
+            continue;
         }
+
+        // pack straight into the block's 48 selector bits
+        uint64_t packed = 0;
+        for (unsigned i = 0; i < 16; i++) packed |= static_cast<uint64_t>(selectors[b * 16 + i]) << (3 * i);
+
+        blocks[b].SetAlphas({maxes[b], mins[b]});
+        blocks[b].SetPackedSelectors(packed);
     }
+    return blocks;
+}
+
+bool BC4Encoder::OptimizeTexture(const RawTexture &decoded, BlockTexture<BC4Block> &encoded, bool flip) const {
+    if (_rdo_lambda <= 0) return false;
 
-    return BC4Block(max, min, selectors);
+    auto error = [&](const ColorBlock<4, 4> &pixels, const BC4Block &candidate, const BC4Block &) -> std::optional<unsigned> {
+        const auto values = ChannelValues(pixels, _channel);
+        const auto palette = candidate.GetValues();
+        const auto selectors = candidate.GetSelectors();
+        unsigned total = 0;
+        for (unsigned i = 0; i < 16; i++) total += static_cast<unsigned>(squarei(values[i] - palette[selectors[i / 4][i % 4]]));
+        return total;
+    };
+
+    auto reselect = [&](const ColorBlock<4, 4> &pixels, const BC4Block &endpoints, const BC4Block &) {
+        const auto result = Evaluate(ChannelValues(pixels, _channel), endpoints.alpha0, endpoints.alpha1);
+        return BC4Block(result.alpha0, result.alpha1, result.selectors);
+    };
+
+    const RDOptimizer<BC4Block> optimizer(2, _rdo_lambda, _rdo_window);
+    return optimizer.Optimize(decoded, encoded, flip, error, reselect);
 }
 
-}  // namespace quicktex::s3tc
\ No newline at end of file
+template std::array<BC4Block, 1> BC4Encoder::EncodeFast<1>(const std::array<ValueArray, 1> &);
+template std::array<BC4Block, 2> BC4Encoder::EncodeFast<2>(const std::array<ValueArray, 2> &);
+
+}  // namespace quicktex::s3tc
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <stdexcept>
 
@@ -30,16 +31,53 @@ namespace quicktex::s3tc {
 
 class BC4Encoder : public BlockEncoder<BlockTexture<BC4Block>> {
    public:
-    BC4Encoder(const uint8_t channel) {
+    using ValueArray = std::array<uint8_t, 16>;
+
+    /// Highest quality level. Level 0 uses the min and max of the block as endpoints, higher levels refine them
+    static constexpr unsigned max_level = 3;
+
+    /// Largest number of preceding blocks that rate-distortion optimization looks for matches in
+    static constexpr unsigned max_rdo_window = 256;
+
+    BC4Encoder(const uint8_t channel, unsigned level = 0) {
         if (channel >= 4) throw std::invalid_argument("Channel out of range");
         _channel = channel;
+        SetLevel(level);
     }
 
     BC4Block EncodeBlock(const ColorBlock<4, 4> &pixels) const override;
 
+    /// Encode a block from the 16 values of its channel, in row-major order
+    BC4Block EncodeValues(const ValueArray &values) const;
+
+    /**
+     * Encode N blocks at once at level 0, such as both channels of a BC5 block.
+     * All N blocks are thresholded together in fixed-size loops, so the compiler can vectorize them.
+     * @param values the 16 values of each block, in row-major order
+     */
+    template <size_t N> static std::array<BC4Block, N> EncodeFast(const std::array<ValueArray, N> &values);
+
     uint8_t GetChannel() const { return _channel; }
 
+    unsigned GetLevel() const { return _level; }
+    void SetLevel(unsigned level) {
+        if (level > max_level) throw std::invalid_argument("Level out of range, must be between 0 and 3 inclusive");
+        _level = level;
+    }
+
+    float GetRDOLambda() const { return _rdo_lambda; }
+    void SetRDOLambda(float rdo_lambda);
+
+    unsigned GetRDOWindow() const { return _rdo_window; }
+    void SetRDOWindow(unsigned rdo_window);
+
+    /// Rate-distortion optimize an encoded texture if the RDO lambda is above 0, trading quality for better compression with zstd or deflate
+    bool OptimizeTexture(const RawTexture &decoded, BlockTexture<BC4Block> &encoded, bool flip) const override;
+
    private:
     uint8_t _channel;
+    unsigned _level;
+    float _rdo_lambda = 0;  // weight of the estimated compressed size of each block against its squared error. 0 disables RDO
+    unsigned _rdo_window = 64;
 };
 }  // namespace quicktex::s3tc
@@ -83,20 +83,41 @@ void InitBC4(py::module_ &s3tc) {
         Encodes single-channel textures to BC4.
     )doc");
 
-    bc4_encoder.def(py::init<uint8_t>(), py::arg("channel") = 3, R"doc(
-        Create a new BC4 encoder with the specified channel
+    bc4_encoder.def(py::init<uint8_t, unsigned>(), py::arg("channel") = 3, py::arg("level") = 0, R"doc(
+        Create a new BC4 encoder with the specified channel and quality level
 
         :param int channel: the channel that will be read from. 0 to 3 inclusive. Default: 3 (alpha).
+        :param int level: The quality level of the encoder. 0 to :py:const:`BC4Encoder.max_level` inclusive. See :py:attr:`level`. Default: 0.
     )doc");
 
-    bc4_encoder.def("encode", &BC4Encoder::Encode, "texture"_a, R"doc(
-        Encode a raw texture into a new BC4Texture using the encoder's current settings.
+    DefEncode(bc4_encoder, "BC4Texture", [](const BC4Encoder &self) { return std::make_pair(BC4Decoder(self.GetChannel()), 1U << self.GetChannel()); });
 
-        :param RawTexture texture: Input texture to encode.
-        :returns: A new BC4Texture with the same dimension as the input.
-    )doc");
+    DefEncodeInto(bc4_encoder);
+    DefEncodeBatch(bc4_encoder);
+    DefEncodeMulti(bc4_encoder);
+    DefEncodeStream(bc4_encoder);
     
     bc4_encoder.def_property_readonly("channel", &BC4Encoder::GetChannel, "The channel that will be read from. 0 to 3 inclusive. Readonly.");
+    bc4_encoder.def_readonly_static("max_level", &BC4Encoder::max_level);
+    bc4_encoder.def_property("level", &BC4Encoder::GetLevel, &BC4Encoder::SetLevel, R"doc(
+        The quality level of the encoder, between 0 and :py:const:`BC4Encoder.max_level` inclusive.
+
+        Level 0 uses the minimum and maximum of each block as its endpoints, which is the fastest.
+        Level 1 refines the endpoints by least squares, and tries 6-value mode for blocks containing pure 0 or 255 values.
+        Levels 2 and 3 also search the neighbourhood of the refined endpoints, which is slower but closer to the input.
+    )doc");
+
+    bc4_encoder.def_readonly_static("max_rdo_window", &BC4Encoder::max_rdo_window);
+    bc4_encoder.def_property("rdo_lambda", &BC4Encoder::GetRDOLambda, &BC4Encoder::SetRDOLambda, R"doc(
+        Strength of rate-distortion optimization, which trades quality for better compression with zstd, deflate or other LZ-based compressors.
+        See :py:attr:`BC1Encoder.rdo_lambda <quicktex.s3tc.bc1.BC1Encoder.rdo_lambda>`. BC4 blocks encode so quickly that on one core
+        rate-distortion optimization makes encoding roughly 100 to 200 times slower with the default :py:attr:`rdo_window`.
+        Only applies when encoding BC4 textures, not the channels of BC3 or BC5 textures. Set to 0 to disable. Default: 0
+    )doc");
+    bc4_encoder.def_property("rdo_window", &BC4Encoder::GetRDOWindow, &BC4Encoder::SetRDOWindow, R"doc(
+        Number of preceding blocks that rate-distortion optimization looks for matches in,
+        between 1 and :py:const:`BC4Encoder.max_rdo_window` inclusive. Default: 64
+    )doc");
     // endregion
 
     // region BC4Decoder
@@ -110,12 +131,15 @@ void InitBC4(py::module_ &s3tc) {
         :param int channel: The channel that will be written to. 0 to 3 inclusive. Default: 3 (alpha).
     )doc");
 
-    bc4_decoder.def("decode", &BC4Decoder::Decode, "texture"_a, R"doc(
+    bc4_decoder.def("decode", &BC4Decoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
         Decode a BC4 texture into a new RawTexture using the decoder's current settings.
 
         :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
         :returns: A new RawTexture with the same dimensions as the input
     )doc");
+
+    DefCompare(bc4_decoder, [](const BC4Decoder &self) { return 1U << self.GetChannel(); });
     
     bc4_decoder.def_property_readonly("channel", &BC4Decoder::GetChannel, "The channel that will be written to. 0 to 3 inclusive. Readonly.");
     // endregion
@@ -52,6 +52,18 @@ class alignas(8) BC5Block {
         chan1_block = pair.second;
     }
 
+    /// Flip the block vertically
+    void Flip() {
+        chan0_block.Flip();
+        chan1_block.Flip();
+    }
+
+    /// Mirror the block horizontally
+    void Mirror() {
+        chan0_block.Mirror();
+        chan1_block.Mirror();
+    }
+
     bool operator==(const BC5Block &Rhs) const { return chan0_block == Rhs.chan0_block && chan1_block == Rhs.chan1_block; }
     bool operator!=(const BC5Block &Rhs) const { return !(Rhs == *this); }
 };
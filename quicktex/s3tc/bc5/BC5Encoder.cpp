@@ -18,14 +18,34 @@
 
 #include "BC5Encoder.h"
 
+#include <array>
+
+#include "../../Color.h"
 #include "../../ColorBlock.h"
 #include "../bc4/BC4Block.h"
 
 namespace quicktex::s3tc {
 BC5Block BC5Encoder::EncodeBlock(const ColorBlock<4, 4> &pixels) const {
-    auto output = BC5Block();
-    output.chan0_block = _chan0_encoder->EncodeBlock(pixels);
-    output.chan1_block = _chan1_encoder->EncodeBlock(pixels);
-    return output;
+    if (_chan0_encoder->GetLevel() > 0 || _chan1_encoder->GetLevel() > 0) {
+        auto output = BC5Block();
+        output.chan0_block = _chan0_encoder->EncodeBlock(pixels);
+        output.chan1_block = _chan1_encoder->EncodeBlock(pixels);
+        return output;
+    }
+
+    // deinterleave both channels and encode them in a single pass
+    std::array<Color, 16> colors;
+    for (int y = 0; y < 4; y++) pixels.GetRow(y, &colors[static_cast<size_t>(y * 4)]);
+
+    const auto chan0 = _chan0_encoder->GetChannel();
+    const auto chan1 = _chan1_encoder->GetChannel();
+    std::array<BC4Encoder::ValueArray, 2> values;
+    for (unsigned i = 0; i < 16; i++) {
+        values[0][i] = colors[i][chan0];
+        values[1][i] = colors[i][chan1];
+    }
+
+    auto [chan0_block, chan1_block] = BC4Encoder::EncodeFast<2>(values);
+    return BC5Block(chan0_block, chan1_block);
 }
-}  // namespace quicktex::s3tc
\ No newline at end of file
+}  // namespace quicktex::s3tc
@@ -64,19 +64,23 @@ void InitBC5(py::module_ &s3tc) {
         Encodes dual-channel textures to BC5.
     )doc");
 
-    bc5_encoder.def(py::init<uint8_t, uint8_t>(), py::arg("chan0") = 0, py::arg("chan1") = 1, R"doc(
-        Create a new BC5 encoder with the specified channels
+    bc5_encoder.def(py::init<uint8_t, uint8_t, unsigned>(), py::arg("chan0") = 0, py::arg("chan1") = 1, py::arg("level") = 0, R"doc(
+        Create a new BC5 encoder with the specified channels and quality level
 
         :param int chan0: the first channel that will be read from. 0 to 3 inclusive. Default: 0 (red).
         :param int chan1: the second channel that will be read from. 0 to 3 inclusive. Default: 1 (green).
+        :param int level: The quality level of both channels' encoders. See :py:attr:`quicktex.s3tc.bc4.BC4Encoder.level`. Default: 0.
     )doc");
 
-    bc5_encoder.def("encode", &BC5Encoder::Encode, "texture"_a, R"doc(
-        Encode a raw texture into a new BC5Texture using the encoder's current settings.
+    DefEncode(bc5_encoder, "BC5Texture", [](const BC5Encoder &self) {
+        auto [chan0, chan1] = self.GetChannels();
+        return std::make_pair(BC5Decoder(chan0, chan1), (1U << chan0) | (1U << chan1));
+    });
 
-        :param RawTexture texture: Input texture to encode.
-        :returns: A new BC5Texture with the same dimension as the input.
-    )doc");
+    DefEncodeInto(bc5_encoder);
+    DefEncodeBatch(bc5_encoder);
+    DefEncodeMulti(bc5_encoder);
+    DefEncodeStream(bc5_encoder);
 
     bc5_encoder.def_property_readonly("channels", &BC5Encoder::GetChannels, "A 2-tuple of channels that will be read from. 0 to 3 inclusive. Readonly.");
     bc5_encoder.def_property_readonly("bc4_encoders", &BC5Encoder::GetBC4Encoders,
@@ -95,13 +99,19 @@ void InitBC5(py::module_ &s3tc) {
         :param int chan1: the second channel that will be written to. 0 to 3 inclusive. Default: 1 (green).
     )doc");
 
-    bc5_decoder.def("decode", &BC5Decoder::Decode, "texture"_a, R"doc(
+    bc5_decoder.def("decode", &BC5Decoder::Decode, "texture"_a, "flip"_a = false, py::call_guard<py::gil_scoped_release>(), R"doc(
         Decode a BC5 texture into a new RawTexture using the decoder's current settings.
 
         :param RawTexture texture: Input texture to encode.
+        :param bool flip: If true, vertically flip the texture while decoding, at no extra cost. Default: False
         :returns: A new RawTexture with the same dimensions as the input
     )doc");
 
+    DefCompare(bc5_decoder, [](const BC5Decoder &self) {
+        auto [chan0, chan1] = self.GetChannels();
+        return (1U << chan0) | (1U << chan1);
+    });
+
     bc5_decoder.def_property_readonly("channels", &BC5Decoder::GetChannels, "A 2-tuple of channels that will be written to. 0 to 3 inclusive. Readonly.");
     bc5_decoder.def_property_readonly("bc4_decoders", &BC5Decoder::GetBC4Decoders,
                                       "2-tuple of internal :py:class:`~quicktex.s3tc.bc4.BC4Decoder` s used for each channel. Readonly.");
@@ -31,6 +31,21 @@
 #define assert5bit(x) assert(x <= UINT5_MAX)
 #define assert6bit(x) assert(x <= UINT6_MAX)
 
+// Compile a kernel for baseline x86-64 (SSE2), x86-64-v2 (SSE4.1), x86-64-v3 (AVX2) and x86-64-v4 (AVX-512), with the best one for the CPU
+// selected when the library is loaded. Everything the kernel calls within its file is inlined into each version, so the whole kernel uses the
+// wider instructions. Dispatch uses ifunc resolvers, so this is only enabled on Linux. Virtual functions can't be multiversioned, and functions
+// called from other files raise ODR warnings under LTO, so this is only used on kernels private to a file. aarch64 always has NEON, so there
+// is nothing to dispatch there.
+#if defined(QUICKTEX_MULTIVERSION) && defined(__x86_64__) && defined(__linux__) && defined(__has_attribute)
+#if __has_attribute(target_clones) && __has_attribute(flatten)
+#define QUICKTEX_TARGET_CLONES __attribute__((target_clones("default", "arch=x86-64-v2", "arch=x86-64-v3", "arch=x86-64-v4"), flatten))
+#endif
+#endif
+
+#ifndef QUICKTEX_TARGET_CLONES
+#define QUICKTEX_TARGET_CLONES
+#endif
+
 template <typename S> constexpr auto iabs(S i) {
     static_assert(!std::is_unsigned<S>::value);
     using O = typename std::make_unsigned<S>::type;
@@ -54,6 +54,11 @@ class CMakeBuild(build_ext):
         ]
         build_args = []
 
+        # pass through optimization options for release builds, see DEVELOPMENT.md
+        for option in ("QUICKTEX_LTO", "QUICKTEX_PGO", "QUICKTEX_PGO_DIR", "QUICKTEX_MULTIVERSION"):
+            if option in os.environ:
+                cmake_args += ["-D{}={}".format(option, os.environ[option])]
+
         if self.compiler.compiler_type != "msvc":
             # Using Ninja-build since it a) is available as a wheel and b)
             # multithreads automatically. MSVC would require all variables be
@@ -0,0 +1,55 @@
+import os.path
+
+import pytest
+from PIL import Image
+
+from quicktex import RawTexture
+from quicktex.s3tc import AutoEncoder
+from quicktex.s3tc.bc1 import BC1Encoder, BC1Texture
+from quicktex.s3tc.bc3 import BC3Encoder, BC3Texture
+from .images import image_path
+
+
+@pytest.mark.parametrize('color_mode', [BC1Encoder.ColorMode.FourColor, BC1Encoder.ColorMode.ThreeColor])
+class TestAutoEncoder:
+    """Test AutoEncoder"""
+
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA')
+
+    def test_opaque(self, color_mode):
+        """Test that opaque textures are encoded to BC1"""
+        image = self.image.copy()
+        image.putalpha(255)
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        out_tex = AutoEncoder(5, color_mode).encode(rawtex)
+        assert isinstance(out_tex, BC1Texture)
+        assert out_tex.tobytes() == BC1Encoder(5, color_mode).encode(rawtex).tobytes()
+
+    def test_alpha(self, color_mode):
+        """Test that textures with any alpha are encoded to BC3, even if only the last block has it"""
+        image = self.image.copy()
+        image.putalpha(255)
+        image.putpixel((image.width - 1, image.height - 1), (0, 0, 0, 254))
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        out_tex = AutoEncoder(5, color_mode).encode(rawtex)
+        assert isinstance(out_tex, BC3Texture)
+        assert out_tex.tobytes() == BC3Encoder(5).encode(rawtex).tobytes()
+
+    def test_punchthrough(self, color_mode):
+        """Test that textures with 1-bit alpha are encoded to BC1 with punch-through alpha, unless it's disabled"""
+        image = self.image.copy()
+        image.putalpha(255)
+        image.putpixel((image.width - 1, image.height - 1), (0, 0, 0, 0))
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        encoder = BC1Encoder(5, color_mode)
+        encoder.alpha_threshold = 128
+
+        out_tex = AutoEncoder(5, color_mode).encode(rawtex)
+        assert isinstance(out_tex, BC1Texture)
+        assert out_tex.tobytes() == encoder.encode(rawtex).tobytes()
+
+        out_tex = AutoEncoder(5, color_mode, punchthrough=False).encode(rawtex)
+        assert isinstance(out_tex, BC3Texture)
@@ -1,10 +1,14 @@
 import math
+import os.path
+import zlib
 
 import pytest
-from PIL import Image, ImageChops
+from PIL import Image, ImageChops, ImageStat
 
+import quicktex.dds as dds
+from quicktex import RawTexture, ErrorReport
 from quicktex.s3tc.bc1 import BC1Block, BC1Texture, BC1Encoder, BC1Decoder
-from .images import BC1Blocks
+from .images import BC1Blocks, image_path
 
 in_endpoints = ((253, 254, 255), (65, 70, 67))  # has some small changes that should encode the same in 5:6:5
 out_endpoints = ((255, 255, 255, 255), (66, 69, 66, 255))
@@ -52,6 +56,17 @@ class TestBC1Block:
         assert block.endpoints == out_endpoints
         assert not block.is_3color
 
+    def test_flip_mirror(self):
+        """Test flipping and mirroring a block"""
+        flip_selectors = [[0, 1, 2, 3], [1, 2, 3, 0], [2, 3, 0, 1], [3, 3, 0, 0]]
+        block = BC1Block(*in_endpoints, flip_selectors)
+
+        block.flip()
+        assert block.selectors == flip_selectors[::-1]
+
+        block.mirror()
+        assert block.selectors == [row[::-1] for row in flip_selectors[::-1]]
+
     def test_eq(self):
         """Test equality between two identical blocks"""
         block1 = BC1Block.frombytes(block_bytes)
@@ -185,6 +200,204 @@ class TestBC1Encoder:
             assert not out_block.is_3color
 
 
+class TestBC1TextureEncoding:
+    """Test encoding whole textures with BC1Encoder"""
+
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA')
+
+    def crop(self, width, height):
+        """The top left corner of the test image, and a raw texture of it"""
+        image = self.image.crop((0, 0, width, height))
+        return image, RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+    @staticmethod
+    def strips(image, strip_height):
+        data = image.tobytes('raw', 'RGBA')
+        row_bytes = image.width * 4
+        return (data[y * row_bytes : (y + strip_height) * row_bytes] for y in range(0, image.height, strip_height))
+
+    @pytest.mark.parametrize('strip_height', [4, 16, 36])
+    def test_encode_stream(self, strip_height):
+        """Test that encoding a texture in strips produces the same blocks as encoding it all at once"""
+        image, rawtex = self.crop(128, 200)
+
+        encoder = BC1Encoder()
+        expected = encoder.encode(rawtex)
+
+        encoded = []
+        encoder.encode_stream(self.strips(image, strip_height), image.width, lambda tex: encoded.append(tex.tobytes()))
+
+        assert b''.join(encoded) == expected.tobytes()
+
+    def test_encode_stream_dds(self, tmp_path):
+        """Test that a DDS file written one strip at a time contains the same blocks as encoding the whole image"""
+        image, rawtex = self.crop(128, 200)
+        path = tmp_path / 'stream.dds'
+
+        dds.encode_stream(path, self.strips(image, 16), image.size, BC1Encoder(), 'DXT1')
+        result = dds.read(path)
+
+        assert result.size == image.size
+        assert result.textures[0].tobytes() == BC1Encoder().encode(rawtex).tobytes()
+
+    @pytest.mark.parametrize('height', [196, 204])
+    def test_encode_stream_dds_rows(self, tmp_path, height):
+        """Test that strips with fewer or more rows than the image are rejected instead of writing an incomplete file"""
+        image, _ = self.crop(128, height)
+        path = tmp_path / 'stream.dds'
+
+        with pytest.raises(ValueError):
+            dds.encode_stream(path, self.strips(image, 16), (128, 200), BC1Encoder(), 'DXT1')
+        assert not path.exists()
+
+    def test_encode_stream_dds_unwritable(self, tmp_path):
+        """Test that failing to create the file raises the original error, rather than one from removing it"""
+        image, _ = self.crop(128, 200)
+        path = tmp_path / 'missing' / 'stream.dds'
+
+        with pytest.raises(FileNotFoundError) as excinfo:
+            dds.encode_stream(path, self.strips(image, 16), image.size, BC1Encoder(), 'DXT1')
+        assert excinfo.value.__context__ is None
+
+    def test_encode_into(self):
+        """Test that encoding into a texture viewing an external buffer writes the encoded blocks into that buffer"""
+        image, rawtex = self.crop(128, 200)
+
+        encoder = BC1Encoder()
+        expected = encoder.encode(rawtex)
+
+        buffer = bytearray(expected.nbytes)
+        view = BC1Texture.from_buffer(buffer, *image.size)
+        assert view.is_view
+
+        encoder.encode_into(rawtex, view)
+        assert bytes(buffer) == expected.tobytes()
+
+    def test_encode_flip(self):
+        """Test that flipping while encoding matches encoding a flipped image"""
+        image, _ = self.crop(128, 202)
+        flipped = image.transpose(Image.FLIP_TOP_BOTTOM)
+
+        encoder = BC1Encoder()
+        expected = encoder.encode(RawTexture.frombytes(flipped.tobytes('raw', 'RGBA'), *image.size))
+        encoded = encoder.encode(RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size), flip=True)
+
+        assert encoded.tobytes() == expected.tobytes()
+
+    def test_encode_stats(self):
+        """Test that collecting stats doesn't change the encoded texture, and that the counters add up"""
+        _, rawtex = self.crop(128, 200)
+
+        encoder = BC1Encoder(18, BC1Encoder.ColorMode.ThreeColorBlack)
+        expected = encoder.encode(rawtex)
+        encoded, stats = encoder.encode(rawtex, stats=True)
+
+        assert encoded.tobytes() == expected.tobytes()
+        assert stats.blocks == (128 // 4) * (200 // 4)
+        modes = [stats.solid_blocks, stats.four_color_blocks, stats.three_color_blocks, stats.three_color_black_blocks]
+        assert stats.blocks == sum(modes) + stats.punchthrough_blocks
+        assert stats.endpoints.blocks == stats.blocks - stats.solid_blocks
+        assert 0 < stats.endpoints.improved <= stats.endpoints.blocks
+        assert stats.cluster_fit.improved <= stats.cluster_fit.blocks
+        assert stats.orderings > 0 and stats.search_rounds > 0
+
+    def test_encode_report(self):
+        """Test that the quality report matches decoding the texture and comparing it with the original"""
+        image, rawtex = self.crop(128, 200)
+
+        encoder = BC1Encoder()
+        encoded, report = encoder.encode(rawtex, report=True)
+        assert isinstance(report, ErrorReport)
+        assert encoded.tobytes() == encoder.encode(rawtex).tobytes()
+
+        decoded = BC1Decoder().decode(encoded)
+        diff = ImageChops.difference(image, Image.frombuffer('RGBA', decoded.size, decoded).convert('RGBA'))
+        rms = ImageStat.Stat(diff).rms
+
+        for channel in range(3):
+            assert report.metrics.channel_mse[channel] == pytest.approx(rms[channel] ** 2)
+        assert report.metrics.mse == pytest.approx(sum(rms[c] ** 2 for c in range(3)) / 3)
+        assert report.metrics.psnr == pytest.approx(10 * math.log10(255**2 / report.metrics.mse))
+        assert 0 < report.metrics.ssim <= 1
+
+        assert (report.blocks_x, report.blocks_y) == (32, 50)
+        assert len(report.block_errors) == 50 and len(report.block_errors[0]) == 32
+        assert max(max(row) for row in report.block_errors) == report.max_block_error
+
+        _, _, combined = encoder.encode(rawtex, stats=True, report=True)
+        assert combined.metrics.mse == pytest.approx(report.metrics.mse)
+
+    def test_channel_weights(self):
+        """Test setting channel weights, and that perceptual weights lower the luma error"""
+        encoder = BC1Encoder()
+        assert encoder.channel_weights == (1, 1, 1)
+
+        with pytest.raises(ValueError):
+            encoder.channel_weights = (0, 0, 0)
+        with pytest.raises(ValueError):
+            encoder.channel_weights = (BC1Encoder.max_channel_weight + 1, 1, 1)
+
+        image, rawtex = self.crop(*self.image.size)
+
+        def luma_mse(encoded):
+            decoded = BC1Decoder().decode(encoded)
+            original = image.convert('L')
+            result = Image.frombuffer('RGBA', decoded.size, decoded).convert('L')
+            return ImageStat.Stat(ImageChops.difference(original, result)).rms[0] ** 2
+
+        uniform = encoder.encode(rawtex)
+        encoder.channel_weights = BC1Encoder.perceptual_weights
+        assert encoder.channel_weights == BC1Encoder.perceptual_weights
+        perceptual = encoder.encode(rawtex)
+
+        assert perceptual.tobytes() != uniform.tobytes()
+        assert luma_mse(perceptual) < luma_mse(uniform)
+
+    def test_alpha_threshold(self):
+        """Test that pixels below the alpha threshold decode as transparent, and that the rest stay opaque"""
+        encoder = BC1Encoder(5, BC1Encoder.ColorMode.ThreeColor)
+        assert encoder.alpha_threshold == 0
+
+        with pytest.raises(ValueError):
+            BC1Encoder(5, BC1Encoder.ColorMode.ThreeColorBlack).alpha_threshold = 128
+
+        image = self.image.copy()
+        alpha = Image.linear_gradient('L').resize(image.size)
+        image.putalpha(alpha)
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        encoder.alpha_threshold = 128
+        encoded, stats = encoder.encode(rawtex, stats=True)
+        assert stats.punchthrough_blocks > 0
+
+        decoded = Image.frombuffer('RGBA', encoded.size, BC1Decoder(True).decode(encoded))
+        expected = alpha.point(lambda a: 0 if a < 128 else 255)
+        assert decoded.getchannel('A').tobytes() == expected.tobytes()
+
+    def test_rdo(self):
+        """Test that rate-distortion optimization makes textures more compressible without losing much quality"""
+        encoder = BC1Encoder(5)
+        assert encoder.rdo_lambda == 0
+
+        with pytest.raises(ValueError):
+            encoder.rdo_lambda = -1
+        with pytest.raises(ValueError):
+            encoder.rdo_window = 0
+        with pytest.raises(ValueError):
+            encoder.rdo_window = BC1Encoder.max_rdo_window + 1
+
+        _, rawtex = self.crop(256, 256)
+        plain = encoder.encode(rawtex)
+
+        encoder.rdo_lambda = 5
+        optimized, report = encoder.encode(rawtex, report=True)
+        assert optimized.tobytes() == encoder.encode(rawtex).tobytes()
+        assert report.metrics.psnr == pytest.approx(BC1Decoder().compare(rawtex, optimized).psnr)
+
+        assert len(zlib.compress(optimized.tobytes(), 9)) < 0.75 * len(zlib.compress(plain.tobytes(), 9))
+        assert BC1Decoder().compare(rawtex, optimized).psnr > BC1Decoder().compare(rawtex, plain).psnr - 2
+
+
 @pytest.mark.parametrize('texture', [BC1Blocks.greyscale, BC1Blocks.three_color, BC1Blocks.three_color_black])
 class TestBC1Decoder:
     """Test BC1Decoder"""
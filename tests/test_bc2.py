@@ -0,0 +1,95 @@
+import os.path
+
+import pytest
+from PIL import Image
+
+from quicktex import RawTexture
+from quicktex.s3tc.bc1 import BC1Block, BC1Encoder
+from quicktex.s3tc.bc2 import BC2Block, BC2Decoder, BC2Encoder
+from .images import image_path
+
+
+class TestBC2Block:
+    """Test BC2Block"""
+
+    alphas = [[0, 1, 2, 3], [4, 5, 6, 7], [8, 9, 10, 11], [12, 13, 14, 15]]
+    color_block = BC1Block.frombytes(b'\xf0\x10\x88\x86\x68\xac\xcf\xff')
+
+    def test_alphas(self):
+        """Test that alpha values are packed as 4-bit values in row-major order"""
+        block = BC2Block(self.alphas, self.color_block)
+        assert block.alphas == self.alphas
+        assert block.color_block == self.color_block
+        assert block.tobytes()[:8] == b'\x10\x32\x54\x76\x98\xba\xdc\xfe'
+
+    def test_flip_mirror(self):
+        """Test flipping and mirroring alpha values"""
+        block = BC2Block(self.alphas, self.color_block)
+        block.flip()
+        assert block.alphas == self.alphas[::-1]
+
+        block = BC2Block(self.alphas, self.color_block)
+        block.mirror()
+        assert block.alphas == [row[::-1] for row in self.alphas]
+
+
+class TestBC2Encoder:
+    """Test BC2Encoder"""
+
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA')
+
+    def test_matches_bc1(self):
+        """Test that the color blocks match encoding with BC1 in 4-color mode"""
+        rawtex = RawTexture.frombytes(self.image.tobytes('raw', 'RGBA'), *self.image.size)
+
+        out_tex = BC2Encoder(5).encode(rawtex)
+        color_tex = BC1Encoder(5).encode(rawtex)
+
+        for x in range(out_tex.width_blocks):
+            for y in range(out_tex.height_blocks):
+                assert out_tex[x, y].color_block == color_tex[x, y]
+
+    def test_alpha_threshold(self):
+        """Test that the color blocks ignore the BC1 encoder's alpha threshold, even when it's set after construction"""
+        image = self.image.copy()
+        image.putalpha(Image.linear_gradient('L').resize(image.size))
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        expected = BC2Encoder(5).encode(rawtex)
+
+        encoder = BC2Encoder(5)
+        encoder.bc1_encoder.alpha_threshold = 128
+        assert encoder.encode(rawtex).tobytes() == expected.tobytes()
+
+    @pytest.mark.parametrize('dither', [False, True])
+    def test_alpha(self, dither):
+        """Test that alpha decodes to within one 4-bit step, and exactly when it is already a multiple of 17"""
+        image = self.image.copy()
+        alpha = Image.linear_gradient('L').resize(image.size)
+        image.putalpha(alpha)
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        decoded = BC2Decoder().decode(BC2Encoder(5, dither).encode(rawtex))
+        decoded = Image.frombuffer('RGBA', decoded.size, decoded)
+
+        for a, b in zip(alpha.getdata(), decoded.getchannel('A').getdata()):
+            assert abs(a - b) <= (17 if dither else 8)
+            if a % 17 == 0 and not dither:
+                assert a == b
+
+    def test_dither(self):
+        """Test that dithering preserves the average of alpha values between two 4-bit steps"""
+        image = self.image.copy()
+        image.putalpha(128)
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        def mean_alpha(encoder):
+            decoded = BC2Decoder().decode(encoder.encode(rawtex))
+            alpha = Image.frombuffer('RGBA', decoded.size, decoded).getchannel('A')
+            return sum(alpha.getdata()) / (alpha.width * alpha.height)
+
+        encoder = BC2Encoder(5)
+        assert mean_alpha(encoder) == 136
+
+        encoder.dither = True
+        assert abs(mean_alpha(encoder) - 128) < 2
@@ -0,0 +1,48 @@
+import os.path
+
+import pytest
+from PIL import Image
+
+from quicktex import RawTexture
+from quicktex.s3tc.bc1 import BC1Encoder
+from quicktex.s3tc.bc3 import BC3Encoder
+from quicktex.s3tc.bc4 import BC4Block, BC4Encoder
+from .images import image_path
+
+
+class TestBC3Encoder:
+    """Test BC3Encoder"""
+
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA')
+
+    @pytest.mark.parametrize('level', [0, 5])
+    def test_matches_halves(self, level):
+        """Test that the fused encoder matches encoding color with BC1 and alpha with BC4"""
+        image = self.image.copy()
+        alpha = Image.linear_gradient('L').resize(image.size)
+        alpha.paste(255, (0, 0, image.width // 2, image.height))  # left half fully opaque
+        image.putalpha(alpha)
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        out_tex = BC3Encoder(level).encode(rawtex)
+        color_tex = BC1Encoder(level).encode(rawtex)
+        alpha_tex = BC4Encoder(3).encode(rawtex)
+
+        for x in range(out_tex.width_blocks):
+            for y in range(out_tex.height_blocks):
+                assert out_tex[x, y].color_block == color_tex[x, y]
+                assert out_tex[x, y].alpha_block == alpha_tex[x, y]
+
+        assert out_tex[0, 0].alpha_block == BC4Block(255, 255, [[0] * 4] * 4)
+
+    def test_alpha_threshold(self):
+        """Test that the color blocks ignore the BC1 encoder's alpha threshold, even when it's set after construction"""
+        image = self.image.copy()
+        image.putalpha(Image.linear_gradient('L').resize(image.size))
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        expected = BC3Encoder(5).encode(rawtex)
+
+        encoder = BC3Encoder(5)
+        encoder.bc1_encoder.alpha_threshold = 128
+        assert encoder.encode(rawtex).tobytes() == expected.tobytes()
@@ -1,10 +1,13 @@
 import math
+import os.path
+import zlib
 
 import pytest
 from PIL import Image, ImageChops
 
+from quicktex import RawTexture
 from quicktex.s3tc.bc4 import BC4Block, BC4Texture, BC4Encoder, BC4Decoder
-from .images import BC4Blocks
+from .images import BC4Blocks, image_path
 
 block_bytes = b'\xF0\x10\x88\x86\x68\xAC\xCF\xFA'
 selectors = [[0, 1, 2, 3]] * 2 + [[4, 5, 6, 7]] * 2
@@ -49,6 +52,17 @@ class TestBC4Block:
         assert block.selectors == selectors
         assert block.endpoints == endpoints
 
+    def test_flip_mirror(self):
+        """Test flipping and mirroring a block"""
+        flip_selectors = [[0, 1, 2, 3], [4, 5, 6, 7], [7, 0, 1, 2], [3, 3, 5, 5]]
+        block = BC4Block(*endpoints, flip_selectors)
+
+        block.flip()
+        assert block.selectors == flip_selectors[::-1]
+
+        block.mirror()
+        assert block.selectors == [row[::-1] for row in flip_selectors[::-1]]
+
     def test_eq(self):
         """Test equality between two identical blocks"""
         block1 = BC4Block.frombytes(block_bytes)
@@ -156,6 +170,51 @@ class TestBC4Encoder:
         assert not out_block.is_6value
         assert out_block == BC4Blocks.eight_value.block
 
+    def test_level(self):
+        """Test that invalid levels are rejected and that every level encodes the 8 value test block exactly"""
+        with pytest.raises(ValueError):
+            BC4Encoder(0, BC4Encoder.max_level + 1)
+
+        for level in range(BC4Encoder.max_level + 1):
+            encoder = BC4Encoder(0, level)
+            assert encoder.level == level
+            out_tex = encoder.encode(BC4Blocks.eight_value.texture)
+            assert BC4Decoder(0).compare(BC4Blocks.eight_value.texture, out_tex).mse == 0
+
+    def test_block_6value(self):
+        """Test that higher levels use 6-value mode for blocks containing pure 0 and 255"""
+        texture = BC4Blocks.six_value.texture
+        decoder = BC4Decoder(0)
+
+        fast = BC4Encoder(0, 0).encode(texture)
+        assert not fast[0, 0].is_6value
+
+        out_tex = BC4Encoder(0, 1).encode(texture)
+        assert out_tex[0, 0].is_6value
+        assert decoder.compare(texture, out_tex).mse == 0
+        assert decoder.compare(texture, fast).mse > 0
+
+    def test_rdo(self):
+        """Test that rate-distortion optimization makes textures more compressible without losing much quality"""
+        encoder = BC4Encoder(0, 2)
+        assert encoder.rdo_lambda == 0
+
+        with pytest.raises(ValueError):
+            encoder.rdo_lambda = -1
+        with pytest.raises(ValueError):
+            encoder.rdo_window = BC4Encoder.max_rdo_window + 1
+
+        image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 256, 256))
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+        decoder = BC4Decoder(0)
+        plain = encoder.encode(rawtex)
+
+        encoder.rdo_lambda = 5
+        optimized = encoder.encode(rawtex)
+
+        assert len(zlib.compress(optimized.tobytes(), 9)) < 0.75 * len(zlib.compress(plain.tobytes(), 9))
+        assert decoder.compare(rawtex, optimized).psnr > decoder.compare(rawtex, plain).psnr - 8
+
 
 @pytest.mark.parametrize('texture', [BC4Blocks.eight_value, BC4Blocks.six_value])
 class TestBC4Decoder:
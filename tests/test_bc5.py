@@ -0,0 +1,29 @@
+import os.path
+
+import pytest
+from PIL import Image
+
+from quicktex import RawTexture
+from quicktex.s3tc.bc4 import BC4Encoder
+from quicktex.s3tc.bc5 import BC5Encoder
+from .images import image_path
+
+
+class TestBC5Encoder:
+    """Test BC5Encoder"""
+
+    @pytest.mark.parametrize('level', [0, 1])
+    @pytest.mark.parametrize('channels', [(0, 1), (3, 2)])
+    def test_matches_bc4(self, level, channels):
+        """Test that encoding both channels at once matches encoding each one with BC4"""
+        image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA')
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+        out_tex = BC5Encoder(*channels, level).encode(rawtex)
+        chan0_tex = BC4Encoder(channels[0], level).encode(rawtex)
+        chan1_tex = BC4Encoder(channels[1], level).encode(rawtex)
+
+        assert out_tex.size_blocks == chan0_tex.size_blocks
+        for x in range(out_tex.width_blocks):
+            for y in range(out_tex.height_blocks):
+                assert out_tex[x, y].blocks == (chan0_tex[x, y], chan1_tex[x, y])
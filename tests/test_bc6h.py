@@ -0,0 +1,178 @@
+import math
+import os.path
+import struct
+
+import pytest
+from PIL import Image
+
+import quicktex.dds as dds
+from quicktex import HalfTexture
+from quicktex.bptc.bc6h import BC6HBlock, BC6HDecoder, BC6HEncoder, BC6HTexture
+from .images import image_path
+
+
+def to_half_texture(pixels, width, height):
+    """Pack a sequence of RGB float tuples into a HalfTexture, with an alpha of 1"""
+    data = b''.join(struct.pack('<4e', *pixel, 1.0) for pixel in pixels)
+    return HalfTexture.frombytes(data, width, height)
+
+
+def to_floats(texture):
+    return list(struct.iter_unpack('<4e', texture.tobytes()))
+
+
+def hdr_image(size=64):
+    """Part of the test image as floats, scaled up to 16 in a gradient from left to right"""
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGB').crop((0, 0, size, size))
+    data = image.tobytes()
+    pixels = [tuple(c / 255 * 16 ** ((i // 3 % size) / size) for c in data[i : i + 3]) for i in range(0, len(data), 3)]
+    return pixels, to_half_texture(pixels, size, size)
+
+
+def log_error(original, decoded):
+    """RMS difference of the base 2 logarithms of two lists of pixels, ignoring values too small to matter"""
+    errors = [
+        (math.log2(max(a, 1e-3)) - math.log2(max(b, 1e-3))) ** 2
+        for p, q in zip(original, decoded)
+        for a, b in zip(p[:3], q[:3])
+    ]
+    return math.sqrt(sum(errors) / len(errors))
+
+
+class TestBC6HBlock:
+    """Test BC6HBlock"""
+
+    def test_default(self):
+        """Test that an all-zero block is mode 0, which decodes to black"""
+        block = BC6HBlock()
+        assert block.mode == 0
+        assert block.tobytes() == b'\x00' * 16
+
+        texture = BC6HTexture(4, 4)
+        texture[0, 0] = block
+        assert to_floats(BC6HDecoder().decode(texture)) == [(0.0, 0.0, 0.0, 1.0)] * 16
+
+    @pytest.mark.parametrize(
+        'mode, code', enumerate([0x00, 0x01, 0x02, 0x06, 0x0A, 0x0E, 0x12, 0x16, 0x1A, 0x1E, 0x03, 0x07, 0x0B, 0x0F])
+    )
+    def test_mode(self, mode, code):
+        """Test that modes are read from their 2 or 5 bit codes"""
+        assert BC6HBlock.frombytes(bytes([code]) + b'\x00' * 15).mode == mode
+
+    @pytest.mark.parametrize('code', [0x13, 0x17, 0x1B, 0x1F])
+    def test_reserved(self, code):
+        """Test that reserved mode codes are recognized"""
+        assert BC6HBlock.frombytes(bytes([code]) + b'\x00' * 15).mode == -1
+
+    @pytest.mark.parametrize('is_signed', [False, True])
+    def test_flip_mirror(self, is_signed):
+        """Test that flipping or mirroring a block twice restores it"""
+        _, texture = hdr_image()
+        encoded = BC6HEncoder(3, is_signed).encode(texture)
+
+        for x in range(encoded.width_blocks):
+            for y in range(encoded.height_blocks):
+                block = encoded[x, y]
+                for can, method in ((block.can_flip, 'flip'), (block.can_mirror, 'mirror')):
+                    moved = BC6HBlock.frombytes(block.tobytes())
+                    if can:
+                        getattr(moved, method)()
+                        getattr(moved, method)()
+                        assert moved == block
+                    else:
+                        with pytest.raises(ValueError):
+                            getattr(moved, method)()
+
+
+class TestBC6HEncoder:
+    """Test BC6HEncoder"""
+
+    @pytest.mark.parametrize('level', range(BC6HEncoder.max_level + 1))
+    @pytest.mark.parametrize(
+        'color, is_signed',
+        [
+            ((1.0, 0.5, 0.25), False),
+            ((65504.0, 0.0, 3.0e-5), False),
+            ((100.0, 2.0, 0.001), False),
+            ((-1.0, 0.5, -300.0), True),
+            ((65504.0, -65504.0, 0.0), True),
+        ],
+    )
+    def test_solid(self, level, color, is_signed):
+        """Test that solid blocks are exact, since mode 13 stores 16-bit endpoints"""
+        texture = to_half_texture([color] * 64, 8, 8)
+        decoded = to_floats(BC6HDecoder(is_signed).decode(BC6HEncoder(level, is_signed).encode(texture)))
+        assert decoded == to_floats(texture)
+
+    def test_unsigned_clamp(self):
+        """Test that unsigned encoding clamps negative values to 0"""
+        texture = to_half_texture([(-1.0, 2.0, -0.5)] * 16, 4, 4)
+        decoded = to_floats(BC6HDecoder().decode(BC6HEncoder().encode(texture)))
+        assert decoded == [(0.0, 2.0, 0.0, 1.0)] * 16
+
+    @pytest.mark.parametrize('is_signed', [False, True])
+    def test_quality(self, is_signed):
+        """Test that the highest level is at least as accurate as the lowest, and both are close to the original"""
+        pixels, texture = hdr_image()
+        if is_signed:
+            pixels = [tuple(-c if i % 2 else c for i, c in enumerate(pixel)) for pixel in pixels]
+            texture = to_half_texture(pixels, 64, 64)
+
+        errors = []
+        for level in (0, BC6HEncoder.max_level):
+            encoded = BC6HEncoder(level, is_signed).encode(texture)
+            decoded = to_floats(BC6HDecoder(is_signed).decode(encoded))
+            if is_signed:
+                assert all((a < 0) == (b < 0) for p, q in zip(pixels, decoded) for a, b in zip(p, q) if abs(a) > 0.01)
+            errors.append(log_error([tuple(map(abs, p)) for p in pixels], [tuple(map(abs, q)) for q in decoded]))
+
+        assert errors[1] <= errors[0] < 0.05
+
+    def test_settings(self):
+        """Test that out-of-range settings are rejected"""
+        encoder = BC6HEncoder()
+        with pytest.raises(ValueError):
+            encoder.set_level(BC6HEncoder.max_level + 1)
+        with pytest.raises(ValueError):
+            encoder.partitions = BC6HEncoder.max_partitions + 1
+        with pytest.raises(ValueError):
+            encoder.refine_passes = BC6HEncoder.max_refine_passes + 1
+
+
+class TestBC6HTexture:
+    """Test flipping BC6H textures"""
+
+    def test_flip(self):
+        """Test that flipping a single-subset texture is lossless"""
+        _, texture = hdr_image()
+        encoded = BC6HEncoder(0).encode(texture)
+        decoded = to_floats(BC6HDecoder().decode(encoded))
+
+        encoded.flip()
+        flipped = to_floats(BC6HDecoder().decode(encoded))
+        assert flipped == [decoded[(63 - i // 64) * 64 + i % 64] for i in range(64 * 64)]
+
+
+def test_dds(tmp_path):
+    """Test that BC6H DDS files are written with a DX10 header, and unsigned ones decode the same as with Pillow"""
+    _, texture = hdr_image()
+
+    for four_cc, dxgi_format, is_signed in (('BC6H_UF16', 95, False), ('BC6H_SF16', 96, True)):
+        path = tmp_path / f'{four_cc}.dds'
+        encoded = dds.encode_textures([texture], BC6HEncoder(1, is_signed), four_cc)
+        encoded.save(path)
+
+        result = dds.read(path)
+        assert result.four_cc == 'DX10'
+        assert result.dxgi_format == dxgi_format
+        assert [t.tobytes() for t in result.textures] == [t.tobytes() for t in encoded.textures]
+        assert result.decode_texture().tobytes() == BC6HDecoder(is_signed).decode(encoded.textures[0]).tobytes()
+        with pytest.raises(ValueError):
+            result.decode()
+
+    # Pillow decodes to 8 bits per channel, and leaves out the rounding when interpolating, so allow a difference of 1
+    decoded = to_floats(dds.read(tmp_path / 'BC6H_UF16.dds').decode_texture())
+    with Image.open(tmp_path / 'BC6H_UF16.dds') as pillow:
+        expected = pillow.convert('RGB').tobytes()
+    actual = [int(min(max(c, 0.0), 1.0) * 255) for pixel in decoded for c in pixel[:3]]
+    assert max(abs(a - e) for a, e in zip(actual, expected)) <= 1
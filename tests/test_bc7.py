@@ -0,0 +1,237 @@
+import os.path
+
+import pytest
+from PIL import Image, ImageChops
+
+import quicktex.dds as dds
+from quicktex import RawTexture
+from quicktex.bptc.bc7 import BC7Block, BC7Decoder, BC7Encoder, BC7Texture
+from quicktex.s3tc.bc3 import BC3Decoder, BC3Encoder
+from .images import image_path
+
+
+def to_image(texture):
+    return Image.frombuffer('RGBA', texture.size, texture)
+
+
+class TestBC7Block:
+    """Test BC7Block"""
+
+    def test_reserved(self):
+        """Test that an all-zero block is a reserved mode, which decodes to transparent black"""
+        block = BC7Block()
+        assert block.mode == -1
+        assert block.tobytes() == b'\x00' * 16
+
+        texture = BC7Texture(4, 4)
+        texture[0, 0] = block
+        decoded = to_image(BC7Decoder().decode(texture))
+        assert decoded.getextrema() == ((0, 0),) * 4
+
+    def test_mode(self):
+        """Test that the mode is the position of the lowest set bit"""
+        for mode in range(8):
+            block = BC7Block.frombytes(bytes([1 << mode]) + b'\x00' * 15)
+            assert block.mode == mode
+
+    # Blocks packed field by field following the bit layout in the BC7 specification, and the pixels they decode to.
+    # Between them they use every mode, both kinds of p-bit, every rotation, and both index selections of mode 4
+    @pytest.mark.parametrize(
+        'mode, block, pixels',
+        [
+            (
+                0,
+                '4163a38524449ac7fa02415ca1b226d8',
+                'a542c6ff7b399cff5a1eaaff731b97ff7b399cff903db1ff5a1eaaff891786ff'
+                '903db1ff8a6d49ff54a32cff9f1474ffbd3a65ffd62173ff8a6d49ff8a6d49ff',
+            ),
+            (
+                1,
+                '0ab6fe29a87b99bbf9fd635537d2f60f',
+                'dba3efff3692edff666fa2ff428adbffe0aad7ff2a9bffff3692edff7e5e7eff'
+                'dda6e3ff428adbff428adbff428adbffebbb9bff2a9bffff726790ff7e5e7eff',
+            ),
+            (
+                2,
+                '04e290410d3f713f8d706bbff4dbbd28',
+                '8cf721ff189ce7ff08efb5ff66d3b5ff66d962ff189ce7ff36e2b5ff08efb5ff'
+                '3ebaa6ff186b94ff3f49dcff66d3b5ff5239ffff3f49dcff3f49dcff5239ffff',
+            ),
+            (
+                3,
+                '18ec5c01ef60588af2916b909f273a04',
+                '6e30d6ff5d8791ff7606f8ffbda341ff5d8791ff7606f8ff6e30d6ff034bd7ff'
+                '6e30d6ff5d8791ff6e30d6ff034bd7ff655db3ff7606f8ff7606f8ff034bd7ff',
+            ),
+            (
+                4,
+                'b0899876f1301dfe25f458058655d76d',
+                '2131bd4a4d49c1390c5bc32d0c41c03e4d31bd4a4d53c2324d39be444d53c232'
+                '385bc32d0c41c03e215bc32d0c49c139385bc32d3849c1394d49c1392149c139',
+            ),
+            (
+                4,
+                '50d9bac0c23f72253a9b4dbccb8def48',
+                'cedf6373bdef262bb5ef0808bd9e262bbdcf262bce8e6373c6df4550ce9e6373'
+                'c6ae4550b5ef0808c69e4550bd8e262bc69e4550b5ef0808cedf6373b5df0808',
+            ),
+            (
+                5,
+                'e0a0d2216fcaba3fa10b333d7e715483',
+                '400eba4c400e4f4c43594f6e4af3bab34359ba6e4359ee6e400e4f4c47a8ba91'
+                '4359ee6e47a8ba914359ba6e47a8ba9147a84f914af3eeb34359ee6e400e834c',
+            ),
+            (
+                6,
+                'c03d6c6374287e99e26ae87f684e3dec',
+                'ee3c1c7a698715379270174bba5a1960a764185669871537608c1432b05f195b'
+                'a7641856ba5a196069871537cf4e1b6b7580153dd8481b6f7f7b164269871537',
+            ),
+            (
+                7,
+                '800325099176fb9bc9ed03cd784f119f',
+                'a6247ddf246d9e3c246d9e3c44db644b246d9e3c7b3c88aa44db644b44db644b'
+                'a6247ddf4f55937149ba498244db644b246d9e3c41eb713049ba498246ca5667',
+            ),
+        ],
+    )
+    def test_reference(self, mode, block, pixels):
+        """Test decoding a block of each mode against its known pixels"""
+        texture = BC7Texture(4, 4)
+        texture[0, 0] = BC7Block.frombytes(bytes.fromhex(block))
+        assert texture[0, 0].mode == mode
+        assert to_image(BC7Decoder().decode(texture)).tobytes() == bytes.fromhex(pixels)
+
+    def test_flip_mirror(self):
+        """Test that flipping or mirroring a block twice restores it"""
+        image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 64, 64))
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+        texture = BC7Encoder(3).encode(rawtex)
+
+        for x in range(texture.width_blocks):
+            for y in range(texture.height_blocks):
+                block = texture[x, y]
+                if block.can_flip:
+                    flipped = BC7Block.frombytes(block.tobytes())
+                    flipped.flip()
+                    flipped.flip()
+                    assert flipped == block
+                else:
+                    with pytest.raises(ValueError):
+                        BC7Block.frombytes(block.tobytes()).flip()
+
+
+class TestBC7Encoder:
+    """Test BC7Encoder"""
+
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 128, 128))
+    rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+    @pytest.mark.parametrize('level', range(BC7Encoder.max_level + 1))
+    @pytest.mark.parametrize('color', [(255, 0, 0, 255), (37, 201, 99, 255), (12, 34, 56, 128), (0, 0, 0, 0)])
+    def test_solid(self, level, color):
+        """Test that solid blocks are exact with mode 5 when it is enabled, and within 1 of the original with mode 6 otherwise"""
+        rawtex = RawTexture.frombytes(Image.new('RGBA', (8, 8), color).tobytes('raw', 'RGBA'), 8, 8)
+        encoder = BC7Encoder(level)
+        encoded = encoder.encode(rawtex)
+        decoded = to_image(BC7Decoder().decode(encoded))
+
+        assert encoded[0, 0].mode == (5 if encoder.mode_mask & (1 << 5) else 6)
+
+        for channel, value in zip(decoded.split(), color):
+            low, high = channel.getextrema()
+            if encoder.mode_mask & (1 << 5):
+                assert low == high == value
+            else:
+                assert abs(low - value) <= 1 and abs(high - value) <= 1
+
+    def test_quality(self):
+        """Test that BC7 is more accurate than BC3, and that the highest level is at least as accurate as the lowest"""
+        bc3_psnr = BC3Decoder().compare(self.rawtex, BC3Encoder(5).encode(self.rawtex)).psnr
+        level0_psnr = BC7Decoder().compare(self.rawtex, BC7Encoder(0).encode(self.rawtex)).psnr
+        max_psnr = BC7Decoder().compare(self.rawtex, BC7Encoder(BC7Encoder.max_level).encode(self.rawtex)).psnr
+
+        assert level0_psnr > bc3_psnr
+        assert max_psnr >= level0_psnr
+
+    def test_alpha(self):
+        """Test that blocks with alpha only use modes that can store it"""
+        image = self.image.copy()
+        image.putalpha(Image.linear_gradient('L').resize(image.size))
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+        texture = BC7Encoder(3).encode(rawtex)
+
+        for x in range(texture.width_blocks):
+            for y in range(texture.height_blocks):
+                assert BC7Encoder.alpha_modes & (1 << texture[x, y].mode)
+
+    @pytest.mark.parametrize('mode_mask', [0x40, 0x20, 0x10, 0x80 | 0x02])
+    def test_mode_mask(self, mode_mask):
+        """Test that only enabled modes are used"""
+        encoder = BC7Encoder(3)
+        encoder.mode_mask = mode_mask
+        texture = encoder.encode(self.rawtex)
+
+        for x in range(texture.width_blocks):
+            for y in range(texture.height_blocks):
+                assert mode_mask & (1 << texture[x, y].mode)
+
+    def test_settings(self):
+        """Test that out-of-range settings are rejected"""
+        encoder = BC7Encoder()
+        with pytest.raises(ValueError):
+            encoder.set_level(BC7Encoder.max_level + 1)
+        with pytest.raises(ValueError):
+            encoder.mode_mask = 0x0F  # no mode can store alpha
+        with pytest.raises(ValueError):
+            encoder.partitions = 0
+        with pytest.raises(ValueError):
+            encoder.partitions = BC7Encoder.max_partitions + 1
+        with pytest.raises(ValueError):
+            encoder.refine_passes = BC7Encoder.max_refine_passes + 1
+
+
+class TestBC7Texture:
+    """Test flipping and mirroring BC7 textures"""
+
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 128, 128))
+    rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+    def test_flip_mirror(self):
+        """Test that flipping and mirroring single-subset textures is lossless"""
+        texture = BC7Encoder(0).encode(self.rawtex)
+        decoded = to_image(BC7Decoder().decode(texture))
+
+        texture.flip()
+        flipped = to_image(BC7Decoder().decode(texture))
+        assert ImageChops.difference(flipped, decoded.transpose(Image.FLIP_TOP_BOTTOM)).getbbox() is None
+
+        texture.mirror()
+        rotated = to_image(BC7Decoder().decode(texture))
+        assert ImageChops.difference(rotated, decoded.transpose(Image.ROTATE_180)).getbbox() is None
+
+    def test_flip_unchanged(self):
+        """Test that a texture containing a block that can't be flipped is left unchanged"""
+        texture = BC7Encoder(3).encode(self.rawtex)
+        blocks = [texture[x, y] for y in range(texture.height_blocks) for x in range(texture.width_blocks)]
+        assert not all(block.can_flip for block in blocks), 'test image should contain a block that cannot be flipped'
+
+        original = texture.tobytes()
+        with pytest.raises(ValueError):
+            texture.flip()
+        assert texture.tobytes() == original
+
+
+def test_dds(tmp_path):
+    """Test that BC7 DDS files are written with a DX10 header, and decode the same as with Pillow"""
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 64, 64))
+    path = tmp_path / 'bc7.dds'
+    encoded = dds.encode_file(path, image, BC7Encoder(2), 'BC7', mip_count=1)
+
+    result = dds.read(path)
+    assert result.four_cc == 'DX10'
+    assert result.dxgi_format == 98
+    assert [t.tobytes() for t in result.textures] == [t.tobytes() for t in encoded.textures]
+
+    with Image.open(path) as pillow:
+        assert ImageChops.difference(pillow.convert('RGBA'), result.decode()).getbbox() is None
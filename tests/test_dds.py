@@ -0,0 +1,56 @@
+import os.path
+
+import pytest
+from PIL import Image
+
+import quicktex.dds as dds
+from quicktex.bptc.bc7 import BC7Encoder
+from quicktex.s3tc.bc1 import BC1Encoder
+from .images import image_path
+
+
+@pytest.fixture
+def layers():
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA')
+    return [image.crop((i * 64, 0, i * 64 + 64, 64)) for i in range(6)]
+
+
+@pytest.mark.parametrize('cubemap', [True, False])
+def test_layers_round_trip(layers, cubemap, tmp_path):
+    """Test that texture arrays and cube maps survive a round trip through a DDS file"""
+    path = tmp_path / 'layers.dds'
+    encoded = dds.encode_layers(layers, BC1Encoder(), 'DXT1', cubemap=cubemap, dx10=True)
+    encoded.save(path)
+
+    result = dds.read(path)
+    assert result.four_cc == 'DX10'
+    assert result.cubemap == cubemap
+    assert result.array_size == (1 if cubemap else 6)
+    assert result.layer_count == 6
+    assert result.mipmap_count == 7
+    assert [t.tobytes() for t in result.textures] == [t.tobytes() for t in encoded.textures]
+
+
+def test_dx10_cubemap_round_trip(layers, tmp_path):
+    """Test that a single cube map in a format without a FourCC code is written as a cube map in its DX10 header"""
+    path = tmp_path / 'cubemap.dds'
+    encoded = dds.encode_layers(layers, BC7Encoder(0), 'BC7', cubemap=True)
+    encoded.save(path)
+
+    result = dds.read(path)
+    assert result.four_cc == 'DX10'
+    assert result.cubemap
+    assert result.array_size == 1
+    assert result.layer_count == 6
+    assert [t.tobytes() for t in result.textures] == [t.tobytes() for t in encoded.textures]
+
+
+def test_batch_matches_single(layers):
+    """Test that batch encoding each layer gives the same result as encoding the layers one at a time"""
+    encoder = BC1Encoder()
+    batch = dds.encode_layers(layers, encoder, 'DXT1')
+
+    for layer, image in enumerate(layers):
+        single = dds.encode(image, encoder, 'DXT1')
+        mips = single.mipmap_count
+        assert [t.tobytes() for t in batch.textures[layer * mips : (layer + 1) * mips]] == [t.tobytes() for t in single.textures]
@@ -0,0 +1,120 @@
+import os.path
+
+import pytest
+from PIL import Image
+
+from quicktex import RawTexture
+from quicktex.etc.eac import EACBlock, EACDecoder, EACEncoder, EACTexture, RG11Decoder, RG11Encoder
+from .images import image_path
+
+Precision = EACBlock.Precision
+
+
+def to_image(texture):
+    return Image.frombuffer('RGBA', texture.size, texture)
+
+
+class TestEACBlock:
+    """Test EACBlock"""
+
+    selectors = [[0, 1, 2, 3], [4, 5, 6, 7], [7, 6, 5, 4], [3, 2, 1, 0]]
+
+    def test_default(self):
+        """Test that an all-zero block has all-zero fields"""
+        block = EACBlock()
+        assert block.tobytes() == b'\x00' * 8
+        assert (block.base, block.multiplier, block.table) == (0, 0, 0)
+        assert block.selectors == [[0] * 4] * 4
+
+    def test_fields(self):
+        """Test that fields are packed in the order of the EAC bitstream"""
+        block = EACBlock(0x80, 3, 5, self.selectors)
+        assert (block.base, block.multiplier, block.table) == (0x80, 3, 5)
+        assert block.selectors == self.selectors
+
+        data = block.tobytes()
+        assert data[:2] == b'\x80\x35'
+        assert int.from_bytes(data[2:], 'big') >> 45 == 0  # the top-left selector comes first
+        assert (int.from_bytes(data[2:], 'big') >> 42) & 7 == 4  # followed by the one below it
+
+    def test_values(self):
+        """Test that values are clamped, and that R11 blocks with a multiplier of 0 use the modifiers unscaled"""
+        assert EACBlock(250, 2, 13, self.selectors).alpha_values == [248, 246, 244, 230, 250, 252, 254, 255]
+        assert EACBlock(100, 0, 13, self.selectors).r11_values == [803, 802, 801, 794, 804, 805, 806, 813]
+
+    def test_out_of_range(self):
+        """Test that out-of-range fields are rejected"""
+        with pytest.raises(ValueError):
+            EACBlock(0, 16, 0, self.selectors)
+        with pytest.raises(ValueError):
+            EACBlock(0, 0, 16, self.selectors)
+        with pytest.raises(ValueError):
+            EACBlock(0, 0, 0, [[8] * 4] * 4)
+
+    def test_flip_mirror(self):
+        """Test that flipping and mirroring reverse the selectors"""
+        block = EACBlock(0, 1, 0, self.selectors)
+        block.flip()
+        assert block.selectors == self.selectors[::-1]
+        block.mirror()
+        assert block.selectors == [row[::-1] for row in self.selectors[::-1]]
+
+
+class TestEACEncoder:
+    """Test EACEncoder"""
+
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 128, 128))
+    rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+    @pytest.mark.parametrize('level', range(EACEncoder.max_level + 1))
+    @pytest.mark.parametrize('precision', [Precision.Alpha, Precision.R11])
+    def test_solid(self, level, precision):
+        """Test that solid blocks of every value are exact"""
+        channel = 3 if precision == Precision.Alpha else 0
+        encoder = EACEncoder(channel, level, precision)
+        decoder = EACDecoder(channel, precision)
+
+        for value in range(256):
+            rawtex = RawTexture.frombytes(bytes([value]) * 4 * 16, 4, 4)
+            decoded = to_image(decoder.decode(encoder.encode(rawtex)))
+            assert decoded.getchannel(channel).getextrema() == (value, value)
+
+    @pytest.mark.parametrize('precision', [Precision.Alpha, Precision.R11])
+    def test_quality(self, precision):
+        """Test that the highest level is at least as accurate as the lowest"""
+        psnr = [
+            EACDecoder(0, precision).compare(self.rawtex, EACEncoder(0, level, precision).encode(self.rawtex)).psnr
+            for level in (0, EACEncoder.max_level)
+        ]
+        assert psnr[1] >= psnr[0] > 35
+
+    def test_settings(self):
+        """Test that out-of-range settings are rejected"""
+        with pytest.raises(ValueError):
+            EACEncoder(4)
+        with pytest.raises(ValueError):
+            EACEncoder(0).level = EACEncoder.max_level + 1
+
+
+class TestRG11:
+    """Test RG11Encoder and RG11Decoder"""
+
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 64, 64))
+    rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+    def test_channels(self):
+        """Test that each channel is encoded the same as it would be with EACEncoder"""
+        encoded = RG11Encoder(2, 1).encode(self.rawtex)
+        for index, channel in enumerate((2, 1)):
+            single = EACEncoder(channel).encode(self.rawtex)
+            blocks = [encoded[x, y].blocks[index] for y in range(16) for x in range(16)]
+            assert blocks == [single[x, y] for y in range(16) for x in range(16)]
+
+        decoded = to_image(RG11Decoder(2, 1).decode(encoded))
+        assert decoded.getchannel('R').getextrema() == (0, 0)
+        assert decoded.getchannel('A').getextrema() == (255, 255)
+
+    def test_texture(self):
+        """Test that single-channel textures hold EAC blocks"""
+        texture = EACTexture(8, 8)
+        assert texture.nbytes == 4 * 8
@@ -0,0 +1,156 @@
+import os.path
+
+import pytest
+from PIL import Image, ImageChops
+
+from quicktex import RawTexture
+from quicktex.etc.eac import EACBlock, EACEncoder
+from quicktex.etc.etc2 import ETC2Block, ETC2Decoder, ETC2Encoder, ETC2RGBADecoder, ETC2RGBAEncoder, ETC2Texture
+from .images import image_path
+
+Mode = ETC2Block.Mode
+
+
+def to_image(texture):
+    return Image.frombuffer('RGBA', texture.size, texture)
+
+
+def blocks(texture):
+    return [texture[x, y] for y in range(texture.height_blocks) for x in range(texture.width_blocks)]
+
+
+image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 128, 128))
+rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+
+class TestETC2Block:
+    """Test ETC2Block"""
+
+    def test_default(self):
+        """Test that an all-zero block is an individual mode block, which decodes to a gray of 2"""
+        block = ETC2Block()
+        assert block.mode == Mode.Individual
+        assert block.tobytes() == b'\x00' * 8
+        assert block.colors == [(2, 2, 2, 255)] * 16
+
+        texture = ETC2Texture(4, 4)
+        texture[0, 0] = block
+        assert to_image(ETC2Decoder().decode(texture)).getextrema() == ((2, 2), (2, 2), (2, 2), (255, 255))
+
+    @pytest.mark.parametrize(
+        'data, mode',
+        [
+            (b'\x00\x00\x00\x02', Mode.Differential),
+            (b'\x04\x00\x00\x02', Mode.T),  # red overflows
+            (b'\x00\x04\x00\x02', Mode.H),  # green overflows
+            (b'\x00\x00\x04\x02', Mode.Planar),  # blue overflows
+        ],
+    )
+    def test_mode(self, data, mode):
+        """Test that the ETC2 modes are selected by overflowing a channel of a differential block"""
+        assert ETC2Block.frombytes(data + b'\x00' * 4).mode == mode
+
+    def test_flip_mirror(self):
+        """Test that flipping or mirroring a block twice restores it"""
+        texture = ETC2Encoder(2).encode(rawtex)
+
+        for block in blocks(texture):
+            for can, method in ((block.can_flip, 'flip'), (block.can_mirror, 'mirror')):
+                moved = ETC2Block.frombytes(block.tobytes())
+                if can:
+                    getattr(moved, method)()
+                    getattr(moved, method)()
+                    assert moved == block
+                else:
+                    assert block.mode in (Mode.Differential, Mode.Planar)
+                    with pytest.raises(ValueError):
+                        getattr(moved, method)()
+
+
+class TestETC2Encoder:
+    """Test ETC2Encoder"""
+
+    @pytest.mark.parametrize('level', range(ETC2Encoder.max_level + 1))
+    @pytest.mark.parametrize('color', [(255, 0, 0, 255), (37, 201, 99, 255), (12, 34, 56, 255), (0, 0, 0, 255)])
+    def test_solid(self, level, color):
+        """Test that solid blocks are close to the original, and closer when the planar mode is enabled"""
+        solid = RawTexture.frombytes(Image.new('RGBA', (8, 8), color).tobytes('raw', 'RGBA'), 8, 8)
+        encoder = ETC2Encoder(level)
+        decoded = to_image(ETC2Decoder().decode(encoder.encode(solid)))
+
+        tolerance = 2 if encoder.mode_mask & (1 << int(Mode.Planar)) else 8
+        for channel, value in zip(decoded.split(), color):
+            low, high = channel.getextrema()
+            assert abs(low - value) <= tolerance and abs(high - value) <= tolerance
+
+    def test_quality(self):
+        """Test that ETC2 is more accurate than ETC1, and the highest level is at least as accurate as the default"""
+        levels = (0, 2, ETC2Encoder.max_level)
+        psnr = [ETC2Decoder().compare(rawtex, ETC2Encoder(level).encode(rawtex)).psnr for level in levels]
+        assert psnr[2] >= psnr[1] > psnr[0] > 30
+
+    @pytest.mark.parametrize(
+        'mode_mask', [ETC2Encoder.etc1_modes, 1 << int(Mode.Planar), (1 << int(Mode.T)) | (1 << int(Mode.H))]
+    )
+    def test_mode_mask(self, mode_mask):
+        """Test that only enabled modes are used"""
+        encoder = ETC2Encoder(1)
+        encoder.mode_mask = mode_mask
+        for block in blocks(encoder.encode(rawtex)):
+            assert mode_mask & (1 << int(block.mode))
+
+    def test_settings(self):
+        """Test that out-of-range settings are rejected"""
+        encoder = ETC2Encoder()
+        with pytest.raises(ValueError):
+            encoder.set_level(ETC2Encoder.max_level + 1)
+        assert (encoder.color_radius, encoder.refine_passes) == (0, 1)  # unchanged from the default level 1
+        with pytest.raises(ValueError):
+            encoder.mode_mask = 0
+        with pytest.raises(ValueError):
+            encoder.mode_mask = 0x20
+        with pytest.raises(ValueError):
+            encoder.color_radius = ETC2Encoder.max_color_radius + 1
+        with pytest.raises(ValueError):
+            encoder.refine_passes = ETC2Encoder.max_refine_passes + 1
+
+
+class TestETC2Texture:
+    """Test flipping and mirroring ETC2 textures"""
+
+    def test_flip_mirror(self):
+        """Test that flipping and mirroring ETC1 textures is lossless when every block can be moved"""
+        texture = ETC2Encoder(0).encode(rawtex)
+        assert all(block.can_flip and block.can_mirror for block in blocks(texture))
+        decoded = to_image(ETC2Decoder().decode(texture))
+
+        texture.flip()
+        flipped = to_image(ETC2Decoder().decode(texture))
+        assert ImageChops.difference(flipped, decoded.transpose(Image.FLIP_TOP_BOTTOM)).getbbox() is None
+
+        texture.mirror()
+        rotated = to_image(ETC2Decoder().decode(texture))
+        assert ImageChops.difference(rotated, decoded.transpose(Image.ROTATE_180)).getbbox() is None
+
+
+class TestETC2RGBA:
+    """Test ETC2RGBAEncoder and ETC2RGBADecoder"""
+
+    def test_alpha(self):
+        """Test that color and alpha are encoded the same as they would be separately"""
+        alpha = image.copy()
+        alpha.putalpha(Image.linear_gradient('L').resize(alpha.size))
+        alphatex = RawTexture.frombytes(alpha.tobytes('raw', 'RGBA'), *alpha.size)
+
+        encoded = ETC2RGBAEncoder(1).encode(alphatex)
+        color = ETC2Encoder(1).encode(alphatex)
+        eac = EACEncoder(3, 1, EACBlock.Precision.Alpha).encode(alphatex)
+        assert [block.color_block for block in blocks(encoded)] == blocks(color)
+        assert [block.alpha_block for block in blocks(encoded)] == blocks(eac)
+
+        assert ETC2RGBADecoder().compare(alphatex, encoded).psnr > 30
+
+    def test_precision(self):
+        """Test that the alpha encoder must use alpha precision"""
+        with pytest.raises(ValueError):
+            ETC2RGBAEncoder(ETC2Encoder(), EACEncoder(3))
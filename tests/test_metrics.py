@@ -0,0 +1,58 @@
+import math
+import os.path
+
+import pytest
+from PIL import Image, ImageChops, ImageStat
+
+from quicktex import RawTexture, compare
+from quicktex.s3tc.bc1 import BC1Encoder, BC1Decoder
+from .images import image_path
+
+
+class TestCompare:
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 126, 201))
+    rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+    def test_identical(self):
+        """Test comparing a texture with itself"""
+        metrics = compare(self.rawtex, self.rawtex)
+        assert metrics.mse == 0
+        assert metrics.psnr == math.inf
+        assert metrics.max_error == 0
+        assert metrics.ssim == pytest.approx(1)
+        assert metrics.pixels == self.image.width * self.image.height
+
+    def test_pillow(self):
+        """Test that per-channel error matches Pillow"""
+        other = self.image.transpose(Image.FLIP_LEFT_RIGHT)
+        metrics = compare(self.rawtex, RawTexture.frombytes(other.tobytes('raw', 'RGBA'), *other.size), channels=0b0111)
+
+        diff = ImageChops.difference(self.image, other)
+        rms = ImageStat.Stat(diff).rms
+        extrema = diff.getextrema()
+
+        for channel in range(4):
+            assert metrics.channel_mse[channel] == pytest.approx(rms[channel] ** 2)
+            assert metrics.channel_max_error[channel] == extrema[channel][1]
+        assert metrics.mse == pytest.approx(sum(rms[c] ** 2 for c in range(3)) / 3)
+        assert metrics.ssim < 1
+
+    def test_size_mismatch(self):
+        """Test that textures of different sizes can't be compared"""
+        with pytest.raises(ValueError):
+            compare(self.rawtex, RawTexture(4, 4))
+
+    def test_decoder(self):
+        """Test that comparing with an encoded texture matches comparing with the decoded texture"""
+        image = self.image.crop((0, 0, 124, 200))
+        rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+        encoded = BC1Encoder().encode(rawtex)
+        decoder = BC1Decoder()
+
+        expected = compare(rawtex, decoder.decode(encoded), channels=0b0111)
+        metrics = decoder.compare(rawtex, encoded)
+
+        assert metrics.channels == 0b0111
+        assert metrics.mse == pytest.approx(expected.mse)
+        assert metrics.ssim == pytest.approx(expected.ssim)
+        assert metrics.channel_max_error == expected.channel_max_error
@@ -0,0 +1,53 @@
+import os.path
+
+import pytest
+from PIL import Image
+
+import quicktex
+from quicktex import RawTexture
+from quicktex.bptc.bc6h import BC6HEncoder
+from quicktex.bptc.bc7 import BC7Encoder, BC7Texture
+from quicktex.etc.eac import RG11Encoder
+from quicktex.etc.etc2 import ETC2Encoder, ETC2Texture
+from quicktex.s3tc.bc1 import BC1Encoder, BC1Texture
+from quicktex.s3tc.bc3 import BC3Encoder, BC3Texture
+from quicktex.s3tc.bc4 import BC4Encoder
+from .images import image_path
+
+
+class TestEncodeMulti:
+    """Test quicktex.encode_multi"""
+
+    image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 62, 66))
+    rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+    @pytest.mark.parametrize('flip', [False, True])
+    def test_matches_separate(self, flip):
+        """Test that every output is identical to encoding with each encoder separately"""
+        encoders = [BC1Encoder(5), BC3Encoder(5), BC4Encoder(0, 2), BC7Encoder(1), ETC2Encoder(1), RG11Encoder()]
+        outputs = quicktex.encode_multi(self.rawtex, encoders, flip)
+
+        assert len(outputs) == len(encoders)
+        for encoder, output in zip(encoders, outputs):
+            expected = encoder.encode(self.rawtex, flip)
+            assert type(output) is type(expected)
+            assert output.size == expected.size
+            assert output.tobytes() == expected.tobytes()
+
+    def test_types(self):
+        """Test that outputs have the texture type of their encoder, and outlive the call"""
+        encoder = BC1Encoder(3)
+        outputs = quicktex.encode_multi(self.rawtex, [encoder, BC3Encoder(), BC7Encoder(0), ETC2Encoder(0), encoder])
+        assert [type(o) for o in outputs] == [BC1Texture, BC3Texture, BC7Texture, ETC2Texture, BC1Texture]
+        assert outputs[0].tobytes() == outputs[4].tobytes()
+
+    def test_empty(self):
+        """Test that encoding to no formats does nothing"""
+        assert quicktex.encode_multi(self.rawtex, []) == []
+
+    def test_unsupported(self):
+        """Test that encoders without 4x4 blocks of 8-bit pixels are rejected"""
+        with pytest.raises(TypeError):
+            quicktex.encode_multi(self.rawtex, [BC1Encoder(), BC6HEncoder()])
+        with pytest.raises(TypeError):
+            quicktex.encode_multi(self.rawtex, [None])
@@ -0,0 +1,85 @@
+import os.path
+import struct
+import zlib
+
+import pytest
+from PIL import Image
+
+from quicktex import RawTexture
+from quicktex.s3tc import supercompress, transcode
+from quicktex.s3tc.bc1 import BC1Encoder, BC1Texture
+from quicktex.s3tc.bc3 import BC3Encoder, BC3Texture
+from quicktex.s3tc.bc4 import BC4Encoder, BC4Texture
+from quicktex.s3tc.bc5 import BC5Encoder, BC5Texture
+from .images import image_path
+
+image = Image.open(os.path.join(image_path, 'Boilerplate.png')).convert('RGBA').crop((0, 0, 256, 256))
+rawtex = RawTexture.frombytes(image.tobytes('raw', 'RGBA'), *image.size)
+
+
+@pytest.mark.parametrize(
+    'encoder, texture_type',
+    [(BC1Encoder(5), BC1Texture), (BC3Encoder(5), BC3Texture), (BC4Encoder(0), BC4Texture), (BC5Encoder(0, 1), BC5Texture)],
+)
+@pytest.mark.parametrize('chunk_blocks', [7, 4096])
+def test_roundtrip(encoder, texture_type, chunk_blocks):
+    """Test that transcoding restores the exact texture, in its original format"""
+    encoded = encoder.encode(rawtex)
+    data = supercompress(encoded, chunk_blocks)
+    assert data[:4] == b'QTXS'
+
+    result = transcode(data)
+    assert isinstance(result, texture_type)
+    assert result.size == encoded.size
+    assert result.tobytes() == encoded.tobytes()
+
+
+def test_odd_size():
+    """Test textures whose size isn't a multiple of the block size, with a partial last chunk"""
+    odd = RawTexture.frombytes(image.crop((0, 0, 37, 19)).tobytes('raw', 'RGBA'), 37, 19)
+    encoded = BC1Encoder(5).encode(odd)
+
+    result = transcode(supercompress(encoded, 5))
+    assert result.size == (37, 19)
+    assert result.tobytes() == encoded.tobytes()
+
+
+@pytest.mark.parametrize('encoder', [BC1Encoder(5), BC4Encoder(0)])
+def test_small(encoder):
+    """Test that textures too small to code well are stored uncompressed, behind only the header and chunk size"""
+    small = RawTexture.frombytes(image.crop((0, 0, 16, 16)).tobytes('raw', 'RGBA'), 16, 16)
+    encoded = encoder.encode(small)
+    data = supercompress(encoded)
+
+    assert len(data) <= 28 + len(encoded.tobytes())
+    assert transcode(data).tobytes() == encoded.tobytes()
+
+
+def test_rdo():
+    """Test that RDO textures supercompress smaller than plain ones, and at least as small as with deflate"""
+    encoder = BC1Encoder(5)
+    plain = encoder.encode(rawtex)
+    encoder.rdo_lambda = 5
+    optimized = encoder.encode(rawtex)
+
+    assert len(supercompress(optimized)) < 0.75 * len(supercompress(plain))
+    assert len(supercompress(optimized)) <= len(zlib.compress(optimized.tobytes(), 9))
+
+
+def test_invalid():
+    """Test that invalid settings and data are rejected"""
+    data = supercompress(BC4Encoder(0).encode(rawtex))
+
+    with pytest.raises(ValueError):
+        supercompress(BC4Encoder(0).encode(rawtex), 0)
+    with pytest.raises(ValueError):
+        transcode(b'DDS ' + data[4:])
+    with pytest.raises(ValueError):
+        transcode(data[:4] + b'\x02' + data[5:])
+    with pytest.raises(ValueError):
+        transcode(data[:5] + b'\x02' + data[6:])
+    with pytest.raises(ValueError):
+        transcode(data[: len(data) // 2])
+    with pytest.raises(ValueError):
+        # a size with far more blocks than the data could hold
+        transcode(data[:8] + struct.pack('<4I', 4096, 4096, 1 << 20, 1) + data[24:])